@@ -8829,7 +8829,7 @@ static int DecompressionStateTable[510 * 16] =
 };
 
 
-bool unhuffimage4(uint32_t* compressed_image, uint32_t compressed_length_u32s, uint32_t stride_bytes, uint32_t height, unsigned char* image)
+inline bool unhuffimage4(uint32_t* compressed_image, uint32_t compressed_length_u32s, uint32_t stride_bytes, uint32_t height, unsigned char* image)
 {
     memcpy(((char*)(image)), ((char*)(compressed_image)), stride_bytes);
     uint32_t wordCount = (stride_bytes + 3) >> 2;
@@ -48,6 +48,17 @@ int rs2_device_list_contains(const rs2_device_list* info_list, const rs2_device*
 */
 rs2_device* rs2_create_device(const rs2_device_list* info_list, int index, rs2_error** error);
 
+/**
+* Creates every device of the list, constructing them concurrently. Devices are initialized through several round-trips
+* to the firmware each; with multiple cameras connected this is considerably faster than calling rs2_create_device in turn.
+* \param[in]  info_list the list of devices to create
+* \param[out] devices   receives rs2_get_device_count(info_list) devices, each to be released by rs2_delete_device
+* \param[in]  count     the size of 'devices', which must be the number of devices in the list
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored.
+*                       Fails if any of the devices fails, in which case none is returned.
+*/
+void rs2_create_devices(const rs2_device_list* info_list, rs2_device** devices, int count, rs2_error** error);
+
 /**
 * Delete RealSense device
 * \param[in]  device    Realsense device to delete
@@ -96,6 +96,16 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 */
 int rs2_supports_frame_metadata(const rs2_frame* frame, rs2_frame_metadata_value frame_metadata, rs2_error** error);
 
+/**
+* retrieve every metadata attribute supported by the frame in a single call, without failing on unsupported ones
+* \param[in] frame      handle returned from a callback
+* \param[out] values    array indexed by rs2_frame_metadata_value, receives the value of each supported attribute
+* \param[in] count      number of entries in values, normally RS2_FRAME_METADATA_COUNT
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               bitmask of the supported attributes, bit i set when values[i] was written
+*/
+unsigned long long rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int count, rs2_error** error);
+
 /**
 * retrieve timestamp domain from frame handle. timestamps can only be comparable if they are in common domain
 * (for example, depth timestamp might come from system time while color timestamp might come from the device)
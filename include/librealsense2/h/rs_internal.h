@@ -458,6 +458,17 @@ void rs2_delete_fw_log_parsed_message(rs2_firmware_log_parsed_message* fw_log_pa
 */
 int rs2_parse_firmware_log(rs2_device* dev, rs2_firmware_log_message* fw_log_msg, rs2_firmware_log_parsed_message* parsed_msg, rs2_error** error);
 
+/**
+* \brief Parses a batch of RealSense firmware log messages, each into its own parsed message
+* \param[in] dev                Device from which the FW logs were taken
+* \param[in] fw_log_msgs        array of 'count' firmware log messages to be parsed
+* \param[in] parsed_msgs        array of 'count' firmware log parsed messages - place holders for the results
+* \param[in] count              number of messages
+* \param[out] error             If non-null, receives any error that occurs during this call, otherwise, errors are ignored.
+* \return                       number of messages successfully parsed
+*/
+int rs2_parse_firmware_logs(rs2_device* dev, rs2_firmware_log_message** fw_log_msgs, rs2_firmware_log_parsed_message** parsed_msgs, int count, rs2_error** error);
+
 /**
 * \brief Returns number of fw logs already polled from device but not by user yet
 * \param[in] dev                Device from which the FW log will be taken
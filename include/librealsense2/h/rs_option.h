@@ -128,6 +128,9 @@ extern "C" {
 		RS2_OPTION_SET_SP_FILTER_HEIGHT, 
 		RS2_OPTION_SET_SP_FILTER_DEPTH_ANGLE,
 		RS2_OPTION_SET_SP_FILTER_CONTURE_MODE,
+		RS2_OPTION_HISTOGRAM_UPDATE_INTERVAL, /**< Number of frames between depth histogram recalculations of the colorizer. 1 recalculates on every frame */
+		RS2_OPTION_MOTION_BATCH_SIZE, /**< Motion samples gathered in a frame of RS2_FORMAT_MOTION_XYZ32F_BATCH */
+		RS2_OPTION_MOTION_BATCH_MAX_AGE, /**< Milliseconds after which a batch of motion samples is sent, even if not full */
         RS2_OPTION_COUNT /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
     } rs2_option;
 
@@ -271,6 +271,139 @@ rs2_processing_block* rs2_create_huffman_depth_decompress_block(rs2_error** erro
 */
 rs2_processing_block* rs2_create_hdr_merge_processing_block(rs2_error** error);
 
+/**
+* Creates a fused filter chain processing block.
+* Depth blocks added to the chain are executed in order; consecutive per-pixel blocks (threshold,
+* disparity transform, hole filling from left) run together on bands of rows into a single output
+* frame, and every other block is executed on the whole frame
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_fused_filter_chain(rs2_error** error);
+
+/**
+* Appends a processing block to a fused filter chain. The chain takes over the output of the block
+* \param[in] chain   fused filter chain created with rs2_create_fused_filter_chain
+* \param[in] block   processing block to append
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_fused_filter_chain_add(rs2_processing_block* chain, rs2_processing_block* block, rs2_error** error);
+
+/**
+* \param[in] chain   fused filter chain
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return            the number of stages in the chain
+*/
+int rs2_fused_filter_chain_get_stages_count(rs2_processing_block* chain, rs2_error** error);
+
+/**
+* \param[in] chain   fused filter chain
+* \param[in] index   index of the stage
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return            the name of the processing block of the stage
+*/
+const char* rs2_fused_filter_chain_get_stage_name(rs2_processing_block* chain, int index, rs2_error** error);
+
+/**
+* \param[in] chain   fused filter chain
+* \param[in] index   index of the stage
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return            average processing time of the stage per frame, in milliseconds
+*/
+float rs2_fused_filter_chain_get_stage_time(rs2_processing_block* chain, int index, rs2_error** error);
+
+/** \brief Counters of a node of a processing graph. */
+typedef struct rs2_processing_node_stats
+{
+    int                queue_depth;        /**< Frames waiting for a block of the node */
+    int                queue_size;         /**< Waiting frames above which the oldest one is dropped */
+    unsigned long long processed;          /**< Frames processed by the node */
+    unsigned long long dropped;            /**< Frames dropped from the queue of the node */
+    float              average_latency_ms; /**< Average time from the arrival of a frame at the node to its result */
+} rs2_processing_node_stats;
+
+/**
+* Creates a processing graph: processing blocks connected as a tree and executed asynchronously on
+* a pool of worker threads, so that consecutive frames are pipelined through the blocks.
+* A node with a single block processes frames one at a time and in order, as stateful blocks need;
+* stateless blocks can be given replicas to process several frames in parallel. The graph outputs
+* the result of its leaf (or a frameset of the results of its leaves) in input frame order.
+* Results are delivered asynchronously to the callback given to rs2_start_processing
+* \param[in] threads  number of worker threads, or 0 for one per core
+* \param[out] error   if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_processing_graph(int threads, rs2_error** error);
+
+/**
+* Adds a node to a processing graph. Nodes can only be added before the graph processes frames
+* \param[in] graph   processing graph created with rs2_create_processing_graph
+* \param[in] block   processing block of the node. The graph takes over its output, which the block must
+*                    output from within its processing call; results output later are dropped
+* \param[in] parent  index of the node whose results the new node processes, or -1 for the frames given to the graph.
+*                    A node has a single parent: the graph is a tree
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return            the index of the new node
+*/
+int rs2_processing_graph_add_node(rs2_processing_block* graph, rs2_processing_block* block, int parent, rs2_error** error);
+
+/**
+* Adds a replica to a node of a processing graph: another instance of the block of the node, configured
+* the same way, that processes frames in parallel with it. Only stateless blocks should be replicated
+* \param[in] graph   processing graph
+* \param[in] node    index of the node
+* \param[in] block   processing block instance. The graph takes over its output
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_processing_graph_add_replica(rs2_processing_block* graph, int node, rs2_processing_block* block, rs2_error** error);
+
+/**
+* Sets the number of frames that can wait for a node of a processing graph before the oldest one is dropped
+* \param[in] graph   processing graph
+* \param[in] node    index of the node
+* \param[in] size    maximum number of waiting frames
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_processing_graph_set_queue_size(rs2_processing_block* graph, int node, int size, rs2_error** error);
+
+/**
+* \param[in] graph   processing graph
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return            the number of nodes in the graph
+*/
+int rs2_processing_graph_get_nodes_count(rs2_processing_block* graph, rs2_error** error);
+
+/**
+* \param[in] graph   processing graph
+* \param[in] node    index of the node
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return            the name of the processing block of the node
+*/
+const char* rs2_processing_graph_get_node_name(rs2_processing_block* graph, int node, rs2_error** error);
+
+/**
+* \param[in] graph   processing graph
+* \param[in] node    index of the node
+* \param[out] stats  receives the counters of the node
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_processing_graph_get_node_stats(rs2_processing_block* graph, int node, rs2_processing_node_stats* stats, rs2_error** error);
+
+/**
+* \param[in] graph   processing graph
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return            the number of input frames dropped because the graph already held as many frames as it can
+*/
+unsigned long long rs2_processing_graph_get_dropped_frames(rs2_processing_block* graph, rs2_error** error);
+
+/**
+* Creates a motion batcher: gathers the samples of RS2_FORMAT_MOTION_XYZ32F streams into frames of
+* RS2_FORMAT_MOTION_XYZ32F_BATCH, one per stream. A batch is sent once it holds RS2_OPTION_MOTION_BATCH_SIZE samples,
+* or once its first sample waited RS2_OPTION_MOTION_BATCH_MAX_AGE milliseconds, which a timer thread of the block
+* checks, so the samples of a stream that stalls are still delivered.
+* Other frames pass through. Results are delivered asynchronously to the callback given to rs2_start_processing
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_motion_batcher(rs2_error** error);
+
 /**
 * Creates a sequence_id_filter processing block.
 * The block lets frames with the selected sequence id pass and blocks frames with other values
@@ -131,6 +131,14 @@ typedef struct rs2_vector
     float x, y, z;
 }rs2_vector;
 
+/** \brief Header of the frames of RS2_FORMAT_MOTION_XYZ32F_BATCH. It is followed by the timestamps of the samples
+    (double, milliseconds), then by their X, Y and Z values (float), each in an array of count values */
+typedef struct rs2_motion_batch_header
+{
+    unsigned int count;         /**< Samples in the frame */
+    unsigned int reserved[3];
+} rs2_motion_batch_header;
+
 /** \brief Quaternion used to represent rotation  */
 typedef struct rs2_quaternion
 {
@@ -732,10 +732,20 @@ namespace rs2
         device_list()
             : _list(nullptr) {}
 
+        // Creates all the devices of the list at once, concurrently
         operator std::vector<device>() const
         {
+            std::vector<rs2_device*> devices(size());
+            if (devices.empty())
+                return {};
+
+            rs2_error* e = nullptr;
+            rs2_create_devices(_list.get(), devices.data(), static_cast<int>(devices.size()), &e);
+            error::handle(e);
+
             std::vector<device> res;
-            for (auto&& dev : *this) res.push_back(dev);
+            for (auto dev : devices)
+                res.push_back(device(std::shared_ptr<rs2_device>(dev, rs2_delete_device)));
             return res;
         }
 
@@ -5,7 +5,11 @@
 #define LIBREALSENSE_RS2_EXPORT_HPP
 
 #include <map>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <vector>
 #include <cmath>
 #include <sstream>
 #include <cassert>
@@ -13,6 +17,9 @@
 #include "rs_internal.hpp"
 #include <iostream>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <chrono>
 namespace rs2
 {
@@ -39,20 +46,177 @@ namespace rs2
         static const auto OPTION_PLY_BINARY = rs2_option(RS2_OPTION_COUNT + 12);
         static const auto OPTION_PLY_NORMALS = rs2_option(RS2_OPTION_COUNT + 13);
         static const auto OPTION_PLY_THRESHOLD = rs2_option(RS2_OPTION_COUNT + 14);
+        // 0 exports every frame to the file name given on construction. N > 0 exports every Nth frame
+        // to "<filename><frame number>.ply" on a background thread, so a live pipeline is never held up:
+        // a frame arriving while the previous export is still running replaces the one waiting for it
+        static const auto OPTION_PLY_EVERY_NTH_FRAME = rs2_option(RS2_OPTION_COUNT + 15);
 
         save_to_ply(std::string filename = "RealSense Pointcloud ", pointcloud pc = pointcloud()) : filter([this](frame f, frame_source& s) { func(f, s); }),
-            _pc(std::move(pc)), fname(filename)
+            _exporter(std::make_shared<exporter>(std::move(pc), filename))
         {
             register_simple_option(OPTION_IGNORE_COLOR, option_range{ 0, 1, 0, 1 });
             register_simple_option(OPTION_PLY_MESH, option_range{ 0, 1, 1, 1 });
             register_simple_option(OPTION_PLY_NORMALS, option_range{ 0, 1, 0, 1 });
             register_simple_option(OPTION_PLY_BINARY, option_range{ 0, 1, 1, 1 });
             register_simple_option(OPTION_PLY_THRESHOLD, option_range{ 0, 1, 0.05f, 0 });
+            register_simple_option(OPTION_PLY_EVERY_NTH_FRAME, option_range{ 0, 1000, 0, 1 });
         }
 
     private:
+        struct ply_options
+        {
+            bool ignore_color, mesh, binary, normals;
+            float threshold;
+        };
+
+        // A fixed set of threads that parallel_for() hands ranges to, started on first use
+        class thread_pool
+        {
+        public:
+            ~thread_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stopping = true;
+                }
+                _wake.notify_all();
+                for (auto&& t : _threads)
+                    t.join();
+            }
+
+            static size_t max_threads() { return std::max<size_t>(1, std::thread::hardware_concurrency()); }
+
+            // Splits [0, count) into 'ranges' contiguous ranges and runs f(begin, end, range) on each,
+            // on the pool threads and the calling one
+            template<class F>
+            void parallel_for(size_t count, size_t ranges, F f)
+            {
+                std::lock_guard<std::mutex> call_lock(_call_mutex);
+                if (ranges <= 1)
+                {
+                    f(0, count, 0);
+                    return;
+                }
+
+                std::function<void(size_t)> task = [&](size_t r) { f(count * r / ranges, count * (r + 1) / ranges, r); };
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    while (_threads.size() + 1 < max_threads())
+                        _threads.emplace_back([this]() { run(); });
+                    _task = &task;
+                    _ranges = ranges;
+                    _next = 0;
+                    _done = 0;
+                    _generation++;
+                }
+                _wake.notify_all();
+
+                size_t done = run_ranges();
+                std::unique_lock<std::mutex> lock(_mutex);
+                _done += done;
+                _finished.wait(lock, [&]() { return _done == _ranges && !_active; });
+                _task = nullptr;
+            }
+
+        private:
+            size_t run_ranges()
+            {
+                size_t done = 0;
+                for (size_t r = _next++; r < _ranges; r = _next++, ++done)
+                    (*_task)(r);
+                return done;
+            }
+
+            void run()
+            {
+                unsigned long long seen = 0;
+                std::unique_lock<std::mutex> lock(_mutex);
+                while (true)
+                {
+                    _wake.wait(lock, [&]() { return _stopping || (_task && _generation != seen); });
+                    if (_stopping)
+                        return;
+                    seen = _generation;
+                    _active++;
+
+                    lock.unlock();
+                    size_t done = run_ranges();
+                    lock.lock();
+                    _done += done;
+                    if (!--_active && _done == _ranges)
+                        _finished.notify_all();
+                }
+            }
+
+            std::mutex _call_mutex;
+            std::mutex _mutex;
+            std::condition_variable _wake, _finished;
+            std::vector<std::thread> _threads;
+            std::function<void(size_t)>* _task = nullptr;
+            size_t _ranges = 0, _done = 0, _active = 0;
+            std::atomic<size_t> _next{ 0 };
+            unsigned long long _generation = 0;
+            bool _stopping = false;
+        };
+
+        // State of the export, shared by the copies of the filter and by the background thread,
+        // which therefore never refers to the filter object itself
+        struct exporter
+        {
+            exporter(pointcloud p, std::string name) : pc(std::move(p)), fname(std::move(name)) {}
+            ~exporter()
+            {
+                if (worker.joinable())
+                {
+                    worker_alive = false;
+                    worker.join();
+                }
+            }
+
+            pointcloud pc;
+            std::string fname;
+            std::mutex save_mutex;      // Serializes pc and pool between the worker and an inline export
+            thread_pool pool;
+            frame_queue pending{ 1, true };
+            std::mutex options_mutex;
+            ply_options options{};      // Options of the frame waiting in 'pending'
+            std::thread worker;
+            std::atomic<bool> worker_alive{ false };
+            unsigned long long frames_seen = 0;
+        };
+
+        ply_options current_options()
+        {
+            return { get_option(OPTION_IGNORE_COLOR) != 0, get_option(OPTION_PLY_MESH) != 0,
+                     get_option(OPTION_PLY_BINARY) != 0, get_option(OPTION_PLY_NORMALS) != 0,
+                     get_option(OPTION_PLY_THRESHOLD) };
+        }
+
         void func(frame data, frame_source& source)
         {
+            auto every_nth = static_cast<unsigned long long>(get_option(OPTION_PLY_EVERY_NTH_FRAME));
+            auto& e = *_exporter;
+            if (!every_nth)
+                save(e, data, e.fname, current_options());
+            else if (e.frames_seen++ % every_nth == 0)
+            {
+                start_worker();
+                {
+                    std::lock_guard<std::mutex> lock(e.options_mutex);
+                    e.options = current_options();
+                }
+                e.pending.enqueue(data);
+            }
+
+            source.frame_ready(data); // passthrough filter because processing_block::process doesn't support sinks
+        }
+
+        // Runs on the filter's thread when exporting every frame and on the worker otherwise. Both can run at
+        // once right after OPTION_PLY_EVERY_NTH_FRAME is set to 0, so they take turns on the pointcloud
+        static void save(exporter& e, frame data, const std::string& filename, const ply_options& options)
+        {
+            std::lock_guard<std::mutex> lock(e.save_mutex);
+
             frame depth, color;
             if (auto fs = data.as<frameset>()) {
                 for (auto f : fs) {
@@ -66,109 +230,171 @@ namespace rs2
 
             if (!depth) throw std::runtime_error("Need depth data to save PLY");
             if (!depth.is<points>()) {
-                if (color) _pc.map_to(color);
-                depth = _pc.calculate(depth);
+                if (color) e.pc.map_to(color);
+                depth = e.pc.calculate(depth);
             }
 
-            export_to_ply(depth, color);
-            source.frame_ready(data); // passthrough filter because processing_block::process doesn't support sinks
+            export_to_ply(e.pool, depth, color, filename, options);
+        }
+
+        void start_worker()
+        {
+            auto e = _exporter.get();
+            if (e->worker.joinable())
+                return;
+
+            e->worker_alive = true;
+            e->worker = std::thread([e]() {
+                while (e->worker_alive)
+                {
+                    frame f;
+                    if (!e->pending.try_wait_for_frame(&f, 100))
+                        continue;
+
+                    ply_options options;
+                    {
+                        std::lock_guard<std::mutex> lock(e->options_mutex);
+                        options = e->options;
+                    }
+
+                    std::stringstream name;
+                    name << e->fname << f.get_frame_number() << ".ply";
+                    try
+                    {
+                        save(*e, f, name.str(), options);
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        rs2_error* err = nullptr;
+                        rs2_log(RS2_LOG_SEVERITY_ERROR, ex.what(), &err);
+                        if (err) rs2_free_error(err);
+                    }
+                }
+            });
         }
 
-        void export_to_ply(points p, video_frame color) {
-            const bool use_texcoords  = color && !get_option(OPTION_IGNORE_COLOR);
-            bool mesh = get_option(OPTION_PLY_MESH) != 0;
-            bool binary = get_option(OPTION_PLY_BINARY) != 0;
-            bool use_normals = get_option(OPTION_PLY_NORMALS) != 0;
+        static size_t parallel_ranges(size_t count, size_t min_per_range)
+        {
+            return std::max<size_t>(1, std::min(thread_pool::max_threads(), count / min_per_range));
+        }
+
+        static void export_to_ply(thread_pool& pool, points p, video_frame color, const std::string& filename, const ply_options& options) {
+            const bool use_texcoords  = color && !options.ignore_color;
+            bool mesh = options.mesh;
+            bool binary = options.binary;
+            bool use_normals = mesh && options.normals;
+            const auto threshold = options.threshold;
             const auto verts = p.get_vertices();
             const auto texcoords = p.get_texture_coordinates();
-            const uint8_t* texture_data;
+            texture_view tex{};
             if (use_texcoords) // texture might be on the gpu, get pointer to data before for-loop to avoid repeated access
-                texture_data = reinterpret_cast<const uint8_t*>(color.get_data());
-            std::vector<rs2::vertex> new_verts;
-            std::vector<vec3d> normals;
-            std::vector<std::array<uint8_t, 3>> new_tex;
-            std::map<size_t, size_t> idx_map;
-            std::map<size_t, std::vector<vec3d>> index_to_normals;
-
-            new_verts.reserve(p.size());
-            if (use_texcoords) new_tex.reserve(p.size());
+                tex = { reinterpret_cast<const uint8_t*>(color.get_data()), color.get_width(), color.get_height(),
+                        color.get_bytes_per_pixel(), color.get_stride_in_bytes() };
 
             static const auto min_distance = 1e-6;
+            static const size_t min_vertices_per_thread = 16 * 1024;
 
+            // Dense pixel -> exported vertex index, -1 for pixels that have no point
+            std::vector<int> idx_map(p.size());
+            int vertex_count = 0;
             for (size_t i = 0; i < p.size(); ++i) {
                 if (fabs(verts[i].x) >= min_distance || fabs(verts[i].y) >= min_distance ||
                     fabs(verts[i].z) >= min_distance)
+                    idx_map[i] = vertex_count++;
+                else
+                    idx_map[i] = -1;
+            }
+
+            std::vector<vec3d> new_verts(vertex_count);
+            std::vector<std::array<uint8_t, 3>> new_tex(use_texcoords ? vertex_count : 0);
+            pool.parallel_for(p.size(), parallel_ranges(p.size(), min_vertices_per_thread), [&](size_t begin, size_t end, size_t) {
+                for (size_t i = begin; i < end; ++i)
                 {
-                    idx_map[int(i)] = int(new_verts.size());
-                    new_verts.push_back({ verts[i].x, -1 * verts[i].y, -1 * verts[i].z });
+                    auto idx = idx_map[i];
+                    if (idx < 0)
+                        continue;
+                    new_verts[idx] = { verts[i].x, -1 * verts[i].y, -1 * verts[i].z };
                     if (use_texcoords)
-                    {
-                        auto rgb = get_texcolor(color, texture_data, texcoords[i].u, texcoords[i].v);
-                        new_tex.push_back(rgb);
-                    }
+                        new_tex[idx] = get_texcolor(tex, texcoords[i].u, texcoords[i].v);
                 }
-            }
+            });
 
             auto profile = p.get_profile().as<video_stream_profile>();
-            auto width = profile.width(), height = profile.height();
-            static const auto threshold = get_option(OPTION_PLY_THRESHOLD);
-            std::vector<std::array<size_t, 3>> faces;
-            if (mesh)
+            size_t width = profile.width(), height = profile.height();
+            std::vector<std::array<int, 3>> faces;
+            std::vector<vec3d> normals;
+            if (mesh && width > 1 && height > 1)
             {
-                for (size_t x = 0; x < width - 1; ++x) {
-                    for (size_t y = 0; y < height - 1; ++y) {
-                        auto a = y * width + x, b = y * width + x + 1, c = (y + 1)*width + x, d = (y + 1)*width + x + 1;
-                        if (verts[a].z && verts[b].z && verts[c].z && verts[d].z
-                            && fabs(verts[a].z - verts[b].z) < threshold && fabs(verts[a].z - verts[c].z) < threshold
-                            && fabs(verts[b].z - verts[d].z) < threshold && fabs(verts[c].z - verts[d].z) < threshold)
-                        {
-                            if (idx_map.count(a) == 0 || idx_map.count(b) == 0 || idx_map.count(c) == 0 ||
-                                idx_map.count(d) == 0)
-                                continue;
-                            faces.push_back({ idx_map[a], idx_map[d], idx_map[b] });
-                            faces.push_back({ idx_map[d], idx_map[a], idx_map[c] });
-
-                            if (use_normals)
+                // Faces are emitted column by column. Bands of columns are scanned concurrently and joined
+                // in order, so the file does not depend on the number of threads.
+                struct quad { size_t a; vec3d n1, n2; };
+                std::vector<std::vector<quad>> bands(parallel_ranges(width - 1, 16));
+                pool.parallel_for(width - 1, bands.size(), [&](size_t begin, size_t end, size_t band) {
+                    for (size_t x = begin; x < end; ++x) {
+                        for (size_t y = 0; y < height - 1; ++y) {
+                            auto a = y * width + x, b = y * width + x + 1, c = (y + 1)*width + x, d = (y + 1)*width + x + 1;
+                            if (verts[a].z && verts[b].z && verts[c].z && verts[d].z
+                                && fabs(verts[a].z - verts[b].z) < threshold && fabs(verts[a].z - verts[c].z) < threshold
+                                && fabs(verts[b].z - verts[d].z) < threshold && fabs(verts[c].z - verts[d].z) < threshold
+                                && idx_map[a] >= 0 && idx_map[b] >= 0 && idx_map[c] >= 0 && idx_map[d] >= 0)
                             {
-                                vec3d point_a = { verts[a].x ,  -1 * verts[a].y,  -1 * verts[a].z };
-                                vec3d point_b = { verts[b].x ,  -1 * verts[b].y,  -1 * verts[b].z };
-                                vec3d point_c = { verts[c].x ,  -1 * verts[c].y,  -1 * verts[c].z };
-                                vec3d point_d = { verts[d].x ,  -1 * verts[d].y,  -1 * verts[d].z };
-
-                                auto n1 = cross(point_d - point_a, point_b - point_a);
-                                auto n2 = cross(point_c - point_a, point_d - point_a);
-
-                                index_to_normals[idx_map[a]].push_back(n1);
-                                index_to_normals[idx_map[a]].push_back(n2);
+                                quad q{ a, {}, {} };
+                                if (use_normals)
+                                {
+                                    vec3d point_a = { verts[a].x ,  -1 * verts[a].y,  -1 * verts[a].z };
+                                    vec3d point_b = { verts[b].x ,  -1 * verts[b].y,  -1 * verts[b].z };
+                                    vec3d point_c = { verts[c].x ,  -1 * verts[c].y,  -1 * verts[c].z };
+                                    vec3d point_d = { verts[d].x ,  -1 * verts[d].y,  -1 * verts[d].z };
+
+                                    q.n1 = cross(point_d - point_a, point_b - point_a);
+                                    q.n2 = cross(point_c - point_a, point_d - point_a);
+                                }
+                                bands[band].push_back(q);
+                            }
+                        }
+                    }
+                });
 
-                                index_to_normals[idx_map[b]].push_back(n1);
+                size_t quads = 0;
+                for (auto& band : bands)
+                    quads += band.size();
+                faces.reserve(2 * quads);
 
-                                index_to_normals[idx_map[c]].push_back(n2);
+                // Normals of a vertex are summed in face order, the same order a serial scan would use
+                std::vector<vec3d> sums(use_normals ? vertex_count : 0, vec3d{ 0, 0, 0 });
+                std::vector<uint8_t> has_normal(use_normals ? vertex_count : 0, 0);
+                for (auto& band : bands)
+                {
+                    for (auto& q : band)
+                    {
+                        auto ia = idx_map[q.a], ib = idx_map[q.a + 1], ic = idx_map[q.a + width], id = idx_map[q.a + width + 1];
+                        faces.push_back({ ia, id, ib });
+                        faces.push_back({ id, ia, ic });
 
-                                index_to_normals[idx_map[d]].push_back(n1);
-                                index_to_normals[idx_map[d]].push_back(n2);
-                            }
+                        if (use_normals)
+                        {
+                            sums[ia] = sums[ia] + q.n1;
+                            sums[ia] = sums[ia] + q.n2;
+                            sums[ib] = sums[ib] + q.n1;
+                            sums[ic] = sums[ic] + q.n2;
+                            sums[id] = sums[id] + q.n1;
+                            sums[id] = sums[id] + q.n2;
+                            has_normal[ia] = has_normal[ib] = has_normal[ic] = has_normal[id] = 1;
                         }
                     }
                 }
-            }
 
-            if (mesh && use_normals)
-            {
-                for (size_t i = 0; i < new_verts.size(); ++i)
+                if (use_normals)
                 {
-                    auto normals_vec = index_to_normals[i];
-                    vec3d sum = { 0, 0, 0 };
-                    for (auto& n : normals_vec)
-                        sum = sum + n;
-                    if (normals_vec.size() > 0)
-                        normals.push_back((sum.normalize()));
-                    else
-                        normals.push_back({ 0, 0, 0 });
+                    normals.resize(vertex_count);
+                    pool.parallel_for(vertex_count, parallel_ranges(vertex_count, min_vertices_per_thread), [&](size_t begin, size_t end, size_t) {
+                        for (size_t i = begin; i < end; ++i)
+                            normals[i] = has_normal[i] ? sums[i].normalize() : vec3d{ 0, 0, 0 };
+                    });
                 }
             }
 
-            std::ofstream out(fname);
+            std::ofstream out(filename);
             out << "ply\n";
             if (binary)
                 out << "format binary_little_endian 1.0\n";
@@ -179,7 +405,7 @@ namespace rs2
             out << "property float" << sizeof(float) * 8 << " x\n";
             out << "property float" << sizeof(float) * 8 << " y\n";
             out << "property float" << sizeof(float) * 8 << " z\n";
-            if (mesh && use_normals)
+            if (use_normals)
             {
                 out << "property float" << sizeof(float) * 8 << " nx\n";
                 out << "property float" << sizeof(float) * 8 << " ny\n";
@@ -201,38 +427,48 @@ namespace rs2
             if (binary)
             {
                 out.close();
-                out.open(fname, std::ios_base::app | std::ios_base::binary);
-                for (size_t i = 0; i < new_verts.size(); ++i)
-                {
-                    // we assume little endian architecture on your device
-                    out.write(reinterpret_cast<const char*>(&(new_verts[i].x)), sizeof(float));
-                    out.write(reinterpret_cast<const char*>(&(new_verts[i].y)), sizeof(float));
-                    out.write(reinterpret_cast<const char*>(&(new_verts[i].z)), sizeof(float));
+                out.open(filename, std::ios_base::app | std::ios_base::binary);
 
-                    if (mesh && use_normals)
-                    {
-                        out.write(reinterpret_cast<const char*>(&(normals[i].x)), sizeof(float));
-                        out.write(reinterpret_cast<const char*>(&(normals[i].y)), sizeof(float));
-                        out.write(reinterpret_cast<const char*>(&(normals[i].z)), sizeof(float));
-                    }
+                // The body is formatted into large chunks in parallel and streamed out with one write per chunk
+                // (we assume little endian architecture on your device)
+                static const size_t chunk_elements = 64 * 1024;
+                const size_t vertex_stride = 3 * sizeof(float) + (use_normals ? 3 * sizeof(float) : 0) + (use_texcoords ? 3 : 0);
+                const size_t face_stride = sizeof(uint8_t) + 3 * sizeof(int);
+                std::vector<char> chunk;
 
-                    if (use_texcoords)
-                    {
-                        out.write(reinterpret_cast<const char*>(&(new_tex[i][0])), sizeof(uint8_t));
-                        out.write(reinterpret_cast<const char*>(&(new_tex[i][1])), sizeof(uint8_t));
-                        out.write(reinterpret_cast<const char*>(&(new_tex[i][2])), sizeof(uint8_t));
-                    }
+                for (size_t first = 0; first < new_verts.size(); first += chunk_elements)
+                {
+                    auto count = std::min(chunk_elements, new_verts.size() - first);
+                    chunk.resize(count * vertex_stride);
+                    pool.parallel_for(count, parallel_ranges(count, min_vertices_per_thread), [&](size_t begin, size_t end, size_t) {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            auto dst = chunk.data() + i * vertex_stride;
+                            memcpy(dst, &new_verts[first + i], 3 * sizeof(float));
+                            dst += 3 * sizeof(float);
+                            if (use_normals)
+                            {
+                                memcpy(dst, &normals[first + i], 3 * sizeof(float));
+                                dst += 3 * sizeof(float);
+                            }
+                            if (use_texcoords)
+                                memcpy(dst, new_tex[first + i].data(), 3);
+                        }
+                    });
+                    out.write(chunk.data(), chunk.size());
                 }
-                if (mesh)
+
+                for (size_t first = 0; first < faces.size(); first += chunk_elements)
                 {
-                    auto size = faces.size();
-                    for (size_t i = 0; i < size; ++i) {
-                        static const int three = 3;
-                        out.write(reinterpret_cast<const char*>(&three), sizeof(uint8_t));
-                        out.write(reinterpret_cast<const char*>(&(faces[i][0])), sizeof(int));
-                        out.write(reinterpret_cast<const char*>(&(faces[i][1])), sizeof(int));
-                        out.write(reinterpret_cast<const char*>(&(faces[i][2])), sizeof(int));
+                    auto count = std::min(chunk_elements, faces.size() - first);
+                    chunk.resize(count * face_stride);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        auto dst = chunk.data() + i * face_stride;
+                        dst[0] = 3;
+                        memcpy(dst + 1, faces[first + i].data(), 3 * sizeof(int));
                     }
+                    out.write(chunk.data(), chunk.size());
                 }
             }
             else
@@ -244,7 +480,7 @@ namespace rs2
                     out << new_verts[i].z << " ";
                     out << "\n";
 
-                    if (mesh && use_normals)
+                    if (use_normals)
                     {
                         out << normals[i].x << " ";
                         out << normals[i].y << " ";
@@ -275,17 +511,22 @@ namespace rs2
             }
         }
 
-        std::array<uint8_t, 3> get_texcolor(const video_frame& texture, const uint8_t* texture_data, float u, float v)
+        struct texture_view
         {
-            const int w = texture.get_width(), h = texture.get_height();
+            const uint8_t* data;
+            int width, height, bpp, stride;
+        };
+
+        static std::array<uint8_t, 3> get_texcolor(const texture_view& texture, float u, float v)
+        {
+            const int w = texture.width, h = texture.height;
             int x = std::min(std::max(int(u*w + .5f), 0), w - 1);
             int y = std::min(std::max(int(v*h + .5f), 0), h - 1);
-            int idx = x * texture.get_bytes_per_pixel() + y * texture.get_stride_in_bytes();
-            return { texture_data[idx], texture_data[idx + 1], texture_data[idx + 2] };
+            int idx = x * texture.bpp + y * texture.stride;
+            return { texture.data[idx], texture.data[idx + 1], texture.data[idx + 2] };
         }
 
-        std::string fname;
-        pointcloud _pc;
+        std::shared_ptr<exporter> _exporter;
     };
 
     class save_single_frameset : public filter {
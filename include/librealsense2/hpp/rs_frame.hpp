@@ -526,6 +526,18 @@ namespace rs2
             return r != 0;
         }
 
+        /** retrieve every metadata attribute the frame supports in a single call
+        * \param[out] values  receives the value of each supported attribute, indexed by rs2_frame_metadata_value
+        * \return            bitmask of the supported attributes, bit i set when values[i] was written
+        */
+        unsigned long long get_frame_metadata_all(rs2_metadata_type (&values)[RS2_FRAME_METADATA_COUNT]) const
+        {
+            rs2_error* e = nullptr;
+            auto r = rs2_get_frame_metadata_all(frame_ref, values, RS2_FRAME_METADATA_COUNT, &e);
+            error::handle(e);
+            return r;
+        }
+
         /**
         * retrieve frame number (from frame handle)
         * \return               the frame number of the frame, in milliseconds since the device was started
@@ -559,6 +559,29 @@ namespace rs2
             return parsingResult;
         }
 
+        // Parses msgs[i] into parsed_msgs[i]; returns the number of messages parsed
+        size_t parse_logs(const std::vector<rs2::firmware_log_message>& msgs, const std::vector<rs2::firmware_log_parsed_message>& parsed_msgs)
+        {
+            if (msgs.size() != parsed_msgs.size())
+                throw error("Number of parsed messages does not match number of messages!");
+            if (msgs.empty())
+                return 0;
+
+            std::vector<rs2_firmware_log_message*> raw_msgs;
+            std::vector<rs2_firmware_log_parsed_message*> raw_parsed_msgs;
+            for (size_t i = 0; i < msgs.size(); ++i)
+            {
+                raw_msgs.push_back(msgs[i].get_message().get());
+                raw_parsed_msgs.push_back(parsed_msgs[i].get_message().get());
+            }
+
+            rs2_error* e = nullptr;
+            auto parsed = rs2_parse_firmware_logs(_dev.get(), raw_msgs.data(), raw_parsed_msgs.data(), static_cast<int>(msgs.size()), &e);
+            error::handle(e);
+
+            return static_cast<size_t>(parsed);
+        }
+
         unsigned int get_number_of_fw_logs() const
         {
             rs2_error* e = nullptr;
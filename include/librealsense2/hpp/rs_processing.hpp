@@ -1205,5 +1205,213 @@ namespace rs2
             return block;
         }
     };
+
+    class fused_filter_chain : public filter
+    {
+    public:
+        /**
+        * Create fused_filter_chain processing block
+        * the block runs the added depth filters in order, fusing consecutive per-pixel filters
+        * into a single pass over bands of rows that produces a single output frame.
+        */
+        fused_filter_chain() : filter(init(), 1) {}
+
+        /**
+        * Append a filter to the chain. The chain takes over the output of the filter,
+        * which should no longer be used to process frames on its own. The filter must output
+        * its result from within its processing call, as the filters of the library do.
+        * \param[in] f - filter to append
+        */
+        void add(const filter& f)
+        {
+            rs2_error* e = nullptr;
+            rs2_fused_filter_chain_add(get(), f.get(), &e);
+            error::handle(e);
+        }
+
+        /**
+        * Average processing time of every stage of the chain per frame
+        * \return pairs of the stage name and its time in milliseconds
+        */
+        std::vector<std::pair<std::string, float>> get_stage_timings() const
+        {
+            rs2_error* e = nullptr;
+            auto count = rs2_fused_filter_chain_get_stages_count(get(), &e);
+            error::handle(e);
+
+            std::vector<std::pair<std::string, float>> res;
+            for (int i = 0; i < count; i++)
+            {
+                std::string name = rs2_fused_filter_chain_get_stage_name(get(), i, &e);
+                error::handle(e);
+                auto ms = rs2_fused_filter_chain_get_stage_time(get(), i, &e);
+                error::handle(e);
+                res.emplace_back(name, ms);
+            }
+            return res;
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_fused_filter_chain(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class processing_graph : public processing_block
+    {
+    public:
+        /**
+        * Create processing_graph processing block
+        * the block runs a tree of processing blocks asynchronously on a pool of worker threads,
+        * pipelining consecutive frames through them. Results are delivered in input frame order
+        * to the callback given to start().
+        * \param[in] threads - number of worker threads, or 0 for one per core
+        */
+        processing_graph(int threads = 0) : processing_block(init(threads)) {}
+
+        /**
+        * Add a node to the graph, before any frame is processed. The graph takes over the output of
+        * the block, which should no longer be used to process frames on its own. The block must output
+        * its result from within its processing call; results output later are dropped.
+        * \param[in] block  - processing block of the node
+        * \param[in] parent - index of the node whose results the new node processes, or -1 for the frames given to the graph.
+        *                     A node has a single parent: the graph is a tree
+        * \return index of the new node
+        */
+        int add_node(const processing_block& block, int parent = -1)
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_processing_graph_add_node(get(), block.get(), parent, &e);
+            error::handle(e);
+            return res;
+        }
+
+        /**
+        * Add another instance of the block of a stateless node, configured the same way,
+        * so that the node processes several frames in parallel
+        * \param[in] node  - index of the node
+        * \param[in] block - processing block instance
+        */
+        void add_replica(int node, const processing_block& block)
+        {
+            rs2_error* e = nullptr;
+            rs2_processing_graph_add_replica(get(), node, block.get(), &e);
+            error::handle(e);
+        }
+
+        /**
+        * Set the number of frames that can wait for a node before the oldest one is dropped
+        * \param[in] node - index of the node
+        * \param[in] size - maximum number of waiting frames
+        */
+        void set_queue_size(int node, int size)
+        {
+            rs2_error* e = nullptr;
+            rs2_processing_graph_set_queue_size(get(), node, size, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Counters of every node of the graph
+        * \return pairs of the node name and its counters, by node index
+        */
+        std::vector<std::pair<std::string, rs2_processing_node_stats>> get_node_stats() const
+        {
+            rs2_error* e = nullptr;
+            auto count = rs2_processing_graph_get_nodes_count(get(), &e);
+            error::handle(e);
+
+            std::vector<std::pair<std::string, rs2_processing_node_stats>> res;
+            for (int i = 0; i < count; i++)
+            {
+                std::string name = rs2_processing_graph_get_node_name(get(), i, &e);
+                error::handle(e);
+                rs2_processing_node_stats stats;
+                rs2_processing_graph_get_node_stats(get(), i, &stats, &e);
+                error::handle(e);
+                res.emplace_back(name, stats);
+            }
+            return res;
+        }
+
+        /**
+        * \return number of input frames dropped because the graph already held as many frames as it can
+        */
+        unsigned long long get_dropped_frames() const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_processing_graph_get_dropped_frames(get(), &e);
+            error::handle(e);
+            return res;
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_block> init(int threads)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_processing_graph(threads, &e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class motion_batcher : public processing_block
+    {
+    public:
+        /**
+        * Create motion_batcher processing block
+        * the block gathers the samples of MOTION_XYZ32F streams into frames of MOTION_XYZ32F_BATCH, one per stream,
+        * sent once they hold RS2_OPTION_MOTION_BATCH_SIZE samples or once their first sample waited
+        * RS2_OPTION_MOTION_BATCH_MAX_AGE milliseconds, as checked by a timer thread of the block, so the samples of
+        * a stream that stalls are still delivered. Batches are delivered to the callback given to start().
+        */
+        motion_batcher() : processing_block(init()) {}
+
+        /**
+        * Samples of a frame of the MOTION_XYZ32F_BATCH format
+        */
+        struct batch
+        {
+            size_t count;
+            const double* timestamps;   // Milliseconds, as the timestamps of the samples
+            const float* x;
+            const float* y;
+            const float* z;
+        };
+
+        /**
+        * Retrieve the samples of a MOTION_XYZ32F_BATCH frame
+        * \param[in] f - frame made by the block, or by a motion sensor streaming the MOTION_XYZ32F_BATCH format
+        */
+        static batch get_batch(const frame& f)
+        {
+            auto header = reinterpret_cast<const rs2_motion_batch_header*>(f.get_data());
+            auto timestamps = reinterpret_cast<const double*>(header + 1);
+            auto x = reinterpret_cast<const float*>(timestamps + header->count);
+            return { header->count, timestamps, x, x + header->count, x + 2 * header->count };
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_motion_batcher(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
 }
 #endif // LIBREALSENSE_RS2_PROCESSING_HPP
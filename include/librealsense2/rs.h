@@ -93,6 +93,35 @@ void rs2_reset_logger( rs2_error ** error);
 */
 void rs2_enable_rolling_log_file( unsigned max_size, rs2_error ** error );
 
+/**
+* Enable or disable frame tracing: every frame records when it entered and left each stage of the library
+* (backend to sensor output, each processing block, frame queues), and the records are aggregated when
+* the frames are released
+* \param[in] enable    non-zero to trace frames
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_enable_frame_trace(int enable, rs2_error** error);
+
+/**
+* Clear the statistics and records collected by frame tracing
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_reset_frame_trace(rs2_error** error);
+
+/**
+* Write the stages of the latest traced frames as Chrome trace events (JSON), to open in chrome://tracing or Perfetto
+* \param[in] file_path path of the file to write
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_export_frame_trace(const char* file_path, rs2_error** error);
+
+/**
+* Write the count, mean, maximum and histogram of the time spent in each traced stage, and end to end (JSON)
+* \param[in] file_path path of the file to write
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_export_frame_trace_histograms(const char* file_path, rs2_error** error);
+
 
 unsigned rs2_get_log_message_line_number( rs2_log_message const * msg, rs2_error** error );
 const char * rs2_get_log_message_filename( rs2_log_message const * msg, rs2_error** error );
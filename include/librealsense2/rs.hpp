@@ -50,6 +50,37 @@ namespace rs2
         rs2_enable_rolling_log_file( max_size, &e );
         error::handle( e );
     }
+
+    // Trace the time frames spend in each stage of the library, see rs2_enable_frame_trace
+    inline void enable_frame_trace(bool enable = true)
+    {
+        rs2_error* e = nullptr;
+        rs2_enable_frame_trace(enable, &e);
+        error::handle(e);
+    }
+
+    inline void reset_frame_trace()
+    {
+        rs2_error* e = nullptr;
+        rs2_reset_frame_trace(&e);
+        error::handle(e);
+    }
+
+    // Write the latest traced frames as Chrome trace events
+    inline void export_frame_trace(const std::string& file_path)
+    {
+        rs2_error* e = nullptr;
+        rs2_export_frame_trace(file_path.c_str(), &e);
+        error::handle(e);
+    }
+
+    // Write the time spent in each traced stage as histograms
+    inline void export_frame_trace_histograms(const std::string& file_path)
+    {
+        rs2_error* e = nullptr;
+        rs2_export_frame_trace_histograms(file_path.c_str(), &e);
+        error::handle(e);
+    }
     
     /*
         Interface to the log message data we expose.
@@ -3,6 +3,8 @@
 #include "metadata-parser.h"
 #include "archive.h"
 #include <fstream>
+#include <array>
+#include <cstring>
 #include "core/processing.h"
 #include "core/video.h"
 #include "frame-archive.h"
@@ -30,20 +32,9 @@ namespace librealsense
         return xyz;
     }
 
-    std::tuple<uint8_t, uint8_t, uint8_t> get_texcolor(const frame_holder& texture, float u, float v)
-    {
-        auto ptr = dynamic_cast<video_frame*>(texture.frame);
-        if (ptr == nullptr) {
-            throw librealsense::invalid_value_exception("frame must be video frame");
-        }
-        const int w = ptr->get_width(), h = ptr->get_height();
-        int x = std::min(std::max(int(u*w + .5f), 0), w - 1);
-        int y = std::min(std::max(int(v*h + .5f), 0), h - 1);
-        int idx = x * ptr->get_bpp() / 8 + y * ptr->get_stride();
-        const auto texture_data = reinterpret_cast<const uint8_t*>(ptr->get_frame_data());
-        return std::make_tuple(texture_data[idx], texture_data[idx + 1], texture_data[idx + 2]);
-    }
-
+    // Vertices and faces are formatted into chunks of this many elements, so the file is streamed out
+    // through a handful of large writes without holding the whole binary body in memory
+    const size_t ply_chunk_elements = 64 * 1024;
 
     void points::export_to_ply(const std::string& fname, const frame_holder& texture)
     {
@@ -51,55 +42,67 @@ namespace librealsense
         auto video_stream_profile = dynamic_cast<video_stream_profile_interface*>(stream_profile);
         if (!video_stream_profile)
             throw librealsense::invalid_value_exception("stream must be video stream");
+
+        video_frame* tex = nullptr;
+        if (texture)
+        {
+            tex = dynamic_cast<video_frame*>(texture.frame);
+            if (tex == nullptr)
+                throw librealsense::invalid_value_exception("frame must be video frame");
+        }
+
         const auto vertices = get_vertices();
         const auto texcoords = get_texture_coordinates();
-        std::vector<float3> new_vertices;
-        std::vector<std::tuple<uint8_t, uint8_t, uint8_t>> new_tex;
-        std::map<int, int> index2reducedIndex;
-
-        new_vertices.reserve(get_vertex_count());
-        new_tex.reserve(get_vertex_count());
-        assert(get_vertex_count());
-        for (int i = 0; i < get_vertex_count(); ++i)
+        const int vertex_count = int(get_vertex_count());
+        assert(vertex_count);
+
+        // Dense pixel -> exported vertex index, -1 for pixels that have no point
+        std::vector<int> index2reducedIndex(vertex_count);
+        int new_vertex_count = 0;
+        for (int i = 0; i < vertex_count; ++i)
+        {
             if (fabs(vertices[i].x) >= MIN_DISTANCE || fabs(vertices[i].y) >= MIN_DISTANCE ||
                 fabs(vertices[i].z) >= MIN_DISTANCE)
-            {
-                index2reducedIndex[i] = (int)new_vertices.size();
-                new_vertices.push_back({ vertices[i].x,  -1*vertices[i].y, -1*vertices[i].z });
-                if (texture)
-                {
-                    auto color = get_texcolor(texture, texcoords[i].x, texcoords[i].y);
-                    new_tex.push_back(color);
-                }
-            }
+                index2reducedIndex[i] = new_vertex_count++;
+            else
+                index2reducedIndex[i] = -1;
+        }
 
+        // Faces are emitted column by column; each column is scanned independently and the
+        // per-column results are joined in order, keeping the file identical to a serial scan
         const auto threshold = 0.05f;
-        auto width = video_stream_profile->get_width();
-        std::vector<std::tuple<int, int, int>> faces;
-        for( uint32_t x = 0; x < width - 1; ++x )
+        const int width = int(video_stream_profile->get_width());
+        const int height = int(video_stream_profile->get_height());
+        std::vector<std::vector<std::array<int, 3>>> column_faces(std::max(width - 1, 0));
+#pragma omp parallel for
+        for (int x = 0; x < width - 1; ++x)
         {
-            for( uint32_t y = 0; y < video_stream_profile->get_height() - 1; ++y )
+            auto& faces = column_faces[x];
+            for (int y = 0; y < height - 1; ++y)
             {
                 auto a = y * width + x, b = y * width + x + 1, c = (y + 1)*width + x, d = (y + 1)*width + x + 1;
                 if (vertices[a].z && vertices[b].z && vertices[c].z && vertices[d].z
                     && abs(vertices[a].z - vertices[b].z) < threshold && abs(vertices[a].z - vertices[c].z) < threshold
                     && abs(vertices[b].z - vertices[d].z) < threshold && abs(vertices[c].z - vertices[d].z) < threshold)
                 {
-                    if (index2reducedIndex.count(a) == 0 || index2reducedIndex.count(b) == 0 || index2reducedIndex.count(c) == 0 ||
-                        index2reducedIndex.count(d) == 0)
+                    if (index2reducedIndex[a] < 0 || index2reducedIndex[b] < 0 || index2reducedIndex[c] < 0 ||
+                        index2reducedIndex[d] < 0)
                         continue;
 
-                    faces.emplace_back(index2reducedIndex[a], index2reducedIndex[d], index2reducedIndex[b]);
-                    faces.emplace_back(index2reducedIndex[d], index2reducedIndex[a], index2reducedIndex[c]);
+                    faces.push_back({ index2reducedIndex[a], index2reducedIndex[d], index2reducedIndex[b] });
+                    faces.push_back({ index2reducedIndex[d], index2reducedIndex[a], index2reducedIndex[c] });
                 }
             }
         }
+        size_t face_count = 0;
+        for (auto&& faces : column_faces)
+            face_count += faces.size();
 
         std::ofstream out(fname);
         out << "ply\n";
         out << "format binary_little_endian 1.0\n";
         out << "comment pointcloud saved from Realsense Viewer\n";
-        out << "element vertex " << new_vertices.size() << "\n";
+        out << "element vertex " << new_vertex_count << "\n";
         out << "property float" << sizeof(float) * 8 << " x\n";
         out << "property float" << sizeof(float) * 8 << " y\n";
         out << "property float" << sizeof(float) * 8 << " z\n";
@@ -109,36 +112,72 @@ namespace librealsense
             out << "property uchar green\n";
             out << "property uchar blue\n";
         }
-        out << "element face " << faces.size() << "\n";
+        out << "element face " << face_count << "\n";
         out << "property list uchar int vertex_indices\n";
         out << "end_header\n";
         out.close();
 
         out.open(fname, std::ios_base::app | std::ios_base::binary);
-        for (int i = 0; i < new_vertices.size(); ++i)
+
+        // we assume little endian architecture on your device
+        const size_t vertex_stride = 3 * sizeof(float) + (texture ? 3 : 0);
+        std::vector<int> reduced2index(new_vertex_count);
+        for (int i = 0; i < vertex_count; ++i)
+            if (index2reducedIndex[i] >= 0)
+                reduced2index[index2reducedIndex[i]] = i;
+
+        int tex_width = 0, tex_height = 0, tex_bpp = 0, tex_stride = 0;
+        const uint8_t* texture_data = nullptr;
+        if (tex)
         {
-            // we assume little endian architecture on your device
-            out.write(reinterpret_cast<const char*>(&(new_vertices[i].x)), sizeof(float));
-            out.write(reinterpret_cast<const char*>(&(new_vertices[i].y)), sizeof(float));
-            out.write(reinterpret_cast<const char*>(&(new_vertices[i].z)), sizeof(float));
+            tex_width = tex->get_width();
+            tex_height = tex->get_height();
+            tex_bpp = tex->get_bpp() / 8;
+            tex_stride = tex->get_stride();
+            texture_data = reinterpret_cast<const uint8_t*>(tex->get_frame_data());
+        }
 
-            if (texture)
+        std::vector<char> chunk;
+        for (int first = 0; first < new_vertex_count; first += int(ply_chunk_elements))
+        {
+            const int count = std::min(int(ply_chunk_elements), new_vertex_count - first);
+            chunk.resize(count * vertex_stride);
+#pragma omp parallel for
+            for (int j = 0; j < count; ++j)
             {
-                uint8_t x, y, z;
-                std::tie(x, y, z) = new_tex[i];
-                out.write(reinterpret_cast<const char*>(&x), sizeof(uint8_t));
-                out.write(reinterpret_cast<const char*>(&y), sizeof(uint8_t));
-                out.write(reinterpret_cast<const char*>(&z), sizeof(uint8_t));
+                auto i = reduced2index[first + j];
+                auto dst = chunk.data() + j * vertex_stride;
+                const float xyz[] = { vertices[i].x, -1 * vertices[i].y, -1 * vertices[i].z };
+                memcpy(dst, xyz, sizeof(xyz));
+                if (texture_data)
+                {
+                    int x = std::min(std::max(int(texcoords[i].x * tex_width + .5f), 0), tex_width - 1);
+                    int y = std::min(std::max(int(texcoords[i].y * tex_height + .5f), 0), tex_height - 1);
+                    memcpy(dst + sizeof(xyz), texture_data + x * tex_bpp + y * tex_stride, 3);
+                }
             }
+            out.write(chunk.data(), chunk.size());
         }
-        auto size = faces.size();
-        for (int i = 0; i < size; ++i) {
-            int three = 3;
-            out.write(reinterpret_cast<const char*>(&three), sizeof(uint8_t));
-            out.write(reinterpret_cast<const char*>(&(std::get<0>(faces[i]))), sizeof(int));
-            out.write(reinterpret_cast<const char*>(&(std::get<1>(faces[i]))), sizeof(int));
-            out.write(reinterpret_cast<const char*>(&(std::get<2>(faces[i]))), sizeof(int));
+
+        const size_t face_stride = sizeof(uint8_t) + 3 * sizeof(int);
+        chunk.clear();
+        chunk.reserve(ply_chunk_elements * face_stride);
+        for (auto&& faces : column_faces)
+        {
+            for (auto&& f : faces)
+            {
+                auto pos = chunk.size();
+                chunk.resize(pos + face_stride);
+                chunk[pos] = 3;
+                memcpy(chunk.data() + pos + 1, f.data(), 3 * sizeof(int));
+                if (chunk.size() >= ply_chunk_elements * face_stride)
+                {
+                    out.write(chunk.data(), chunk.size());
+                    chunk.clear();
+                }
+            }
         }
+        out.write(chunk.data(), chunk.size());
     }
 
     size_t points::get_vertex_count() const
@@ -192,6 +231,8 @@ namespace librealsense
     {
         if (ref_count.fetch_sub(1) == 1)
         {
+            if (additional_data.trace.count && frame_tracer::is_enabled())
+                frame_tracer::get_instance().complete(this, additional_data.trace);
             unpublish();
             on_release();
             owner->unpublish_frame(this);
@@ -213,12 +254,42 @@ namespace librealsense
         return owner->publish_frame(this);
     }
 
+    bool frame::decode_frame_metadata(rs2_frame_metadata_value frame_metadata) const
+    {
+        const uint64_t bit = uint64_t(1) << frame_metadata;
+        if (_md_decoded.load(std::memory_order_acquire) & bit)
+            return (_md_supported.load(std::memory_order_acquire) & bit) != 0;
+
+        // No lock is held while parsing: some parsers query other attributes of this frame (actual fps reads
+        // the exposure). Two threads decoding the same attribute concurrently store the same value.
+        auto parsers = metadata_parsers->equal_range(frame_metadata);
+        for (auto it = parsers.first; it != parsers.second; ++it)
+        {
+            if (!it->second->supports(*this))
+                continue;
+            try
+            {
+                _md_values[frame_metadata].store(it->second->get(*this), std::memory_order_relaxed);
+                _md_supported.fetch_or(bit, std::memory_order_release);
+                break;
+            }
+            catch (invalid_value_exception&) {}
+        }
+        _md_decoded.fetch_or(bit, std::memory_order_release);
+
+        return (_md_supported.load(std::memory_order_acquire) & bit) != 0;
+    }
+
     rs2_metadata_type frame::get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const
     {
         if (!metadata_parsers)
             throw invalid_value_exception(to_string() << "metadata not available for "
                 << get_string(get_stream()->get_stream_type()) << " stream");
 
+        if (frame_metadata < ::RS2_FRAME_METADATA_COUNT && decode_frame_metadata(frame_metadata))
+            return _md_values[frame_metadata].load(std::memory_order_relaxed);
+
+        // Internal or unsupported attribute: go through the parsers to report why (or return what a lenient parser yields)
         auto parsers = metadata_parsers->equal_range(frame_metadata);
         if (parsers.first == metadata_parsers->end())          // Possible user error - md attribute is not supported by this frame type
             throw invalid_value_exception(to_string() << get_string(frame_metadata)
@@ -253,19 +324,33 @@ namespace librealsense
         if (!metadata_parsers)
             return false;                         // No parsers are available or no metadata was attached
 
-        bool ret = false;
-        auto found = metadata_parsers->equal_range(frame_metadata);
-        if (found.first == metadata_parsers->end())
-            return false;
+        if (frame_metadata < ::RS2_FRAME_METADATA_COUNT)
+            return decode_frame_metadata(frame_metadata);
 
+        auto found = metadata_parsers->equal_range(frame_metadata);
         for (auto it = found.first; it != found.second; ++it)
             if (it->second->supports(*this))
+                return true;
+
+        return false;
+    }
+
+    unsigned long long frame::get_frame_metadata_all(rs2_metadata_type* values, size_t count) const
+    {
+        if (!metadata_parsers)
+            return 0;
+
+        unsigned long long supported = 0;
+        for (size_t i = 0; i < std::min<size_t>(count, ::RS2_FRAME_METADATA_COUNT); ++i)
+        {
+            auto frame_metadata = rs2_frame_metadata_value(i);
+            if (decode_frame_metadata(frame_metadata))
             {
-                ret = true;
-                break;
+                values[i] = _md_values[i].load(std::memory_order_relaxed);
+                supported |= 1ull << i;
             }
-
-        return ret;
+        }
+        return supported;
     }
 
     int frame::get_frame_data_size() const
@@ -5,6 +5,7 @@
 
 #include "types.h"
 #include "core/streaming.h"
+#include "frame-trace.h"
 #include <atomic>
 #include <array>
 #include <math.h>
@@ -45,6 +46,7 @@ namespace librealsense
         uint32_t            raw_size = 0;   // The frame transmitted size (payload only)
         
         std::array<uint8_t, 1016> al3d_ai_results; //al3d ai results
+        frame_trace         trace;  // stages the frame went through, when frame tracing is enabled
 
         frame_additional_data() {}
 
@@ -127,12 +129,15 @@ namespace librealsense
             r.owner.reset();
             if (owner) metadata_parsers = owner->get_md_parsers();
             if (r.metadata_parsers) metadata_parsers = std::move(r.metadata_parsers);
+            _md_decoded = 0;
+            _md_supported = 0;
             return *this;
         }
 
         virtual ~frame() { on_release.reset(); }
         rs2_metadata_type get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
         bool supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
+        unsigned long long get_frame_metadata_all(rs2_metadata_type* values, size_t count) const override;
         int get_frame_data_size() const override;
         const byte* get_frame_data() const override;
         //for al3d ai
@@ -187,6 +192,14 @@ namespace librealsense
         bool _fixed = false;
         std::atomic_bool _kept;
         std::shared_ptr<stream_profile_interface> stream;
+
+        // Public metadata attributes are decoded once per frame, on their first query. The bit of an attribute is set
+        // in _md_decoded once it was decoded and in _md_supported when its value is held in _md_values.
+        bool decode_frame_metadata(rs2_frame_metadata_value frame_metadata) const;
+        static_assert(::RS2_FRAME_METADATA_COUNT <= 64, "metadata attributes must fit the decoded/supported bitmasks");
+        mutable std::array<std::atomic<rs2_metadata_type>, ::RS2_FRAME_METADATA_COUNT> _md_values;
+        mutable std::atomic<uint64_t> _md_decoded{ 0 };
+        mutable std::atomic<uint64_t> _md_supported{ 0 };
     };
 
     class points : public frame
@@ -241,6 +254,10 @@ namespace librealsense
         {
             return first()->supports_frame_metadata(frame_metadata);
         }
+        unsigned long long get_frame_metadata_all(rs2_metadata_type* values, size_t count) const override
+        {
+            return first()->get_frame_metadata_all(values, count);
+        }
         int get_frame_data_size() const override
         {
             return first()->get_frame_data_size();
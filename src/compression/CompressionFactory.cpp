@@ -2,9 +2,10 @@
 // Copyright(c) 2020 Intel Corporation. All Rights Reserved.
 
 #include "CompressionFactory.h"
-#include "JpegCompression.h"
 #include "Lz4Compression.h"
+#include "ParallelJpegCompression.h"
 #include "RvlCompression.h"
+#include "TemporalCompression.h"
 
 std::shared_ptr<ICompression> CompressionFactory::getObject(int t_width, int t_height, rs2_format t_format, rs2_stream t_streamType, int t_bpp)
 {
@@ -15,7 +16,7 @@ std::shared_ptr<ICompression> CompressionFactory::getObject(int t_width, int t_h
     }
     else if(t_streamType == RS2_STREAM_DEPTH)
     {
-        zipMeth = ZipMethod::lz;
+        zipMeth = t_format == RS2_FORMAT_Z16 ? getDepthMethod() : ZipMethod::lz;
     }
     if(!isCompressionSupported(t_format, t_streamType))
     {
@@ -28,11 +29,14 @@ std::shared_ptr<ICompression> CompressionFactory::getObject(int t_width, int t_h
         return std::make_shared<RvlCompression>(t_width, t_height, t_format, t_bpp);
         break;
     case ZipMethod::jpeg:
-        return std::make_shared<JpegCompression>(t_width, t_height, t_format, t_bpp);
+        return std::make_shared<ParallelJpegCompression>(t_width, t_height, t_format, t_bpp, getJpegQuality(), getJpegThreads());
         break;
     case ZipMethod::lz:
         return std::make_shared<Lz4Compression>(t_width, t_height, t_format, t_bpp);
         break;
+    case ZipMethod::temporal:
+        return std::make_shared<TemporalCompression>(t_width, t_height, t_format, t_bpp, getKeyframeInterval(), getDepthTolerance());
+        break;
     default:
         ERR << "unknown zip method";
         return nullptr;
@@ -45,6 +49,36 @@ bool& CompressionFactory::getIsEnabled()
     return m_isEnabled;
 }
 
+ZipMethod& CompressionFactory::getDepthMethod()
+{
+    static ZipMethod m_depthMethod = ZipMethod::lz;
+    return m_depthMethod;
+}
+
+int& CompressionFactory::getKeyframeInterval()
+{
+    static int m_keyframeInterval = 30;
+    return m_keyframeInterval;
+}
+
+int& CompressionFactory::getDepthTolerance()
+{
+    static int m_depthTolerance = 0;
+    return m_depthTolerance;
+}
+
+int& CompressionFactory::getJpegQuality()
+{
+    static int m_jpegQuality = 75;
+    return m_jpegQuality;
+}
+
+int& CompressionFactory::getJpegThreads()
+{
+    static int m_jpegThreads = 0;
+    return m_jpegThreads;
+}
+
 bool CompressionFactory::isCompressionSupported(rs2_format t_format, rs2_stream t_streamType)
 {
     if(getIsEnabled() == 0)
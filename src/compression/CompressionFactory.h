@@ -12,6 +12,7 @@ typedef enum ZipMethod
     rvl,
     jpeg,
     lz,
+    temporal,
 } ZipMethod;
 
 class CompressionFactory
@@ -20,4 +21,14 @@ public:
     static std::shared_ptr<ICompression> getObject(int t_width, int t_height, rs2_format t_format, rs2_stream t_streamType, int t_bpp);
     static bool isCompressionSupported(rs2_format t_format, rs2_stream t_streamType);
     static bool& getIsEnabled();
+    // Method of Z16 depth streams: lz, or temporal to code frames against the previous one
+    static ZipMethod& getDepthMethod();
+    // Frames between the keyframes of temporal compression, 0 for keyframes on request only
+    static int& getKeyframeInterval();
+    // Depth changes of up to this many units that temporal compression leaves out
+    static int& getDepthTolerance();
+    // Quality of JPEG compression of color and infrared streams, from 1 to 100
+    static int& getJpegQuality();
+    // Threads that compress slices of each JPEG frame, 0 for one per core
+    static int& getJpegThreads();
 };
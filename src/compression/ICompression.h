@@ -15,6 +15,16 @@ public:
     virtual int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf) = 0;
     virtual int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf) = 0;
 
+    // Codecs that predict frames from the previous ones: makes the encoder code its next frame on its own.
+    // May be called from any thread.
+    virtual void requestKeyframe() {}
+    // Codecs that predict frames from the previous ones: whether the decoder lost the frame it predicts from,
+    // and the encoder should be asked for a keyframe. Answers true once per request to make.
+    virtual bool needsKeyframe()
+    {
+        return false;
+    }
+
 protected:
     int m_width, m_height, m_bpp;
     rs2_format m_format;
@@ -0,0 +1,346 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "ParallelJpegCompression.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// Room for the markers and tables in front of the entropy coded data of a slice
+#define JPEG_HEADERS_SIZE 1024
+
+// Finds where the entropy coded data of a JPEG starts, past its SOS segment, and where the height of its frame is
+static bool findScan(const unsigned char* t_jpeg, unsigned long t_size, size_t& t_scan, size_t& t_height)
+{
+    size_t at = 2; // SOI
+    t_height = 0;
+    while(at + 4 <= t_size && t_jpeg[at] == 0xFF)
+    {
+        unsigned char marker = t_jpeg[at + 1];
+        size_t length = (t_jpeg[at + 2] << 8) | t_jpeg[at + 3];
+        if(marker >= 0xC0 && marker <= 0xC2)
+        {
+            t_height = at + 5; // Past the length and the sample precision
+        }
+        at += 2 + length;
+        if(marker == 0xDA)
+        {
+            t_scan = at;
+            return t_height != 0 && at + 2 <= t_size;
+        }
+    }
+    return false;
+}
+
+ParallelJpegCompression::ParallelJpegCompression(int t_width, int t_height, rs2_format t_format, int t_bpp, int t_quality, int t_threads)
+    : JpegCompression(t_width, t_height, t_format, t_bpp)
+    , m_quality(t_quality)
+    , m_raw(t_format == RS2_FORMAT_YUYV || t_format == RS2_FORMAT_UYVY)
+    , m_frame(nullptr)
+    , m_generation(0)
+    , m_pending(0)
+    , m_stop(false)
+{
+    J_COLOR_SPACE colorSpace;
+    int components;
+    if(m_raw)
+    {
+        colorSpace = JCS_YCbCr;
+        components = 3;
+    }
+    else if(m_format == RS2_FORMAT_Y8)
+    {
+        colorSpace = JCS_GRAYSCALE;
+        components = 1;
+    }
+    else if(m_format == RS2_FORMAT_RGB8)
+    {
+        colorSpace = JCS_RGB;
+        components = 3;
+    }
+    else if(m_format == RS2_FORMAT_BGR8)
+    {
+        colorSpace = JCS_EXT_BGR;
+        components = 3;
+    }
+    else
+    {
+        ERR << "unsupported format " << t_format << " for JPEG compression";
+        return;
+    }
+
+    int threads = t_threads > 0 ? t_threads : (int)std::thread::hardware_concurrency();
+    // libjpeg subsamples RGB to 4:2:0, in MCUs of 16 rows; MCUs of 4:2:2 and grayscale are 8 rows high
+    int mcuHeight = (m_format == RS2_FORMAT_RGB8 || m_format == RS2_FORMAT_BGR8) ? 2 * DCTSIZE : DCTSIZE;
+    int mcuRows = (m_height + mcuHeight - 1) / mcuHeight;
+    int slices = std::max(1, std::min(threads, mcuRows));
+    int mcus = (m_width + 2 * DCTSIZE - 1) / (2 * DCTSIZE);
+    m_planeWidth[0] = mcus * 2 * DCTSIZE;
+    m_planeWidth[1] = m_planeWidth[2] = mcus * DCTSIZE;
+
+    m_slices.resize(slices);
+    int mcuRow = 0;
+    for(int i = 0; i < slices; i++)
+    {
+        Slice& slice = m_slices[i];
+        int sliceMcuRows = mcuRows / slices + (i < mcuRows % slices ? 1 : 0);
+        slice.firstMcuRow = mcuRow;
+        slice.firstRow = mcuRow * mcuHeight;
+        slice.rows = std::min(sliceMcuRows * mcuHeight, m_height - slice.firstRow);
+        mcuRow += sliceMcuRows;
+        slice.data = nullptr;
+        slice.capacity = 0;
+        slice.size = 0;
+        slice.scan = 0;
+        slice.height = 0;
+        slice.compressed = false;
+
+        struct jpeg_compress_struct& cinfo = slice.cinfo;
+        cinfo.err = jpeg_std_error(&slice.jerr);
+        jpeg_create_compress(&cinfo);
+        cinfo.image_width = m_width;
+        cinfo.image_height = slice.rows;
+        cinfo.in_color_space = colorSpace;
+        cinfo.input_components = components;
+        jpeg_set_defaults(&cinfo);
+        jpeg_set_quality(&cinfo, m_quality, TRUE);
+        // The slices are joined where a restart marker would be
+        cinfo.restart_in_rows = 1;
+        if(m_raw)
+        {
+            cinfo.raw_data_in = TRUE;
+            cinfo.comp_info[0].h_samp_factor = 2;
+            cinfo.comp_info[0].v_samp_factor = 1;
+            for(int c = 1; c < 3; c++)
+            {
+                cinfo.comp_info[c].h_samp_factor = 1;
+                cinfo.comp_info[c].v_samp_factor = 1;
+            }
+            slice.planes.resize((m_planeWidth[0] + m_planeWidth[1] + m_planeWidth[2]) * DCTSIZE);
+            slice.rowPointers.resize(3 * DCTSIZE);
+            unsigned char* row = slice.planes.data();
+            for(int c = 0; c < 3; c++)
+            {
+                for(int r = 0; r < DCTSIZE; r++)
+                {
+                    slice.rowPointers[c * DCTSIZE + r] = row;
+                    row += m_planeWidth[c];
+                }
+            }
+        }
+        else
+        {
+            slice.rowPointers.resize(slice.rows);
+        }
+    }
+}
+
+ParallelJpegCompression::~ParallelJpegCompression()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for(auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    for(auto& slice : m_slices)
+    {
+        jpeg_destroy_compress(&slice.cinfo);
+        free(slice.data);
+    }
+}
+
+void ParallelJpegCompression::writeRawRows(Slice& t_slice, int t_row, JSAMPARRAY* t_planes)
+{
+    int y0 = 0, u = 1, y1 = 2, v = 3;
+    if(m_format == RS2_FORMAT_UYVY)
+    {
+        y0 = 1, u = 0, y1 = 3, v = 2;
+    }
+    int pairs = m_width / 2;
+    size_t stride = (size_t)m_width * m_bpp;
+    for(int r = 0; r < DCTSIZE; r++)
+    {
+        // Rows past the bottom of the frame repeat its last row, as libjpeg does not pad raw data
+        const unsigned char* src = m_frame + (t_slice.firstRow + std::min(t_row + r, t_slice.rows - 1)) * stride;
+        JSAMPROW y = t_planes[0][r], cb = t_planes[1][r], cr = t_planes[2][r];
+        for(int x = 0; x < pairs; x++, src += 4)
+        {
+            y[2 * x] = src[y0];
+            y[2 * x + 1] = src[y1];
+            cb[x] = src[u];
+            cr[x] = src[v];
+        }
+        memset(y + m_width, y[m_width - 1], m_planeWidth[0] - m_width);
+        memset(cb + pairs, cb[pairs - 1], m_planeWidth[1] - pairs);
+        memset(cr + pairs, cr[pairs - 1], m_planeWidth[2] - pairs);
+    }
+}
+
+void ParallelJpegCompression::compressSlice(Slice& t_slice)
+{
+    struct jpeg_compress_struct& cinfo = t_slice.cinfo;
+    unsigned char* data = t_slice.data;
+    unsigned long size = t_slice.capacity;
+    jpeg_mem_dest(&cinfo, &data, &size);
+    jpeg_start_compress(&cinfo, TRUE);
+    if(m_raw)
+    {
+        JSAMPARRAY planes[3] = {&t_slice.rowPointers[0], &t_slice.rowPointers[DCTSIZE], &t_slice.rowPointers[2 * DCTSIZE]};
+        while(cinfo.next_scanline < cinfo.image_height)
+        {
+            writeRawRows(t_slice, cinfo.next_scanline, planes);
+            jpeg_write_raw_data(&cinfo, planes, DCTSIZE);
+        }
+    }
+    else
+    {
+        size_t stride = (size_t)m_width * m_bpp;
+        for(int r = 0; r < t_slice.rows; r++)
+        {
+            t_slice.rowPointers[r] = (JSAMPROW)(m_frame + (t_slice.firstRow + r) * stride);
+        }
+        while(cinfo.next_scanline < cinfo.image_height)
+        {
+            jpeg_write_scanlines(&cinfo, &t_slice.rowPointers[cinfo.next_scanline], cinfo.image_height - cinfo.next_scanline);
+        }
+    }
+    jpeg_finish_compress(&cinfo);
+    if(data != t_slice.data)
+    {
+        // libjpeg moved to a larger buffer of its own
+        free(t_slice.data);
+        t_slice.data = data;
+        t_slice.capacity = size;
+    }
+    t_slice.size = size;
+
+    t_slice.compressed = findScan(data, size, t_slice.scan, t_slice.height) && data[size - 2] == 0xFF && data[size - 1] == 0xD9;
+    if(t_slice.compressed && t_slice.firstMcuRow % 8 != 0)
+    {
+        // Restart markers are numbered on from the MCU rows of the slices above. 0xFF is followed by 0 in entropy
+        // coded data, so RSTn are the only 0xFFD0-0xFFD7 there.
+        unsigned restart = t_slice.firstMcuRow;
+        for(size_t i = t_slice.scan; i + 3 < size; i++)
+        {
+            if(data[i] == 0xFF && data[i + 1] >= 0xD0 && data[i + 1] <= 0xD7)
+            {
+                data[++i] = 0xD0 + restart++ % 8;
+            }
+        }
+    }
+}
+
+void ParallelJpegCompression::work(size_t t_slice)
+{
+    unsigned generation = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+            if(m_stop)
+            {
+                return;
+            }
+            generation = m_generation;
+        }
+        compressSlice(m_slices[t_slice]);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending--;
+        }
+        m_done.notify_one();
+    }
+}
+
+int ParallelJpegCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf)
+{
+    if(m_slices.empty())
+    {
+        ERR << "unsupported format " << m_format << " for JPEG compression";
+        return -1;
+    }
+    if(t_size < m_width * m_height * m_bpp)
+    {
+        ERR << "Unexpected frame size " << t_size;
+        return -1;
+    }
+    // Set up on the first frame, as the objects of the clients only decompress
+    if(m_slices[0].data == nullptr)
+    {
+        for(auto& slice : m_slices)
+        {
+            slice.capacity = (unsigned long)m_width * slice.rows * m_bpp + JPEG_HEADERS_SIZE;
+            slice.data = (unsigned char*)malloc(slice.capacity);
+        }
+        for(size_t i = 1; i < m_slices.size(); i++)
+        {
+            m_workers.emplace_back(&ParallelJpegCompression::work, this, i);
+        }
+    }
+
+    m_frame = t_buffer;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = m_slices.size() - 1;
+        m_generation++;
+    }
+    m_start.notify_all();
+    compressSlice(m_slices[0]);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_pending == 0; });
+    }
+
+    // The headers of the first slice, the entropy coded data of each slice between restart markers, and EOI
+    size_t compressedSize = m_slices[0].scan + 2;
+    for(size_t i = 0; i < m_slices.size(); i++)
+    {
+        const Slice& slice = m_slices[i];
+        if(!slice.compressed)
+        {
+            ERR << "Failure trying to compress the frame.";
+            return -1;
+        }
+        compressedSize += slice.size - slice.scan - 2 + (i > 0 ? 2 : 0);
+    }
+    if(compressedSize + sizeof(int) > (size_t)t_size)
+    {
+        ERR << "compression overflow, destination buffer is smaller than the compressed size";
+        return -1;
+    }
+
+    unsigned char* out = t_compressedBuf + sizeof(int);
+    const Slice& first = m_slices[0];
+    memcpy(out, first.data, first.scan);
+    // The first slice is coded as a frame of its own height
+    out[first.height] = (unsigned char)(m_height >> 8);
+    out[first.height + 1] = (unsigned char)m_height;
+    out += first.scan;
+    for(size_t i = 0; i < m_slices.size(); i++)
+    {
+        const Slice& slice = m_slices[i];
+        if(i > 0)
+        {
+            *out++ = 0xFF;
+            *out++ = 0xD0 + (slice.firstMcuRow - 1) % 8;
+        }
+        size_t entropySize = slice.size - slice.scan - 2;
+        memcpy(out, slice.data + slice.scan, entropySize);
+        out += entropySize;
+    }
+    *out++ = 0xFF;
+    *out++ = 0xD9;
+
+    int size = (int)compressedSize;
+    memcpy(t_compressedBuf, &size, sizeof(size));
+    if(m_compFrameCounter++ % 50 == 0)
+    {
+        INF << "frame " << m_compFrameCounter << "\tcolor\tcompression\tJPEG\t" << t_size << "\t/\t" << size << "\t" << m_slices.size() << " slices";
+    }
+    return size + sizeof(size);
+}
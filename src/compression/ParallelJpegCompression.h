@@ -0,0 +1,62 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "JpegCompression.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    JPEG compression of horizontal slices of the frame on several threads. Each slice is a whole number of MCU rows,
+    coded with a restart marker after each MCU row, the same tables and no state carried from the slice above; the
+    slices are then joined into one baseline JPEG of the whole frame, by renumbering their restart markers. Any
+    JPEG decoder reads it, and frames are decompressed by JpegCompression.
+    YUYV and UYVY frames are given to libjpeg as 4:2:2 planes, and RGB8, BGR8 and Y8 frames as they are, so rows are
+    not converted on the way.
+*/
+class ParallelJpegCompression : public JpegCompression
+{
+public:
+    // t_threads is the number of slices, 0 for one per core
+    ParallelJpegCompression(int t_width, int t_height, rs2_format t_format, int t_bpp, int t_quality, int t_threads);
+    ~ParallelJpegCompression();
+    int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
+
+private:
+    struct Slice
+    {
+        struct jpeg_error_mgr jerr;
+        struct jpeg_compress_struct cinfo;
+        int firstRow, rows;
+        int firstMcuRow;
+        unsigned char* data;   // Allocated with malloc(), as libjpeg replaces it when it runs out of it
+        unsigned long capacity;
+        unsigned long size;
+        size_t scan;   // Offset of the entropy coded data in data
+        size_t height; // Offset of the height of the frame in data
+        bool compressed;
+        std::vector<unsigned char> planes;
+        std::vector<JSAMPROW> rowPointers;
+    };
+
+    void compressSlice(Slice& t_slice);
+    void writeRawRows(Slice& t_slice, int t_row, JSAMPARRAY* t_planes);
+    void work(size_t t_slice);
+
+    int m_quality;
+    std::vector<Slice> m_slices;
+    bool m_raw;            // Frames are given as planes of 4:2:2 samples
+    int m_planeWidth[3];   // Width of the planes, in whole MCUs
+    const unsigned char* m_frame;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start, m_done;
+    unsigned m_generation;
+    size_t m_pending;
+    bool m_stop;
+};
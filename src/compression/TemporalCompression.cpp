@@ -0,0 +1,188 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "TemporalCompression.h"
+#include <cstring>
+#include <lz4.h>
+
+// Undecodable frames after which the decoder asks for a keyframe again, in case the request was lost
+#define TEMPORAL_RESYNC_FRAMES 30
+
+static inline uint16_t zigzag(int16_t t_delta)
+{
+    return (uint16_t)((t_delta << 1) ^ (t_delta >> 15));
+}
+
+static inline int16_t unzigzag(uint16_t t_residual)
+{
+    return (int16_t)((t_residual >> 1) ^ -(t_residual & 1));
+}
+
+TemporalCompression::TemporalCompression(int t_width, int t_height, rs2_format t_format, int t_bpp, int t_keyframeInterval, int t_tolerance)
+    : ICompression(t_width, t_height, t_format, t_bpp)
+    , m_keyframeInterval(t_keyframeInterval)
+    , m_tolerance(t_tolerance)
+    , m_pixels(t_width * t_height)
+    , m_planes(t_width * t_height * 2)
+    , m_sequence(0)
+    , m_sinceKeyframe(0)
+    , m_keyframeRequested(false)
+    , m_decodedSequence(0)
+    , m_undecodable(0)
+    , m_needsKeyframe(false)
+{
+}
+
+void TemporalCompression::requestKeyframe()
+{
+    m_keyframeRequested = true;
+}
+
+bool TemporalCompression::needsKeyframe()
+{
+    bool needed = m_needsKeyframe;
+    m_needsKeyframe = false;
+    return needed;
+}
+
+int TemporalCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf)
+{
+    if(t_size != m_pixels * (int)sizeof(uint16_t))
+    {
+        ERR << "Unexpected depth frame size " << t_size;
+        return -1;
+    }
+    if(m_reference.empty())
+    {
+        m_reference.resize(m_pixels);
+        m_reconstructed.resize(m_pixels);
+    }
+
+    bool requested = m_keyframeRequested.exchange(false);
+    bool keyframe = m_sequence == 0 || requested || (m_keyframeInterval > 0 && m_sinceKeyframe >= m_keyframeInterval);
+    const uint16_t* frame = (const uint16_t*)t_buffer;
+    uint16_t* reconstructed = m_reconstructed.data();
+    uint8_t* low = m_planes.data();
+    uint8_t* high = low + m_pixels;
+    if(keyframe)
+    {
+        uint16_t previous = 0;
+        for(int i = 0; i < m_pixels; i++)
+        {
+            uint16_t residual = zigzag((int16_t)(frame[i] - previous));
+            low[i] = (uint8_t)residual;
+            high[i] = (uint8_t)(residual >> 8);
+            previous = frame[i];
+        }
+        memcpy(reconstructed, frame, t_size);
+    }
+    else
+    {
+        const uint16_t* reference = m_reference.data();
+        int tolerance = m_tolerance;
+        for(int i = 0; i < m_pixels; i++)
+        {
+            uint16_t current = frame[i], previous = reference[i];
+            int delta = (int)current - previous;
+            // Holes appearing or filling are always sent
+            bool unchanged = current != 0 && previous != 0 && delta <= tolerance && -delta <= tolerance;
+            current = unchanged ? previous : current;
+            uint16_t residual = zigzag((int16_t)(current - previous));
+            low[i] = (uint8_t)residual;
+            high[i] = (uint8_t)(residual >> 8);
+            reconstructed[i] = current;
+        }
+    }
+
+    FrameHeader header;
+    header.sequence = m_sequence + 1;
+    header.reference = keyframe ? 0 : m_sequence;
+    unsigned char* compressed = t_compressedBuf + sizeof(int) + sizeof(header);
+    // Compressed frames replace the frame in its buffer, so they cannot be any larger
+    int capacity = t_size - (int)(sizeof(int) + sizeof(header));
+    int planesSize = LZ4_compress_default((const char*)m_planes.data(), (char*)compressed, (int)m_planes.size(), capacity);
+    if(planesSize <= 0)
+    {
+        // The frame is dropped: the next one is predicted from the same reference
+        ERR << "Compression overflow, destination buffer is smaller than the compressed size.";
+        if(requested)
+        {
+            m_keyframeRequested = true;
+        }
+        return -1;
+    }
+
+    m_sequence = header.sequence;
+    m_sinceKeyframe = keyframe ? 1 : m_sinceKeyframe + 1;
+    m_reference.swap(m_reconstructed);
+    int compressedSize = (int)sizeof(header) + planesSize;
+    memcpy(t_compressedBuf, &compressedSize, sizeof(compressedSize));
+    memcpy(t_compressedBuf + sizeof(int), &header, sizeof(header));
+    if(m_compFrameCounter++ % 50 == 0)
+    {
+        INF << "frame " << m_compFrameCounter << "\tdepth\tcompression\ttemporal\t" << t_size << "\t/\t" << compressedSize << (keyframe ? "\tkeyframe" : "");
+    }
+    return compressedSize + sizeof(compressedSize);
+}
+
+int TemporalCompression::decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf)
+{
+    FrameHeader header;
+    if(t_size < (int)sizeof(header))
+    {
+        ERR << "Failure trying to decompress the frame: " << t_size << " bytes";
+        return -1;
+    }
+    memcpy(&header, t_buffer, sizeof(header));
+    bool keyframe = header.reference == 0;
+    bool decoded = false;
+    if(keyframe || (m_decodedSequence != 0 && header.reference == m_decodedSequence))
+    {
+        int planesSize = LZ4_decompress_safe((const char*)t_buffer + sizeof(header), (char*)m_planes.data(), t_size - sizeof(header), (int)m_planes.size());
+        decoded = planesSize == (int)m_planes.size();
+        if(!decoded)
+        {
+            ERR << "Failure trying to decompress the frame.";
+        }
+    }
+    if(!decoded)
+    {
+        // Whatever comes next is predicted from frames this decoder does not have
+        m_decodedSequence = 0;
+        m_needsKeyframe = m_undecodable++ % TEMPORAL_RESYNC_FRAMES == 0;
+        return -1;
+    }
+
+    if(m_decoded.empty())
+    {
+        m_decoded.resize(m_pixels);
+    }
+    uint16_t* depth = m_decoded.data();
+    const uint8_t* low = m_planes.data();
+    const uint8_t* high = low + m_pixels;
+    if(keyframe)
+    {
+        uint16_t previous = 0;
+        for(int i = 0; i < m_pixels; i++)
+        {
+            previous = depth[i] = previous + unzigzag(low[i] | (high[i] << 8));
+        }
+    }
+    else
+    {
+        for(int i = 0; i < m_pixels; i++)
+        {
+            depth[i] += unzigzag(low[i] | (high[i] << 8));
+        }
+    }
+    m_decodedSequence = header.sequence;
+    m_undecodable = 0;
+
+    int uncompressedSize = m_pixels * (int)sizeof(uint16_t);
+    memcpy(t_uncompressedBuf, depth, uncompressedSize);
+    if(m_decompFrameCounter++ % 50 == 0)
+    {
+        INF << "frame " << m_decompFrameCounter << "\tdepth\tdecompression\ttemporal\t" << t_size << "\t/\t" << uncompressedSize;
+    }
+    return uncompressedSize;
+}
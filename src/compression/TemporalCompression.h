@@ -0,0 +1,54 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "ICompression.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/*
+    Z16 depth compression that codes each frame against the previous one, as the decoder reconstructs it. Changes
+    of up to the tolerance between two valid depths are left out, so the depth of a static scene codes to zeros;
+    the reconstruction never differs from the frame by more than the tolerance. Keyframes are coded on their own,
+    against the pixel on the left, every keyframe interval frames and when requested.
+    The residuals are zigzag coded, split in planes of low and high bytes and compressed with LZ4.
+
+    Frames name the sequence of the frame they are predicted from. The decoder drops the ones whose reference is
+    not the frame it decoded last, and asks for a keyframe (see needsKeyframe()) until it gets one.
+*/
+class TemporalCompression : public ICompression
+{
+public:
+    TemporalCompression(int t_width, int t_height, rs2_format t_format, int t_bpp, int t_keyframeInterval, int t_tolerance);
+    int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
+    int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
+    void requestKeyframe();
+    bool needsKeyframe();
+
+private:
+    struct FrameHeader
+    {
+        uint32_t sequence;
+        uint32_t reference; // Sequence of the frame predicted from, 0 for keyframes
+    };
+
+    int m_keyframeInterval;
+    int m_tolerance;
+    int m_pixels;
+    std::vector<uint8_t> m_planes;
+
+    // Encoder
+    std::vector<uint16_t> m_reference, m_reconstructed;
+    uint32_t m_sequence;
+    int m_sinceKeyframe;
+    std::atomic<bool> m_keyframeRequested;
+
+    // Decoder
+    std::vector<uint16_t> m_decoded;
+    uint32_t m_decodedSequence; // 0 while there is no frame to predict from
+    unsigned m_undecodable;     // Frames dropped since the decoder lost its reference
+    bool m_needsKeyframe;
+};
@@ -29,9 +29,11 @@ namespace librealsense
                                                       int new_stride = 0,
                                                       rs2_extension frame_type = RS2_EXTENSION_VIDEO_FRAME) = 0;
 
+        // new_size: size of the frame data, or 0 for the size of the original
         virtual frame_interface* allocate_motion_frame(std::shared_ptr<stream_profile_interface> stream,
                                                        frame_interface* original,
-                                                       rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME) = 0;
+                                                       rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME,
+                                                       size_t new_size = 0) = 0;
 
         virtual frame_interface* allocate_composite_frame(std::vector<frame_holder> frames) = 0;
 
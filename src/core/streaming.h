@@ -84,6 +84,8 @@ namespace librealsense
     public:
         virtual rs2_metadata_type get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const = 0;
         virtual bool supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const = 0;
+        // Writes every supported attribute below 'count' into values[attribute] and returns the mask of supported attributes
+        virtual unsigned long long get_frame_metadata_all(rs2_metadata_type* values, size_t count) const = 0;
         virtual int get_frame_data_size() const = 0;
         virtual const byte* get_frame_data() const = 0;
         //for al3d ai
@@ -0,0 +1,224 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "device-cache.h"
+#include "types.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace librealsense
+{
+    static const char* cache_file_magic = "librealsense2 device cache 2";
+
+    static std::string default_cache_directory()
+    {
+        if (auto dir = getenv("LRS_DEVICE_CACHE_DIR"))
+            return dir;
+#ifdef _WIN32
+        if (auto dir = getenv("LOCALAPPDATA"))
+            return std::string(dir) + "\\librealsense2";
+#else
+        if (auto dir = getenv("XDG_CACHE_HOME"))
+            return std::string(dir) + "/librealsense2";
+        if (auto dir = getenv("HOME"))
+            return std::string(dir) + "/.cache/librealsense2";
+#endif
+        return "";
+    }
+
+    static void make_directories(const std::string& path)
+    {
+        for (size_t pos = path.find_first_of("/\\", 1); ; pos = path.find_first_of("/\\", pos + 1))
+        {
+            auto dir = path.substr(0, pos);
+#ifdef _WIN32
+            _mkdir(dir.c_str());
+#else
+            mkdir(dir.c_str(), 0755);
+#endif
+            if (pos == std::string::npos)
+                break;
+        }
+    }
+
+    static void write_blob(std::ostream& out, const char* data, size_t size)
+    {
+        auto len = static_cast<uint32_t>(size);
+        out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        out.write(data, len);
+    }
+
+    // Fails on a length that runs past the end of the file, so a corrupt length never gets allocated
+    static bool read_blob(std::istream& in, std::string& blob, uint64_t& remaining)
+    {
+        uint32_t len = 0;
+        if (remaining < sizeof(len) || !in.read(reinterpret_cast<char*>(&len), sizeof(len)))
+            return false;
+        remaining -= sizeof(len);
+        if (len > remaining)
+            return false;
+        remaining -= len;
+        blob.resize(len);
+        return len == 0 || in.read(&blob[0], len);
+    }
+
+    static uint32_t entry_checksum(const std::string& key, const std::string& value)
+    {
+        auto entry = key + value;
+        return calc_crc32(reinterpret_cast<const uint8_t*>(entry.data()), entry.size());
+    }
+
+    device_cache::device_cache(const std::string& directory, const std::string& serial, const std::string& version)
+        : _directory(directory), _version(version)
+    {
+        // Serial numbers are printable, but keep anything unexpected out of the file name
+        std::string name;
+        for (auto c : serial)
+            name += (isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_') ? c : '_';
+        _path = directory + "/" + name + ".cache";
+
+        load();
+    }
+
+    device_cache::~device_cache()
+    {
+        flush();
+    }
+
+    std::shared_ptr<device_cache> device_cache::open(const std::string& serial, const std::string& version)
+    {
+        auto directory = default_cache_directory();
+        if (directory.empty() || serial.empty())
+            return nullptr;
+        return std::make_shared<device_cache>(directory, serial, version);
+    }
+
+    bool device_cache::get(const std::string& key, std::vector<uint8_t>& value) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(key);
+        if (it == _entries.end())
+            return false;
+        value = it->second;
+        return true;
+    }
+
+    void device_cache::put(const std::string& key, const std::vector<uint8_t>& value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(key);
+        if (it != _entries.end() && it->second == value)
+            return;
+        _entries[key] = value;
+        _dirty = true;
+    }
+
+    void device_cache::flush()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_dirty)
+            return;
+        save();
+        _dirty = false;
+    }
+
+    void device_cache::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+        _dirty = false;
+        std::remove(_path.c_str());
+    }
+
+    void device_cache::load()
+    {
+        std::ifstream in(_path, std::ios::binary | std::ios::ate);
+        if (!in)
+            return;
+        auto size = in.tellg();
+        in.seekg(0);
+
+        std::string magic, version;
+        if (!std::getline(in, magic) || magic != cache_file_magic || !std::getline(in, version))
+            return;
+        if (version != _version)
+        {
+            LOG_DEBUG("Device cache " << _path << " is of firmware " << version << ", discarding it");
+            return;
+        }
+
+        auto pos = in.tellg();
+        if (size < 0 || pos < 0)
+            return;
+        auto remaining = uint64_t(size - pos);
+        std::string key, value;
+        while (remaining)
+        {
+            uint32_t checksum = 0;
+            if (!read_blob(in, key, remaining) || !read_blob(in, value, remaining) || remaining < sizeof(checksum)
+                || !in.read(reinterpret_cast<char*>(&checksum), sizeof(checksum)) || checksum != entry_checksum(key, value))
+            {
+                LOG_WARNING("Device cache " << _path << " is corrupt, discarding it");
+                _entries.clear();
+                std::remove(_path.c_str());
+                return;
+            }
+            remaining -= sizeof(checksum);
+            _entries[key] = std::vector<uint8_t>(value.begin(), value.end());
+        }
+    }
+
+    void device_cache::save() const
+    {
+        make_directories(_directory);
+
+        // Write a sibling file and move it in place, so a concurrent reader never sees a partial file.
+        // The name is per process, so two processes saving the same cache do not write into each other's file.
+#ifdef _WIN32
+        auto pid = _getpid();
+#else
+        auto pid = getpid();
+#endif
+        auto tmp = _path + "." + std::to_string(pid) + ".tmp";
+        bool written = false;
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (out)
+            {
+                out << cache_file_magic << '\n' << _version << '\n';
+                for (auto&& e : _entries)
+                {
+                    std::string value(e.second.begin(), e.second.end());
+                    auto checksum = entry_checksum(e.first, value);
+                    write_blob(out, e.first.data(), e.first.size());
+                    write_blob(out, value.data(), value.size());
+                    out.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+                }
+                out.close();
+                written = !out.fail();
+            }
+        }
+        // The stream is closed by now, so the file can be removed on every platform
+        if (!written)
+        {
+            LOG_DEBUG("Cannot write device cache " << tmp);
+            std::remove(tmp.c_str());
+            return;
+        }
+#ifdef _WIN32
+        std::remove(_path.c_str());
+#endif
+        if (std::rename(tmp.c_str(), _path.c_str()) != 0)
+            std::remove(tmp.c_str());
+    }
+}
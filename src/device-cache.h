@@ -0,0 +1,48 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace librealsense
+{
+    // Device data that only changes with the firmware (calibration tables, option ranges), persisted
+    // between sessions so that opening a known camera does not read it again. There is one file per
+    // serial number; its entries are dropped as soon as the firmware version no longer matches, and the
+    // whole file as soon as an entry fails its checksum.
+    class device_cache
+    {
+    public:
+        device_cache(const std::string& directory, const std::string& serial, const std::string& version);
+        // Flushes the entries put since the last flush()
+        ~device_cache();
+
+        // The cache of a device in the default location: $LRS_DEVICE_CACHE_DIR, else the user's cache
+        // directory. Returns null when LRS_DEVICE_CACHE_DIR is set empty, which disables caching.
+        static std::shared_ptr<device_cache> open(const std::string& serial, const std::string& version);
+
+        bool get(const std::string& key, std::vector<uint8_t>& value) const;
+        // Entries are written to disk by flush() (or on destruction), so that putting the tables
+        // of a device one by one writes the file once
+        void put(const std::string& key, const std::vector<uint8_t>& value);
+        void flush();
+        void clear();
+
+    private:
+        void load();
+        void save() const;
+
+        std::string _directory;
+        std::string _path;
+        std::string _version;
+
+        mutable std::mutex _mutex;
+        std::map<std::string, std::vector<uint8_t>> _entries;
+        bool _dirty = false;
+    };
+}
@@ -53,6 +53,32 @@ constexpr bool hw_mon_over_xu = false;
 
 namespace librealsense
 {
+    // Breaks a device's initialization down into named phases, for the startup log
+    class startup_phases
+    {
+    public:
+        startup_phases() : _start(std::chrono::steady_clock::now()), _last(_start) {}
+
+        void end_phase(const char* name)
+        {
+            auto now = std::chrono::steady_clock::now();
+            _summary << (_summary.tellp() > 0 ? ", " : "") << name << " "
+                     << std::chrono::duration_cast<std::chrono::milliseconds>(now - _last).count() << " ms";
+            _last = now;
+        }
+
+        long long total_ms() const
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(_last - _start).count();
+        }
+
+        std::string str() const { return _summary.str(); }
+
+    private:
+        std::chrono::steady_clock::time_point _start, _last;
+        std::ostringstream _summary;
+    };
+
     std::map<uint32_t, rs2_format> ds5_depth_fourcc_to_rs2_format = {
         {rs_fourcc('Y','U','Y','2'), RS2_FORMAT_YUYV},
         {rs_fourcc('Y','U','Y','V'), RS2_FORMAT_YUYV},
@@ -797,8 +823,23 @@ namespace librealsense
 
     std::vector<uint8_t> ds5_device::get_raw_calibration_table(ds::calibration_table_id table_id) const
     {
+        auto key = "calibration-table/" + std::to_string(table_id);
+        std::vector<uint8_t> table;
+        if (_device_cache && _device_cache->get(key, table))
+            return table;
+
         command cmd(ds::GETINTCAL, table_id);
-        return _hw_monitor->send(cmd);
+        table = _hw_monitor->send(cmd);
+        if (_device_cache && !table.empty())
+            _device_cache->put(key, table);
+        return table;
+    }
+
+    void ds5_device::write_calibration() const
+    {
+        auto_calibrated::write_calibration();
+        if (_device_cache)
+            _device_cache->clear();
     }
 
     std::vector<uint8_t> ds5_device::get_new_calibration_table() const
@@ -813,11 +854,9 @@ namespace librealsense
         return {};
     }
 
-    ds::d400_caps ds5_device::parse_device_capabilities() const
+    ds::d400_caps ds5_device::parse_device_capabilities(const std::vector<uint8_t>& gvd_buf) const
     {
         using namespace ds;
-        std::array<unsigned char,HW_MONITOR_BUFFER_SIZE> gvd_buf;
-        _hw_monitor->get_gvd(gvd_buf.size(), gvd_buf.data(), GVD);
 
         // Opaque retrieval
         d400_caps val{d400_caps::CAP_UNDEFINED};
@@ -906,6 +945,7 @@ namespace librealsense
     {
         using namespace ds;
 
+        startup_phases phases;
         auto&& backend = ctx->get_backend();
         auto& raw_sensor = get_raw_depth_sensor();
         auto pid = group.uvc_devices.front().pid;
@@ -966,6 +1006,8 @@ namespace librealsense
         _pid = group.uvc_devices.front().pid;
         std::string device_name = (rs400_sku_names.end() != rs400_sku_names.find(_pid)) ? rs400_sku_names.at(_pid) : "RS4xx";
 
+        phases.end_phase("hw-monitor");
+
         std::vector<uint8_t> gvd_buff(HW_MONITOR_BUFFER_SIZE);
         _hw_monitor->get_gvd(gvd_buff.size(), gvd_buff.data(), GVD);
 
@@ -1009,9 +1051,15 @@ namespace librealsense
         _recommended_fw_version = firmware_version(fwv_debug); //for al3d debug
         _al3d_fw_version = firmware_version(fwv_debug); //for al3d fw version
 #endif
+
+        // AL3D calibration and parameter queries are slow round-trips whose answers only change with the
+        // firmware; keep them on disk between sessions
+        if ((_pid == ds::AL3D_PID) || (_pid == ds::AL3Di_PID) || (_pid == ds::AL3D_iTOF_PID) || (_pid == ds::AL3Di_iTOF_PID))
+            _device_cache = device_cache::open(optic_serial, fwv + "/" + fwv_debug);
+        phases.end_phase("gvd");
         
         if (_fw_version >= firmware_version("5.10.4.0"))
-            _device_capabilities = parse_device_capabilities();
+            _device_capabilities = parse_device_capabilities(gvd_buff);
 
         auto& depth_sensor = get_depth_sensor();
         auto& raw_depth_sensor = get_raw_depth_sensor();
@@ -1078,7 +1126,7 @@ namespace librealsense
 
         if (_fw_version >= firmware_version("5.6.3.0"))
         {
-            _is_locked = _hw_monitor->is_camera_locked(GVD, is_camera_locked_offset);
+            _is_locked = gvd_buff[is_camera_locked_offset] != 0;
         }
 
         if (_fw_version >= firmware_version("5.5.8.0"))
@@ -1328,19 +1376,19 @@ namespace librealsense
 				rs2_option al_opt;
 
 				al_opt = RS2_OPTION_SET_AE_TARGET;
-				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 0, "AE target"));
+				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 0, "AE target"));
 			
 				al_opt = RS2_OPTION_SET_MAX_EXPOSURE_TIME;
-				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 0, "max exposure time(us)"));
+				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 0, "max exposure time(us)"));
 			
 				al_opt = RS2_OPTION_SET_MIN_EXPOSURE_TIME;
-				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 0, "min exposure time(us)"));
+				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 0, "min exposure time(us)"));
 
 				al_opt = RS2_OPTION_SET_DEPTH_MASK;
-				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 0, "depth mask (0 ~ 50 %)"));
+				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 0, "depth mask (0 ~ 50 %)"));
 
 				al_opt = RS2_OPTION_SET_DEPTH_MASK_VERTICAL;
-				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 0, "depth mask - vertical(0 ~ 50 %)"));
+				depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 0, "depth mask - vertical(0 ~ 50 %)"));
 				
 			}
 
@@ -1361,19 +1409,19 @@ namespace librealsense
 					rs2_option al_opt;
 
 					al_opt = RS2_OPTION_SET_SP_FILTER_FUNC_ENABLE;
-					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 2, "AL SPFilter, function enable"));
+					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 2, "AL SPFilter, function enable"));
 				
 					al_opt = RS2_OPTION_SET_SP_FILTER_FLOOR_REMOVE;
-					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 0, "AL SPFilter, floor removr enable"));
+					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 0, "AL SPFilter, floor removr enable"));
 				
 					al_opt = RS2_OPTION_SET_SP_FILTER_HEIGHT;
-					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 0, "AL SPFilter, hight(um)"));
+					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 0, "AL SPFilter, hight(um)"));
 				
 					al_opt = RS2_OPTION_SET_SP_FILTER_DEPTH_ANGLE;
-					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 0, "AL SPFilter, depth angle(0.01 deg)"));
+					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 0, "AL SPFilter, depth angle(0.01 deg)"));
 
 					al_opt = RS2_OPTION_SET_SP_FILTER_CONTURE_MODE;
-					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, get_depth_option_range(al_opt), al_opt, 0, "AL SPFilter, conture mode enable"));
+					depth_sensor.register_option(al_opt, std::make_shared<al3d_depth_cmd_option>(*_hw_monitor, &depth_sensor, [this, al_opt]() { return get_depth_option_range(al_opt); }, al_opt, 0, "AL SPFilter, conture mode enable"));
 				}
 			}
 
@@ -1463,19 +1511,17 @@ namespace librealsense
                     }));
         }
 		
+        phases.end_phase("options");
+
 		if ((_pid == AL3D_PID) || (_pid == AL3Di_PID) || (_pid == AL3D_iTOF_PID) || (_pid == AL3Di_iTOF_PID))
 		{
 			if (_al3d_fw_version >= firmware_version("0.0.2.106"))
 			{
 				char ver[5] = { '\0' };
-				
-				bool ret = set_al3d_param(503, 0xff, 0xff, 0xff);
 
-				if (ret)
-				{
-					std::vector<uint8_t> data = get_al3d_data();
-					memcpy(ver, &data[8], 4);
-				}
+				auto data = get_al3d_param_data(503);
+				if (data.size() >= 4)
+					memcpy(ver, data.data(), 4);
 
 				device_name.append(" ").append(ver);
 			}
@@ -1515,6 +1561,7 @@ namespace librealsense
             register_info(RS2_CAMERA_INFO_USB_TYPE_DESCRIPTOR, usb_type_str);
 
         std::string curr_version= _fw_version;
+        phases.end_phase("info");
 		
        if (
            ((_pid == AL3D_PID)  && (_al3d_fw_version >= firmware_version("0.0.1.147"))) || 
@@ -1587,9 +1634,14 @@ namespace librealsense
                }                  
            }
        }
-       
-      
+       phases.end_phase("time-sync");
 
+       // Everything read during initialization goes to disk at once
+       if (_device_cache)
+           _device_cache->flush();
+
+       LOG_INFO(device_name << " " << optic_serial << " initialized in " << phases.total_ms() << " ms ("
+                << phases.str() << (_device_cache ? ", device cache" : "") << ")");
     }
 
 	uint32_t ds5_device::get_al3d_error() 
@@ -1654,17 +1706,36 @@ namespace librealsense
 	option_range ds5_device::get_depth_option_range(rs2_option opt)
 	{
 		option_range range = {1.0,1.0,1.0,1.0};
-		bool ret = false;
+		auto data = get_al3d_param_data(opt);
+		if (data.size() >= sizeof(range))
+			memcpy(&range, data.data(), sizeof(range));
 
-		ret = set_al3d_param(opt, 0xff, 0xff, 0xff);
+        return range;
+	}
+
+	std::vector<uint8_t> ds5_device::get_al3d_param_data(int param) const
+	{
+		// Unlike set_al3d_param(), does not go through _al3d_ret, so options may query concurrently
+		auto key = "al3d-param/" + std::to_string(param);
+		std::vector<uint8_t> data;
+		if (_device_cache && _device_cache->get(key, data))
+			return data;
 
-		if(ret)
+		try
 		{
-			std::vector<uint8_t> data = get_al3d_data();
-			memcpy(&range, &data[8], sizeof(range));
+			command cmd(ds::fw_cmd::SET_AL3D_PARAM, param, 0xff, 0xff, 0xff);
+			auto res = _hw_monitor->send(cmd);
+			if (res.size() > 8)
+				data.assign(res.begin() + 8, res.end());
 		}
-		
-        return range;
+		catch (const std::exception& e)
+		{
+			LOG_DEBUG("AL3D parameter " << param << " query failed: " << e.what());
+		}
+
+		if (_device_cache && !data.empty())
+			_device_cache->put(key, data);
+		return data;
 	}		
 	
     notification ds5_notification_decoder::decode(int value)
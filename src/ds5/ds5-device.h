@@ -15,6 +15,7 @@
 #include "ds5-auto-calibration.h"
 #include "ds5-options.h"
 #include "al3d-ai.h"
+#include "device-cache.h"
 
 
 namespace librealsense
@@ -72,6 +73,7 @@ namespace librealsense
         std::vector<uint8_t> backup_flash(update_progress_callback_ptr callback) override;
         void update_flash(const std::vector<uint8_t>& image, update_progress_callback_ptr callback, int update_mode) override;
         bool check_fw_compatibility(const std::vector<uint8_t>& image) const override;
+        void write_calibration() const override;
         void al3d_fw_update_start(const std::vector<uint8_t>& image, update_progress_callback_ptr callback, int update_mode);
 		option_range get_depth_option_range(rs2_option opt);
         std::shared_ptr<al3d_ai_monitor> _al3d_ai_monitor; //for al3d ai cmd
@@ -83,11 +85,14 @@ namespace librealsense
         std::vector<uint8_t> get_raw_calibration_table(ds::calibration_table_id table_id) const;
         std::vector<uint8_t> get_new_calibration_table() const;
 
+        // Payload of an AL3D parameter query, i.e. the reply past its 8 bytes header; empty on failure
+        std::vector<uint8_t> get_al3d_param_data(int param) const;
+
         bool is_camera_in_advanced_mode() const;
 
         float get_stereo_baseline_mm() const;
 
-        ds::d400_caps parse_device_capabilities() const;
+        ds::d400_caps parse_device_capabilities(const std::vector<uint8_t>& gvd_buf) const;
 
         //TODO - add these to device class as pure virtual methods
         command get_firmware_logs_command() const;
@@ -125,6 +130,7 @@ namespace librealsense
         bool _is_locked = true;
 		std::vector<uint8_t> _al3d_ret;
 		bool _is_al3d_fw_update_start = false;
+        std::shared_ptr<device_cache> _device_cache;
     };
 
     class ds5u_device : public ds5_device
@@ -246,6 +246,24 @@ namespace librealsense
             [&, mm_correct_opt]() { return std::make_shared<gyroscope_transform>(_mm_calib, mm_correct_opt);
         });
 
+        // Opt-in profiles that carry several samples per frame
+        auto batch_size_opt = std::make_shared<float_option>(option_range{ 1, 1000, 1, 16 }, "Motion samples gathered in a frame of the MOTION_XYZ32F_BATCH format");
+        auto batch_age_opt = std::make_shared<float_option>(option_range{ 1, 1000, 1, 20 }, "Milliseconds after which a batch of motion samples is sent, even if not full");
+        hid_ep->register_option(RS2_OPTION_MOTION_BATCH_SIZE, batch_size_opt);
+        hid_ep->register_option(RS2_OPTION_MOTION_BATCH_MAX_AGE, batch_age_opt);
+
+        hid_ep->register_processing_block(
+            { {RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_ACCEL} },
+            { {RS2_FORMAT_MOTION_XYZ32F_BATCH, RS2_STREAM_ACCEL} },
+            [&, mm_correct_opt, batch_size_opt, batch_age_opt]() { return std::make_shared<motion_batcher>(RS2_STREAM_ACCEL, _mm_calib, mm_correct_opt, batch_size_opt, batch_age_opt);
+        });
+
+        hid_ep->register_processing_block(
+            { {RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_GYRO} },
+            { {RS2_FORMAT_MOTION_XYZ32F_BATCH, RS2_STREAM_GYRO} },
+            [&, mm_correct_opt, batch_size_opt, batch_age_opt]() { return std::make_shared<motion_batcher>(RS2_STREAM_GYRO, _mm_calib, mm_correct_opt, batch_size_opt, batch_age_opt);
+        });
+
         if ((camera_fw_version >= firmware_version(custom_sensor_fw_ver)) &&
                 (!val_in_range(_pid, { ds::RS400_IMU_PID, ds::RS435I_PID, ds::RS430I_PID, ds::RS465_PID, ds::RS405_PID, ds::RS455_PID, ds::AL3Di_PID })))  //al3d
         {
@@ -968,17 +968,22 @@ namespace librealsense
         return 0;
     }
 
-	al3d_depth_cmd_option::al3d_depth_cmd_option(hw_monitor& hwm, sensor_base* depth_ep, option_range range, rs2_option opt, uint8_t read_opt, std::string name)
-		: option_base(range), _hwm(hwm), _sensor(depth_ep), _opt_id(opt), _read_opt(read_opt)
+	al3d_depth_cmd_option::al3d_depth_cmd_option(hw_monitor& hwm, sensor_base* depth_ep, std::function<option_range()> range, rs2_option opt, uint8_t read_opt, std::string name)
+		: option_base({ 1.0, 1.0, 1.0, 1.0 }), _range(std::move(range)), _hwm(hwm), _sensor(depth_ep), _opt_id(opt), _value(0), _read_opt(read_opt)
 	{
 	    _name =  name + " -al3d";
+	}
 
-        _range = [range]()
-        {
-            return range;
-        };
-
-		_value = (uint32_t)_range->def;
+	bool al3d_depth_cmd_option::is_valid(float value) const
+	{
+		// Same as option_base::is_valid(), against the range read from the camera
+		auto range = get_range();
+		if ((value < range.min) || (value > range.max))
+			return false;
+		if (range.step == 0)
+			return true;
+		auto n = (value - range.min) / range.step;
+		return (fabs(fmod(n, 1)) < std::numeric_limits<float>::min());
 	}
 
 	void al3d_depth_cmd_option::set(float value)
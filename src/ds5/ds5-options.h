@@ -381,7 +381,8 @@ namespace librealsense
     class al3d_depth_cmd_option : public option_base
     {
     public:
-        al3d_depth_cmd_option(hw_monitor& hwm, sensor_base* depth_ep, option_range range, rs2_option opt, uint8_t read_opt, std::string name);
+        // The range is read from the camera on first use rather than at device construction
+        al3d_depth_cmd_option(hw_monitor& hwm, sensor_base* depth_ep, std::function<option_range()> range, rs2_option opt, uint8_t read_opt, std::string name);
         virtual ~al3d_depth_cmd_option() = default;
         virtual void set(float value) override;
         virtual float query() const override;
@@ -391,6 +392,8 @@ namespace librealsense
         virtual const char* get_description() const override;
         virtual void enable_recording(std::function<void(const option&)> record_action) override { _record_action = record_action; }
     private:
+        bool is_valid(float value) const;
+
         std::function<void(const option&)> _record_action = [](const option&) {};
         lazy<option_range> _range;
         hw_monitor& _hwm;
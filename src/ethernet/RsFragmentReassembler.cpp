@@ -0,0 +1,185 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "RsFragmentReassembler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+// Largest UDP payload
+#define MAX_DATAGRAM_SIZE 65536
+
+RsFragmentReassembler::RsFragmentReassembler()
+    : m_buffer(nullptr)
+    , m_capacity(0)
+    , m_started(false)
+    , m_complete(false)
+    , m_frameId(0)
+    , m_messageSize(0)
+    , m_fragmentSize(0)
+    , m_receivedSize(0)
+    , m_expected(0)
+    , m_scratch(MAX_DATAGRAM_SIZE)
+    , m_droppedMessages(0)
+{}
+
+void RsFragmentReassembler::begin(unsigned char* t_buffer, unsigned t_capacity)
+{
+    if(m_started && !m_complete)
+    {
+        // The message under way was in the previous buffer
+        m_droppedMessages++;
+        m_complete = true;
+    }
+    m_buffer = t_buffer;
+    m_capacity = t_capacity;
+}
+
+unsigned RsFragmentReassembler::expectedOffset() const
+{
+    if(!m_started || m_complete)
+    {
+        return 0;
+    }
+    if(m_expected >= m_received.size())
+    {
+        return m_capacity;
+    }
+    return m_expected * m_fragmentSize;
+}
+
+int RsFragmentReassembler::receive(int t_socket)
+{
+    if(m_buffer == nullptr)
+    {
+        return -1;
+    }
+
+    RsFragmentPacketHeader header;
+#ifdef _WIN32
+    int res = recv(t_socket, (char*)m_scratch.data(), (int)m_scratch.size(), 0);
+    if(res < (int)sizeof(header))
+    {
+        return res < 0 ? -1 : 0;
+    }
+    memcpy(&header, m_scratch.data(), sizeof(header));
+    return place(header, 0, 0, m_scratch.data() + sizeof(header), res - sizeof(header));
+#else
+    // Read the payload where the next fragment belongs, and whatever does not fit there aside
+    unsigned at = expectedOffset();
+    unsigned room = 0;
+    if(at < m_capacity)
+    {
+        room = std::min(m_capacity - at, m_started && !m_complete ? m_fragmentSize : (unsigned)MAX_DATAGRAM_SIZE);
+    }
+    iovec pieces[3];
+    int count = 0;
+    pieces[count++] = {&header, sizeof(header)};
+    if(room)
+    {
+        pieces[count++] = {m_buffer + at, room};
+    }
+    pieces[count++] = {m_scratch.data(), m_scratch.size()};
+    msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = pieces;
+    message.msg_iovlen = count;
+
+    ssize_t res = recvmsg(t_socket, &message, 0);
+    if(res < (ssize_t)sizeof(header))
+    {
+        return res < 0 ? -1 : 0;
+    }
+    unsigned size = (unsigned)res - sizeof(header);
+    unsigned inBuffer = std::min(size, room);
+    return place(header, at, inBuffer, m_scratch.data(), size);
+#endif
+}
+
+int RsFragmentReassembler::push(const unsigned char* t_packet, unsigned t_size)
+{
+    RsFragmentPacketHeader header;
+    if(m_buffer == nullptr || t_size < sizeof(header))
+    {
+        return 0;
+    }
+    memcpy(&header, t_packet, sizeof(header));
+    return place(header, 0, 0, t_packet + sizeof(header), t_size - sizeof(header));
+}
+
+int RsFragmentReassembler::place(const RsFragmentPacketHeader& t_header, unsigned t_at, unsigned t_inBuffer, const unsigned char* t_rest, unsigned t_size)
+{
+    if((t_header.rtpFlags & 0xc0) != 0x80)
+    {
+        return 0;
+    }
+
+    uint32_t frameId = ntohl(t_header.frameId);
+    if(!m_started || frameId != m_frameId)
+    {
+        if(m_started && (int32_t)(frameId - m_frameId) < 0)
+        {
+            // A late fragment of a message that is gone
+            return 0;
+        }
+        if(m_started && !m_complete)
+        {
+            m_droppedMessages++;
+        }
+        m_started = true;
+        m_complete = false;
+        m_frameId = frameId;
+        m_messageSize = ntohl(t_header.messageSize);
+        m_fragmentSize = ntohs(t_header.fragmentSize);
+        m_receivedSize = 0;
+        m_expected = 0;
+        if(m_fragmentSize == 0 || m_messageSize == 0 || m_messageSize > m_capacity)
+        {
+            m_droppedMessages++;
+            m_complete = true;
+            return 0;
+        }
+        m_received.assign((m_messageSize + m_fragmentSize - 1) / m_fragmentSize, false);
+    }
+    if(m_complete)
+    {
+        return 0;
+    }
+
+    unsigned offset = ntohl(t_header.offset);
+    unsigned index = offset / m_fragmentSize;
+    if(offset % m_fragmentSize != 0 || index >= m_received.size() || m_received[index] ||
+       t_size != std::min(m_fragmentSize, m_messageSize - offset))
+    {
+        return 0;
+    }
+
+    if(t_at != offset || t_inBuffer != t_size)
+    {
+        unsigned char* to = m_buffer + offset;
+        memmove(to, m_buffer + t_at, t_inBuffer);
+        memcpy(to + t_inBuffer, t_rest, t_size - t_inBuffer);
+    }
+
+    m_received[index] = true;
+    m_receivedSize += t_size;
+    while(m_expected < m_received.size() && m_received[m_expected])
+    {
+        m_expected++;
+    }
+
+    if(m_receivedSize < m_messageSize)
+    {
+        return 0;
+    }
+    m_complete = true;
+    return (int)m_messageSize;
+}
@@ -0,0 +1,55 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../ipDeviceCommon/RsCommon.h"
+
+#include <vector>
+
+/*
+    Reassembles the messages the server sends in fragments (see RsFragmentPacketHeader) straight into the buffer
+    of the frame. Datagrams are read with their payload already at the place the next fragment is expected, so in
+    order delivery costs no copy; fragments that arrive elsewhere are moved to their place.
+    A message missing a fragment when the next one starts is dropped: there is no retransmission nor FEC.
+*/
+class RsFragmentReassembler
+{
+public:
+    RsFragmentReassembler();
+
+    // Starts receiving a message into t_buffer, of t_capacity bytes
+    void begin(unsigned char* t_buffer, unsigned t_capacity);
+
+    // Reads one datagram from the socket. Returns the size of the message once it is complete, 0 while it is not,
+    // and -1 when nothing could be read.
+    int receive(int t_socket);
+
+    // Same as receive(), for a packet read by other means
+    int push(const unsigned char* t_packet, unsigned t_size);
+
+    unsigned long long droppedMessages() const
+    {
+        return m_droppedMessages;
+    }
+
+private:
+    // Puts the fragment of t_header in its place. Its payload of t_size bytes was read to m_buffer + t_at for its
+    // first t_inBuffer bytes, and to t_rest for the others.
+    int place(const RsFragmentPacketHeader& t_header, unsigned t_at, unsigned t_inBuffer, const unsigned char* t_rest, unsigned t_size);
+    // Where the next fragment is read, past the fragments already received
+    unsigned expectedOffset() const;
+
+    unsigned char* m_buffer;
+    unsigned m_capacity;
+    bool m_started;     // A message is under way, or was just completed
+    bool m_complete;
+    uint32_t m_frameId;
+    unsigned m_messageSize;
+    unsigned m_fragmentSize;
+    unsigned m_receivedSize;
+    unsigned m_expected; // Index of the fragment expected next
+    std::vector<bool> m_received;
+    std::vector<unsigned char> m_scratch;
+    unsigned long long m_droppedMessages;
+};
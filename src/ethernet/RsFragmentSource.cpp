@@ -0,0 +1,64 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "RsFragmentSource.h"
+#include "GroupsockHelper.hh"
+
+// Datagrams read at most by one call of the handler, so other streams get their turn
+#define MAX_PACKETS_PER_READ 256
+
+RsFragmentSource* RsFragmentSource::createNew(UsageEnvironment& t_env, Groupsock* t_rtpGroupsock, unsigned char t_rtpPayloadFormat, unsigned t_rtpTimestampFrequency)
+{
+    return new RsFragmentSource(t_env, t_rtpGroupsock, t_rtpPayloadFormat, t_rtpTimestampFrequency);
+}
+
+RsFragmentSource::RsFragmentSource(UsageEnvironment& t_env, Groupsock* t_rtpGroupsock, unsigned char t_rtpPayloadFormat, unsigned t_rtpTimestampFrequency)
+    : RTPSource(t_env, t_rtpGroupsock, t_rtpPayloadFormat, t_rtpTimestampFrequency)
+{
+    // A frame arrives as a burst of packets: read them all as they come, without blocking once they are read
+    makeSocketNonBlocking(RTPgs()->socketNum());
+    increaseReceiveBufferTo(envir(), RTPgs()->socketNum(), 1024 * 1024 * 8);
+}
+
+RsFragmentSource::~RsFragmentSource()
+{
+    envir().taskScheduler().turnOffBackgroundReadHandling(RTPgs()->socketNum());
+}
+
+void RsFragmentSource::doGetNextFrame()
+{
+    m_reassembler.begin(fTo, fMaxSize);
+    envir().taskScheduler().turnOnBackgroundReadHandling(RTPgs()->socketNum(), (TaskScheduler::BackgroundHandlerProc*)&incomingPacketHandler, this);
+}
+
+void RsFragmentSource::doStopGettingFrames()
+{
+    envir().taskScheduler().turnOffBackgroundReadHandling(RTPgs()->socketNum());
+}
+
+void RsFragmentSource::incomingPacketHandler(RsFragmentSource* t_source, int /*t_mask*/)
+{
+    t_source->incomingPacketHandler1();
+}
+
+void RsFragmentSource::incomingPacketHandler1()
+{
+    for(int i = 0; i < MAX_PACKETS_PER_READ; i++)
+    {
+        int size = m_reassembler.receive(RTPgs()->socketNum());
+        if(size < 0)
+        {
+            return;
+        }
+        if(size > 0)
+        {
+            fFrameSize = size;
+            fNumTruncatedBytes = 0;
+            gettimeofday(&fPresentationTime, NULL);
+            // Reading resumes once the sink asks for the next frame
+            envir().taskScheduler().turnOffBackgroundReadHandling(RTPgs()->socketNum());
+            FramedSource::afterGetting(this);
+            return;
+        }
+    }
+}
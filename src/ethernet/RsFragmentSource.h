@@ -0,0 +1,36 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "liveMedia.hh"
+
+#include "RsFragmentReassembler.h"
+
+// Reads the streams the server sends in fragments, in place of live555's RTP source: each frame is reassembled
+// straight into the buffer its sink asks to fill. It is still an RTP source, so RTCP reports keep the session alive.
+class RsFragmentSource : public RTPSource
+{
+public:
+    static RsFragmentSource* createNew(UsageEnvironment& t_env, Groupsock* t_rtpGroupsock, unsigned char t_rtpPayloadFormat, unsigned t_rtpTimestampFrequency);
+
+    unsigned long long droppedFrames() const
+    {
+        return m_reassembler.droppedMessages();
+    }
+
+    virtual void setPacketReorderingThresholdTime(unsigned /*t_uSeconds*/) {}
+
+protected:
+    RsFragmentSource(UsageEnvironment& t_env, Groupsock* t_rtpGroupsock, unsigned char t_rtpPayloadFormat, unsigned t_rtpTimestampFrequency);
+    virtual ~RsFragmentSource();
+
+private:
+    virtual void doGetNextFrame();
+    virtual void doStopGettingFrames();
+
+    static void incomingPacketHandler(RsFragmentSource* t_source, int t_mask);
+    void incomingPacketHandler1();
+
+    RsFragmentReassembler m_reassembler;
+};
@@ -6,6 +6,7 @@
 #include "liveMedia.hh"
 
 #include "RsCommon.h"
+#include "RsFragmentSource.h"
 #include "RsMediaSession.hh"
 
 #include <ctype.h>
@@ -80,7 +81,13 @@ RsMediaSubsession::~RsMediaSubsession()
 
 Boolean RsMediaSubsession::createSourceObjects(int useSpecialRTPoffset)
 {
-    if(strcmp(fCodecName, RS_PAYLOAD_FORMAT.c_str()) == 0)
+    if(strcmp(fCodecName, RS_PAYLOAD_FORMAT.c_str()) == 0 && RS_PAYLOAD_FRAGMENTS == attrVal_str("payload"))
+    {
+        // The server sends the frames in fragments of its own, which are reassembled in place
+        fReadSource = fRTPSource = RsFragmentSource::createNew(env(), fRTPSocket, fRTPPayloadFormat, fRTPTimestampFrequency);
+        return True;
+    }
+    else if(strcmp(fCodecName, RS_PAYLOAD_FORMAT.c_str()) == 0)
     {
         // This subsession uses our custom RTP payload format:
         std::string mimeTypeString = RS_MEDIA_TYPE + "/" + RS_PAYLOAD_FORMAT;
@@ -8,12 +8,19 @@
 #include <ipDeviceCommon/RsCommon.h>
 
 #include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <math.h>
 #include <string>
 #include <thread>
 #include <vector>
 
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#endif
+
 #define RTSP_CLIENT_VERBOSITY_LEVEL 0 // by default, print verbose output from each "RTSPClient"
 #define REQUEST_STREAMING_OVER_TCP 0
 
@@ -33,6 +40,41 @@ long long int RsRTSPClient::getStreamProfileUniqueKey(rs2_video_stream t_profile
     return key;
 }
 
+bool RsRTSPClient::isLocalServer(char const *t_rtspURL)
+{
+#ifdef _WIN32
+    return false;
+#else
+    char host[256];
+    in_addr address;
+    if (sscanf(t_rtspURL, "rtsp://%255[^:/]", host) != 1)
+    {
+        return false;
+    }
+    if (inet_pton(AF_INET, host, &address) != 1)
+    {
+        return strcmp(host, "localhost") == 0;
+    }
+    if ((ntohl(address.s_addr) >> 24) == 127)
+    {
+        return true;
+    }
+
+    // An address of one of our interfaces
+    bool local = false;
+    ifaddrs *interfaces;
+    if (getifaddrs(&interfaces) == 0)
+    {
+        for (ifaddrs *it = interfaces; it != NULL && !local; it = it->ifa_next)
+        {
+            local = it->ifa_addr != NULL && it->ifa_addr->sa_family == AF_INET && ((sockaddr_in *)it->ifa_addr)->sin_addr.s_addr == address.s_addr;
+        }
+        freeifaddrs(interfaces);
+    }
+    return local;
+#endif
+}
+
 int RsRTSPClient::getPhysicalSensorUniqueKey(rs2_stream stream_type, int sensors_index)
 {
     return stream_type * 10 + sensors_index;
@@ -114,6 +156,9 @@ int RsRTSPClient::addStream(rs2_video_stream t_stream, rtp_callback *t_callbackO
         throw std::runtime_error(format_error_msg(__FUNCTION__, err));
     }
 
+    // Servers on this host can publish the frames in shared memory; they still come over RTP otherwise
+    m_requestSharedMemory = subsession->attrVal_bool("shm") && isLocalServer(this->url());
+
     // Continue setting up this subsession, by sending a RTSP "SETUP" command:
     unsigned res = this->sendSetupCommand(*subsession, this->continueAfterSETUP, False, REQUEST_STREAMING_OVER_TCP);
     // wait for continueAfterSETUP to finish
@@ -464,6 +509,7 @@ void RsRTSPClient::continueAfterDESCRIBE(RTSPClient *rtspClient, int resultCode,
             videoStream.intrinsics.fx = subsession->attrVal_int("fx");
             videoStream.intrinsics.fy = subsession->attrVal_int("fy");
             CompressionFactory::getIsEnabled() = subsession->attrVal_bool("compression");
+            CompressionFactory::getDepthMethod() = subsession->attrVal_bool("temporal") ? ZipMethod::temporal : ZipMethod::lz;
             videoStream.intrinsics.model = (rs2_distortion)subsession->attrVal_int("model");
 
             for (size_t i = 0; i < 5; i++)
@@ -666,6 +712,16 @@ void RsRTSPClient::continueAfterSETCOMMAND(RTSPClient *rtspClient, int resultCod
     rsRtspClient->m_cv.notify_one();
 }
 
+void RsRTSPClient::continueAfterKeyframeRequest(RTSPClient *rtspClient, int resultCode, char *resultString)
+{
+    // Nobody waits for this answer: the decoder asks again if no keyframe comes
+    if (resultCode != 0)
+    {
+        ERR << "keyframe request failed: " << resultCode << " " << (resultString != nullptr ? resultString : "");
+    }
+    delete[] resultString;
+}
+
 void RsRTSPClient::continueAfterGETCOMMAND(RTSPClient *rtspClient, int resultCode, char *resultString)
 {
     std::string resultStr;
@@ -717,6 +773,12 @@ unsigned RsRTSPClient::sendSetParameterCommand(responseHandler *responseHandler,
     return result;
 }
 
+void RsRTSPClient::requestKeyframe(MediaSubsession &t_subsession)
+{
+    // Called from the event loop, by the sink of the stream
+    RTSPClient::sendSetParameterCommand(*this->m_scs.m_session, this->continueAfterKeyframeRequest, RS_KEYFRAME_PARAMETER.c_str(), t_subsession.controlPath());
+}
+
 unsigned RsRTSPClient::sendGetParameterCommand(responseHandler *responseHandler, char const *parameterName, Authenticator *authenticator)
 {
     if (fCurrentAuthenticator < authenticator)
@@ -755,6 +817,20 @@ Boolean RsRTSPClient::setRequestFields(RequestRecord *request, char *&cmdURL, Bo
         cmdURLWasAllocated = True; //use BaseUrl
         sprintf(cmdURL, "%s", "*");
     }
+    else if (strcmp(request->commandName(), "SETUP") == 0 && m_requestSharedMemory)
+    {
+        if (!RTSPClient::setRequestFields(request, cmdURL, cmdURLWasAllocated, protocolStr, extraHeaders, extraHeadersWereAllocated))
+        {
+            return False;
+        }
+        std::string headers = std::string(extraHeaders) + RS_SHARED_MEMORY_HEADER + "\r\n";
+        if (extraHeadersWereAllocated)
+        {
+            delete[] extraHeaders;
+        }
+        extraHeaders = strDup(headers.c_str());
+        extraHeadersWereAllocated = True;
+    }
     else
     {
         return RTSPClient::setRequestFields(request, cmdURL, cmdURLWasAllocated, protocolStr, extraHeaders, extraHeadersWereAllocated);
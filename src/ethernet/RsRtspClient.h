@@ -32,6 +32,8 @@ public:
     void initFunc(MemoryPool* t_pool);
 
     static long long int getStreamProfileUniqueKey(rs2_video_stream t_profile);
+    // Whether the server of t_rtspURL runs on this host
+    static bool isLocalServer(char const* t_rtspURL);
     static int getPhysicalSensorUniqueKey(rs2_stream stream_type, int sensors_index);
     void setDeviceData(DeviceData t_data);
 
@@ -58,6 +60,7 @@ public:
     static void continueAfterOPTIONS(RTSPClient* rtspClient, int resultCode, char* resultString);
     static void continueAfterSETCOMMAND(RTSPClient* rtspClient, int resultCode, char* resultString);
     static void continueAfterGETCOMMAND(RTSPClient* rtspClient, int resultCode, char* resultString);
+    static void continueAfterKeyframeRequest(RTSPClient* rtspClient, int resultCode, char* resultString);
     static void subsessionAfterPlaying(void* clientData); // called when a stream's subsession (e.g., audio or video substream) ends
     static void subsessionByeHandler(void* clientData, char const* reason);
     char& getEventLoopWatchVariable()
@@ -71,6 +74,8 @@ public:
 
     unsigned sendSetParameterCommand(responseHandler* responseHandler, char const* parameterName, char const* parameterValue, Authenticator* authenticator = NULL);
     unsigned sendGetParameterCommand(responseHandler* responseHandler, char const* parameterName, Authenticator* authenticator = NULL);
+    // Asks the server for a keyframe of the stream of t_subsession, without waiting for its answer
+    void requestKeyframe(MediaSubsession& t_subsession);
     Boolean setRequestFields(RequestRecord* request, char*& cmdURL, Boolean& cmdURLWasAllocated, char const*& protocolStr, char*& extraHeaders, Boolean& extraHeadersWereAllocated);
 
 private:
@@ -81,6 +86,7 @@ private:
 
     StreamClientState m_scs;
     bool isActiveSession = false; //this flag should affect the get/set param commands to run in context of specific session, currently value is always false
+    bool m_requestSharedMemory = false; // The SETUP being sent asks for the frames in shared memory
     std::vector<rs2_video_stream> m_supportedProfiles;
     std::map<long long int, RsMediaSubsession*> m_subsessionMap;
     RsRtspReturnValue m_lastReturnValue;
@@ -2,6 +2,7 @@
 // Copyright(c) 2020 Intel Corporation. All Rights Reserved.
 
 #include "RsSink.h"
+#include "RsRtspClient.h"
 #include <ipDeviceCommon/Statistic.h>
 
 #include "stdio.h"
@@ -55,6 +56,8 @@ RsSink::RsSink(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video
     {
         INF << "compression is disabled or configured unsupported format to zip, run without compression";
     }
+    // A frame being received and, when compressed, the one it is decompressed into
+    m_memPool->reserve(m_bufferSize, m_iCompress != nullptr ? 2 : 1);
 }
 
 RsSink::~RsSink()
@@ -95,48 +98,110 @@ void RsSink::afterGettingFrameUid3(void* t_clientData, unsigned t_frameSize, uns
     sink->afterGettingFrame(t_frameSize, t_numTruncatedBytes, t_presentationTime, t_durationInMicroseconds);
 }
 
+unsigned char* RsSink::acquireSharedFrame(const RsNetworkHeader& t_header, unsigned& t_frameSize)
+{
+    std::string name(t_header.data.sharedMemoryName, strnlen(t_header.data.sharedMemoryName, SHARED_MEMORY_NAME_SIZE));
+    if(m_ring == nullptr || m_ring->name() != name)
+    {
+        // The server makes a ring for each session
+        m_ring = RsSharedMemoryRing::open(name);
+        if(m_ring == nullptr)
+        {
+            envir() << m_streamId << ": cannot open shared memory " << name.c_str() << "\n";
+            return nullptr;
+        }
+    }
+    const unsigned char* message = m_ring->acquire(t_header.data.sharedMemorySlot, t_header.data.sharedMemorySequence, t_frameSize);
+    if(message == nullptr)
+    {
+        envir() << m_streamId << ": frame " << (unsigned)t_header.data.sharedMemorySequence << " was overwritten in shared memory\n";
+    }
+    // Mapped read-only: frames are handed on as they lie, never written
+    return const_cast<unsigned char*>(message);
+}
+
+void RsSink::releaseMessage(unsigned char* t_message, bool t_shared)
+{
+    if(t_shared)
+    {
+        m_ring->release(t_message);
+    }
+    else
+    {
+        m_memPool->returnMem(t_message);
+    }
+}
+
 // If you don't want to see debugging output for each received frame, then comment out the following line:
 #define DEBUG_PRINT_EACH_RECEIVED_FRAME 0
 
 void RsSink::afterGettingFrame(unsigned t_frameSize, unsigned t_numTruncatedBytes, struct timeval t_presentationTime, unsigned /*t_durationInMicroseconds*/)
 {
-    RsNetworkHeader* header = (RsNetworkHeader*)m_receiveBuffer;
+    unsigned char* message = m_receiveBuffer;
+    RsNetworkHeader* header = (RsNetworkHeader*)message;
+    bool shared = t_frameSize == sizeof(RsFrameHeader) && header->data.sharedMemoryName[0] != '\0';
+    if(shared)
+    {
+        // Only the header came: the frame is in shared memory
+        message = acquireSharedFrame(*header, t_frameSize);
+        m_memPool->returnMem(m_receiveBuffer);
+        m_receiveBuffer = nullptr;
+        if(message == nullptr)
+        {
+            continuePlaying();
+            return;
+        }
+        header = (RsNetworkHeader*)message;
+    }
+
     if(header->data.frameSize == t_frameSize - sizeof(RsNetworkHeader))
     {
         if(this->m_rtpCallback != NULL)
         {
             if(CompressionFactory::isCompressionSupported(m_stream.fmt, m_stream.type) && m_iCompress != nullptr)
             {
-                m_to = m_memPool->getNextMem();
+                m_to = m_memPool->getNextMem(m_bufferSize);
                 if(m_to == nullptr)
                 {
+                    releaseMessage(message, shared);
+                    m_receiveBuffer = nullptr;
+                    continuePlaying();
                     return;
                 }
-                int decompressedSize = m_iCompress->decompressBuffer(m_receiveBuffer + sizeof(RsFrameHeader), header->data.frameSize - sizeof(RsMetadataHeader), m_to + sizeof(RsFrameHeader));
+                int decompressedSize = m_iCompress->decompressBuffer(message + sizeof(RsFrameHeader), header->data.frameSize - sizeof(RsMetadataHeader), m_to + sizeof(RsFrameHeader));
                 if(decompressedSize != -1)
                 {
                     // copy metadata
-                    memcpy(m_to + sizeof(RsNetworkHeader), m_receiveBuffer + sizeof(RsNetworkHeader), sizeof(RsMetadataHeader));
+                    memcpy(m_to + sizeof(RsNetworkHeader), message + sizeof(RsNetworkHeader), sizeof(RsMetadataHeader));
                     this->m_rtpCallback->on_frame((u_int8_t*)m_to + sizeof(RsNetworkHeader), decompressedSize + sizeof(RsMetadataHeader), t_presentationTime);
                 }
-                m_memPool->returnMem(m_receiveBuffer);
+                else
+                {
+                    m_memPool->returnMem(m_to);
+                    if(m_iCompress->needsKeyframe())
+                    {
+                        ((RsRTSPClient*)m_subsession.miscPtr)->requestKeyframe(m_subsession);
+                    }
+                }
+                releaseMessage(message, shared);
             }
             else
             {
-                this->m_rtpCallback->on_frame(m_receiveBuffer + sizeof(RsNetworkHeader), header->data.frameSize, t_presentationTime);
+                // Released by the frame deleter of the stream
+                this->m_rtpCallback->on_frame(message + sizeof(RsNetworkHeader), header->data.frameSize, t_presentationTime);
             }
         }
         else
         {
             // TODO: error, no call back
-            m_memPool->returnMem(m_receiveBuffer);
+            releaseMessage(message, shared);
             envir() << "Frame call back is NULL\n";
         }
     }
     else
     {
                 envir() << m_streamId << ":corrupted frame!!!: data size is " << header->data.frameSize << " frame size is " << t_frameSize << "\n";
-                m_memPool->returnMem(m_receiveBuffer);
+                releaseMessage(message, shared);
     }
     m_receiveBuffer = nullptr;
 
@@ -150,7 +215,7 @@ Boolean RsSink::continuePlaying()
         return False; // sanity check (should not happen)
 
     // Request the next frame of data from our input source.  "afterGettingFrame()" will get called later, when it arrives:
-    m_receiveBuffer = m_memPool->getNextMem();
+    m_receiveBuffer = m_memPool->getNextMem(m_bufferSize);
     if(m_receiveBuffer == nullptr)
     {
         return false;
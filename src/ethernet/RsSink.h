@@ -10,6 +10,7 @@
 #include "rtp_callback.hh"
 #include <compression/CompressionFactory.h>
 #include <ipDeviceCommon/MemoryPool.h>
+#include <ipDeviceCommon/RsSharedMemoryRing.h>
 
 #include <librealsense2/hpp/rs_internal.hpp>
 
@@ -34,6 +35,9 @@ private:
     static void afterGettingFrameUid2(void* t_clientData, unsigned t_frameSize, unsigned t_numTruncatedBytes, struct timeval t_presentationTime, unsigned t_durationInMicroseconds);
     static void afterGettingFrameUid3(void* t_clientData, unsigned t_frameSize, unsigned t_numTruncatedBytes, struct timeval t_presentationTime, unsigned t_durationInMicroseconds);
     void afterGettingFrame(unsigned t_frameSize, unsigned t_numTruncatedBytes, struct timeval t_presentationTime, unsigned t_durationInMicroseconds);
+    // Takes the frame the server published in shared memory as t_header tells, or returns nullptr if it is gone
+    unsigned char* acquireSharedFrame(const RsNetworkHeader& t_header, unsigned& t_frameSize);
+    void releaseMessage(unsigned char* t_message, bool t_shared);
 
 private:
     // redefined virtual functions:
@@ -51,6 +55,7 @@ private:
     rs2_video_stream m_stream;
     std::shared_ptr<ICompression> m_iCompress;
     MemoryPool* m_memPool;
+    std::shared_ptr<RsSharedMemoryRing> m_ring;
     std::vector<FramedSource::afterGettingFunc*> m_afterGettingFunctions;
 };
 
@@ -90,7 +90,7 @@ public:
         while(!frames_queue.empty())
         {
             Raw_Frame* frame = frames_queue.front();
-            get_memory_pool().returnMem((unsigned char*)frame->m_buffer - sizeof(RsFrameHeader));
+            release_frame(frame->m_buffer);
             frames_queue.pop();
         }
         INF << "Frames queue cleaned for " << m_rs_stream.uid;
@@ -104,7 +104,7 @@ public:
 
     static MemoryPool& get_memory_pool()
     {
-        static MemoryPool memory_pool_instance = MemoryPool();
+        static MemoryPool memory_pool_instance;
         return memory_pool_instance;
     }
 
@@ -117,7 +117,17 @@ public:
 private:
     static void frame_deleter(void* p)
     {
-        get_memory_pool().returnMem((unsigned char*)p - sizeof(RsFrameHeader));
+        release_frame(p);
+    }
+
+    // Frames come in buffers of the pool, or in shared memory when the server is on this host
+    static void release_frame(void* p)
+    {
+        unsigned char* message = (unsigned char*)p - sizeof(RsFrameHeader);
+        if(!RsSharedMemoryRing::releaseMessage(message))
+        {
+            get_memory_pool().returnMem(message);
+        }
     }
 
     rs2::stream_profile m_stream_profile;
@@ -130,11 +130,19 @@ namespace librealsense
         bool result = false;
         if (_parser && parsed_msg && fw_log_msg)
         {
-            *parsed_msg = _parser->parse_fw_log(fw_log_msg);
-            result = true;
+            result = _parser->parse_fw_log(fw_log_msg, parsed_msg);
         }
 
         return result;
     }
 
+    size_t firmware_logger_device::parse_logs(const fw_logs::fw_logs_binary_data* const* fw_log_msgs,
+        fw_logs::fw_log_data* const* parsed_msgs, size_t count)
+    {
+        if (!_parser)
+            return 0;
+
+        return _parser->parse_fw_logs(fw_log_msgs, parsed_msgs, count);
+    }
+
 }
@@ -19,6 +19,7 @@ namespace librealsense
         virtual unsigned int get_number_of_fw_logs() const = 0;
         virtual bool init_parser(std::string xml_content) = 0;
         virtual bool parse_log(const fw_logs::fw_logs_binary_data* fw_log_msg, fw_logs::fw_log_data* parsed_msg) = 0;
+        virtual size_t parse_logs(const fw_logs::fw_logs_binary_data* const* fw_log_msgs, fw_logs::fw_log_data* const* parsed_msgs, size_t count) = 0;
         virtual ~firmware_logger_extensions() = default;
     };
     MAP_EXTENSION(RS2_EXTENSION_FW_LOGGER, librealsense::firmware_logger_extensions);
@@ -37,6 +38,7 @@ namespace librealsense
 
         bool init_parser(std::string xml_content) override;
         bool parse_log(const fw_logs::fw_logs_binary_data* fw_log_msg, fw_logs::fw_log_data* parsed_msg) override;
+        size_t parse_logs(const fw_logs::fw_logs_binary_data* const* fw_log_msgs, fw_logs::fw_log_data* const* parsed_msgs, size_t count) override;
 
         // Temporal solution for HW_Monitor injection
         void assign_hw_monitor(std::shared_ptr<hw_monitor> hardware_monitor)
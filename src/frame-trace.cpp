@@ -0,0 +1,228 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "frame-trace.h"
+
+#include "archive.h"
+
+#include <fstream>
+
+namespace librealsense
+{
+    std::atomic<bool> frame_tracer::_enabled(false);
+
+    // Stage names come from blocks and sensors, which can be named anything
+    static void write_json_string(std::ostream& out, const std::string& str)
+    {
+        out << '"';
+        for (unsigned char c : str)
+        {
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (c < 0x20)
+            {
+                static const char hex[] = "0123456789abcdef";
+                out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+            }
+            else
+                out << c;
+        }
+        out << '"';
+    }
+
+    frame_tracer& frame_tracer::get_instance()
+    {
+        static frame_tracer instance;
+        return instance;
+    }
+
+    frame_tracer::frame_tracer()
+        : _next_record(0)
+    {
+        _end_to_end = { "End to end", 0, 0., 0., {} };
+    }
+
+    void frame_tracer::enable(bool on)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (on && _history.empty())
+            _history.reserve(history_size);
+        _enabled = on;
+    }
+
+    void frame_tracer::reset()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto&& s : _stages)
+            s = { s.name, 0, 0., 0., {} };
+        _end_to_end = { _end_to_end.name, 0, 0., 0., {} };
+        _history.clear();
+        _next_record = 0;
+    }
+
+    uint16_t frame_tracer::register_stage(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = 0; i < _stages.size(); ++i)
+            if (_stages[i].name == name)
+                return uint16_t(i);
+        _stages.push_back({ name, 0, 0., 0., {} });
+        return uint16_t(_stages.size() - 1);
+    }
+
+    void frame_tracer::begin(frame_interface* f)
+    {
+        if (auto composite = dynamic_cast<composite_frame*>(f))
+        {
+            for (size_t i = 0; i < composite->get_embedded_frames_count(); ++i)
+                begin(composite->get_frame(int(i)));
+            return;
+        }
+        if (auto fr = dynamic_cast<frame*>(f))
+            fr->additional_data.trace.pending = _clock.get_time();
+    }
+
+    void frame_tracer::end(frame_interface* f, uint16_t stage)
+    {
+        if (auto composite = dynamic_cast<composite_frame*>(f))
+        {
+            for (size_t i = 0; i < composite->get_embedded_frames_count(); ++i)
+                end(composite->get_frame(int(i)), stage);
+            return;
+        }
+        auto fr = dynamic_cast<frame*>(f);
+        if (!fr)
+            return;
+
+        auto& data = fr->additional_data;
+        auto& trace = data.trace;
+        auto now = _clock.get_time();
+        // Without a start, the stage began when the previous one ended, or when the frame
+        // reached the backend for the first one (software frames have no backend time)
+        auto start = trace.pending;
+        if (!start && trace.count)
+            start = trace.points[trace.count - 1].end;
+        if (!start)
+            start = data.backend_timestamp ? data.backend_timestamp : (data.system_time ? data.system_time : now);
+        trace.pending = 0;
+
+        if (trace.count < frame_trace::max_points)
+            trace.points[trace.count++] = { start, now, stage };
+    }
+
+    void frame_tracer::add(stage_stats& stats, double ms)
+    {
+        stats.count++;
+        stats.total_ms += ms;
+        stats.max_ms = std::max(stats.max_ms, ms);
+
+        auto us = static_cast<unsigned long long>(std::max(ms, 0.) * 1000.);
+        int bucket = 0;
+        while (us >>= 1)
+            bucket++;
+        stats.buckets[std::min(bucket, buckets_count - 1)]++;
+    }
+
+    void frame_tracer::complete(const frame_interface* f, const frame_trace& trace)
+    {
+        if (!trace.count || trace.forwarded)
+            return;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (int i = 0; i < trace.count; ++i)
+        {
+            auto& p = trace.points[i];
+            if (p.stage < _stages.size())
+                add(_stages[p.stage], p.end - p.start);
+        }
+        add(_end_to_end, trace.points[trace.count - 1].end - trace.points[0].start);
+
+        auto sp = f->get_stream();
+        record r{ trace, sp ? sp->get_stream_type() : RS2_STREAM_ANY, sp ? sp->get_stream_index() : 0, f->get_frame_number() };
+        if (_history.size() < history_size)
+            _history.push_back(r);
+        else
+            _history[_next_record] = r;
+        _next_record = (_next_record + 1) % history_size;
+    }
+
+    void frame_tracer::export_chrome_trace(const std::string& file_path)
+    {
+        std::ofstream out(file_path);
+        if (!out)
+            throw invalid_value_exception(to_string() << "Failed to open " << file_path);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        // One row per stream
+        std::map<std::pair<rs2_stream, int>, int> rows;
+        bool first = true;
+        for (auto&& r : _history)
+        {
+            auto key = std::make_pair(r.stream, r.index);
+            if (rows.count(key))
+                continue;
+            auto row = int(rows.size());
+            rows[key] = row;
+            out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << row
+                << ",\"args\":{\"name\":\"" << get_string(r.stream) << " " << r.index << "\"}}";
+            first = false;
+        }
+
+        for (auto&& r : _history)
+        {
+            auto row = rows[std::make_pair(r.stream, r.index)];
+            for (int i = 0; i < r.trace.count; ++i)
+            {
+                auto& p = r.trace.points[i];
+                out << (first ? "" : ",") << "\n{\"name\":";
+                write_json_string(out, p.stage < _stages.size() ? _stages[p.stage].name : std::string("Unknown"));
+                out << ",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" << row
+                    << ",\"ts\":" << p.start * 1000. << ",\"dur\":" << (p.end - p.start) * 1000.
+                    << ",\"args\":{\"frame\":" << r.frame_number << "}}";
+                first = false;
+            }
+        }
+        out << "\n]}\n";
+    }
+
+    void frame_tracer::write_stats(std::ostream& out, const stage_stats& stats)
+    {
+        out << "{\"name\":";
+        write_json_string(out, stats.name);
+        out << ",\"count\":" << stats.count
+            << ",\"mean_ms\":" << (stats.count ? stats.total_ms / stats.count : 0.)
+            << ",\"max_ms\":" << stats.max_ms << ",\"buckets\":[";
+        for (int i = 0; i < buckets_count; ++i)
+            out << (i ? "," : "") << stats.buckets[i];
+        out << "]}";
+    }
+
+    void frame_tracer::export_histograms(const std::string& file_path)
+    {
+        std::ofstream out(file_path);
+        if (!out)
+            throw invalid_value_exception(to_string() << "Failed to open " << file_path);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        out << std::fixed << std::setprecision(3);
+        out << "{\"bucket_bounds_us\":[";
+        for (int i = 0; i < buckets_count; ++i)
+            out << (i ? "," : "") << (1ull << (i + 1));
+        out << "],\n\"stages\":[";
+        bool first = true;
+        for (auto&& s : _stages)
+        {
+            if (!s.count)
+                continue;
+            out << (first ? "\n" : ",\n");
+            write_stats(out, s);
+            first = false;
+        }
+        out << "],\n\"end_to_end\":";
+        write_stats(out, _end_to_end);
+        out << "\n}\n";
+    }
+}
@@ -0,0 +1,120 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "types.h"
+
+#include <array>
+#include <atomic>
+
+namespace librealsense
+{
+    class frame_interface;
+
+    /*
+        Where a frame spent its time inside the library. Every point is a stage the frame went through
+        (backend to sensor output, a processing block, a frame queue) with the times it entered and left it.
+        The record is part of the frame header, so tracing a frame never allocates.
+        A frame is stamped by the thread that holds it; frames shared by several threads may lose points.
+    */
+    struct frame_trace
+    {
+        static const int max_points = 16;
+
+        struct point
+        {
+            rs2_time_t start;
+            rs2_time_t end;
+            uint16_t stage;
+        };
+
+        std::array<point, max_points> points;
+        uint8_t count = 0;
+        bool forwarded = false;     // A frame made from this one carries the record on
+        rs2_time_t pending = 0;     // When the frame entered the stage it is in, if known
+
+        // Record for a frame made from this one, which is then left out of the statistics
+        frame_trace forward()
+        {
+            auto res = *this;
+            res.forwarded = false;
+            forwarded = true;
+            return res;
+        }
+    };
+
+    // Collects the records of released frames into per-stage histograms and keeps the latest ones
+    // for export as Chrome trace events (chrome://tracing, Perfetto)
+    class frame_tracer
+    {
+    public:
+        static frame_tracer& get_instance();
+
+        static bool is_enabled() { return _enabled.load(std::memory_order_relaxed); }
+        void enable(bool on);
+        void reset();
+
+        // Stages with the same name share their statistics (replicas of a block, sensors)
+        uint16_t register_stage(const std::string& name);
+
+        void begin(frame_interface* f);
+        void end(frame_interface* f, uint16_t stage);
+        void complete(const frame_interface* f, const frame_trace& trace);
+
+        void export_chrome_trace(const std::string& file_path);
+        void export_histograms(const std::string& file_path);
+
+    private:
+        frame_tracer();
+
+        // Bucket i counts the stages that took less than 2^(i+1) microseconds, and at least 2^i for i > 0
+        static const int buckets_count = 24;
+        // Latest records kept for the Chrome trace
+        static const size_t history_size = 2048;
+
+        struct stage_stats
+        {
+            std::string name;
+            unsigned long long count;
+            double total_ms;
+            double max_ms;
+            std::array<unsigned long long, buckets_count> buckets;
+        };
+
+        struct record
+        {
+            frame_trace trace;
+            rs2_stream stream;
+            int index;
+            unsigned long long frame_number;
+        };
+
+        static void add(stage_stats& stats, double ms);
+        static void write_stats(std::ostream& out, const stage_stats& stats);
+
+        static std::atomic<bool> _enabled;
+        // The clock of the backend timestamps, also available without a context (software devices)
+        platform::os_time_service _clock;
+
+        std::mutex _mutex;
+        std::vector<stage_stats> _stages;   // Indexed by stage
+        stage_stats _end_to_end;
+        std::vector<record> _history;
+        size_t _next_record;
+    };
+
+    // Marks the frame (or each frame of a frameset) as entering a stage
+    inline void trace_frame_begin(frame_interface* f)
+    {
+        if (frame_tracer::is_enabled() && f)
+            frame_tracer::get_instance().begin(f);
+    }
+
+    // Adds the stage the frame (or each frame of a frameset) just left to its record
+    inline void trace_frame_end(frame_interface* f, uint16_t stage)
+    {
+        if (frame_tracer::is_enabled() && f)
+            frame_tracer::get_instance().end(f, stage);
+    }
+}
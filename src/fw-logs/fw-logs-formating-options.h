@@ -39,6 +39,7 @@ namespace librealsense
             bool get_file_name(int id, std::string* file_name) const;
             bool get_thread_name(uint32_t thread_id, std::string* thread_name) const;
             std::unordered_map<std::string, std::vector<kvp>> get_enums() const;
+            const std::unordered_map<int, fw_log_event>& get_events() const { return _fw_logs_event_list; }
             bool initialize_from_xml();
 
         private:
@@ -4,7 +4,9 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include "fw-logs-formating-options.h"
+#include "fw-string-formatter.h"
 #include "fw-log-data.h"
 
 namespace librealsense
@@ -17,13 +19,26 @@ namespace librealsense
             explicit fw_logs_parser(std::string xml_content);
             ~fw_logs_parser(void);
 
+            // The compiled formats point into _formatter, so a copy would refer to the original's enums
+            fw_logs_parser(const fw_logs_parser&) = delete;
+            fw_logs_parser& operator=(const fw_logs_parser&) = delete;
+
             fw_log_data parse_fw_log(const fw_logs_binary_data* fw_log_msg);
 
+            // Parses into 'log_data', reusing the storage of its strings
+            bool parse_fw_log(const fw_logs_binary_data* fw_log_msg, fw_log_data* log_data);
+
+            // Parses 'count' messages at once; returns the number of messages parsed
+            size_t parse_fw_logs(const fw_logs_binary_data* const* fw_log_msgs, fw_log_data* const* log_data, size_t count);
 
         private:
-            fw_log_data fill_log_data(const fw_logs_binary_data* fw_log_msg);
+            void fill_log_data(const fw_logs_binary_data* fw_log_msg, fw_log_data* log_data);
+            const fw_string_formatter::compiled_format& get_format(int event_id);
 
             fw_logs_formating_options _fw_logs_formating_options;
+            fw_string_formatter _formatter;
+            // Every event's format string, compiled once
+            std::unordered_map<int, fw_string_formatter::compiled_format> _formats;
             uint64_t _last_timestamp;
             const double _timestamp_factor;
         };
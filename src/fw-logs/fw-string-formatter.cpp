@@ -2,9 +2,8 @@
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 #include "fw-string-formatter.h"
 #include "fw-logs-formating-options.h"
-#include <regex>
+#include <algorithm>
 #include <sstream>
-#include <iomanip>
 #include <iostream>
 
 using namespace std;
@@ -23,116 +22,140 @@ namespace librealsense
         {
         }
 
-        bool fw_string_formatter::generate_message(const string& source, size_t num_of_params, const uint32_t* params, string* dest)
+        fw_string_formatter::compiled_format fw_string_formatter::compile(const string& source, size_t num_of_params) const
         {
-            map<string, string> exp_replace_map;
-            map<string, int> enum_replace_map;
-
-            if (params == nullptr && num_of_params > 0) return false;
+            compiled_format res;
+            res._num_of_params = num_of_params;
+            res._text = source;
 
-            for (size_t i = 0; i < num_of_params; i++)
+            auto add_literal = [&res](size_t offset, size_t length)
             {
-                string regular_exp[4];
-                string replacement[4];
-                stringstream st_regular_exp[4];
-                stringstream st_replacement[4];
-
-                st_regular_exp[0] << "\\{\\b(" << i << ")\\}";
-                regular_exp[0] = st_regular_exp[0].str();
-
-                st_replacement[0] << params[i];
-                replacement[0] = st_replacement[0].str();
-
-                exp_replace_map[regular_exp[0]] = replacement[0];
-
-
-                st_regular_exp[1] << "\\{\\b(" << i << "):x\\}";
-                regular_exp[1] = st_regular_exp[1].str();
-
-                st_replacement[1] << hex << setw(2) << setfill('0') << params[i];
-                replacement[1] = st_replacement[1].str();
-
-                exp_replace_map[regular_exp[1]] = replacement[1];
-
-                st_regular_exp[2] << "\\{\\b(" << i << "):f\\}";
-                regular_exp[2] = st_regular_exp[2].str();
-                st_replacement[2] << params[i];
-                replacement[2] = st_replacement[2].str();
-                exp_replace_map[regular_exp[2]] = replacement[2];
-
-
-                st_regular_exp[3] << "\\{\\b(" << i << "),[a-zA-Z]+\\}";
-                regular_exp[3] = st_regular_exp[3].str();
+                if (!length)
+                    return;
+                auto& tokens = res._tokens;
+                if (!tokens.empty() && tokens.back().type == compiled_format::literal &&
+                    tokens.back().offset + tokens.back().length == offset)
+                    tokens.back().length += length;
+                else
+                    tokens.push_back({ compiled_format::literal, 0, offset, length, nullptr });
+            };
+
+            size_t pos = 0;
+            while (pos < source.size())
+            {
+                auto open = source.find('{', pos);
+                if (open == string::npos)
+                    break;
+                add_literal(pos, open - pos);
+
+                // The parameter index, without leading zeros
+                size_t end = open + 1;
+                while (end < source.size() && isdigit(static_cast<unsigned char>(source[end])))
+                    ++end;
+                auto digits = source.substr(open + 1, end - open - 1);
+                bool valid_index = !digits.empty() && digits.size() < 10 && (digits == "0" || digits[0] != '0');
+                size_t param = valid_index ? stoul(digits) : 0;
+                valid_index = valid_index && param < num_of_params;
+
+                compiled_format::token slot{ compiled_format::decimal, param, 0, 0, nullptr };
+                size_t close = string::npos;
+                if (valid_index && end < source.size())
+                {
+                    if (source[end] == '}')
+                        close = end;
+                    else if (source.compare(end, 3, ":x}") == 0)
+                        slot.type = compiled_format::hex, close = end + 2;
+                    else if (source.compare(end, 3, ":f}") == 0)
+                        close = end + 2;
+                    else if (source[end] == ',')
+                    {
+                        auto name_end = end + 1;
+                        while (name_end < source.size() && isalpha(static_cast<unsigned char>(source[name_end])))
+                            ++name_end;
+                        auto name = source.substr(end + 1, name_end - end - 1);
+                        auto it = _enums.find(name);
+                        if (!name.empty() && name_end < source.size() && source[name_end] == '}' && it != _enums.end())
+                        {
+                            slot.type = compiled_format::enumeration;
+                            slot.values = &it->second;
+                            close = name_end;
+                        }
+                    }
+                }
 
-                enum_replace_map[regular_exp[3]] = params[i];
+                if (close == string::npos)
+                {
+                    // Not a slot: the brace is text
+                    add_literal(open, 1);
+                    pos = open + 1;
+                    continue;
+                }
+                res._tokens.push_back(slot);
+                pos = close + 1;
             }
-
-            return replace_params(source, exp_replace_map, enum_replace_map, dest);
+            add_literal(pos, source.size() - pos);
+            return res;
         }
 
-        bool fw_string_formatter::replace_params(const string& source, const map<string, string>& exp_replace_map, const map<string, int>& enum_replace_map, string* dest)
+        static void append_number(string* dest, uint32_t value, bool hex)
         {
-            string source_temp(source);
-
-            for (auto exp_replace_it = exp_replace_map.begin(); exp_replace_it != exp_replace_map.end(); exp_replace_it++)
-            {
-                string destTemp;
-                regex e(exp_replace_it->first);
-                auto res = regex_replace(back_inserter(destTemp), source_temp.begin(), source_temp.end(), e, exp_replace_it->second);
-                source_temp = destTemp;
-            }
-
-            for (auto exp_replace_it = enum_replace_map.begin(); exp_replace_it != enum_replace_map.end(); exp_replace_it++)
+            char buf[16];
+            auto end = buf + sizeof(buf);
+            auto p = end;
+            const uint32_t base = hex ? 16 : 10;
+            do
             {
-                string destTemp;
-                regex e(exp_replace_it->first);
-                std::smatch m;
-                std::regex_search(source_temp, m, std::regex(e));
-
-                string enum_name;
+                *--p = "0123456789abcdef"[value % base];
+                value /= base;
+            } while (value);
+            if (hex && end - p < 2)
+                *--p = '0';
+            dest->append(p, end);
+        }
 
-                string st_regular_exp = "[a-zA-Z]+";
-                regex e1(st_regular_exp);
+        bool fw_string_formatter::format(const compiled_format& format, const uint32_t* params, string* dest) const
+        {
+            if (params == nullptr && format._num_of_params > 0) return false;
 
-                for (size_t exp = 0; exp < m.size(); exp++)
+            dest->clear();
+            for (auto&& t : format._tokens)
+            {
+                switch (t.type)
                 {
-                    string str = m[exp];
-
-                    std::smatch m1;
-
-                    regex e2 = e1;
-                    std::regex_search(str, m1, std::regex(e2));
-
-                    for (size_t exp = 0; exp < m1.size(); exp++)
+                case compiled_format::literal:
+                    dest->append(format._text, t.offset, t.length);
+                    break;
+                case compiled_format::decimal:
+                case compiled_format::hex:
+                    append_number(dest, params[t.param], t.type == compiled_format::hex);
+                    break;
+                case compiled_format::enumeration:
+                {
+                    // Verify user's input is within the enumerated range
+                    int val = params[t.param];
+                    auto& vec = *t.values;
+                    auto it = std::find_if(vec.begin(), vec.end(), [val](const kvp& entry) { return entry.first == val; });
+                    if (it == vec.end())
                     {
-                        enum_name = m1[exp];
-                        if (_enums.size() > 0 && _enums.find(enum_name) != _enums.end())
-                        {
-                            auto vec = _enums[enum_name];
-                            regex e3 = e;
-                            // Verify user's input is within the enumerated range
-                            int val = exp_replace_it->second;
-                            auto it = std::find_if(vec.begin(), vec.end(), [val](kvp& entry) { return entry.first == val; });
-                            if (it != vec.end())
-                            {
-                                regex_replace(back_inserter(destTemp), source_temp.begin(), source_temp.end(), e3, it->second);
-                            }
-                            else
-                            {
-                                stringstream s;
-                                s << "Protocol Error recognized!\nImproper log message received: " << source_temp
-                                    << ", invalid parameter: " << exp_replace_it->second << ".\n The range of supported values is \n";
-                                for_each(vec.begin(), vec.end(), [&s](kvp& entry) { s << entry.first << ":" << entry.second << " ,"; });
-                                std::cout << s.str().c_str() << std::endl;;
-                            }
-                            source_temp = destTemp;
-                        }
+                        stringstream s;
+                        s << "Protocol Error recognized!\nImproper log message received: " << format._text
+                            << ", invalid parameter: " << val << ".\n The range of supported values is \n";
+                        for_each(vec.begin(), vec.end(), [&s](const kvp& entry) { s << entry.first << ":" << entry.second << " ,"; });
+                        std::cout << s.str().c_str() << std::endl;
+                        dest->clear();
+                        return true;
                     }
+                    dest->append(it->second);
+                    break;
+                }
                 }
             }
-
-            *dest = source_temp;
             return true;
         }
+
+        bool fw_string_formatter::generate_message(const string& source, size_t num_of_params, const uint32_t* params, string* dest)
+        {
+            return format(compile(source, num_of_params), params, dest);
+        }
     }
 }
@@ -14,14 +14,43 @@ namespace librealsense
         class fw_string_formatter
         {
         public:
+            // A format string broken down once into literal text and argument slots.
+            // {N} and {N:f} print parameter N in decimal, {N:x} in hex (at least 2 digits) and
+            // {N,EnumName} the name of its value in the XML enum. Slots of parameters past the
+            // event's parameter count, or of unknown enums, are kept as literal text.
+            class compiled_format
+            {
+            public:
+                size_t num_of_params() const { return _num_of_params; }
+
+            private:
+                friend class fw_string_formatter;
+
+                enum token_type { literal, decimal, hex, enumeration };
+                struct token
+                {
+                    token_type type;
+                    size_t param;                                       // decimal, hex, enumeration
+                    size_t offset, length;                              // literal: range of _text
+                    const std::vector<std::pair<int, std::string>>* values;  // enumeration
+                };
+
+                std::string _text;
+                std::vector<token> _tokens;
+                size_t _num_of_params = 0;
+            };
+
             fw_string_formatter(std::unordered_map<std::string, std::vector<std::pair<int, std::string>>> enums);
             ~fw_string_formatter(void);
 
+            compiled_format compile(const std::string& source, size_t num_of_params) const;
+
+            // Formats into 'dest', reusing its storage
+            bool format(const compiled_format& format, const uint32_t* params, std::string* dest) const;
+
             bool generate_message(const std::string& source, size_t num_of_params, const uint32_t* params, std::string* dest);
 
         private:
-            bool replace_params(const std::string& source, const std::map<std::string, std::string>& exp_replace_map, const std::map<std::string, int>& enum_replace_map, std::string* dest);
-
             std::unordered_map<std::string, std::vector<std::pair<int, std::string>>> _enums;
         };
     }
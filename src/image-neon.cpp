@@ -0,0 +1,167 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "image-neon.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+
+namespace librealsense
+{
+    // One of R, G or B of 8 pixels: clamp((298 * c + KD * d + KE * e + 128) >> 8), computed in 32 bits
+    // like the generic code. The shifted sums always fit in 16 bits, so narrowing them is exact.
+    template<int KD, int KE> static inline uint8x8_t yuv_to_channel(int16x8_t c, int16x8_t d, int16x8_t e)
+    {
+        int32x4_t lo = vmlal_n_s16(vdupq_n_s32(128), vget_low_s16(c), 298);
+        int32x4_t hi = vmlal_n_s16(vdupq_n_s32(128), vget_high_s16(c), 298);
+        if (KD)
+        {
+            lo = vmlal_n_s16(lo, vget_low_s16(d), KD);
+            hi = vmlal_n_s16(hi, vget_high_s16(d), KD);
+        }
+        if (KE)
+        {
+            lo = vmlal_n_s16(lo, vget_low_s16(e), KE);
+            hi = vmlal_n_s16(hi, vget_high_s16(e), KE);
+        }
+        return vqmovun_s16(vcombine_s16(vshrn_n_s32(lo, 8), vshrn_n_s32(hi, 8)));
+    }
+
+    static inline int16x8_t minus(uint8x8_t v, int16_t offset)
+    {
+        return vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(offset));
+    }
+
+    // The even and odd pixels of a channel, back in pixel order
+    static inline uint8x16_t interleave(uint8x8_t even, uint8x8_t odd)
+    {
+        uint8x8x2_t zipped = vzip_u8(even, odd);
+        return vcombine_u8(zipped.val[0], zipped.val[1]);
+    }
+
+    // Unpacks YUY2 (Y0 U Y1 V) or UYVY (U Y0 V Y1) into Y8/Y16/RGB8/RGBA8/BGR8/BGRA8, 16 pixels at a time
+    template<bool UYVY, rs2_format FORMAT> static void unpack_yuv422(byte * const d[], const byte * s, int n)
+    {
+        auto src = reinterpret_cast<const uint8_t *>(s);
+        auto dst = reinterpret_cast<uint8_t *>(d[0]);
+
+#pragma omp parallel for
+        for (int i = 0; i < n / 16; i++)
+        {
+            // Deinterleave into the 8 even pixels, the 8 odd pixels and their 8 shared U and V
+            uint8x8x4_t px = vld4_u8(src + i * 32);
+            uint8x8_t y_even = px.val[UYVY ? 1 : 0];
+            uint8x8_t u = px.val[UYVY ? 0 : 1];
+            uint8x8_t y_odd = px.val[UYVY ? 3 : 2];
+            uint8x8_t v = px.val[UYVY ? 2 : 3];
+
+            if (FORMAT == RS2_FORMAT_Y8)
+            {
+                uint8x8x2_t y = { { y_even, y_odd } };
+                vst2_u8(dst + i * 16, y);
+                continue;
+            }
+
+            if (FORMAT == RS2_FORMAT_Y16)
+            {
+                // Y16 is little-endian.  We output Y << 8.
+                uint8x16x2_t y = { { vdupq_n_u8(0), interleave(y_even, y_odd) } };
+                vst2q_u8(dst + i * 32, y);
+                continue;
+            }
+
+            int16x8_t c_even = minus(y_even, 16);
+            int16x8_t c_odd = minus(y_odd, 16);
+            int16x8_t dd = minus(u, 128);
+            int16x8_t ee = minus(v, 128);
+
+            uint8x16_t r = interleave(yuv_to_channel<0, 409>(c_even, dd, ee), yuv_to_channel<0, 409>(c_odd, dd, ee));
+            uint8x16_t g = interleave(yuv_to_channel<-100, -208>(c_even, dd, ee), yuv_to_channel<-100, -208>(c_odd, dd, ee));
+            uint8x16_t b = interleave(yuv_to_channel<516, 0>(c_even, dd, ee), yuv_to_channel<516, 0>(c_odd, dd, ee));
+
+            if (FORMAT == RS2_FORMAT_RGB8)
+            {
+                uint8x16x3_t out = { { r, g, b } };
+                vst3q_u8(dst + i * 48, out);
+            }
+            if (FORMAT == RS2_FORMAT_BGR8)
+            {
+                uint8x16x3_t out = { { b, g, r } };
+                vst3q_u8(dst + i * 48, out);
+            }
+            if (FORMAT == RS2_FORMAT_RGBA8)
+            {
+                uint8x16x4_t out = { { r, g, b, vdupq_n_u8(255) } };
+                vst4q_u8(dst + i * 64, out);
+            }
+            if (FORMAT == RS2_FORMAT_BGRA8)
+            {
+                uint8x16x4_t out = { { b, g, r, vdupq_n_u8(255) } };
+                vst4q_u8(dst + i * 64, out);
+            }
+        }
+    }
+
+    void unpack_yuy2_neon_y8(byte * const d[], const byte * s, int n) { unpack_yuv422<false, RS2_FORMAT_Y8>(d, s, n); }
+    void unpack_yuy2_neon_y16(byte * const d[], const byte * s, int n) { unpack_yuv422<false, RS2_FORMAT_Y16>(d, s, n); }
+    void unpack_yuy2_neon_rgb8(byte * const d[], const byte * s, int n) { unpack_yuv422<false, RS2_FORMAT_RGB8>(d, s, n); }
+    void unpack_yuy2_neon_rgba8(byte * const d[], const byte * s, int n) { unpack_yuv422<false, RS2_FORMAT_RGBA8>(d, s, n); }
+    void unpack_yuy2_neon_bgr8(byte * const d[], const byte * s, int n) { unpack_yuv422<false, RS2_FORMAT_BGR8>(d, s, n); }
+    void unpack_yuy2_neon_bgra8(byte * const d[], const byte * s, int n) { unpack_yuv422<false, RS2_FORMAT_BGRA8>(d, s, n); }
+
+    void unpack_uyvy_neon_rgb8(byte * const d[], const byte * s, int n) { unpack_yuv422<true, RS2_FORMAT_RGB8>(d, s, n); }
+    void unpack_uyvy_neon_rgba8(byte * const d[], const byte * s, int n) { unpack_yuv422<true, RS2_FORMAT_RGBA8>(d, s, n); }
+    void unpack_uyvy_neon_bgr8(byte * const d[], const byte * s, int n) { unpack_yuv422<true, RS2_FORMAT_BGR8>(d, s, n); }
+    void unpack_uyvy_neon_bgra8(byte * const d[], const byte * s, int n) { unpack_yuv422<true, RS2_FORMAT_BGRA8>(d, s, n); }
+
+    int split_y8i_neon(byte * const dest[], const byte * source, int count)
+    {
+        auto left = reinterpret_cast<uint8_t *>(dest[0]);
+        auto right = reinterpret_cast<uint8_t *>(dest[1]);
+        const int blocks = count / 16;
+
+#pragma omp parallel for
+        for (int i = 0; i < blocks; i++)
+        {
+            uint8x16x2_t lr = vld2q_u8(source + i * 32);
+            vst1q_u8(left + i * 16, lr.val[0]);
+            vst1q_u8(right + i * 16, lr.val[1]);
+        }
+        return blocks * 16;
+    }
+
+    // 10-bit values in 12-bit containers, scaled to 16 bits as (v << 6 | v >> 4)
+    static inline uint16x8_t y10_to_y16(uint16x8_t v)
+    {
+        return vorrq_u16(vshlq_n_u16(v, 6), vshrq_n_u16(v, 4));
+    }
+
+    // 8 pixels of 3 bytes: right's low 8 bits, right's high 4 bits | left's low 4 bits << 4, left's high 8 bits
+    static inline void split_y12i_8(uint8x8_t b0, uint8x8_t b1, uint8x8_t b2, uint16_t * left, uint16_t * right)
+    {
+        uint16x8_t l = vorrq_u16(vshll_n_u8(b2, 4), vmovl_u8(vshr_n_u8(b1, 4)));
+        uint16x8_t r = vorrq_u16(vshll_n_u8(vand_u8(b1, vdup_n_u8(0x0f)), 8), vmovl_u8(b0));
+        vst1q_u16(left, y10_to_y16(l));
+        vst1q_u16(right, y10_to_y16(r));
+    }
+
+    int split_y12i_10_neon(byte * const dest[], const byte * source, int count)
+    {
+        auto left = reinterpret_cast<uint16_t *>(dest[0]);
+        auto right = reinterpret_cast<uint16_t *>(dest[1]);
+        const int blocks = count / 16;
+
+#pragma omp parallel for
+        for (int i = 0; i < blocks; i++)
+        {
+            uint8x16x3_t px = vld3q_u8(source + i * 48);
+            split_y12i_8(vget_low_u8(px.val[0]), vget_low_u8(px.val[1]), vget_low_u8(px.val[2]),
+                left + i * 16, right + i * 16);
+            split_y12i_8(vget_high_u8(px.val[0]), vget_high_u8(px.val[1]), vget_high_u8(px.val[2]),
+                left + i * 16 + 8, right + i * 16 + 8);
+        }
+        return blocks * 16;
+    }
+}
+
+#endif
@@ -0,0 +1,33 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifndef LIBREALSENSE_IMAGE_NEON_H
+#define LIBREALSENSE_IMAGE_NEON_H
+
+#include "types.h"
+
+namespace librealsense
+{
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    // Bit-exact with the generic (scalar) unpackers. The YUY2/UYVY ones expect n % 16 == 0, like
+    // their callers; the splitters convert whole blocks of 16 pixels and return how many pixels
+    // they did, leaving the rest to the scalar code.
+    void unpack_yuy2_neon_y8(byte * const d[], const byte * s, int n);
+    void unpack_yuy2_neon_y16(byte * const d[], const byte * s, int n);
+    void unpack_yuy2_neon_rgb8(byte * const d[], const byte * s, int n);
+    void unpack_yuy2_neon_rgba8(byte * const d[], const byte * s, int n);
+    void unpack_yuy2_neon_bgr8(byte * const d[], const byte * s, int n);
+    void unpack_yuy2_neon_bgra8(byte * const d[], const byte * s, int n);
+
+    void unpack_uyvy_neon_rgb8(byte * const d[], const byte * s, int n);
+    void unpack_uyvy_neon_rgba8(byte * const d[], const byte * s, int n);
+    void unpack_uyvy_neon_bgr8(byte * const d[], const byte * s, int n);
+    void unpack_uyvy_neon_bgra8(byte * const d[], const byte * s, int n);
+
+    int split_y8i_neon(byte * const dest[], const byte * source, int count);
+    int split_y12i_10_neon(byte * const dest[], const byte * source, int count);
+#endif
+}
+
+#endif
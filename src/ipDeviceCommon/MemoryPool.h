@@ -3,96 +3,213 @@
 
 #pragma once
 
-#include <ipDeviceCommon/RsCommon.h>
+#include "RsCommon.h"
 
-#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <map>
 #include <mutex>
-#include <queue>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
 
 #include "NetdevLog.h"
 
-#define POOL_SIZE 100
+// Bytes of returned buffers kept for reuse, over all sizes, before further ones are freed
+#define POOL_MAX_BYTES (512 * 1024 * 1024)
 
+/*
+    Frame buffers of the network device and rs-server, reused from frame to frame instead of allocated for each.
+    Buffers are kept in size classes (the requested size rounded up to whole pages), so the streams of a profile
+    share buffers with one another but not with smaller streams. The size class of a buffer is recorded in front
+    of the memory handed out, so a buffer can be returned to any pool.
+    Buffers of 2MB and more are aligned to 2MB and advised as huge pages, to cut page faults and TLB misses on
+    multi-megabyte frames.
+*/
 class MemoryPool
 {
-
 public:
-    MemoryPool()
+    struct Metrics
     {
-        // //alloc memory
-        // std::unique_lock<std::mutex> lk(m_mutex);
-        // for(int i = 0; i < POOL_SIZE; i++)
-        // {
-        //     unsigned char *mem = new unsigned char[sizeof(RsFrameHeader) + MAX_FRAME_SIZE]; //TODO:to use OutPacketBuffer::maxSize;
-        //     m_pool.push(mem);
-        // }
-        // lk.unlock();
-    }
+        unsigned long long allocations; // Buffers taken from the heap
+        unsigned long long reuses;      // Buffers taken from the pool
+        unsigned long long releases;    // Returned buffers freed since the pool was full
+        size_t pooledBytes;
+        long long outstanding;          // Buffers handed out and not returned yet (less those of other pools returned here)
+    };
+
+    explicit MemoryPool(size_t t_maxPooledBytes = POOL_MAX_BYTES)
+        : m_maxPooledBytes(t_maxPooledBytes)
+        , m_metrics()
+    {}
 
-    MemoryPool(const MemoryPool& obj)
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    // Returns a buffer of at least t_size bytes, by default the size of the largest frame
+    unsigned char* getNextMem(size_t t_size = sizeof(RsFrameHeader) + MAX_FRAME_SIZE)
     {
-        m_pool = obj.m_pool;
+        size_t sizeClass = getSizeClass(t_size);
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_metrics.outstanding++;
+            auto it = m_pool.find(sizeClass);
+            if(it != m_pool.end() && !it->second.empty())
+            {
+                unsigned char* mem = it->second.back();
+                it->second.pop_back();
+                m_metrics.pooledBytes -= sizeClass;
+                m_metrics.reuses++;
+                return mem;
+            }
+            m_metrics.allocations++;
+        }
+
+        unsigned char* mem = allocate(sizeClass);
+        if(mem == nullptr)
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_metrics.outstanding--;
+            ERR << "getNextMem: failed to allocate " << sizeClass << " bytes";
+        }
+        return mem;
     }
 
-    MemoryPool& operator=(const MemoryPool&& obj)
+    // Fills the pool with buffers for a stream before it starts, so its first frames neither allocate nor fault pages in
+    void reserve(size_t t_size, int t_count)
     {
-        m_pool = obj.m_pool;
-        return *this;
+        size_t sizeClass = getSizeClass(t_size);
+        std::vector<unsigned char*> reserved;
+        for(int i = 0; i < t_count; i++)
+        {
+            unsigned char* mem = allocate(sizeClass);
+            if(mem == nullptr)
+            {
+                break;
+            }
+            memset(mem, 0, sizeClass);
+            reserved.push_back(mem);
+        }
+
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_metrics.allocations += reserved.size();
+        m_metrics.outstanding += reserved.size();
+        for(auto mem : reserved)
+        {
+            putBack(mem, sizeClass);
+        }
     }
 
-    unsigned char* getNextMem()
+    void returnMem(unsigned char* t_mem)
     {
-        // unsigned char* mem = nullptr;
-        // std::unique_lock<std::mutex> lk(m_mutex);
-        // if(!m_pool.empty())
-        // {
-        //     mem = m_pool.front();
-        //     m_pool.pop();
-        // }
-        // else
-        // {
-        //     ERR << "getNextMem: pool is empty";
-        // }
-        // lk.unlock();
-        // return mem;
-        return new unsigned char[sizeof(RsFrameHeader) + MAX_FRAME_SIZE]; 
+        if(t_mem == nullptr)
+        {
+            ERR << "returnMem: invalid address";
+            return;
+        }
+
+        size_t sizeClass = getHeader(t_mem)->sizeClass;
+        std::lock_guard<std::mutex> lk(m_mutex);
+        putBack(t_mem, sizeClass);
     }
 
-    void returnMem(unsigned char* t_mem)
+    Metrics getMetrics()
     {
-        // if(t_mem != nullptr)
-        // {
-        //     std::unique_lock<std::mutex> lk(m_mutex);
-        //     m_pool.push(t_mem);
-        //     lk.unlock();
-        // }
-        // else
-        // {
-        //     ERR << "returnMem: invalid address";
-        // }
-        delete[] t_mem;
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_metrics;
     }
 
     ~MemoryPool()
     {
-        // std::unique_lock<std::mutex> lk(m_mutex);
-        // while(!m_pool.empty())
-        // {
-        //     unsigned char* mem = m_pool.front();
-        //     m_pool.pop();
-        //     if(mem != nullptr)
-        //     {
-        //         delete mem;
-        //     }
-        //     else
-        //     {
-        //         ERR << "~memory_pool: invalid address";
-        //     }
-        // }
-        // lk.unlock();
+        std::lock_guard<std::mutex> lk(m_mutex);
+        for(auto& sizeClass : m_pool)
+        {
+            for(auto mem : sizeClass.second)
+            {
+                release(mem);
+            }
+        }
+        m_pool.clear();
     }
 
 private:
-    std::queue<unsigned char*> m_pool;
+    // Kept in front of every buffer; its size keeps the frame data 16 bytes aligned
+    union BlockHeader
+    {
+        size_t sizeClass;
+        char alignment[64];
+    };
+
+    static const size_t PAGE_SIZE_BYTES = 4096;
+    static const size_t HUGE_PAGE_SIZE_BYTES = 2 * 1024 * 1024;
+
+    static size_t getSizeClass(size_t t_size)
+    {
+        return (t_size + PAGE_SIZE_BYTES - 1) / PAGE_SIZE_BYTES * PAGE_SIZE_BYTES;
+    }
+
+    static BlockHeader* getHeader(unsigned char* t_mem)
+    {
+        return reinterpret_cast<BlockHeader*>(t_mem - sizeof(BlockHeader));
+    }
+
+    static unsigned char* allocate(size_t t_sizeClass)
+    {
+        size_t blockSize = sizeof(BlockHeader) + t_sizeClass;
+        size_t alignment = blockSize >= HUGE_PAGE_SIZE_BYTES ? HUGE_PAGE_SIZE_BYTES : PAGE_SIZE_BYTES;
+        void* block = nullptr;
+#ifdef _WIN32
+        block = _aligned_malloc(blockSize, alignment);
+#else
+        if(posix_memalign(&block, alignment, blockSize) != 0)
+        {
+            block = nullptr;
+        }
+#ifdef MADV_HUGEPAGE
+        if(block != nullptr && alignment == HUGE_PAGE_SIZE_BYTES)
+        {
+            madvise(block, blockSize / HUGE_PAGE_SIZE_BYTES * HUGE_PAGE_SIZE_BYTES, MADV_HUGEPAGE);
+        }
+#endif
+#endif
+        if(block == nullptr)
+        {
+            return nullptr;
+        }
+        BlockHeader* header = static_cast<BlockHeader*>(block);
+        header->sizeClass = t_sizeClass;
+        return reinterpret_cast<unsigned char*>(header + 1);
+    }
+
+    static void release(unsigned char* t_mem)
+    {
+#ifdef _WIN32
+        _aligned_free(getHeader(t_mem));
+#else
+        free(getHeader(t_mem));
+#endif
+    }
+
+    // Called with the mutex held
+    void putBack(unsigned char* t_mem, size_t t_sizeClass)
+    {
+        m_metrics.outstanding--;
+        if(m_metrics.pooledBytes + t_sizeClass > m_maxPooledBytes)
+        {
+            m_metrics.releases++;
+            release(t_mem);
+            return;
+        }
+        m_pool[t_sizeClass].push_back(t_mem);
+        m_metrics.pooledBytes += t_sizeClass;
+    }
+
+    size_t m_maxPooledBytes;
+    std::map<size_t, std::vector<unsigned char*>> m_pool;
+    Metrics m_metrics;
     std::mutex m_mutex;
 };
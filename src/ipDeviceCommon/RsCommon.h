@@ -8,11 +8,17 @@
 
 #pragma pack(push, 1)
 
+const int SHARED_MEMORY_NAME_SIZE = 64;
+
 union RsNetworkHeader { //IMPORTANT:: RsNetworkHeader should be alligned to 16 bytes, this enables frame data to start on 16 bit alligned address
     char maxHeaderSize[128];
     struct
     {
         uint32_t frameSize;
+        // Set when the frame was published to the shared memory ring of that name rather than sent after the header
+        uint32_t sharedMemorySlot;
+        uint64_t sharedMemorySequence;
+        char sharedMemoryName[SHARED_MEMORY_NAME_SIZE];
     } data;
 };
 
@@ -33,6 +39,22 @@ struct RsFrameHeader
     RsMetadataHeader metadataHeader;
 };
 
+// Leads every packet of the fragments payload path: the RTP header, then where the fragment lies in its message
+// (an RsFrameHeader followed by the frame data). All fields are in network byte order.
+struct RsFragmentPacketHeader
+{
+    uint8_t rtpFlags;       // Version 2, no padding, extension or CSRC
+    uint8_t rtpPayloadType; // With the marker bit on the last fragment of a message
+    uint16_t rtpSeqNo;
+    uint32_t rtpTimestamp;
+    uint32_t rtpSsrc;
+    uint32_t frameId;
+    uint32_t offset;        // Of the fragment in the message
+    uint32_t messageSize;
+    uint16_t fragmentSize;  // Of all the fragments of the message but the last
+    uint16_t reserved;
+};
+
 struct IpDeviceControlData
 {
     int sensorId;
@@ -52,6 +74,15 @@ const int MAX_FRAME_SIZE = MAX_WIDTH * MAX_HEIGHT * MAX_BPP;
 const int MAX_MESSAGE_SIZE = MAX_FRAME_SIZE + sizeof(RsFrameHeader);
 const unsigned int SDP_MAX_LINE_LENGHT = 4000;
 const unsigned int RTP_TIMESTAMP_FREQ = 90000;
+// Value of the "payload" SDP field of streams sent in fragments by the server itself, rather than by live555
+const std::string RS_PAYLOAD_FRAGMENTS("fragments");
+const unsigned int RS_DEFAULT_MTU = 1500;
+// RTSP header of the SETUP requests of clients that take the frames of the stream from shared memory
+const std::string RS_SHARED_MEMORY_HEADER("X-Rs-Transport: shared-memory");
+const unsigned int RS_SHARED_MEMORY_SLOTS = 8;
+// SET_PARAMETER of a session asking for a keyframe of the stream of the track it names, for clients whose decoder
+// lost the frames it predicts from
+const std::string RS_KEYFRAME_PARAMETER("keyframe");
 
 int getStreamProfileBpp(rs2_format t_format);
 
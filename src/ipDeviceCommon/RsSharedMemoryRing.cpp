@@ -0,0 +1,311 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "RsSharedMemoryRing.h"
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "NetdevLog.h"
+
+#define SHARED_MEMORY_MAGIC 0x52534d52 // "RSMR"
+#define SHARED_MEMORY_VERSION 1
+// Messages start on cache lines, so frames that follow a header of whole lines are aligned too
+#define SLOT_ALIGNMENT 64
+
+struct RsSharedMemoryRing::Slot
+{
+    std::atomic<uint32_t> references;
+    uint32_t size;
+    std::atomic<uint64_t> sequence; // Of the message in the slot, 0 while it is written
+};
+
+struct RsSharedMemoryRing::Header
+{
+    std::atomic<uint32_t> magic; // Set once the ring is ready
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint64_t dataOffset;
+    std::atomic<uint64_t> published;
+};
+
+namespace
+{
+    // Rings this process opened, to find the one of a message released by its address only
+    std::vector<std::shared_ptr<RsSharedMemoryRing>>& getOpenRings()
+    {
+        static std::vector<std::shared_ptr<RsSharedMemoryRing>> rings;
+        return rings;
+    }
+
+    std::mutex& getOpenRingsMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    size_t roundUp(size_t t_size, size_t t_alignment)
+    {
+        return (t_size + t_alignment - 1) / t_alignment * t_alignment;
+    }
+} // namespace
+
+RsSharedMemoryRing::RsSharedMemoryRing(const std::string& t_name, bool t_owner)
+    : m_name(t_name)
+    , m_owner(t_owner)
+    , m_header(nullptr)
+    , m_headerSize(0)
+    , m_data(nullptr)
+    , m_dataSize(0)
+    , m_held(0)
+{}
+
+RsSharedMemoryRing::Slot* RsSharedMemoryRing::getSlot(uint32_t t_index) const
+{
+    return (Slot*)(m_header + 1) + t_index;
+}
+
+bool RsSharedMemoryRing::contains(const unsigned char* t_message) const
+{
+    return t_message >= m_data && t_message < m_data + m_dataSize;
+}
+
+#ifdef _WIN32
+
+std::shared_ptr<RsSharedMemoryRing> RsSharedMemoryRing::create(const std::string&, unsigned, unsigned)
+{
+    return nullptr;
+}
+
+std::shared_ptr<RsSharedMemoryRing> RsSharedMemoryRing::open(const std::string&)
+{
+    return nullptr;
+}
+
+RsSharedMemoryRing::~RsSharedMemoryRing() {}
+
+#else
+
+std::shared_ptr<RsSharedMemoryRing> RsSharedMemoryRing::create(const std::string& t_name, unsigned t_slotCount, unsigned t_slotSize)
+{
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    t_slotSize = roundUp(t_slotSize, SLOT_ALIGNMENT);
+    size_t headerSize = roundUp(sizeof(Header) + t_slotCount * sizeof(Slot), pageSize);
+    size_t dataSize = (size_t)t_slotCount * t_slotSize;
+
+    // A ring left by a server that died under the same name is of no use to anyone
+    shm_unlink(t_name.c_str());
+    int fd = shm_open(t_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+    if(fd < 0)
+    {
+        ERR << "Cannot create shared memory " << t_name << ": " << strerror(errno);
+        return nullptr;
+    }
+    void* mem = MAP_FAILED;
+    if(ftruncate(fd, headerSize + dataSize) == 0)
+    {
+        mem = mmap(nullptr, headerSize + dataSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if(mem == MAP_FAILED)
+    {
+        ERR << "Cannot map shared memory " << t_name << ": " << strerror(errno);
+        shm_unlink(t_name.c_str());
+        return nullptr;
+    }
+
+    // The new pages are zeroed, which the slots and the counters start from
+    std::shared_ptr<RsSharedMemoryRing> ring(new RsSharedMemoryRing(t_name, true));
+    ring->m_header = (Header*)mem;
+    ring->m_headerSize = headerSize;
+    ring->m_data = (unsigned char*)mem + headerSize;
+    ring->m_dataSize = dataSize;
+    ring->m_header->version = SHARED_MEMORY_VERSION;
+    ring->m_header->slotCount = t_slotCount;
+    ring->m_header->slotSize = t_slotSize;
+    ring->m_header->dataOffset = headerSize;
+    ring->m_header->magic.store(SHARED_MEMORY_MAGIC);
+    return ring;
+}
+
+std::shared_ptr<RsSharedMemoryRing> RsSharedMemoryRing::open(const std::string& t_name)
+{
+    int fd = shm_open(t_name.c_str(), O_RDWR, 0);
+    if(fd < 0)
+    {
+        DBG << "Cannot open shared memory " << t_name << ": " << strerror(errno);
+        return nullptr;
+    }
+
+    std::shared_ptr<RsSharedMemoryRing> ring(new RsSharedMemoryRing(t_name, false));
+    struct stat status;
+    Header header;
+    bool valid = false;
+    if(fstat(fd, &status) == 0 && (size_t)status.st_size >= sizeof(Header))
+    {
+        void* mem = mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, fd, 0);
+        if(mem != MAP_FAILED)
+        {
+            Header* shared = (Header*)mem;
+            header.version = shared->version;
+            header.slotCount = shared->slotCount;
+            header.slotSize = shared->slotSize;
+            header.dataOffset = shared->dataOffset;
+            valid = shared->magic.load() == SHARED_MEMORY_MAGIC && header.version == SHARED_MEMORY_VERSION &&
+                    header.dataOffset >= sizeof(Header) + header.slotCount * sizeof(Slot) &&
+                    (size_t)status.st_size == header.dataOffset + (size_t)header.slotCount * header.slotSize;
+            munmap(mem, sizeof(Header));
+        }
+    }
+    if(valid)
+    {
+        // The slot table is written by every reader, the messages by the writer only
+        void* control = mmap(nullptr, header.dataOffset, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        void* data = mmap(nullptr, status.st_size - header.dataOffset, PROT_READ, MAP_SHARED, fd, header.dataOffset);
+        if(control != MAP_FAILED)
+        {
+            ring->m_header = (Header*)control;
+            ring->m_headerSize = header.dataOffset;
+        }
+        if(data != MAP_FAILED)
+        {
+            ring->m_data = (unsigned char*)data;
+            ring->m_dataSize = status.st_size - header.dataOffset;
+        }
+        valid = control != MAP_FAILED && data != MAP_FAILED;
+    }
+    close(fd);
+    if(!valid)
+    {
+        ERR << "Cannot map shared memory " << t_name;
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lk(getOpenRingsMutex());
+    auto& rings = getOpenRings();
+    // Unmap the rings of former sessions, once their messages are all released
+    for(auto it = rings.begin(); it != rings.end();)
+    {
+        it = (*it)->m_held == 0 && it->use_count() == 1 ? rings.erase(it) : it + 1;
+    }
+    rings.push_back(ring);
+    return ring;
+}
+
+RsSharedMemoryRing::~RsSharedMemoryRing()
+{
+    if(m_owner)
+    {
+        // The writer maps the ring at once. Readers keep their mappings until they are done with them.
+        munmap(m_header, m_headerSize + m_dataSize);
+        shm_unlink(m_name.c_str());
+        return;
+    }
+    if(m_header != nullptr)
+    {
+        munmap(m_header, m_headerSize);
+    }
+    if(m_data != nullptr)
+    {
+        munmap(m_data, m_dataSize);
+    }
+}
+
+#endif
+
+bool RsSharedMemoryRing::publish(const void* t_header, unsigned t_headerSize, const void* t_data, unsigned t_dataSize, uint32_t& t_slot, uint64_t& t_sequence)
+{
+    if(m_header == nullptr || !m_owner || t_headerSize + t_dataSize > m_header->slotSize)
+    {
+        return false;
+    }
+
+    uint64_t sequence = m_header->published.load() + 1;
+    for(uint32_t i = 0; i < m_header->slotCount; i++)
+    {
+        uint32_t index = (sequence + i) % m_header->slotCount;
+        Slot* slot = getSlot(index);
+        if(slot->references.load() != 0)
+        {
+            continue;
+        }
+        // Mark the slot as written before looking at its references again: a reader that took one meanwhile
+        // either is seen here, or sees the mark and lets go
+        uint64_t previous = slot->sequence.exchange(0);
+        if(slot->references.load() != 0)
+        {
+            slot->sequence.store(previous);
+            continue;
+        }
+
+        unsigned char* message = m_data + (size_t)index * m_header->slotSize;
+        memcpy(message, t_header, t_headerSize);
+        memcpy(message + t_headerSize, t_data, t_dataSize);
+        slot->size = t_headerSize + t_dataSize;
+        slot->sequence.store(sequence);
+        m_header->published.store(sequence);
+
+        t_slot = index;
+        t_sequence = sequence;
+        return true;
+    }
+    return false;
+}
+
+const unsigned char* RsSharedMemoryRing::acquire(uint32_t t_slot, uint64_t t_sequence, unsigned& t_size)
+{
+    if(m_header == nullptr || t_slot >= m_header->slotCount || t_sequence == 0)
+    {
+        return nullptr;
+    }
+    Slot* slot = getSlot(t_slot);
+    slot->references.fetch_add(1);
+    if(slot->sequence.load() != t_sequence)
+    {
+        slot->references.fetch_sub(1);
+        return nullptr;
+    }
+    m_held++;
+    t_size = slot->size;
+    return m_data + (size_t)t_slot * m_header->slotSize;
+}
+
+void RsSharedMemoryRing::release(const unsigned char* t_message)
+{
+    if(m_header == nullptr || !contains(t_message))
+    {
+        return;
+    }
+    getSlot((uint32_t)((t_message - m_data) / m_header->slotSize))->references.fetch_sub(1);
+    m_held--;
+}
+
+bool RsSharedMemoryRing::releaseMessage(const unsigned char* t_message)
+{
+    std::lock_guard<std::mutex> lk(getOpenRingsMutex());
+    auto& rings = getOpenRings();
+    for(auto it = rings.begin(); it != rings.end(); ++it)
+    {
+        if((*it)->contains(t_message))
+        {
+            (*it)->release(t_message);
+            // Unmap rings no one uses any more
+            if((*it)->m_held == 0 && it->use_count() == 1)
+            {
+                rings.erase(it);
+            }
+            return true;
+        }
+    }
+    return false;
+}
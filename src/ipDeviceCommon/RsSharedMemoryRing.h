@@ -0,0 +1,60 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/*
+    A ring of frame messages in POSIX shared memory, which rs-server publishes for the clients running on the same
+    host instead of sending them the frames. Each slot holds one message and counts the references readers of all
+    processes take on it; the writer only overwrites slots no one holds, and a reader checks the slot still holds
+    the message it was told about once its reference is taken.
+    Readers map the slot table read-write, for their references, and the messages read-only.
+    A reader that dies holding messages keeps their slots until the writer destroys the ring, which rs-server does
+    when the session of the client ends.
+*/
+class RsSharedMemoryRing
+{
+public:
+    // Creates the ring t_name of t_slotCount messages of up to t_slotSize bytes. Its name is unlinked when the ring is destroyed.
+    static std::shared_ptr<RsSharedMemoryRing> create(const std::string& t_name, unsigned t_slotCount, unsigned t_slotSize);
+    // Maps the ring t_name that another process created
+    static std::shared_ptr<RsSharedMemoryRing> open(const std::string& t_name);
+    // Releases a message acquired from any ring this process opened. Returns false when t_message is in none of them.
+    static bool releaseMessage(const unsigned char* t_message);
+
+    ~RsSharedMemoryRing();
+
+    const std::string& name() const
+    {
+        return m_name;
+    }
+
+    // Copies the message made of t_header then t_data into a slot no reader holds, and tells which. Returns false
+    // when the message does not fit a slot or all the slots are held.
+    bool publish(const void* t_header, unsigned t_headerSize, const void* t_data, unsigned t_dataSize, uint32_t& t_slot, uint64_t& t_sequence);
+
+    // Takes a reference on message t_sequence of slot t_slot and returns it, or nullptr when the slot was written over
+    const unsigned char* acquire(uint32_t t_slot, uint64_t t_sequence, unsigned& t_size);
+    void release(const unsigned char* t_message);
+
+private:
+    struct Slot;
+    struct Header;
+
+    RsSharedMemoryRing(const std::string& t_name, bool t_owner);
+    Slot* getSlot(uint32_t t_index) const;
+    bool contains(const unsigned char* t_message) const;
+
+    std::string m_name;
+    bool m_owner;
+    Header* m_header;
+    size_t m_headerSize;
+    unsigned char* m_data;
+    size_t m_dataSize;
+    std::atomic<long> m_held; // Messages this process holds
+};
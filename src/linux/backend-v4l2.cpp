@@ -3,6 +3,7 @@
 
 #include "backend-v4l2.h"
 #include "backend-hid.h"
+#include "udev-device-watcher.h"
 #include "backend.h"
 #include "types.h"
 #include "usb/usb-enumerator.h"
@@ -25,6 +26,7 @@
 #include <thread>
 #include <atomic>
 #include <iomanip> // std::put_time
+#include <future>
 
 #include <dirent.h>
 #include <fcntl.h>
@@ -492,9 +494,123 @@ namespace librealsense
             }
         }
 
+        // Reads the identification of a /sys/class/video4linux entry and queries its capabilities.
+        // Returns false for nodes that are not USB video devices or lie outside 'sysfs_scope'.
+        static bool probe_uvc_node(const std::string& name, const std::string& sysfs_scope, uvc_device_info& info)
+        {
+            // Resolve a pathname to ignore virtual video devices
+            std::string path = "/sys/class/video4linux/" + name;
+            std::string real_path{};
+            char buff[PATH_MAX] = {0};
+            if (realpath(path.c_str(), buff) != nullptr)
+            {
+                real_path = std::string(buff);
+                if (real_path.find("virtual") != std::string::npos)
+                    return false;
+            }
+            if (!sysfs_scope.empty() && real_path.compare(0, sysfs_scope.size() + 1, sysfs_scope + "/") != 0)
+                return false;
+
+            try
+            {
+                uint16_t vid, pid, mi;
+                std::string busnum, devnum, devpath;
+
+                auto dev_name = "/dev/" + name;
+
+                struct stat st = {};
+                if(stat(dev_name.c_str(), &st) < 0)
+                {
+                    throw linux_backend_exception(to_string() << "Cannot identify '" << dev_name);
+                }
+                if(!S_ISCHR(st.st_mode))
+                    throw linux_backend_exception(dev_name + " is no device");
+
+                // Search directory and up to three parent directories to find busnum/devnum
+                std::ostringstream ss; ss << "/sys/dev/char/" << major(st.st_rdev) << ":" << minor(st.st_rdev) << "/device/";
+                auto path = ss.str();
+                auto valid_path = false;
+                for(auto i=0U; i < MAX_DEV_PARENT_DIR; ++i)
+                {
+                    if(std::ifstream(path + "busnum") >> busnum)
+                    {
+                        if(std::ifstream(path + "devnum") >> devnum)
+                        {
+                            if(std::ifstream(path + "devpath") >> devpath)
+                            {
+                                valid_path = true;
+                                break;
+                            }
+                        }
+                    }
+                    path += "../";
+                }
+                if(!valid_path)
+                {
+#ifndef RS2_USE_CUDA
+                   /* On the Jetson TX, the camera module is CSI & I2C and does not report as this code expects
+                   Patch suggested by JetsonHacks: https://github.com/jetsonhacks/buildLibrealsense2TX */
+                    LOG_INFO("Failed to read busnum/devnum. Device Path: " << path);
+#endif
+                    return false;
+                }
+
+                std::string modalias;
+                if(!(std::ifstream("/sys/class/video4linux/" + name + "/device/modalias") >> modalias))
+                    throw linux_backend_exception("Failed to read modalias");
+                if(modalias.size() < 14 || modalias.substr(0,5) != "usb:v" || modalias[9] != 'p')
+                    throw linux_backend_exception("Not a usb format modalias");
+                if(!(std::istringstream(modalias.substr(5,4)) >> std::hex >> vid))
+                    throw linux_backend_exception("Failed to read vendor ID");
+                if(!(std::istringstream(modalias.substr(10,4)) >> std::hex >> pid))
+                    throw linux_backend_exception("Failed to read product ID");
+                if(!(std::ifstream("/sys/class/video4linux/" + name + "/device/bInterfaceNumber") >> std::hex >> mi))
+                    throw linux_backend_exception("Failed to read interface number");
+
+                // Find the USB specification (USB2/3) type from the underlying device
+                // Use device mapping obtained in previous step to traverse node tree
+                // and extract the required descriptors
+                // Traverse from
+                // /sys/devices/pci0000:00/0000:00:xx.0/ABC/M-N/3-6:1.0/video4linux/video0
+                // to
+                // /sys/devices/pci0000:00/0000:00:xx.0/ABC/M-N/version
+                usb_spec usb_specification = get_usb_connection_type(real_path + "/../../../");
+
+                info = {};
+                info.pid = pid;
+                info.vid = vid;
+                info.mi = mi;
+                info.id = dev_name;
+                info.device_path = std::string(buff);
+                info.unique_id = busnum + "-" + devpath + "-" + devnum;
+                info.conn_spec = usb_specification;
+                info.uvc_capabilities = get_dev_capabilities(dev_name);
+
+                return true;
+            }
+            catch(const std::exception & e)
+            {
+                LOG_INFO("Not a USB video device: " << e.what());
+            }
+            return false;
+        }
+
+        std::string v4l_uvc_device::get_usb_device_sysfs_path(const std::string& node_path)
+        {
+            // /sys/devices/pci0000:00/0000:00:xx.0/ABC/M-N/3-6:1.0/video4linux/video0 -> /sys/devices/pci0000:00/0000:00:xx.0/ABC/M-N
+            auto pos = node_path.rfind("/video4linux/");
+            if (pos == std::string::npos)
+                return "";
+            auto interface_pos = node_path.rfind('/', pos - 1);
+            if (interface_pos == std::string::npos || interface_pos == 0)
+                return "";
+            return node_path.substr(0, interface_pos);
+        }
+
         void v4l_uvc_device::foreach_uvc_device(
                 std::function<void(const uvc_device_info&,
-                                   const std::string&)> action)
+                                   const std::string&)> action,
+                const std::string& sysfs_scope)
         {
             // Enumerate all subdevices present on the system
             DIR * dir = opendir("/sys/class/video4linux");
@@ -508,106 +624,35 @@ namespace librealsense
             typedef std::pair<uvc_device_info,std::string> node_info;
             std::vector<node_info> uvc_nodes,uvc_devices;
 
+            std::vector<std::string> names;
             while (dirent * entry = readdir(dir))
             {
                 std::string name = entry->d_name;
                 if(name == "." || name == "..") continue;
-
-                // Resolve a pathname to ignore virtual video devices
-                std::string path = "/sys/class/video4linux/" + name;
-                std::string real_path{};
-                char buff[PATH_MAX] = {0};
-                if (realpath(path.c_str(), buff) != nullptr)
-                {
-                    real_path = std::string(buff);
-                    if (real_path.find("virtual") != std::string::npos)
-                        continue;
-                }
-
-                try
-                {
-                    uint16_t vid, pid, mi;
-                    std::string busnum, devnum, devpath;
-
-                    auto dev_name = "/dev/" + name;
-
-                    struct stat st = {};
-                    if(stat(dev_name.c_str(), &st) < 0)
-                    {
-                        throw linux_backend_exception(to_string() << "Cannot identify '" << dev_name);
-                    }
-                    if(!S_ISCHR(st.st_mode))
-                        throw linux_backend_exception(dev_name + " is no device");
-
-                    // Search directory and up to three parent directories to find busnum/devnum
-                    std::ostringstream ss; ss << "/sys/dev/char/" << major(st.st_rdev) << ":" << minor(st.st_rdev) << "/device/";
-                    auto path = ss.str();
-                    auto valid_path = false;
-                    for(auto i=0U; i < MAX_DEV_PARENT_DIR; ++i)
-                    {
-                        if(std::ifstream(path + "busnum") >> busnum)
-                        {
-                            if(std::ifstream(path + "devnum") >> devnum)
-                            {
-                                if(std::ifstream(path + "devpath") >> devpath)
-                                {
-                                    valid_path = true;
-                                    break;
-                                }
-                            }
-                        }
-                        path += "../";
-                    }
-                    if(!valid_path)
-                    {
-#ifndef RS2_USE_CUDA
-                       /* On the Jetson TX, the camera module is CSI & I2C and does not report as this code expects
-                       Patch suggested by JetsonHacks: https://github.com/jetsonhacks/buildLibrealsense2TX */
-                        LOG_INFO("Failed to read busnum/devnum. Device Path: " << path);
-#endif
-                        continue;
-                    }
-
-                    std::string modalias;
-                    if(!(std::ifstream("/sys/class/video4linux/" + name + "/device/modalias") >> modalias))
-                        throw linux_backend_exception("Failed to read modalias");
-                    if(modalias.size() < 14 || modalias.substr(0,5) != "usb:v" || modalias[9] != 'p')
-                        throw linux_backend_exception("Not a usb format modalias");
-                    if(!(std::istringstream(modalias.substr(5,4)) >> std::hex >> vid))
-                        throw linux_backend_exception("Failed to read vendor ID");
-                    if(!(std::istringstream(modalias.substr(10,4)) >> std::hex >> pid))
-                        throw linux_backend_exception("Failed to read product ID");
-                    if(!(std::ifstream("/sys/class/video4linux/" + name + "/device/bInterfaceNumber") >> std::hex >> mi))
-                        throw linux_backend_exception("Failed to read interface number");
-
-                    // Find the USB specification (USB2/3) type from the underlying device
-                    // Use device mapping obtained in previous step to traverse node tree
-                    // and extract the required descriptors
-                    // Traverse from
-                    // /sys/devices/pci0000:00/0000:00:xx.0/ABC/M-N/3-6:1.0/video4linux/video0
-                    // to
-                    // /sys/devices/pci0000:00/0000:00:xx.0/ABC/M-N/version
-                    usb_spec usb_specification = get_usb_connection_type(real_path + "/../../../");
-
-                    uvc_device_info info{};
-                    info.pid = pid;
-                    info.vid = vid;
-                    info.mi = mi;
-                    info.id = dev_name;
-                    info.device_path = std::string(buff);
-                    info.unique_id = busnum + "-" + devpath + "-" + devnum;
-                    info.conn_spec = usb_specification;
-                    info.uvc_capabilities = get_dev_capabilities(dev_name);
-
-                    uvc_nodes.emplace_back(info, dev_name);
-                }
-                catch(const std::exception & e)
-                {
-                    LOG_INFO("Not a USB video device: " << e.what());
-                }
+                names.push_back(name);
             }
             closedir(dir);
 
+            // Probing opens every node and reads several sysfs files; the nodes are probed concurrently
+            // so that enumeration time does not grow with the number of connected cameras. A few probing
+            // threads take the nodes in turn, so a system with many video nodes does not get a thread per node.
+            const size_t max_probing_threads = 8;
+            std::vector<uvc_device_info> infos(names.size());
+            std::vector<char> found(names.size(), 0);
+            std::atomic<size_t> next_name(0);
+            std::vector<std::future<void>> probes;
+            for (size_t t = 0; t < std::min(names.size(), max_probing_threads); ++t)
+                probes.push_back(std::async(std::launch::async, [&]()
+                {
+                    for (size_t i = next_name++; i < names.size(); i = next_name++)
+                        found[i] = probe_uvc_node(names[i], sysfs_scope, infos[i]);
+                }));
+            for (auto&& p : probes)
+                p.get();
+            for (size_t i = 0; i < names.size(); ++i)
+                if (found[i])
+                    uvc_nodes.emplace_back(infos[i], infos[i].id);
+
             // Matching video and metadata nodes
             // UVC nodes shall be traversed in ascending order for metadata nodes assignment ("dev/video1, Video2..
             // Replace lexicographic with numeric sort to ensure "video2" is listed before "video11"
@@ -695,7 +740,7 @@ namespace librealsense
                     _device_path = i.device_path;
                     _device_usb_spec = i.conn_spec;
                 }
-            });
+            }, get_usb_device_sysfs_path(info.device_path));
             if (_name == "")
                 throw linux_backend_exception("device is no longer connected!");
 
@@ -1853,8 +1898,17 @@ namespace librealsense
             // Give the device a chance to restart, if we don't catch
             // it, the watcher will find it later.
             if(tm_boot(device_infos)) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(2000));
-                device_infos = usb_enumerator::query_devices_info();
+                // Enumeration returns as soon as every booted device is back with its new identity,
+                // rather than after the longest restart time
+                auto is_booting = [](const usb_device_info& i) { return i.vid == 0x03E7 && i.pid == 0x2150; };
+                auto expected = device_infos.size();
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(2000);
+                do
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    device_infos = usb_enumerator::query_devices_info();
+                } while ((device_infos.size() < expected || std::any_of(device_infos.begin(), device_infos.end(), is_booting))
+                         && std::chrono::steady_clock::now() < deadline);
             }
             return device_infos;
         }
@@ -1880,6 +1934,28 @@ namespace librealsense
 
         std::shared_ptr<device_watcher> v4l_backend::create_device_watcher() const
         {
+            hotplug_enumerator enumerator;
+            enumerator.query_uvc_devices = [](const std::string& sysfs_scope)
+            {
+                std::vector<uvc_device_info> uvc_nodes;
+                v4l_uvc_device::foreach_uvc_device(
+                [&uvc_nodes](const uvc_device_info& i, const std::string&)
+                {
+                    uvc_nodes.push_back(i);
+                }, sysfs_scope);
+                return uvc_nodes;
+            };
+            enumerator.query_usb_devices = [this]() { return query_usb_devices(); };
+            enumerator.query_hid_devices = [this]() { return query_hid_devices(); };
+
+            try
+            {
+                return std::make_shared<udev_device_watcher>(enumerator, std::make_shared<netlink_event_source>());
+            }
+            catch (const std::exception& e)
+            {
+                LOG_WARNING("Hot-plug notifications unavailable, polling for devices instead: " << e.what());
+            }
             return std::make_shared<polling_device_watcher>(this);
         }
 
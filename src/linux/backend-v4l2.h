@@ -255,9 +255,14 @@ namespace librealsense
         class v4l_uvc_device : public uvc_device, public v4l_uvc_interface
         {
         public:
+            // 'sysfs_scope' restricts the enumeration to the nodes of one USB device, e.g. /sys/devices/.../usb2/2-1
             static void foreach_uvc_device(
                     std::function<void(const uvc_device_info&,
-                                       const std::string&)> action);
+                                       const std::string&)> action,
+                    const std::string& sysfs_scope = "");
+
+            // The sysfs path of the USB device a video node (as in uvc_device_info::device_path) belongs to
+            static std::string get_usb_device_sysfs_path(const std::string& node_path);
 
             v4l_uvc_device(const uvc_device_info& info, bool use_memory_map = false);
 
@@ -0,0 +1,282 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "udev-device-watcher.h"
+#include "backend-v4l2.h"
+
+#include <future>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace librealsense
+{
+    namespace platform
+    {
+        // Netlink multicast groups of NETLINK_KOBJECT_UEVENT
+        enum uevent_group
+        {
+            UEVENT_GROUP_KERNEL = 1,
+            UEVENT_GROUP_UDEV = 2,
+        };
+
+        // Header udev prepends to the events it re-broadcasts (see libudev-monitor.c)
+        struct udev_netlink_header
+        {
+            char prefix[8];             // "libudev"
+            uint32_t magic;             // htonl(0xfeedcafe)
+            uint32_t header_size;
+            uint32_t properties_off;
+            uint32_t properties_len;
+        };
+
+        static const uint32_t udev_monitor_magic = 0xfeedcafe;
+
+        netlink_event_source::netlink_event_source()
+        {
+            // udev re-broadcasts the kernel events after its rules ran; listening to the kernel directly
+            // would report nodes before udev set their permissions
+            _from_udev = access("/run/udev/control", F_OK) == 0;
+
+            _fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+            if (_fd < 0)
+                throw linux_backend_exception("netlink socket creation failed");
+
+            sockaddr_nl addr = {};
+            addr.nl_family = AF_NETLINK;
+            addr.nl_groups = _from_udev ? UEVENT_GROUP_UDEV : UEVENT_GROUP_KERNEL;
+            if (bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+            {
+                close(_fd);
+                throw linux_backend_exception("netlink bind failed");
+            }
+
+            int on = 1;
+            if (setsockopt(_fd, SOL_SOCKET, SO_PASSCRED, &on, sizeof(on)) < 0)
+            {
+                close(_fd);
+                throw linux_backend_exception("netlink SO_PASSCRED failed");
+            }
+        }
+
+        netlink_event_source::~netlink_event_source()
+        {
+            if (_fd >= 0)
+                close(_fd);
+        }
+
+        bool netlink_event_source::read(hotplug_event& event, std::chrono::milliseconds timeout)
+        {
+            pollfd fds = { _fd, POLLIN, 0 };
+            auto res = poll(&fds, 1, static_cast<int>(timeout.count()));
+            if (res < 0 && errno != EINTR)
+                throw linux_backend_exception("netlink poll failed");
+            if (res <= 0)
+                return false;
+
+            char buf[8192];
+            char cred_buf[CMSG_SPACE(sizeof(ucred))];
+            iovec iov = { buf, sizeof(buf) - 1 };
+            sockaddr_nl sender = {};
+            msghdr msg = {};
+            msg.msg_name = &sender;
+            msg.msg_namelen = sizeof(sender);
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = cred_buf;
+            msg.msg_controllen = sizeof(cred_buf);
+
+            auto len = recvmsg(_fd, &msg, 0);
+            if (len <= 0)
+                return false;
+            buf[len] = 0;
+
+            // Only trust messages sent by root, and only kernel messages on the kernel group
+            auto cmsg = CMSG_FIRSTHDR(&msg);
+            if (!cmsg || cmsg->cmsg_type != SCM_CREDENTIALS)
+                return false;
+            auto cred = reinterpret_cast<ucred*>(CMSG_DATA(cmsg));
+            if (cred->uid != 0)
+                return false;
+            if (!_from_udev && sender.nl_pid != 0)
+                return false;
+
+            size_t offset = 0;
+            if (_from_udev)
+            {
+                udev_netlink_header header;
+                if (size_t(len) < sizeof(header))
+                    return false;
+                memcpy(&header, buf, sizeof(header));
+                if (strcmp(header.prefix, "libudev") != 0 || ntohl(header.magic) != udev_monitor_magic)
+                    return false;
+                if (header.properties_off + header.properties_len > size_t(len))
+                    return false;
+                offset = header.properties_off;
+            }
+            else
+            {
+                // "action@devpath" precedes the properties
+                auto head = strnlen(buf, len);
+                if (!memchr(buf, '@', head))
+                    return false;
+                offset = head + 1;
+            }
+
+            event = {};
+            while (offset < size_t(len))
+            {
+                const char* key = buf + offset;
+                auto key_len = strnlen(key, len - offset);
+                std::string property(key, key_len);
+                offset += key_len + 1;
+
+                auto eq = property.find('=');
+                if (eq == std::string::npos)
+                    continue;
+                auto name = property.substr(0, eq);
+                auto value = property.substr(eq + 1);
+                if (name == "ACTION") event.action = value;
+                else if (name == "DEVPATH") event.devpath = value;
+                else if (name == "SUBSYSTEM") event.subsystem = value;
+                else if (name == "DEVTYPE") event.devtype = value;
+            }
+            return !event.action.empty() && !event.devpath.empty();
+        }
+
+        static std::string parent_path(const std::string& path)
+        {
+            auto pos = path.rfind('/');
+            return pos == std::string::npos ? "" : path.substr(0, pos);
+        }
+
+        udev_device_watcher::udev_device_watcher(hotplug_enumerator enumerator,
+                                                 std::shared_ptr<hotplug_event_source> source,
+                                                 std::chrono::milliseconds settle_time)
+            : _enumerator(std::move(enumerator)), _source(std::move(source)), _settle_time(settle_time),
+              _active_object([this](dispatcher::cancellable_timer cancellable_timer)
+            {
+                watch(cancellable_timer);
+            })
+        {
+            // The three subsystems are independent; enumerating them side by side shortens startup
+            auto uvc = std::async(std::launch::async, _enumerator.query_uvc_devices, std::string());
+            auto hid = std::async(std::launch::async, _enumerator.query_hid_devices);
+            _devices_data.usb_devices = _enumerator.query_usb_devices();
+            _devices_data.uvc_devices = uvc.get();
+            _devices_data.hid_devices = hid.get();
+        }
+
+        udev_device_watcher::~udev_device_watcher()
+        {
+            stop();
+        }
+
+        void udev_device_watcher::start(device_changed_callback callback)
+        {
+            stop();
+            _callback = std::move(callback);
+            _active_object.start();
+        }
+
+        void udev_device_watcher::stop()
+        {
+            _active_object.stop();
+
+            _callback_inflight.wait_until_empty();
+        }
+
+        void udev_device_watcher::collect(const hotplug_event& event)
+        {
+            // Map the event to the sysfs path of the USB device it belongs to
+            std::string usb_device;
+            if (event.subsystem == "usb" && event.devtype == "usb_device")
+                usb_device = "/sys" + event.devpath;
+            else if (event.subsystem == "usb" && event.devtype == "usb_interface")
+                usb_device = parent_path("/sys" + event.devpath);
+            else if (event.subsystem == "video4linux")
+                usb_device = v4l_uvc_device::get_usb_device_sysfs_path("/sys" + event.devpath);
+            else if (event.subsystem != "hidraw" && event.subsystem != "iio" && event.subsystem != "hid")
+                return;
+
+            if (!usb_device.empty())
+                _touched.insert(usb_device);
+            _changed = true;
+        }
+
+        backend_device_group udev_device_watcher::apply_changes(const backend_device_group& prev)
+        {
+            // Re-probe the video nodes of the USB devices touched by the burst only; a device that went
+            // away simply yields no nodes. USB and HID enumeration read sysfs attributes only and are
+            // queried as a whole, alongside.
+            auto usb = std::async(std::launch::async, _enumerator.query_usb_devices);
+            auto hid = std::async(std::launch::async, _enumerator.query_hid_devices);
+
+            std::vector<std::future<std::vector<uvc_device_info>>> scoped;
+            for (auto&& path : _touched)
+                scoped.push_back(std::async(std::launch::async, _enumerator.query_uvc_devices, path));
+
+            backend_device_group curr;
+            for (auto&& uvc : prev.uvc_devices)
+            {
+                auto touched = std::any_of(_touched.begin(), _touched.end(), [&](const std::string& path)
+                {
+                    return uvc.device_path.compare(0, path.size() + 1, path + "/") == 0;
+                });
+                if (!touched)
+                    curr.uvc_devices.push_back(uvc);
+            }
+            for (auto&& f : scoped)
+            {
+                auto nodes = f.get();
+                curr.uvc_devices.insert(curr.uvc_devices.end(), nodes.begin(), nodes.end());
+            }
+            curr.usb_devices = usb.get();
+            curr.hid_devices = hid.get();
+            return curr;
+        }
+
+        void udev_device_watcher::watch(dispatcher::cancellable_timer cancellable_timer)
+        {
+            // Wake up regularly so that stop() is not held back by an idle socket
+            hotplug_event event;
+            auto timeout = _changed ? _settle_time : std::chrono::milliseconds(100);
+            if (_source->read(event, timeout))
+            {
+                collect(event);
+                return;
+            }
+            if (!_changed)
+                return;
+
+            platform::backend_device_group curr;
+            try
+            {
+                curr = apply_changes(_devices_data);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_WARNING("Device enumeration after hot-plug event failed: " << e.what());
+                return;
+            }
+            _touched.clear();
+            _changed = false;
+
+            if (list_changed(_devices_data.uvc_devices, curr.uvc_devices) ||
+                list_changed(_devices_data.usb_devices, curr.usb_devices) ||
+                list_changed(_devices_data.hid_devices, curr.hid_devices))
+            {
+                callback_invocation_holder callback = { _callback_inflight.allocate(), &_callback_inflight };
+                if (callback)
+                {
+                    _callback(_devices_data, curr);
+                    _devices_data = curr;
+                }
+            }
+        }
+    }
+}
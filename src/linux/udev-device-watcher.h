@@ -0,0 +1,94 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../backend.h"
+#include "../types.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace librealsense
+{
+    namespace platform
+    {
+        // A change of the kernel device tree, as broadcast over netlink
+        struct hotplug_event
+        {
+            std::string action;     // add, remove, change, bind, ...
+            std::string devpath;    // relative to /sys, e.g. /devices/pci0000:00/0000:00:14.0/usb2/2-1
+            std::string subsystem;  // usb, video4linux, hidraw, iio, ...
+            std::string devtype;    // usb_device, usb_interface, ...
+        };
+
+        class hotplug_event_source
+        {
+        public:
+            // Returns false if no event arrived within the timeout
+            virtual bool read(hotplug_event& event, std::chrono::milliseconds timeout) = 0;
+            virtual ~hotplug_event_source() = default;
+        };
+
+        // Listens to the events udev re-broadcasts once its rules ran, i.e. once device nodes exist and
+        // have their permissions. Hosts without a udev daemon get the raw kernel events instead.
+        class netlink_event_source : public hotplug_event_source
+        {
+        public:
+            netlink_event_source();
+            ~netlink_event_source();
+
+            bool read(hotplug_event& event, std::chrono::milliseconds timeout) override;
+
+        private:
+            int _fd = -1;
+            bool _from_udev = false;
+        };
+
+        // The queries the watcher runs after an event. The UVC query takes the sysfs path of the USB device
+        // that changed, or an empty string for all devices.
+        struct hotplug_enumerator
+        {
+            std::function<std::vector<uvc_device_info>(const std::string& sysfs_scope)> query_uvc_devices;
+            std::function<std::vector<usb_device_info>()> query_usb_devices;
+            std::function<std::vector<hid_device_info>()> query_hid_devices;
+        };
+
+        // Reports device changes as hot-plug events arrive instead of re-enumerating periodically.
+        // A plug or unplug produces a burst of events (the USB device, its interfaces, their video and HID
+        // nodes); the watcher waits for 'settle_time' without events before acting on a burst. Video nodes
+        // are only re-enumerated below the USB devices the burst touched.
+        class udev_device_watcher : public device_watcher
+        {
+        public:
+            udev_device_watcher(hotplug_enumerator enumerator, std::shared_ptr<hotplug_event_source> source,
+                                std::chrono::milliseconds settle_time = std::chrono::milliseconds(100));
+            ~udev_device_watcher();
+
+            void start(device_changed_callback callback) override;
+            void stop() override;
+
+        private:
+            void watch(dispatcher::cancellable_timer cancellable_timer);
+            void collect(const hotplug_event& event);
+            backend_device_group apply_changes(const backend_device_group& prev);
+
+            hotplug_enumerator _enumerator;
+            std::shared_ptr<hotplug_event_source> _source;
+            std::chrono::milliseconds _settle_time;
+
+            // Sysfs paths of the USB devices touched by the current burst of events
+            std::set<std::string> _touched;
+            bool _changed = false;
+
+            active_object<> _active_object;
+            callbacks_heap _callback_inflight;
+            backend_device_group _devices_data;
+            device_changed_callback _callback;
+        };
+    }
+}
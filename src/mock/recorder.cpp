@@ -36,7 +36,14 @@ const char* DEVICE_INFO_INSERT = "INSERT INTO rs_device_info(section, type, id,
 
 const char* BLOBS_CREATE = "CREATE TABLE rs_blobs(section NUMBER, data BLOB)";
 const char* BLOBS_INSERT = "INSERT INTO rs_blobs(section, data) VALUES(?, ?)";
-const char* BLOBS_SELECT_ALL = "SELECT * FROM rs_blobs WHERE section = ?";
+const char* BLOBS_SELECT_ROWS = "SELECT rowid FROM rs_blobs WHERE section = ? ORDER BY rowid";
+const char* BLOBS_SELECT_BY_ROW = "SELECT data FROM rs_blobs WHERE rowid = ?";
+
+const char* CALLS_INDEX_CREATE = "CREATE INDEX IF NOT EXISTS rs_calls_section ON rs_calls(section)";
+const char* BLOBS_INDEX_CREATE = "CREATE INDEX IF NOT EXISTS rs_blobs_section ON rs_blobs(section)";
+
+// Blob pages are read through a memory map of the file rather than copied into the page cache
+const char* PLAYBACK_MMAP_PRAGMA = "PRAGMA mmap_size = 1073741824";
 
 const char* PROFILES_CREATE = "CREATE TABLE rs_profile(section NUMBER, width NUMBER, height NUMBER, fps NUMBER, fourcc NUMBER)";
 const char* PROFILES_INSERT = "INSERT INTO rs_profile(section, width, height, fps, fourcc) VALUES(?, ? ,? ,? ,?)";
@@ -150,6 +157,8 @@ namespace librealsense
         {
         }
 
+        recording::~recording() = default;
+
         void recording::invoke_device_changed_event()
         {
             call* next;
@@ -182,6 +191,8 @@ namespace librealsense
                 c.execute(BLOBS_CREATE);
                 c.execute(PROFILES_CREATE);
             }
+            c.execute(CALLS_INDEX_CREATE);
+            c.execute(BLOBS_INDEX_CREATE);
 
             auto section_id = 0;
 
@@ -391,7 +402,9 @@ namespace librealsense
 
             auto result = make_shared<recording>(nullptr, watcher);
 
-            connection c(filename);
+            result->_db.reset(new connection(filename));
+            auto&& c = *result->_db;
+            c.execute(PLAYBACK_MMAP_PRAGMA);
 
             if (!c.table_exists(CONFIG_TABLE))
             {
@@ -521,17 +534,57 @@ namespace librealsense
                 result->stream_profiles.push_back(p);
             }
 
-            statement select_blobs(c, BLOBS_SELECT_ALL);
+            // Only the rows of the blobs are loaded, frames are read as playback reaches them
+            statement select_blobs(c, BLOBS_SELECT_ROWS);
             select_blobs.bind(1, section_id);
 
             for (auto&& row : select_blobs)
             {
-                result->blobs.push_back(row[1].get_blob());
+                result->_blob_rows.push_back(row[0].get_int64());
             }
+            result->_select_blob.reset(new statement(c, BLOBS_SELECT_BY_ROW));
+            result->index_calls();
 
             return result;
         }
 
+        vector<uint8_t> recording::load_blob(int id) const
+        {
+            if (!_db)
+                return blobs[id];
+
+            lock_guard<mutex> lock(_blob_mutex);
+            for (auto&& cached : _blob_cache)
+            {
+                if (cached.first == id)
+                    return cached.second;
+            }
+
+            if (id < 0 || id >= static_cast<int>(_blob_rows.size()))
+                throw runtime_error(to_string() << "The recording is missing blob " << id << "!");
+
+            _select_blob->reset();
+            _select_blob->bind(1, _blob_rows[id]);
+            auto data = (*_select_blob)()[0].get_blob();
+
+            if (_blob_cache.size() < blob_cache_size)
+                _blob_cache.emplace_back(id, data);
+            else
+                _blob_cache[_next_cached_blob] = { id, data };
+            _next_cached_blob = (_next_cached_blob + 1) % blob_cache_size;
+            return data;
+        }
+
+        void recording::index_calls()
+        {
+            for (; _indexed_calls < calls.size(); ++_indexed_calls)
+            {
+                auto&& cl = calls[_indexed_calls];
+                _calls_by_key[call_key(cl.type, cl.entity_id)].push_back(_indexed_calls);
+                _calls_by_entity[cl.entity_id].push_back(_indexed_calls);
+            }
+        }
+
         int recording::save_blob(const void* ptr, size_t size)
         {
             lock_guard<recursive_mutex> lock(_mutex);
@@ -551,33 +604,35 @@ namespace librealsense
         call& recording::find_call(call_type t, int entity_id, std::function<bool(const call& c)> history_match_validation)
         {
             lock_guard<recursive_mutex> lock(_mutex);
+            index_calls();
 
-
-            for (size_t i = 1; i <= calls.size(); i++)
+            // The first call of this type and entity after the cursor, wrapping around to the start
+            auto it = _calls_by_key.find(call_key(t, entity_id));
+            if (it != _calls_by_key.end())
             {
-                const auto idx = (_cursors[entity_id] + i) % static_cast<int>(calls.size());
-                if (calls[idx].type == t && calls[idx].entity_id == entity_id)
+                auto&& matches = it->second;
+                auto next_match = std::upper_bound(matches.begin(), matches.end(), _cursors[entity_id]);
+                const auto idx = next_match != matches.end() ? *next_match : matches.front();
+
+                if (calls[idx].had_error)
                 {
-                    if (calls[idx].had_error)
-                    {
-                        throw runtime_error(calls[idx].inline_string);
-                    }
-                    _curr_time = calls[idx].timestamp;
+                    throw runtime_error(calls[idx].inline_string);
+                }
+                _curr_time = calls[idx].timestamp;
 
-                    if (!history_match_validation(calls[idx]))
-                    {
-                        throw playback_backend_exception("Recording history mismatch!", t, entity_id);
-                    }
+                if (!history_match_validation(calls[idx]))
+                {
+                    throw playback_backend_exception("Recording history mismatch!", t, entity_id);
+                }
 
-                    _cursors[entity_id] = _cycles[entity_id] = idx;
+                _cursors[entity_id] = _cycles[entity_id] = idx;
 
-                    auto next = pick_next_call();
-                    if (next && t != call_type::device_watcher_event && next->type == call_type::device_watcher_event)
-                    {
-                        invoke_device_changed_event();
-                    }
-                    return calls[idx];
+                auto next = pick_next_call();
+                if (next && t != call_type::device_watcher_event && next->type == call_type::device_watcher_event)
+                {
+                    invoke_device_changed_event();
                 }
+                return calls[idx];
             }
             throw runtime_error("The recording is missing the part you are trying to playback!");
         }
@@ -599,28 +654,21 @@ namespace librealsense
                 invoke_device_changed_event();
             }
 
-            for (size_t i = 1; i <= calls.size(); i++)
-            {
-                const auto idx = (_cycles[id] + i);
-                 if (idx >= calls.size())
-                 {
-                     _cycles[id] = _cursors[id];
-                     return nullptr;
-                 }
+            index_calls();
 
-                if (calls[idx].type == t && calls[idx].entity_id == id)
-                {
-                    _cycles[id] = idx;
-                    _curr_time = calls[idx].timestamp;
-                    return &calls[idx];
-                }
-                if (calls[idx].type != t && calls[idx].entity_id == id)
-                {
-                    _cycles[id] = _cursors[id];
-                    return nullptr;
-                }
+            // The frames of an entity are cycled until its next call of another type
+            auto&& entity_calls = _calls_by_entity[id];
+            auto next_call = std::upper_bound(entity_calls.begin(), entity_calls.end(), _cycles[id]);
+            if (next_call == entity_calls.end() || calls[*next_call].type != t)
+            {
+                _cycles[id] = _cursors[id];
+                return nullptr;
             }
-            return nullptr;
+
+            const auto idx = *next_call;
+            _cycles[id] = idx;
+            _curr_time = calls[idx].timestamp;
+            return &calls[idx];
         }
 
         void record_device_watcher::start(device_changed_callback callback)
@@ -12,6 +12,13 @@
 #include <chrono>
 #include <atomic>
 #include <map>
+#include <unordered_map>
+
+namespace sql
+{
+    class connection;
+    class statement;
+}
 
 namespace librealsense
 {
@@ -110,6 +117,7 @@ namespace librealsense
         {
         public:
             recording(std::shared_ptr<time_service> ts = nullptr, std::shared_ptr<playback_device_watcher> watcher = nullptr);
+            ~recording();
 
             double get_time();
             void save(const char* filename, const char* section, bool append = false) const;
@@ -288,10 +296,8 @@ namespace librealsense
                 return load_list(hid_sensors, c);
             }
 
-            std::vector<uint8_t> load_blob(int id) const
-            {
-                return blobs[id];
-            }
+            // Blobs of a loaded recording stay in the file and are read on demand
+            std::vector<uint8_t> load_blob(int id) const;
 
             call& find_call(call_type t, int entity_id, std::function<bool(const call& c)> history_match_validation = [](const call& c) {return true; });
             call* cycle_calls(call_type call_type, int id);
@@ -312,8 +318,32 @@ namespace librealsense
             std::recursive_mutex _mutex;
             std::shared_ptr<time_service> _ts;
 
-            std::map<size_t, size_t> _cursors;
-            std::map<size_t, size_t> _cycles;
+            std::unordered_map<size_t, size_t> _cursors;
+            std::unordered_map<size_t, size_t> _cycles;
+
+            // Indices of the calls of every (entity, type) and of every entity, in recording order
+            std::unordered_map<uint64_t, std::vector<size_t>> _calls_by_key;
+            std::unordered_map<int, std::vector<size_t>> _calls_by_entity;
+            size_t _indexed_calls = 0;
+
+            // Loaded recordings: the open file, memory-mapped, and the row of every blob in it.
+            // The statement is declared last so it is finalized before the connection closes.
+            std::unique_ptr<sql::connection> _db;
+            std::vector<int64_t> _blob_rows;
+            std::unique_ptr<sql::statement> _select_blob;
+
+            // The latest blobs read from the file; frames reuse their profile blob and
+            // commands are compared with the recording before their response is read
+            static const size_t blob_cache_size = 8;
+            mutable std::mutex _blob_mutex;
+            mutable std::vector<std::pair<int, std::vector<uint8_t>>> _blob_cache;
+            mutable size_t _next_cached_blob = 0;
+
+            static uint64_t call_key(call_type t, int entity_id)
+            {
+                return (uint64_t(uint32_t(entity_id)) << 32) | uint32_t(t);
+            }
+            void index_calls();
 
             double get_current_time();
 
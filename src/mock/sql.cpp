@@ -112,6 +112,11 @@ namespace sql
         return sqlite3_column_int(m_handle.get(), column);
     }
 
+    int64_t statement::get_int64(int const column) const
+    {
+        return sqlite3_column_int64(m_handle.get(), column);
+    }
+
     double statement::get_double(int const column) const
     {
         auto val = sqlite3_column_double(m_handle.get(), column);
@@ -138,6 +143,11 @@ namespace sql
         sqlite3_bind_int(m_handle.get(), param, value);
     }
 
+    void statement::bind(int param, int64_t value) const
+    {
+        sqlite3_bind_int64(m_handle.get(), param, value);
+    }
+
     void statement::bind(int param, double value) const
     {
         sqlite3_bind_double(m_handle.get(), param, value);
@@ -153,6 +163,12 @@ namespace sql
         sqlite3_bind_blob(m_handle.get(), param, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
     }
 
+    void statement::reset() const
+    {
+        sqlite3_reset(m_handle.get());
+        sqlite3_clear_bindings(m_handle.get());
+    }
+
     statement::row_value statement::iterator::operator*() const
     {
         return row_value(m_owner, m_end);
@@ -78,15 +78,20 @@ namespace sql
         bool step() const;
 
         int get_int(int column = 0) const;
+        int64_t get_int64(int column = 0) const;
         double get_double(int column = 0) const;
         std::string get_string(int column = 0) const;
         std::vector<uint8_t> get_blob(int column = 0) const;
 
         void bind(int param, int value) const;
+        void bind(int param, int64_t value) const;
         void bind(int param, double value) const;
         void bind(int param, const char* value) const;
         void bind(int param, const std::vector<uint8_t>& value) const;
 
+        // Rewinds the statement so it can run again with new bindings
+        void reset() const;
+
         class iterator;
         class row_value;
 
@@ -101,6 +106,7 @@ namespace sql
         public:
             std::string get_string() const { return m_owner->get_string(m_column); }
             int get_int() const { return m_owner->get_int(m_column); }
+            int64_t get_int64() const { return m_owner->get_int64(m_column); }
             double get_double() const { return m_owner->get_double(m_column); }
             int get_bool() const { return m_owner->get_int(m_column) != 0; }
             std::vector<uint8_t> get_blob() const { return m_owner->get_blob(m_column); }
@@ -232,15 +232,19 @@ namespace librealsense
     class LRS_EXTENSION_API float_option : public option_base
     {
     public:
-        float_option(option_range range) : option_base(range), _value(range.def) {}
+        float_option(option_range range, std::string description = "") : option_base(range), _value(range.def), _desc(description) {}
 
         void set(float value) override;
         float query() const override { return _value; }
         bool is_enabled() const override { return true; }
         // TODO: expose this outwards
-        const char* get_description() const override { return "A simple custom option for a processing block or software device"; }
+        const char* get_description() const override
+        {
+            return _desc.empty() ? "A simple custom option for a processing block or software device" : _desc.c_str();
+        }
     protected:
         float _value;
+        std::string _desc;
     };
 
     template<class T>
@@ -14,7 +14,8 @@ namespace librealsense
             _queue(new single_consumer_frame_queue<frame_holder>(1)),
             _streams_to_aggregate_ids(streams_to_aggregate),
             _streams_to_sync_ids(streams_to_sync),
-            _accepting(true)
+            _accepting(true),
+            _queue_trace_stage(frame_tracer::get_instance().register_stage("Pipeline queue"))
         {
             auto processing_callback = [&](frame_holder frame, synthetic_source_interface* source)
             {
@@ -104,12 +105,18 @@ namespace librealsense
 
         bool aggregator::dequeue(frame_holder* item, unsigned int timeout_ms)
         {
-            return _queue->dequeue(item, timeout_ms);
+            if (!_queue->dequeue(item, timeout_ms))
+                return false;
+            trace_frame_end(item->frame, _queue_trace_stage);
+            return true;
         }
 
         bool aggregator::try_dequeue(frame_holder* item)
         {
-            return _queue->try_dequeue(item);
+            if (!_queue->try_dequeue(item))
+                return false;
+            trace_frame_end(item->frame, _queue_trace_stage);
+            return true;
         }
 
         void aggregator::start()
@@ -19,6 +19,7 @@ namespace librealsense
             std::vector<int> _streams_to_aggregate_ids;
             std::vector<int> _streams_to_sync_ids;
             std::atomic<bool> _accepting;
+            uint16_t _queue_trace_stage;
             void handle_frame(frame_holder frame, synthetic_source_interface* source);
         public:
             aggregator(const std::vector<int>& streams_to_aggregate, const std::vector<int>& streams_to_sync);
@@ -8,6 +8,7 @@
 #include "proc/synthetic-stream.h"
 #include "environment.h"
 #include "align.h"
+#include "deprojection-table.h"
 #include "stream.h"
 
 namespace librealsense
@@ -16,8 +17,12 @@ namespace librealsense
 
     template<class GET_DEPTH, class TRANSFER_PIXEL>
     void align_images(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
-        const rs2_intrinsics& other_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel)
+        const rs2_intrinsics& other_intrin, const deprojection_table& top_left, const deprojection_table& bottom_right,
+        GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel)
     {
+        auto top_left_rays = top_left.rays();
+        auto bottom_right_rays = bottom_right.rays();
+
         // Iterate over the pixels of the depth image
 #pragma omp parallel for schedule(dynamic)
         for (int depth_y = 0; depth_y < depth_intrin.height; ++depth_y)
@@ -29,16 +34,16 @@ namespace librealsense
                 if (float depth = get_depth(depth_pixel_index))
                 {
                     // Map the top-left corner of the depth pixel onto the other image
-                    float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+                    auto ray = top_left_rays[depth_pixel_index];
+                    float depth_point[3] = { ray.x * depth, ray.y * depth, depth }, other_point[3], other_pixel[2];
                     rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
                     rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
                     const int other_x0 = static_cast<int>(other_pixel[0] + 0.5f);
                     const int other_y0 = static_cast<int>(other_pixel[1] + 0.5f);
 
                     // Map the bottom-right corner of the depth pixel onto the other image
-                    depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+                    ray = bottom_right_rays[depth_pixel_index];
+                    depth_point[0] = ray.x * depth; depth_point[1] = ray.y * depth;
                     rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
                     rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
                     const int other_x1 = static_cast<int>(other_pixel[0] + 0.5f);
@@ -79,7 +84,8 @@ namespace librealsense
         auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto out_z = (uint16_t *)(aligned_data);
 
-        align_images(z_intrin, z_to_other, other_intrin,
+        update_deprojection(z_intrin);
+        align_images(z_intrin, z_to_other, other_intrin, *_top_left_rays, *_bottom_right_rays,
             [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
             [out_z, z_pixels](int z_pixel_index, int other_pixel_index)
         {
@@ -90,33 +96,35 @@ namespace librealsense
     }
 
     template<int N, class GET_DEPTH>
-    void align_other_to_depth_bytes(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels)
+    void align_other_to_depth_bytes(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels,
+        const deprojection_table& top_left, const deprojection_table& bottom_right)
     {
         auto in_other = (const bytes<N> *)(other_pixels);
         auto out_other = (bytes<N> *)(other_aligned_to_depth);
-        align_images(depth_intrin, depth_to_other, other_intrin, get_depth,
+        align_images(depth_intrin, depth_to_other, other_intrin, top_left, bottom_right, get_depth,
             [out_other, in_other](int depth_pixel_index, int other_pixel_index) { out_other[depth_pixel_index] = in_other[other_pixel_index]; });
     }
 
     template<class GET_DEPTH>
-    void align_other_to_depth(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics & depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels, rs2_format other_format)
+    void align_other_to_depth(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics & depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels, rs2_format other_format,
+        const deprojection_table& top_left, const deprojection_table& bottom_right)
     {
         switch (other_format)
         {
         case RS2_FORMAT_Y8:
-            align_other_to_depth_bytes<1>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<1>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels, top_left, bottom_right);
             break;
         case RS2_FORMAT_Y16:
         case RS2_FORMAT_Z16:
-            align_other_to_depth_bytes<2>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<2>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels, top_left, bottom_right);
             break;
         case RS2_FORMAT_RGB8:
         case RS2_FORMAT_BGR8:
-            align_other_to_depth_bytes<3>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<3>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels, top_left, bottom_right);
             break;
         case RS2_FORMAT_RGBA8:
         case RS2_FORMAT_BGRA8:
-            align_other_to_depth_bytes<4>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<4>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels, top_left, bottom_right);
             break;
         default:
             assert(false); // NOTE: rs2_align_other_to_depth_bytes<2>(...) is not appropriate for RS2_FORMAT_YUYV/RS2_FORMAT_RAW10 images, no logic prevents U/V channels from being written to one another
@@ -139,8 +147,18 @@ namespace librealsense
         auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto other_pixels = reinterpret_cast<const byte*>(other.get_data());
 
+        update_deprojection(z_intrin);
         align_other_to_depth(aligned_data, [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
-            z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format());
+            z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format(), *_top_left_rays, *_bottom_right_rays);
+    }
+
+    void align::update_deprojection(const rs2_intrinsics& depth_intrin)
+    {
+        if (!_top_left_rays || !_top_left_rays->matches(depth_intrin, -0.5f))
+        {
+            _top_left_rays = get_deprojection_table(depth_intrin, -0.5f);
+            _bottom_right_rays = get_deprojection_table(depth_intrin, 0.5f);
+        }
     }
 
     std::shared_ptr<rs2::video_stream_profile> align::create_aligned_profile(
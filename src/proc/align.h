@@ -12,6 +12,8 @@
 
 namespace librealsense
 {
+    class deprojection_table;
+
     class LRS_EXTENSION_API align : public generic_processing_block
     {
     public:
@@ -50,6 +52,11 @@ namespace librealsense
         float _depth_scale;
 
     private:
+        // Rays through the top-left and bottom-right corners of every depth pixel
+        void update_deprojection(const rs2_intrinsics& depth_intrin);
+        std::shared_ptr<const deprojection_table> _top_left_rays;
+        std::shared_ptr<const deprojection_table> _bottom_right_rays;
+
         rs2::video_frame allocate_aligned_frame(const rs2::frame_source& source, const rs2::video_frame& from, const rs2::video_frame& to);
         void align_frames(rs2::video_frame& aligned, const rs2::video_frame& from, const rs2::video_frame& to);
     };
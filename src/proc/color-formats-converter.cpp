@@ -5,6 +5,7 @@
 
 #include "option.h"
 #include "image-avx.h"
+#include "image-neon.h"
 #include "image.h"
 
 #define STB_IMAGE_STATIC
@@ -59,6 +60,15 @@ namespace librealsense
         rscuda::unpack_yuy2_cuda<FORMAT>(d, s, n);
         return;
 #endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        if (FORMAT == RS2_FORMAT_Y8) unpack_yuy2_neon_y8(d, s, n);
+        if (FORMAT == RS2_FORMAT_Y16) unpack_yuy2_neon_y16(d, s, n);
+        if (FORMAT == RS2_FORMAT_RGB8) unpack_yuy2_neon_rgb8(d, s, n);
+        if (FORMAT == RS2_FORMAT_RGBA8) unpack_yuy2_neon_rgba8(d, s, n);
+        if (FORMAT == RS2_FORMAT_BGR8) unpack_yuy2_neon_bgr8(d, s, n);
+        if (FORMAT == RS2_FORMAT_BGRA8) unpack_yuy2_neon_bgra8(d, s, n);
+        return;
+#endif
 #if defined __SSSE3__ && ! defined ANDROID
         static bool do_avx = has_avx();
 #ifdef __AVX2__
@@ -98,7 +108,7 @@ namespace librealsense
                     // Align all Y components and output 16 pixels (16 bytes) at once
                     __m128i y0 = _mm_shuffle_epi8(s0, _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, 0, 2, 4, 6, 8, 10, 12, 14));
                     __m128i y1 = _mm_shuffle_epi8(s1, _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15));
-                    _mm_storeu_si128(&dst[i], _mm_alignr_epi8(y0, y1, 8));
+                    _mm_storeu_si128(&dst[i], _mm_alignr_epi8(y1, y0, 8));
                     continue;
                 }
 
@@ -392,6 +402,13 @@ namespace librealsense
     {
         auto n = width * height;
         assert(n % 16 == 0); // All currently supported color resolutions are multiples of 16 pixels. Could easily extend support to other resolutions by copying final n<16 pixels into a zero-padded buffer and recursively calling self for final iteration.
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        if (FORMAT == RS2_FORMAT_RGB8) unpack_uyvy_neon_rgb8(d, s, n);
+        if (FORMAT == RS2_FORMAT_RGBA8) unpack_uyvy_neon_rgba8(d, s, n);
+        if (FORMAT == RS2_FORMAT_BGR8) unpack_uyvy_neon_bgr8(d, s, n);
+        if (FORMAT == RS2_FORMAT_BGRA8) unpack_uyvy_neon_bgra8(d, s, n);
+        return;
+#endif
 #ifdef __SSSE3__
         auto src = reinterpret_cast<const __m128i *>(s);
         auto dst = reinterpret_cast<__m128i *>(d[0]);
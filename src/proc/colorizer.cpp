@@ -11,6 +11,10 @@
 #include "colorizer.h"
 #include "disparity-transform.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
 namespace librealsense
 {
     static color_map hue{ {
@@ -220,6 +224,13 @@ namespace librealsense
 
         auto hist_opt = std::make_shared<ptr_option<bool>>(false, true, true, true, &_equalize, "Perform histogram equalization");
         register_option(RS2_OPTION_HISTOGRAM_EQUALIZATION_ENABLED, hist_opt);
+
+        auto hist_interval_opt = std::make_shared<ptr_option<int>>(1, 300, 1, 1, &_hist_update_interval, "Number of frames between histogram recalculations");
+        hist_interval_opt->on_set([this](float)
+        {
+            _frames_since_hist_update = 0;
+        });
+        register_option(RS2_OPTION_HISTOGRAM_UPDATE_INTERVAL, hist_interval_opt);
     }
 
     bool colorizer::should_process(const rs2::frame& frame)
@@ -244,6 +255,7 @@ namespace librealsense
 
             auto info = disparity_info::update_info_from_frame(f);
             _d2d_convert_factor = info.d2d_convert_factor;
+            _frames_since_hist_update = 0;
         }
 
         auto make_equalized_histogram = [this](const rs2::video_frame& depth, rs2::video_frame rgb)
@@ -261,13 +273,23 @@ namespace librealsense
             {
                 auto depth_data = reinterpret_cast<const float*>(depth.get_data());
                 update_histogram(_hist_data, depth_data, w, h);
+                _lut_dirty = true;
                 make_rgb_data<float>(depth_data, rgb_data, w, h, coloring_function);
             }
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
-                update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                // The histogram is refreshed every <interval> frames; in between, the
+                // table built from the last one keeps being used
+                if (_frames_since_hist_update == 0 || !_lut_equalize)
+                {
+                    update_histogram(_hist_data, depth_data, w, h);
+                    _lut_dirty = true;
+                }
+                _frames_since_hist_update = (_frames_since_hist_update + 1) % std::max(_hist_update_interval, 1);
+
+                update_lut(true);
+                make_rgb_data_from_lut(depth_data, rgb_data, w, h);
             }
         };
 
@@ -294,13 +316,8 @@ namespace librealsense
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
-                auto min = _min;
-                auto max = _max;
-                auto coloring_function = [&, this](float data) {
-                    if (min >= max) return 0.f;
-                    return (data * _depth_units - min) / (max - min);
-                };
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                update_lut(false);
+                make_rgb_data_from_lut(depth_data, rgb_data, w, h);
             }
         };
 
@@ -316,4 +333,82 @@ namespace librealsense
 
         return ret;
     }
+
+    void colorizer::update_lut(bool equalize)
+    {
+        if (!_lut_dirty && !_lut.empty() && _lut_equalize == equalize && _lut_map_index == _map_index &&
+            (equalize || (_lut_min == _min && _lut_max == _max && _lut_depth_units == _depth_units)))
+            return;
+
+        auto cm = _maps[_map_index];
+        auto pack = [](const float3& c) {
+            return uint32_t((uint8_t)c.x) | uint32_t((uint8_t)c.y) << 8 | uint32_t((uint8_t)c.z) << 16;
+        };
+
+        // Same per-value computation as the coloring functions of make_rgb_data
+        _lut.resize(MAX_DEPTH);
+        _lut[0] = 0;
+        if (equalize)
+        {
+            auto pixels = (float)_hist_data[MAX_DEPTH - 1];
+            for (int d = 1; d < MAX_DEPTH; ++d)
+                _lut[d] = pack(cm->get(pixels > 0 ? _hist_data[d] / pixels : 0.f));
+        }
+        else
+        {
+            auto min = _min;
+            auto max = _max;
+            for (int d = 1; d < MAX_DEPTH; ++d)
+            {
+                float data = d;
+                _lut[d] = pack(cm->get(min >= max ? 0.f : (data * _depth_units - min) / (max - min)));
+            }
+        }
+
+        _lut_dirty = false;
+        _lut_equalize = equalize;
+        _lut_map_index = _map_index;
+        _lut_min = _min;
+        _lut_max = _max;
+        _lut_depth_units = _depth_units;
+    }
+
+    void colorizer::make_rgb_data_from_lut(const uint16_t* depth_data, uint8_t* rgb_data, int width, int height) const
+    {
+        auto lut = _lut.data();
+
+#pragma omp parallel for
+        for (int j = 0; j < height; ++j)
+        {
+            auto in = depth_data + j * width;
+            auto out = rgb_data + j * width * 3;
+            int i = 0;
+#ifdef __SSSE3__
+            // Drop the padding byte of the packed entries: 4 pixels -> 12 bytes in the low lanes
+            const __m128i to_rgb = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+            for (; i + 16 <= width; i += 16)
+            {
+                __m128i px[4];
+                for (int k = 0; k < 4; ++k)
+                {
+                    auto d = in + i + k * 4;
+                    px[k] = _mm_shuffle_epi8(_mm_setr_epi32((int)lut[d[0]], (int)lut[d[1]], (int)lut[d[2]], (int)lut[d[3]]), to_rgb);
+                }
+
+                // Stitch the four 12-byte groups into three full 16-byte stores
+                auto dst = reinterpret_cast<__m128i*>(out + i * 3);
+                _mm_storeu_si128(dst + 0, _mm_or_si128(px[0], _mm_slli_si128(px[1], 12)));
+                _mm_storeu_si128(dst + 1, _mm_or_si128(_mm_srli_si128(px[1], 4), _mm_slli_si128(px[2], 8)));
+                _mm_storeu_si128(dst + 2, _mm_or_si128(_mm_srli_si128(px[2], 8), _mm_slli_si128(px[3], 4)));
+            }
+#endif
+            for (; i < width; ++i)
+            {
+                auto c = lut[in[i]];
+                out[i * 3 + 0] = (uint8_t)(c);
+                out[i * 3 + 1] = (uint8_t)(c >> 8);
+                out[i * 3 + 2] = (uint8_t)(c >> 16);
+            }
+        }
+    }
 }
@@ -123,6 +123,11 @@ namespace librealsense {
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
+        // Z16 depth is colorized through a depth -> RGB lookup table, rebuilt only when
+        // the histogram, range or color map it was computed from has changed
+        void update_lut(bool equalize);
+        void make_rgb_data_from_lut(const uint16_t* depth_data, uint8_t* rgb_data, int width, int height) const;
+
         template<typename T, typename F>
         void make_rgb_data(const T* depth_data, uint8_t* rgb_data, int width, int height, F coloring_func)
         {
@@ -161,6 +166,14 @@ namespace librealsense {
 
         std::vector<int> _histogram;
         int* _hist_data;
+        int _hist_update_interval = 1;
+        int _frames_since_hist_update = 0;
+
+        std::vector<uint32_t> _lut;         // Packed as 0x00BBGGRR
+        bool _lut_dirty = true;
+        bool _lut_equalize = false;
+        int _lut_map_index = 0;
+        float _lut_min = 0.f, _lut_max = 0.f, _lut_depth_units = 0.f;
 
         int _preset = 0;
         rs2::stream_profile _target_stream_profile;
@@ -6,6 +6,10 @@
 
 #include <numeric>
 #include <cmath>
+#include <algorithm>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
 #include "environment.h"
 #include "option.h"
 #include "context.h"
@@ -194,6 +198,235 @@ namespace librealsense
         return PIX_MIN(p[4], p[2]);
     }
 
+    // Median of the non-zero members of a <scale x scale> block.
+    // For even-size kernels picks the member one below the middle
+    static inline uint16_t median_of_valid(const uint16_t * block, size_t stride, size_t scale)
+    {
+        uint16_t working_kernel[9];
+        auto wk_itr = working_kernel;
+        for (size_t n = 0; n < scale; ++n)
+        {
+            const uint16_t* p = block + stride * n;
+            for (size_t m = 0; m < scale; ++m)
+            {
+                if (p[m])
+                    *wk_itr++ = p[m];
+            }
+        }
+
+        switch (wk_itr - working_kernel)
+        {
+        case 1: return working_kernel[0];
+        case 2: return PIX_MIN(working_kernel[0], working_kernel[1]);
+        case 3: return opt_med3<uint16_t>(working_kernel);
+        case 4: return opt_med4<uint16_t>(working_kernel);
+        case 5: return opt_med5<uint16_t>(working_kernel);
+        case 6: return opt_med6<uint16_t>(working_kernel);
+        case 7: return opt_med7<uint16_t>(working_kernel);
+        case 8: return opt_med8<uint16_t>(working_kernel);
+        case 9: return opt_med9<uint16_t>(working_kernel);
+        default: return 0;
+        }
+    }
+
+#ifdef __SSSE3__
+    // The kernels below sort the whole block, zeros included, and then pick the lower
+    // median of the valid members by rank: with z zeros in an n-member block the valid
+    // values occupy ranks [z, n) so the one opt_medN() would return sits at z + (n-z-1)/2.
+    // SSSE3 has no unsigned 16-bit min/max, so the values are biased into the signed range.
+    static const __m128i u16_bias = _mm_set1_epi16(short(0x8000));
+
+    static inline void sort_pair(__m128i& a, __m128i& b)
+    {
+        __m128i t = _mm_min_epi16(a, b);
+        b = _mm_max_epi16(a, b);
+        a = t;
+    }
+
+    // Pick s[z + (n-z-1)/2] per lane, given a fully sorted (biased) block s[0..n)
+    static inline __m128i select_lower_median(const __m128i* s, int n, __m128i zeros)
+    {
+        __m128i res = _mm_setzero_si128();
+        for (int z = 0; z <= n; z++)
+        {
+            // An all-zero block yields the (zero) top rank
+            auto rank = (z < n) ? z + (n - z - 1) / 2 : n - 1;
+            auto hit = _mm_cmpeq_epi16(zeros, _mm_set1_epi16(short(z)));
+            res = _mm_or_si128(res, _mm_and_si128(hit, s[rank]));
+        }
+        return _mm_xor_si128(res, u16_bias);
+    }
+
+    // Count the zero lanes of v and bias it into the signed range
+    static inline __m128i load_biased(__m128i v, __m128i& zeros)
+    {
+        zeros = _mm_sub_epi16(zeros, _mm_cmpeq_epi16(v, _mm_setzero_si128()));
+        return _mm_xor_si128(v, u16_bias);
+    }
+
+    // 8 output pixels per iteration: even/odd columns of the two rows form the 2x2 blocks
+    static size_t decimate_band_median_2x2_sse(const uint16_t * band, size_t stride, size_t width_out, uint16_t * out)
+    {
+        const __m128i even = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i odd = _mm_setr_epi8(2, 3, 6, 7, 10, 11, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+
+        size_t i = 0;
+        for (; i + 8 <= width_out; i += 8)
+        {
+            __m128i s[4];
+            __m128i zeros = _mm_setzero_si128();
+            for (int n = 0; n < 2; n++)
+            {
+                auto row = reinterpret_cast<const __m128i*>(band + stride * n + i * 2);
+                auto lo = _mm_loadu_si128(row);
+                auto hi = _mm_loadu_si128(row + 1);
+                s[n * 2] = load_biased(_mm_unpacklo_epi64(_mm_shuffle_epi8(lo, even), _mm_shuffle_epi8(hi, even)), zeros);
+                s[n * 2 + 1] = load_biased(_mm_unpacklo_epi64(_mm_shuffle_epi8(lo, odd), _mm_shuffle_epi8(hi, odd)), zeros);
+            }
+
+            sort_pair(s[0], s[1]); sort_pair(s[2], s[3]);
+            sort_pair(s[0], s[2]); sort_pair(s[1], s[3]);
+            sort_pair(s[1], s[2]);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), select_lower_median(s, 4, zeros));
+        }
+        return i;
+    }
+
+    // 8 output pixels per iteration: 24 columns of each of the three rows are split by stride 3
+    static size_t decimate_band_median_3x3_sse(const uint16_t * band, size_t stride, size_t width_out, uint16_t * out)
+    {
+        // masks[k][r] gathers column 3j+k of the 24 loaded pixels out of register r into lane j
+        __m128i masks[3][3];
+        for (int k = 0; k < 3; k++)
+        {
+            for (int r = 0; r < 3; r++)
+            {
+                alignas(16) int8_t m[16];
+                for (int j = 0; j < 8; j++)
+                {
+                    int e = 3 * j + k;
+                    bool mine = (e / 8 == r);
+                    m[2 * j] = mine ? int8_t(2 * (e % 8)) : -1;
+                    m[2 * j + 1] = mine ? int8_t(2 * (e % 8) + 1) : -1;
+                }
+                masks[k][r] = _mm_load_si128(reinterpret_cast<const __m128i*>(m));
+            }
+        }
+
+        size_t i = 0;
+        for (; i + 8 <= width_out; i += 8)
+        {
+            __m128i s[9];
+            __m128i zeros = _mm_setzero_si128();
+            for (int n = 0; n < 3; n++)
+            {
+                auto row = reinterpret_cast<const __m128i*>(band + stride * n + i * 3);
+                __m128i v[3] = { _mm_loadu_si128(row), _mm_loadu_si128(row + 1), _mm_loadu_si128(row + 2) };
+                for (int k = 0; k < 3; k++)
+                {
+                    auto col = _mm_or_si128(_mm_or_si128(
+                        _mm_shuffle_epi8(v[0], masks[k][0]),
+                        _mm_shuffle_epi8(v[1], masks[k][1])),
+                        _mm_shuffle_epi8(v[2], masks[k][2]));
+                    s[n * 3 + k] = load_biased(col, zeros);
+                }
+            }
+
+            // 25-comparator sorting network for 9 inputs
+            sort_pair(s[0], s[1]); sort_pair(s[3], s[4]); sort_pair(s[6], s[7]);
+            sort_pair(s[1], s[2]); sort_pair(s[4], s[5]); sort_pair(s[7], s[8]);
+            sort_pair(s[0], s[1]); sort_pair(s[3], s[4]); sort_pair(s[6], s[7]);
+            sort_pair(s[0], s[3]); sort_pair(s[3], s[6]); sort_pair(s[0], s[3]);
+            sort_pair(s[1], s[4]); sort_pair(s[4], s[7]); sort_pair(s[1], s[4]);
+            sort_pair(s[2], s[5]); sort_pair(s[5], s[8]); sort_pair(s[2], s[5]);
+            sort_pair(s[1], s[3]); sort_pair(s[5], s[7]); sort_pair(s[2], s[6]);
+            sort_pair(s[4], s[6]); sort_pair(s[2], s[4]); sort_pair(s[2], s[3]);
+            sort_pair(s[5], s[6]);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), select_lower_median(s, 9, zeros));
+        }
+        return i;
+    }
+
+    // Accumulate sum and count of the non-zero pixels for every input column of the band
+    static size_t accumulate_band_columns_sse(const uint16_t * band, size_t stride, size_t scale, size_t width, int * sums, int * counts)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        size_t c = 0;
+        for (; c + 8 <= width; c += 8)
+        {
+            __m128i sum_lo = zero, sum_hi = zero, cnt = zero;
+            for (size_t n = 0; n < scale; ++n)
+            {
+                auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(band + stride * n + c));
+                sum_lo = _mm_add_epi32(sum_lo, _mm_unpacklo_epi16(v, zero));
+                sum_hi = _mm_add_epi32(sum_hi, _mm_unpackhi_epi16(v, zero));
+                cnt = _mm_sub_epi16(cnt, _mm_cmpeq_epi16(v, zero));
+            }
+            // cnt holds the number of zeros
+            cnt = _mm_sub_epi16(_mm_set1_epi16(short(scale)), cnt);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + c), sum_lo);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + c + 4), sum_hi);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(counts + c), _mm_unpacklo_epi16(cnt, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(counts + c + 4), _mm_unpackhi_epi16(cnt, zero));
+        }
+        return c;
+    }
+#endif // __SSSE3__
+
+    static void decimate_band_median_2x2(const uint16_t * band, size_t stride, size_t width_out, uint16_t * out)
+    {
+        size_t i = 0;
+#ifdef __SSSE3__
+        i = decimate_band_median_2x2_sse(band, stride, width_out, out);
+#endif
+        for (; i < width_out; i++)
+            out[i] = median_of_valid(band + i * 2, stride, 2);
+    }
+
+    static void decimate_band_median_3x3(const uint16_t * band, size_t stride, size_t width_out, uint16_t * out)
+    {
+        size_t i = 0;
+#ifdef __SSSE3__
+        i = decimate_band_median_3x3_sse(band, stride, width_out, out);
+#endif
+        for (; i < width_out; i++)
+            out[i] = median_of_valid(band + i * 3, stride, 3);
+    }
+
+    static void decimate_band_mean(const uint16_t * band, size_t stride, size_t width_out, size_t scale, uint16_t * out)
+    {
+        const size_t width = width_out * scale;
+        std::vector<int> sums(width), counts(width);
+
+        size_t c = 0;
+#ifdef __SSSE3__
+        c = accumulate_band_columns_sse(band, stride, scale, width, sums.data(), counts.data());
+#endif
+        for (; c < width; c++)
+        {
+            for (size_t n = 0; n < scale; ++n)
+            {
+                auto v = band[stride * n + c];
+                sums[c] += v;
+                counts[c] += (v != 0);
+            }
+        }
+
+        for (size_t i = 0; i < width_out; i++)
+        {
+            int sum = 0;
+            int counter = 0;
+            for (size_t m = 0; m < scale; ++m)
+            {
+                sum += sums[i * scale + m];
+                counter += counts[i * scale + m];
+            }
+            out[i] = (counter == 0 ? 0 : sum / counter);
+        }
+    }
+
     const uint8_t decimation_min_val = 1;
     const uint8_t decimation_max_val = 8;    // Decimation levels according to the reference design
     const uint8_t decimation_default_val = 2;
@@ -357,132 +590,33 @@ namespace librealsense
     void decimation_filter::decimate_depth(const uint16_t * frame_data_in, uint16_t * frame_data_out,
         size_t width_in, size_t height_in, size_t scale)
     {
-        // Use median filtering
-        std::vector<uint16_t> working_kernel(_kernel_size);
-        auto wk_begin = working_kernel.data();
-        auto wk_itr = wk_begin;
-        std::vector<uint16_t*> pixel_raws(scale);
-        uint16_t* block_start = const_cast<uint16_t*>(frame_data_in);
-
-        if (scale == 2 || scale == 3)
-        {
-            for (int j = 0; j < _real_height; j++)
-            {
-                uint16_t *p{};
-                // Mark the beginning of each of the N lines that the filter will run upon
-                for (size_t i = 0; i < pixel_raws.size(); i++)
-                    pixel_raws[i] = block_start + (width_in*i);
-
-                for (size_t i = 0, chunk_offset = 0; i < _real_width; i++)
-                {
-                    wk_itr = wk_begin;
-                    // extract data the kernel to process
-                    for (size_t n = 0; n < scale; ++n)
-                    {
-                        p = pixel_raws[n] + chunk_offset;
-                        for (size_t m = 0; m < scale; ++m)
-                        {
-                            if (*(p + m))
-                                *wk_itr++ = *(p + m);
-                        }
-                    }
-
-                    // For even-size kernels pick the member one below the middle
-                    auto ks = (int)(wk_itr - wk_begin);
-                    if (ks == 0)
-                        *frame_data_out++ = 0;
-                    else
-                    {
-                        switch (ks)
-                        {
-                        case 1:
-                            *frame_data_out++ = working_kernel[0];
-                            break;
-                        case 2:
-                            *frame_data_out++ = PIX_MIN(working_kernel[0], working_kernel[1]);
-                            break;
-                        case 3:
-                            *frame_data_out++ = opt_med3<uint16_t>(working_kernel.data());
-                            break;
-                        case 4:
-                            *frame_data_out++ = opt_med4<uint16_t>(working_kernel.data());
-                            break;
-                        case 5:
-                            *frame_data_out++ = opt_med5<uint16_t>(working_kernel.data());
-                            break;
-                        case 6:
-                            *frame_data_out++ = opt_med6<uint16_t>(working_kernel.data());
-                            break;
-                        case 7:
-                            *frame_data_out++ = opt_med7<uint16_t>(working_kernel.data());
-                            break;
-                        case 8:
-                            *frame_data_out++ = opt_med8<uint16_t>(working_kernel.data());
-                            break;
-                        case 9:
-                            *frame_data_out++ = opt_med9<uint16_t>(working_kernel.data());
-                            break;
-                        }
-                    }
-
-                    chunk_offset += scale;
-                }
-
-                // Fill-in the padded colums with zeros
-                for (int j = _real_width; j < _padded_width; j++)
-                    *frame_data_out++ = 0;
-
-                // Skip N lines to the beginnig of the next processing segment
-                block_start += width_in * scale;
-            }
-        }
-        else
+        const int real_height = _real_height;
+        const size_t real_width = _real_width;
+        const size_t padded_width = _padded_width;
+
+        // Every output row depends only on its own band of <scale> input rows,
+        // so the bands are processed independently
+#pragma omp parallel for
+        for (int j = 0; j < real_height; j++)
         {
-            for (int j = 0; j < _real_height; j++)
-            {
-                uint16_t *p{};
-                // Mark the beginning of each of the N lines that the filter will run upon
-                for (size_t i = 0; i < pixel_raws.size(); i++)
-                    pixel_raws[i] = block_start + (width_in*i);
-
-                for (size_t i = 0, chunk_offset = 0; i < _real_width; i++)
-                {
-                    int sum = 0;
-                    int counter = 0;
-
-                    // extract data the kernel to process
-                    for (size_t n = 0; n < scale; ++n)
-                    {
-                        p = pixel_raws[n] + chunk_offset;
-                        for (size_t m = 0; m < scale; ++m)
-                        {
-                            if (*(p + m))
-                            {
-                                sum += p[m];
-                                ++counter;
-                            }
-                        }
-                    }
-
-                    *frame_data_out++ = (counter == 0 ? 0 : sum / counter);
-                    chunk_offset += scale;
-                }
-
-                // Fill-in the padded colums with zeros
-                for (int j = _real_width; j < _padded_width; j++)
-                    *frame_data_out++ = 0;
+            const uint16_t* band = frame_data_in + j * width_in * scale;
+            uint16_t* out = frame_data_out + j * padded_width;
+
+            // Use median filtering for the small kernels, mean-of-valid for the rest
+            if (scale == 2)
+                decimate_band_median_2x2(band, width_in, real_width, out);
+            else if (scale == 3)
+                decimate_band_median_3x3(band, width_in, real_width, out);
+            else
+                decimate_band_mean(band, width_in, real_width, scale, out);
 
-                // Skip N lines to the beginnig of the next processing segment
-                block_start += width_in * scale;
-            }
+            // Fill-in the padded colums with zeros
+            std::fill(out + real_width, out + padded_width, uint16_t(0));
         }
 
         // Fill-in the padded rows with zeros
-        for (auto v = _real_height; v < _padded_height; ++v)
-        {
-            for (auto u = 0; u < _padded_width; ++u)
-                *frame_data_out++ = 0;
-        }
+        std::fill(frame_data_out + real_height * padded_width,
+            frame_data_out + size_t(_padded_height) * padded_width, uint16_t(0));
     }
 
     void decimation_filter::decimate_others(rs2_format format, const void * frame_data_in, void * frame_data_out,
@@ -0,0 +1,102 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/rsutil.h"
+#include "proc/deprojection-table.h"
+
+#include <algorithm>
+#include <mutex>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace librealsense
+{
+    deprojection_table::deprojection_table(const rs2_intrinsics& intrin, float offset)
+        : _intrinsics(intrin), _offset(offset), _rays(size_t(intrin.width) * intrin.height)
+    {
+        // Deprojecting at depth 1 leaves the undistorted ray, and depth * ray later on
+        // reproduces exactly what rs2_deproject_pixel_to_point() computes for that depth
+#pragma omp parallel for
+        for (int y = 0; y < intrin.height; ++y)
+        {
+            for (int x = 0; x < intrin.width; ++x)
+            {
+                const float pixel[] = { x + offset, y + offset };
+                float point[3];
+                rs2_deproject_pixel_to_point(point, &intrin, pixel, 1.f);
+                _rays[y * intrin.width + x] = { point[0], point[1] };
+            }
+        }
+    }
+
+    bool deprojection_table::matches(const rs2_intrinsics& intrin, float offset) const
+    {
+        return _offset == offset &&
+            _intrinsics.width == intrin.width && _intrinsics.height == intrin.height &&
+            _intrinsics.ppx == intrin.ppx && _intrinsics.ppy == intrin.ppy &&
+            _intrinsics.fx == intrin.fx && _intrinsics.fy == intrin.fy &&
+            _intrinsics.model == intrin.model &&
+            std::equal(std::begin(_intrinsics.coeffs), std::end(_intrinsics.coeffs), std::begin(intrin.coeffs));
+    }
+
+    std::shared_ptr<const deprojection_table> get_deprojection_table(const rs2_intrinsics& intrin, float offset)
+    {
+        static std::mutex mutex;
+        static std::vector<std::weak_ptr<const deprojection_table>> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        tables.erase(std::remove_if(tables.begin(), tables.end(),
+            [](const std::weak_ptr<const deprojection_table>& t) { return t.expired(); }), tables.end());
+
+        for (auto&& t : tables)
+        {
+            auto table = t.lock();
+            if (table && table->matches(intrin, offset))
+                return table;
+        }
+
+        auto table = std::make_shared<const deprojection_table>(intrin, offset);
+        tables.push_back(table);
+        return table;
+    }
+
+    void deproject_depth(float3* points, const deprojection_table& table, const uint16_t* depth, float depth_scale)
+    {
+        const int width = table.width();
+        const int height = table.height();
+
+#pragma omp parallel for
+        for (int y = 0; y < height; ++y)
+        {
+            auto rays = table.rays() + y * width;
+            auto row_depth = depth + y * width;
+            auto out = reinterpret_cast<float*>(points + y * width);
+            int x = 0;
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+            const float32x4_t scale = vdupq_n_f32(depth_scale);
+            for (; x + 4 <= width; x += 4)
+            {
+                // 4 depth pixels -> meters, then one multiply per component against the (x, y) rays
+                float32x4_t z = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vld1_u16(row_depth + x))), scale);
+                float32x4x2_t ray = vld2q_f32(reinterpret_cast<const float*>(rays + x));
+                float32x4x3_t point;
+                point.val[0] = vmulq_f32(ray.val[0], z);
+                point.val[1] = vmulq_f32(ray.val[1], z);
+                point.val[2] = z;
+                vst3q_f32(out + 3 * x, point);
+            }
+#endif
+            for (; x < width; ++x)
+            {
+                float z = depth_scale * row_depth[x];
+                out[3 * x + 0] = rays[x].x * z;
+                out[3 * x + 1] = rays[x].y * z;
+                out[3 * x + 2] = z;
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../types.h"
+
+#include <memory>
+#include <vector>
+
+namespace librealsense
+{
+    // Deprojection of every pixel of an image to depth 1, i.e. rs2_deproject_pixel_to_point()
+    // with the distortion model already solved. A pixel of depth z deprojects to
+    // (ray.x * z, ray.y * z, z), bit-exact with rs2_deproject_pixel_to_point().
+    class deprojection_table
+    {
+    public:
+        // 'offset' shifts the sampled position inside the pixel, e.g. -0.5 for its top-left corner
+        deprojection_table(const rs2_intrinsics& intrin, float offset);
+
+        bool matches(const rs2_intrinsics& intrin, float offset) const;
+
+        const float2* rays() const { return _rays.data(); }
+        int width() const { return _intrinsics.width; }
+        int height() const { return _intrinsics.height; }
+
+    private:
+        rs2_intrinsics _intrinsics;
+        float _offset;
+        std::vector<float2> _rays;
+    };
+
+    // Returns the table of the given intrinsics, shared by every block currently holding it
+    // (pointcloud, align). Callers keep the returned pointer and query again when their
+    // intrinsics change; a table is released once the last holder lets go of it.
+    std::shared_ptr<const deprojection_table> get_deprojection_table(const rs2_intrinsics& intrin, float offset = 0.f);
+
+    // points[i] = (ray.x * z, ray.y * z, z), z = depth_scale * depth[i]
+    void deproject_depth(float3* points, const deprojection_table& table, const uint16_t* depth, float depth_scale);
+}
@@ -1,11 +1,13 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 
-#include <fstream>
-#include "../common/decompress-huffman.h"
 #include "proc/depth-decompress.h"
 #include "environment.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace librealsense
 {
     depth_decompression_huffman::depth_decompression_huffman():
@@ -17,7 +19,12 @@ namespace librealsense
 
     void depth_decompression_huffman::process_function(byte* const dest[], const byte* source, int width, int height, int actual_size, int input_size)
     {
-        if (!unhuffimage4(reinterpret_cast<uint32_t*>(const_cast<byte*>(source)), uint32_t(input_size >> 2), width << 1, height, const_cast<byte*>(*dest)))
+#ifdef _OPENMP
+        static const int threads = omp_get_max_threads();
+#else
+        static const int threads = 1;
+#endif
+        if (!_decoder.decode(reinterpret_cast<const uint32_t*>(source), uint32_t(input_size >> 2), width << 1, height, *dest, threads))
         {
             LOG_INFO("Depth decompression failed, ts: " << static_cast<uint64_t>(environment::get_instance().get_time_service()->get_time())
                         << " , compressed size: " << input_size);
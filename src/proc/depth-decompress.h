@@ -4,6 +4,7 @@
 #pragma once
 
 #include "proc/synthetic-stream.h"
+#include "proc/z16h-decoder.h"
 
 namespace librealsense
 {
@@ -16,6 +17,8 @@ namespace librealsense
 
     protected:
         depth_decompression_huffman(const depth_decompression_huffman&) = delete;
+
+        z16h_decoder _decoder;
     };
 
     MAP_EXTENSION(RS2_EXTENSION_DEPTH_HUFFMAN_DECODER, librealsense::depth_decompression_huffman);
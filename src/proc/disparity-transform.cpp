@@ -18,7 +18,10 @@ namespace librealsense
     disparity_transform::disparity_transform(bool transform_to_disparity):
         generic_processing_block(transform_to_disparity ? "Depth to Disparity" : "Disparity to Depth"),
         _transform_to_disparity(transform_to_disparity),
+        _band_to_disparity(transform_to_disparity),
         _update_target(false),
+        _band_stereoscopic_depth(false),
+        _band_d2d_convert_factor(0.f),
         _width(0), _height(0), _bpp(0)
     {
         auto transform_opt = std::make_shared<ptr_option<bool>>(
@@ -73,14 +76,47 @@ namespace librealsense
             auto src = f.as<rs2::video_frame>();
 
             if (_transform_to_disparity)
-                convert<uint16_t, float>(src.get_data(), const_cast<void*>(tgt.get_data()));
+                convert<uint16_t, float>(src.get_data(), const_cast<void*>(tgt.get_data()), _width * _height, _d2d_convert_factor);
             else
-                convert<float, uint16_t>(src.get_data(), const_cast<void*>(tgt.get_data()));
+                convert<float, uint16_t>(src.get_data(), const_cast<void*>(tgt.get_data()), _width * _height, _d2d_convert_factor);
         }
 
         return tgt;
     }
 
+    rs2_format disparity_transform::prepare_bands(const rs2::frame& f, rs2_format input_format)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // DISPARITY16 input is left to the whole-frame path
+        auto expected = _transform_to_disparity ? RS2_FORMAT_Z16 : RS2_FORMAT_DISPARITY32;
+        if (input_format != expected || f.get_profile().stream_type() != RS2_STREAM_DEPTH)
+            return RS2_FORMAT_ANY;
+
+        // The chain allocates the output frame itself, so only the conversion factor is needed here. It is kept
+        // apart from the whole-frame path, whose source profile differs when the block sits inside a chain
+        if (f.get_profile().get() != _band_source_profile.get())
+        {
+            _band_source_profile = f.get_profile();
+            auto info = disparity_info::update_info_from_frame(f);
+            _band_stereoscopic_depth = info.stereoscopic_depth;
+            _band_d2d_convert_factor = info.d2d_convert_factor;
+        }
+        if (!_band_stereoscopic_depth)
+            return RS2_FORMAT_ANY;
+
+        _band_to_disparity = _transform_to_disparity;
+        return _band_to_disparity ? RS2_FORMAT_DISPARITY32 : RS2_FORMAT_Z16;
+    }
+
+    void disparity_transform::process_band(const void* in, void* out, size_t width, size_t rows)
+    {
+        if (_band_to_disparity)
+            convert<uint16_t, float>(in, out, width * rows, _band_d2d_convert_factor);
+        else
+            convert<float, uint16_t>(in, out, width * rows, _band_d2d_convert_factor);
+    }
+
     void disparity_transform::on_set_mode(bool to_disparity)
     {
         _transform_to_disparity = to_disparity;
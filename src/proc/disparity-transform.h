@@ -11,18 +11,21 @@
 
 namespace librealsense
 {
-    class disparity_transform : public generic_processing_block
+    class disparity_transform : public generic_processing_block, public band_processing_interface
     {
     public:
         disparity_transform(bool transform_to_disparity);
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
+        rs2_format prepare_bands(const rs2::frame& f, rs2_format input_format) override;
+        void process_band(const void* in, void* out, size_t width, size_t rows) override;
+
     protected:
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
 
         template<typename Tin, typename Tout>
-        void convert(const void* in_data, void* out_data)
+        void convert(const void* in_data, void* out_data, size_t count, float d2d_convert_factor)
         {
             static_assert((std::is_arithmetic<Tin>::value), "disparity transform requires numeric type for input data");
             static_assert((std::is_arithmetic<Tout>::value), "disparity transform requires numeric type for output data");
@@ -35,16 +38,15 @@ namespace librealsense
 
             float input{};
             //TODO SSE optimize
-            for (size_t i = 0; i < _height; i++)
-                for (size_t j = 0; j < _width; j++)
-                {
-                    input = *in;
-                    if (std::isnormal(input))
-                        *out++ = static_cast<Tout>((_d2d_convert_factor / input)+round);
-                    else
-                        *out++ = 0;
-                    in++;
-                }
+            for (size_t i = 0; i < count; i++)
+            {
+                input = *in;
+                if (std::isnormal(input))
+                    *out++ = static_cast<Tout>((d2d_convert_factor / input)+round);
+                else
+                    *out++ = 0;
+                in++;
+            }
         }
 
     private:
@@ -53,12 +55,16 @@ namespace librealsense
         void    on_set_mode(bool to_disparity);
 
         bool                    _transform_to_disparity;
+        bool                    _band_to_disparity;
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
         bool                    _update_target;
         bool                    _stereoscopic_depth;
         float                   _stereo_baseline_meter; // in meters
         float                   _d2d_convert_factor;
+        rs2::stream_profile     _band_source_profile;       // Of the band runs of a fused chain
+        bool                    _band_stereoscopic_depth;
+        float                   _band_d2d_convert_factor;
         size_t                  _width, _height;
         size_t                  _bpp;
     };
@@ -0,0 +1,196 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/hpp/rs_sensor.hpp"
+#include "../include/librealsense2/hpp/rs_processing.hpp"
+
+#include "context.h"
+#include "core/video.h"
+#include "proc/synthetic-stream.h"
+#include "proc/fused-filter-chain.h"
+#include "image.h"
+
+#include <chrono>
+
+namespace librealsense
+{
+    // Bands are sized so that the input, the two intermediate buffers and the output of a band
+    // stay in the L2 cache while every stage of the run works on it
+    const size_t band_size_bytes = 64 * 1024;
+
+    fused_filter_chain::fused_filter_chain()
+        : generic_processing_block("Fused Filter Chain")
+    {
+    }
+
+    void fused_filter_chain::add(std::shared_ptr<processing_block_interface> block)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Blocks report their result synchronously from invoke(), so a single slot is enough
+        auto on_output = [this](frame_holder fh) { _stage_output = std::move(fh); };
+        block->set_output_callback(std::make_shared<internal_frame_callback<decltype(on_output)>>(on_output));
+
+        stage s{ block, dynamic_cast<band_processing_interface*>(block.get()),
+                 block->get_info(RS2_CAMERA_INFO_NAME), RS2_FORMAT_ANY, 0., 0, false };
+        _stages.push_back(s);
+    }
+
+    std::vector<fused_filter_chain::stage_timing> fused_filter_chain::get_stage_timings()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::vector<stage_timing> res;
+        for (auto&& s : _stages)
+            res.push_back({ s.name, s.frames ? s.total_ms / s.frames : 0., s.frames, s.fused });
+        return res;
+    }
+
+    const char* fused_filter_chain::get_stage_name(size_t index)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (index >= _stages.size())
+            throw invalid_value_exception(to_string() << "Stage index " << index << " is out of range");
+        return _stages[index].name.c_str();
+    }
+
+    void fused_filter_chain::reset_stage_timings()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto&& s : _stages)
+        {
+            s.total_ms = 0.;
+            s.frames = 0;
+        }
+    }
+
+    bool fused_filter_chain::should_process(const rs2::frame& frame)
+    {
+        return frame && !frame.is<rs2::frameset>() && frame.is<rs2::video_frame>()
+            && frame.get_profile().stream_type() == RS2_STREAM_DEPTH;
+    }
+
+    // Called with _mutex held (see generic_processing_block), which keeps _stages stable for the whole frame
+    rs2::frame fused_filter_chain::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        rs2::frame res = f;
+        size_t i = 0;
+        while (i < _stages.size() && res)
+        {
+            if (auto fused = process_bands(source, res, i))
+            {
+                i += fused;
+                continue;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            res = process_whole_frame(_stages[i], res);
+            auto& s = _stages[i++];
+            s.total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            s.frames++;
+            s.fused = false;
+        }
+        return res;
+    }
+
+    size_t fused_filter_chain::process_bands(const rs2::frame_source& source, rs2::frame& f, size_t first)
+    {
+        auto vf = f.as<rs2::video_frame>();
+        if (!vf)
+            return 0;
+
+        auto width = size_t(vf.get_width());
+        auto height = size_t(vf.get_height());
+        auto format = f.get_profile().format();
+        auto in_bpp = size_t(get_image_bpp(format) / 8);
+        if (!width || !height || size_t(vf.get_stride_in_bytes()) != width * in_bpp)
+            return 0;
+
+        // Collect the longest run of stages that can work on bands of this frame
+        size_t end = first;
+        for (; end < _stages.size() && _stages[end].bands; ++end)
+        {
+            auto next = _stages[end].bands->prepare_bands(f, format);
+            if (next == RS2_FORMAT_ANY)
+                break;
+            _stages[end].band_format = format = next;
+        }
+        if (end == first)
+            return 0;
+
+        auto out_bpp = size_t(get_image_bpp(format) / 8);
+        auto tgt = source.allocate_video_frame(get_target_profile(f, format), f, int(out_bpp), int(width), int(height),
+            int(width * out_bpp), format == RS2_FORMAT_DISPARITY32 ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME);
+        if (!tgt)
+            return 0;
+
+        auto band_rows = std::max<size_t>(1, band_size_bytes / (width * sizeof(float)));
+        for (auto&& buf : _band_buffers)
+            buf.resize(band_rows * width * sizeof(float));
+
+        auto src = static_cast<const uint8_t*>(f.get_data());
+        auto dst = static_cast<uint8_t*>(const_cast<void*>(tgt.get_data()));
+        for (size_t row = 0; row < height; row += band_rows)
+        {
+            auto rows = std::min(band_rows, height - row);
+            const void* in = src + row * width * in_bpp;
+
+            for (size_t i = first; i < end; i++)
+            {
+                void* out = (i + 1 == end) ? dst + row * width * out_bpp : _band_buffers[(i - first) & 1].data();
+
+                auto start = std::chrono::steady_clock::now();
+                _stages[i].bands->process_band(in, out, width, rows);
+                _stages[i].total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+                in = out;
+            }
+        }
+
+        for (size_t i = first; i < end; i++)
+        {
+            _stages[i].frames++;
+            _stages[i].fused = true;
+        }
+
+        f = tgt;
+        return end - first;
+    }
+
+    rs2::frame fused_filter_chain::process_whole_frame(stage& s, const rs2::frame& f)
+    {
+        auto fi = (frame_interface*)f.get();
+        fi->acquire();
+        s.block->invoke(frame_holder(fi));
+
+        // Only synchronous blocks are supported (see add()); nothing here means the frame was dropped
+        frame_interface* res = nullptr;
+        std::swap(_stage_output.frame, res);
+        return rs2::frame((rs2_frame*)res);
+    }
+
+    rs2::stream_profile fused_filter_chain::get_target_profile(const rs2::frame& f, rs2_format format)
+    {
+        if (f.get_profile().get() != _source_stream_profile.get())
+        {
+            _source_stream_profile = f.get_profile();
+            _target_stream_profiles.clear();
+        }
+
+        auto it = _target_stream_profiles.find(format);
+        if (it != _target_stream_profiles.end())
+            return it->second;
+
+        auto tgt = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, format);
+        auto src_vspi = dynamic_cast<video_stream_profile_interface*>(_source_stream_profile.get()->profile);
+        auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(tgt.get()->profile);
+        rs2_intrinsics src_intrin = src_vspi->get_intrinsics();
+        tgt_vspi->set_intrinsics([src_intrin]() { return src_intrin; });
+        tgt_vspi->set_dims(src_intrin.width, src_intrin.height);
+
+        _target_stream_profiles[format] = tgt;
+        return tgt;
+    }
+}
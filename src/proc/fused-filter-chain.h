@@ -0,0 +1,63 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+namespace librealsense
+{
+    // Runs a chain of depth processing blocks as a single block.
+    // Consecutive blocks that implement band_processing_interface are executed together, one
+    // cache-sized band of rows at a time, into a single output frame. Any other block (or a block
+    // whose current configuration needs the whole frame) is invoked on the whole frame as usual.
+    class fused_filter_chain : public generic_processing_block
+    {
+    public:
+        struct stage_timing
+        {
+            std::string name;
+            double average_ms;          // Average time spent in the stage per frame
+            unsigned long long frames;  // Frames that went through the stage
+            bool fused;                 // Whether the last frame was processed in bands
+        };
+
+        fused_filter_chain();
+
+        // The chain takes over the output of the block. The block must output its result from within invoke(),
+        // as every block of the library does; the result of a block that outputs later, from another thread,
+        // is lost and ends the chain for that frame.
+        void add(std::shared_ptr<processing_block_interface> block);
+        std::vector<stage_timing> get_stage_timings();
+        const char* get_stage_name(size_t index);
+        void reset_stage_timings();
+
+    protected:
+        bool should_process(const rs2::frame& frame) override;
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        struct stage
+        {
+            std::shared_ptr<processing_block_interface> block;
+            band_processing_interface* bands;
+            std::string name;
+            rs2_format band_format;     // Output format of the stage in the current band run
+            double total_ms;
+            unsigned long long frames;
+            bool fused;
+        };
+
+        size_t process_bands(const rs2::frame_source& source, rs2::frame& f, size_t first);
+        rs2::frame process_whole_frame(stage& s, const rs2::frame& f);
+        rs2::stream_profile get_target_profile(const rs2::frame& f, rs2_format format);
+
+        // Guarded by _mutex, which generic_processing_block holds around process_frame(), so
+        // add() and the timing accessors never race with the frame being processed
+        std::vector<stage> _stages;
+        std::vector<uint8_t> _band_buffers[2];
+        frame_holder _stage_output;
+        rs2::stream_profile _source_stream_profile;
+        std::map<rs2_format, rs2::stream_profile> _target_stream_profiles;
+    };
+}
@@ -3,12 +3,73 @@
 
 #include "hdr-merge.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
 namespace librealsense
 {
+#ifdef __SSSE3__
+    // IR validity is (under < ir < over); values are biased so that the signed 16-bit
+    // compares also hold for the full unsigned Y16 range
+    static inline __m128i merge_8_pixels(__m128i d0, __m128i d1, __m128i i0, __m128i i1, __m128i under, __m128i over)
+    {
+        const __m128i bias = _mm_set1_epi16(short(0x8000));
+        const __m128i zero = _mm_setzero_si128();
+        i0 = _mm_xor_si128(i0, bias);
+        i1 = _mm_xor_si128(i1, bias);
+        auto valid0 = _mm_andnot_si128(_mm_cmpeq_epi16(d0, zero),
+            _mm_and_si128(_mm_cmpgt_epi16(i0, under), _mm_cmpgt_epi16(over, i0)));
+        auto valid1 = _mm_andnot_si128(_mm_cmpeq_epi16(d1, zero),
+            _mm_and_si128(_mm_cmpgt_epi16(i1, under), _mm_cmpgt_epi16(over, i1)));
+        return _mm_or_si128(_mm_and_si128(valid0, d0), _mm_andnot_si128(valid0, _mm_and_si128(valid1, d1)));
+    }
+#endif
+
+    int hdr_merge_rows_using_ir(uint16_t* out, const uint16_t* d0, const uint16_t* d1,
+        const uint8_t* i0, const uint8_t* i1, int count, int under, int over)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i u = _mm_set1_epi16(short(under ^ 0x8000));
+        const __m128i o = _mm_set1_epi16(short(over ^ 0x8000));
+        for (; i + 8 <= count; i += 8)
+        {
+            auto ir0 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(i0 + i)), zero);
+            auto ir1 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(i1 + i)), zero);
+            auto res = merge_8_pixels(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d0 + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(d1 + i)), ir0, ir1, u, o);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), res);
+        }
+#endif
+        return i;
+    }
+
+    int hdr_merge_rows_using_ir(uint16_t* out, const uint16_t* d0, const uint16_t* d1,
+        const uint16_t* i0, const uint16_t* i1, int count, int under, int over)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        const __m128i u = _mm_set1_epi16(short(under ^ 0x8000));
+        const __m128i o = _mm_set1_epi16(short(over ^ 0x8000));
+        for (; i + 8 <= count; i += 8)
+        {
+            auto res = merge_8_pixels(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d0 + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(d1 + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(i0 + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(i1 + i)), u, o);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), res);
+        }
+#endif
+        return i;
+    }
+
     hdr_merge::hdr_merge()
         : generic_processing_block("HDR Merge"),
         _previous_depth_frame_counter(0),
-        _frames_without_requested_metadata_counter(0)
+        _frames_without_requested_metadata_counter(0),
+        _framesets_count(0)
     {}
 
     // processing only framesets
@@ -82,21 +143,21 @@ namespace librealsense
         // saving frame of sequence id 0
         // so that the merging with be deterministic - always done with frame n and n+1
         // with frame n as basis
-        if (_framesets.size() == depth_seq_id)
+        if (_framesets_count < 2 && depth_seq_id == static_cast<rs2_metadata_type>(_framesets_count))
         {
-            _framesets[(int)depth_seq_id] = fs;
+            _framesets[_framesets_count++] = fs;
         }
 
         // discard merged frame if not relevant
         discard_depth_merged_frame_if_needed(f);
 
         // 3. check if size of this vector is at least 2 (if not - return latest merge frame)
-        if (_framesets.size() >= 2)
+        if (_framesets_count >= 2)
         {
             // 4. pop out both framesets from the vector
-            rs2::frameset fs_0 = _framesets[0];
-            rs2::frameset fs_1 = _framesets[1];
-            _framesets.clear();
+            rs2::frameset fs_0 = std::move(_framesets[0]);
+            rs2::frameset fs_1 = std::move(_framesets[1]);
+            _framesets_count = 0;
 
             bool use_ir = false;
             if (check_frames_mergeability(fs_0, fs_1, use_ir))
@@ -142,7 +203,7 @@ namespace librealsense
         }
     }
 
-    bool hdr_merge::check_frames_mergeability(const rs2::frameset first_fs, const rs2::frameset second_fs,
+    bool hdr_merge::check_frames_mergeability(const rs2::frameset& first_fs, const rs2::frameset& second_fs,
         bool& use_ir) const
     {
         auto first_depth = first_fs.get_depth_frame();
@@ -167,17 +228,15 @@ namespace librealsense
         return true;
     }
 
-    rs2::frame hdr_merge::merging_algorithm(const rs2::frame_source& source, const rs2::frameset first_fs, const rs2::frameset second_fs, const bool use_ir) const
+    rs2::frame hdr_merge::merging_algorithm(const rs2::frame_source& source, const rs2::frameset& first_fs, const rs2::frameset& second_fs, const bool use_ir) const
     {
-        auto first = first_fs;
-        auto second = second_fs;
-
-        auto first_depth = first.get_depth_frame();
-        auto second_depth = second.get_depth_frame();
-        auto first_ir = first.get_infrared_frame();
-        auto second_ir = second.get_infrared_frame();
+        auto first_depth = first_fs.get_depth_frame();
+        auto second_depth = second_fs.get_depth_frame();
+        auto first_ir = first_fs.get_infrared_frame();
+        auto second_ir = second_fs.get_infrared_frame();
 
-        // new frame allocation
+        // new frame allocation - served from the frame source freelist without touching the
+        // heap once downstream releases merged frames (see RS2_OPTION_FRAMES_QUEUE_SIZE)
         auto vf = first_depth.as<rs2::depth_frame>();
         auto width = vf.get_width();
         auto height = vf.get_height();
@@ -196,28 +255,25 @@ namespace librealsense
 
             ptr->set_sensor(orig->get_sensor());
 
-            memset(new_data, 0, width * height * sizeof(uint16_t));
-
-            int width_height_product = width * height;
-
+            // Every pixel is written by the merge kernels, no need to clear the buffer first
             if (use_ir)
             {
                 if (first_ir.get_profile().format() == RS2_FORMAT_Y8)
                 {
-                    merge_frames_using_ir<uint8_t>(new_data, d0, d1, first_ir, second_ir, width_height_product);
+                    merge_frames_using_ir<uint8_t>(new_data, d0, d1, first_ir, second_ir, width, height);
                 }
                 else if (first_ir.get_profile().format() == RS2_FORMAT_Y16)
                 {
-                    merge_frames_using_ir<uint16_t>(new_data, d0, d1, first_ir, second_ir, width_height_product);
+                    merge_frames_using_ir<uint16_t>(new_data, d0, d1, first_ir, second_ir, width, height);
                 }
                 else
                 {
-                    merge_frames_using_only_depth(new_data, d0, d1, width_height_product);
+                    merge_frames_using_only_depth(new_data, d0, d1, width, height);
                 }
             }
             else
             {
-                merge_frames_using_only_depth(new_data, d0, d1, width_height_product);
+                merge_frames_using_only_depth(new_data, d0, d1, width, height);
             }
 
             return new_f;
@@ -225,16 +281,26 @@ namespace librealsense
         return first_fs;
     }
 
-    void hdr_merge::merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width_height_prod) const
+    void hdr_merge::merge_frames_using_only_depth(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1, int width, int height) const
     {
-        for (int i = 0; i < width_height_prod; i++)
+#pragma omp parallel for
+        for (int j = 0; j < height; j++)
         {
-            if (d0[i])
-                new_data[i] = d0[i];
-            else if (d1[i])
-                new_data[i] = d1[i];
-            else
-                new_data[i] = 0;
+            int i = j * width;
+            const int end = i + width;
+#ifdef __SSSE3__
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 8 <= end; i += 8)
+            {
+                auto v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d0 + i));
+                auto v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d1 + i));
+                auto holes = _mm_cmpeq_epi16(v0, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(new_data + i),
+                    _mm_or_si128(_mm_andnot_si128(holes, v0), _mm_and_si128(holes, v1)));
+            }
+#endif
+            for (; i < end; i++)
+                new_data[i] = d0[i] ? d0[i] : d1[i];
         }
     }
 
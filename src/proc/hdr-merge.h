@@ -9,6 +9,12 @@ Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
 
 namespace librealsense
 {
+    // Vectorized merge kernels; return the number of leading pixels of the row they processed
+    int hdr_merge_rows_using_ir(uint16_t* out, const uint16_t* d0, const uint16_t* d1,
+        const uint8_t* i0, const uint8_t* i1, int count, int under, int over);
+    int hdr_merge_rows_using_ir(uint16_t* out, const uint16_t* d0, const uint16_t* d1,
+        const uint16_t* i0, const uint16_t* i1, int count, int under, int over);
+
     class hdr_merge : public generic_processing_block
     {
     public:
@@ -32,42 +38,53 @@ namespace librealsense
         void reset_warning_counter_on_pipe_restart(const rs2::depth_frame& depth_frame);
         void discard_depth_merged_frame_if_needed(const rs2::frame& f);
 
-        bool check_frames_mergeability(const rs2::frameset first_fs, const rs2::frameset second_fs, bool& use_ir) const;
+        bool check_frames_mergeability(const rs2::frameset& first_fs, const rs2::frameset& second_fs, bool& use_ir) const;
         bool should_ir_be_used_for_merging(const rs2::depth_frame& first_depth, const rs2::video_frame& first_ir,
             const rs2::depth_frame& second_depth, const rs2::video_frame& second_ir) const;
-        rs2::frame merging_algorithm(const rs2::frame_source& source, const rs2::frameset first_fs,
-            const rs2::frameset second_fs, const bool use_ir) const;
+        rs2::frame merging_algorithm(const rs2::frame_source& source, const rs2::frameset& first_fs,
+            const rs2::frameset& second_fs, const bool use_ir) const;
         template <typename T>
         bool is_infrared_valid(T ir_value, rs2_format ir_format) const;
         template <typename T>
-        void merge_frames_using_ir(uint16_t* new_data, uint16_t* d0, uint16_t* d1,
-            const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width_height_prod) const;
-        void merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width_height_prod) const;
+        void merge_frames_using_ir(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1,
+            const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width, int height) const;
+        void merge_frames_using_only_depth(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1, int width, int height) const;
 
         unsigned long long _previous_depth_frame_counter;
         int _frames_without_requested_metadata_counter;
-        std::map<int, rs2::frameset> _framesets;
+        // Pairing buffer, indexed by sequence id; filled strictly in order 0, 1
+        rs2::frameset _framesets[2];
+        size_t _framesets_count;
         rs2::frame _depth_merged_frame;
     };
     MAP_EXTENSION(RS2_EXTENSION_HDR_MERGE, librealsense::hdr_merge);
 
     template <typename T>
-    void hdr_merge::merge_frames_using_ir(uint16_t* new_data, uint16_t* d0, uint16_t* d1,
-        const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width_height_prod) const
+    void hdr_merge::merge_frames_using_ir(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1,
+        const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width, int height) const
     {
-        auto i0 = (T*)first_ir.get_data();
-        auto i1 = (T*)second_ir.get_data();
+        auto i0 = (const T*)first_ir.get_data();
+        auto i1 = (const T*)second_ir.get_data();
 
         auto format = first_ir.get_profile().format();
+        auto under = (format == RS2_FORMAT_Y8) ? IR_UNDER_SATURATED_VALUE_Y8 : IR_UNDER_SATURATED_VALUE_Y16;
+        auto over = (format == RS2_FORMAT_Y8) ? IR_OVER_SATURATED_VALUE_Y8 : IR_OVER_SATURATED_VALUE_Y16;
 
-        for (int i = 0; i < width_height_prod; i++)
+#pragma omp parallel for
+        for (int j = 0; j < height; j++)
         {
-            if (is_infrared_valid<T>(i0[i], format) && d0[i])
-                new_data[i] = d0[i];
-            else if (is_infrared_valid<T>(i1[i], format) && d1[i])
-                new_data[i] = d1[i];
-            else
-                new_data[i] = 0;
+            auto offset = j * width;
+            int i = hdr_merge_rows_using_ir(new_data + offset, d0 + offset, d1 + offset, i0 + offset, i1 + offset, width, under, over);
+            for (; i < width; i++)
+            {
+                auto idx = offset + i;
+                if (is_infrared_valid<T>(i0[idx], format) && d0[idx])
+                    new_data[idx] = d0[idx];
+                else if (is_infrared_valid<T>(i1[idx], format) && d1[idx])
+                    new_data[idx] = d1[idx];
+                else
+                    new_data[idx] = 0;
+            }
         }
     }
 
@@ -24,7 +24,8 @@ namespace librealsense
         _width(0), _height(0), _stride(0), _bpp(0),
         _extension_type(RS2_EXTENSION_DEPTH_FRAME),
         _current_frm_size_pixels(0),
-        _hole_filling_mode(hole_fill_def)
+        _hole_filling_mode(hole_fill_def),
+        _band_format(RS2_FORMAT_ANY)
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -68,6 +69,32 @@ namespace librealsense
         return tgt;
     }
 
+    rs2_format hole_filling_filter::prepare_bands(const rs2::frame& f, rs2_format input_format)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_hole_filling_mode != hf_fill_from_left || f.get_profile().stream_type() != RS2_STREAM_DEPTH
+            || (input_format != RS2_FORMAT_Z16 && input_format != RS2_FORMAT_DISPARITY32))
+            return RS2_FORMAT_ANY;
+
+        _band_format = input_format;
+        return input_format;
+    }
+
+    void hole_filling_filter::process_band(const void* in, void* out, size_t width, size_t rows)
+    {
+        if (_band_format == RS2_FORMAT_DISPARITY32)
+        {
+            memmove(out, in, width * rows * sizeof(float));
+            holes_fill_left(reinterpret_cast<float*>(out), width, rows, width * sizeof(float));
+        }
+        else
+        {
+            memmove(out, in, width * rows * sizeof(uint16_t));
+            holes_fill_left(reinterpret_cast<uint16_t*>(out), width, rows, width * sizeof(uint16_t));
+        }
+    }
+
     void  hole_filling_filter::update_configuration(const rs2::frame& f)
     {
         if (f.get_profile().get() != _source_stream_profile.get())
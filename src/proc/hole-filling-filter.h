@@ -13,11 +13,15 @@ namespace librealsense
         hf_max_value
     };
 
-    class hole_filling_filter : public depth_processing_block
+    class hole_filling_filter : public depth_processing_block, public band_processing_interface
     {
     public:
         hole_filling_filter();
 
+        // Only "Fill from Left" is row-local; the other modes look at the neighbouring rows
+        rs2_format prepare_bands(const rs2::frame& f, rs2_format input_format) override;
+        void process_band(const void* in, void* out, size_t width, size_t rows) override;
+
     protected:
         void update_configuration(const rs2::frame& f);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
@@ -165,6 +169,7 @@ namespace librealsense
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
         uint8_t                 _hole_filling_mode;
+        rs2_format              _band_format;
     };
     MAP_EXTENSION(RS2_EXTENSION_HOLE_FILLING_FILTER, librealsense::hole_filling_filter);
 }
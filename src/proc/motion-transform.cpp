@@ -122,5 +122,235 @@ namespace librealsense
     {
         unpack_gyro_axes<RS2_FORMAT_MOTION_XYZ32F>(dest, source, width, height, actual_size);
     }
-}
 
+    motion_batcher::motion_batcher()
+        : processing_block("Motion Batcher"),
+        _raw(false),
+        _transform{ {1,0,0},{0,1,0},{0,0,1} },
+        _corrected_transform(_transform),
+        _bias{ 0, 0, 0 },
+        _batch_size(std::make_shared<float_option>(option_range{ 1, 1000, 1, 16 }, "Motion samples gathered in a frame")),
+        _max_age(std::make_shared<float_option>(option_range{ 1, 1000, 1, 20 }, "Milliseconds after which a batch of motion samples is sent, even if not full")),
+        _emitting(false),
+        _stopping(false)
+    {
+        register_option(RS2_OPTION_MOTION_BATCH_SIZE, _batch_size);
+        register_option(RS2_OPTION_MOTION_BATCH_MAX_AGE, _max_age);
+
+        auto process_callback = [this](frame_holder frame, synthetic_source_interface* source)
+        {
+            add_sample(std::move(frame), source);
+        };
+        set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(
+            new internal_frame_processor_callback<decltype(process_callback)>(process_callback)));
+    }
+
+    motion_batcher::motion_batcher(rs2_stream target_stream,
+        std::shared_ptr<mm_calib_handler> mm_calib,
+        std::shared_ptr<enable_motion_correction> mm_correct_opt,
+        std::shared_ptr<option> batch_size,
+        std::shared_ptr<option> max_age)
+        : motion_batcher()
+    {
+        _raw = true;
+        _mm_correct_opt = mm_correct_opt;
+        _batch_size = batch_size;
+        _max_age = max_age;
+
+        // The conversion of unpack_accel_axes() / unpack_gyro_axes() and correct_motion(), as a single matrix
+        float factor = target_stream == RS2_STREAM_ACCEL ? float(0.001 * 9.80665) : float(deg2rad(0.1));
+        float3x3 scale{ { factor, 0, 0 }, { 0, factor, 0 }, { 0, 0, factor } };
+        float3x3 alignment = mm_calib ? (*mm_calib).imu_to_depth_alignment() : float3x3{ {1,0,0},{0,1,0},{0,0,1} };
+        _transform = alignment * scale;
+        _corrected_transform = _transform;
+        if (mm_calib && _mm_correct_opt)
+        {
+            auto intr = (*mm_calib).get_intrinsic(target_stream);
+            _corrected_transform = intr.sensitivity * _transform;
+            _bias = intr.bias;
+        }
+    }
+
+    motion_batcher::~motion_batcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _timer_cv.notify_all();
+        if (_timer.joinable())
+            _timer.join();
+    }
+
+    void motion_batcher::on_input_stopped()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto&& e : _batches)
+                if (!e.second.timestamps.empty())
+                    send(e.second, &_source_wrapper);
+        }
+        emit_ready();
+    }
+
+    // Sends the batches whose first sample waited the maximal age, and sleeps until the next one will have.
+    // A batch started while it sleeps is due after it wakes up, so it does not need to be woken.
+    void motion_batcher::send_expired()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_stopping)
+        {
+            auto max_age = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<float, std::milli>(_max_age->query()));
+            auto now = std::chrono::steady_clock::now();
+            auto wake = now + max_age;
+            bool sent = false;
+            for (auto&& e : _batches)
+            {
+                auto& b = e.second;
+                if (b.timestamps.empty())
+                    continue;
+                auto deadline = b.first_arrival + max_age;
+                if (deadline <= now)
+                {
+                    send(b, &_source_wrapper);
+                    sent = true;
+                }
+                else
+                    wake = std::min(wake, deadline);
+            }
+            if (sent)
+            {
+                lock.unlock();
+                emit_ready();
+                lock.lock();
+                continue;
+            }
+            _timer_cv.wait_until(lock, wake);
+        }
+    }
+
+    // Applies m to every sample and subtracts bias. The samples are independent and their axes stored apart,
+    // so the loop compiles to SIMD instructions
+    static void transform_samples(const float3x3& m, const float3& bias,
+        const float* x, const float* y, const float* z, float* out_x, float* out_y, float* out_z, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out_x[i] = m.x.x * x[i] + m.y.x * y[i] + m.z.x * z[i] - bias.x;
+            out_y[i] = m.x.y * x[i] + m.y.y * y[i] + m.z.y * z[i] - bias.y;
+            out_z[i] = m.x.z * x[i] + m.y.z * y[i] + m.z.z * z[i] - bias.z;
+        }
+    }
+
+    void motion_batcher::add_sample(frame_holder frame, synthetic_source_interface* source)
+    {
+        auto profile = frame->get_stream();
+        if (!profile || !dynamic_cast<motion_frame*>(frame.frame) ||
+            (!_raw && profile->get_format() != RS2_FORMAT_MOTION_XYZ32F))
+        {
+            source->frame_ready(std::move(frame));
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_timer.joinable())
+            _timer = std::thread([this]() { send_expired(); });
+
+        auto&& b = _batches[profile->get_unique_id()];
+        if (b.source_profile != profile)
+        {
+            b.source_profile = profile;
+            b.target_profile = profile->clone();
+            b.target_profile->set_stream_type(profile->get_stream_type());
+            b.target_profile->set_stream_index(profile->get_stream_index());
+            b.target_profile->set_format(RS2_FORMAT_MOTION_XYZ32F_BATCH);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (b.timestamps.empty())
+            b.first_arrival = now;
+
+        auto data = frame->get_frame_data();
+        b.timestamps.push_back(frame->get_frame_timestamp());
+        if (_raw)
+        {
+            auto hid = reinterpret_cast<const hid_data*>(data);
+            b.x.push_back(hid->x);
+            b.y.push_back(hid->y);
+            b.z.push_back(hid->z);
+        }
+        else
+        {
+            auto xyz = reinterpret_cast<const float3*>(data);
+            b.x.push_back(xyz->x);
+            b.y.push_back(xyz->y);
+            b.z.push_back(xyz->z);
+        }
+        b.last = std::move(frame);
+
+        auto age = std::chrono::duration<float, std::milli>(now - b.first_arrival).count();
+        if (b.timestamps.size() >= size_t(_batch_size->query()) || age >= _max_age->query())
+        {
+            send(b, source);
+            lock.unlock();
+            emit_ready();
+        }
+    }
+
+    // Called with _mutex locked. The batch frame is output by emit_ready() once the lock is released.
+    void motion_batcher::send(batch& b, synthetic_source_interface* source)
+    {
+        auto count = b.timestamps.size();
+        auto size = sizeof(rs2_motion_batch_header) + count * (sizeof(double) + 3 * sizeof(float));
+        frame_holder res = source->allocate_motion_frame(b.target_profile, b.last.frame, RS2_EXTENSION_MOTION_FRAME, size);
+
+        auto data = const_cast<byte*>(res->get_frame_data());
+        rs2_motion_batch_header header{ static_cast<unsigned int>(count), { 0, 0, 0 } };
+        memcpy(data, &header, sizeof(header));
+        auto timestamps = reinterpret_cast<double*>(data + sizeof(header));
+        memcpy(timestamps, b.timestamps.data(), count * sizeof(double));
+        auto x = reinterpret_cast<float*>(timestamps + count);
+        auto y = x + count;
+        auto z = y + count;
+
+        if (_raw)
+        {
+            bool corrected = _mm_correct_opt && _mm_correct_opt->query() > 0.f;
+            transform_samples(corrected ? _corrected_transform : _transform, corrected ? _bias : float3{ 0, 0, 0 },
+                b.x.data(), b.y.data(), b.z.data(), x, y, z, count);
+        }
+        else
+        {
+            memcpy(x, b.x.data(), count * sizeof(float));
+            memcpy(y, b.y.data(), count * sizeof(float));
+            memcpy(z, b.z.data(), count * sizeof(float));
+        }
+
+        b.timestamps.clear();
+        b.x.clear();
+        b.y.clear();
+        b.z.clear();
+        b.last = {};
+        _ready.push_back(std::move(res));
+    }
+
+    // Called with no lock held, as the callback may call back into the batcher. Whoever finds frames ready
+    // outputs them all, so that the frames of the timer and of the samples thread go out in order.
+    void motion_batcher::emit_ready()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_emitting)
+            return;
+        _emitting = true;
+        while (!_ready.empty())
+        {
+            auto f = std::move(_ready.front());
+            _ready.pop_front();
+            lock.unlock();
+            _source_wrapper.frame_ready(std::move(f));
+            lock.lock();
+        }
+        _emitting = false;
+    }
+}
@@ -3,6 +3,12 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <thread>
+
 namespace librealsense
 {
     class enable_motion_correction;
@@ -53,4 +59,59 @@ namespace librealsense
         gyroscope_transform(const char* name, std::shared_ptr<mm_calib_handler> mm_calib, std::shared_ptr<enable_motion_correction> mm_correct_opt);
         void process_function(byte * const dest[], const byte * source, int width, int height, int actual_size, int input_size) override;
     };
+
+    // Gathers the samples of motion streams into frames of RS2_FORMAT_MOTION_XYZ32F_BATCH, one per stream.
+    // A batch is sent once it holds RS2_OPTION_MOTION_BATCH_SIZE samples, once its first sample waited RS2_OPTION_MOTION_BATCH_MAX_AGE
+    // (checked by a timer thread, so a stalled stream still gets its samples), or when the stream stops.
+    // The samples of a batch are converted together, with a loop the compiler vectorizes.
+    // The samples are still allocated as frames one by one before they reach the batcher.
+    class motion_batcher : public processing_block
+    {
+    public:
+        // Batches frames of RS2_FORMAT_MOTION_XYZ32F as they are
+        motion_batcher();
+
+        // Batches the raw samples of a motion sensor and converts them as the acceleration and gyroscope transforms do
+        motion_batcher(rs2_stream target_stream,
+            std::shared_ptr<mm_calib_handler> mm_calib,
+            std::shared_ptr<enable_motion_correction> mm_correct_opt,
+            std::shared_ptr<option> batch_size,
+            std::shared_ptr<option> max_age);
+        ~motion_batcher();
+
+        void on_input_stopped() override;
+
+    private:
+        struct batch
+        {
+            std::vector<double> timestamps;
+            std::vector<float> x, y, z;
+            frame_holder last;          // The batch frame carries its header and metadata
+            std::chrono::steady_clock::time_point first_arrival;
+            std::shared_ptr<stream_profile_interface> source_profile;
+            std::shared_ptr<stream_profile_interface> target_profile;
+        };
+
+        void add_sample(frame_holder frame, synthetic_source_interface* source);
+        void send(batch& b, synthetic_source_interface* source);
+        void emit_ready();
+        void send_expired();
+
+        bool _raw;                      // Input is raw HID samples, rather than converted ones
+        float3x3 _transform;            // Of the raw samples to the output
+        float3x3 _corrected_transform;  // With the IMU calibration applied
+        float3 _bias;
+        std::shared_ptr<enable_motion_correction> _mm_correct_opt;
+        std::shared_ptr<option> _batch_size;
+        std::shared_ptr<option> _max_age;
+
+        // Guarded by _mutex
+        std::map<int, batch> _batches;  // By stream profile unique id
+        std::deque<frame_holder> _ready;    // Batch frames waiting to be output, oldest first
+        bool _emitting;
+
+        std::thread _timer;             // Started with the first sample
+        std::condition_variable _timer_cv;
+        bool _stopping;
+    };
 }
@@ -61,49 +61,6 @@ namespace librealsense
            }
 
        return res;
-   }
-   template<size_t SIZE>
-   void rotate_image_optimized(byte* dest[], const byte* source, int width, int height)
-   {
-
-       auto width_out = height;
-       auto height_out = width;
-
-       auto out = dest[0];
-       auto buffer_size = maxDivisorRange(height, width, 1, ROTATION_BUFFER_SIZE); 
-
-       byte** buffer = new byte * [buffer_size];
-       for (int i = 0; i < buffer_size; ++i)
-           buffer[i] = new byte[buffer_size * SIZE];
-
-
-       for (int i = 0; i <= height - buffer_size; i = i + buffer_size)
-       {
-           for (int j = 0; j <= width - buffer_size; j = j + buffer_size)
-           {
-               for (int ii = 0; ii < buffer_size; ++ii)
-               {
-                   for (int jj = 0; jj < buffer_size; ++jj)
-                   {
-                       auto source_index = ((j + jj) + (width * (i + ii))) * SIZE;
-                       memcpy((void*)&(buffer[(buffer_size-1 - jj)][(buffer_size-1 - ii) * SIZE]), &source[source_index], SIZE);
-                   }
-               }
-
-               for (int ii = 0; ii < buffer_size; ++ii)
-               {
-                   auto out_index = (((height_out - buffer_size - j + 1) * width_out) - i - buffer_size + (ii)*width_out);
-                   memcpy(&out[(out_index)*SIZE], (buffer[ii]), buffer_size * SIZE);
-               }
-           }
-       }
-
-       for (int i = 0; i < buffer_size; ++i)
-       {
-           delete[] buffer[i];
-       }
-       delete[] buffer;
- 
    }
     // IMPORTANT! This implementation is based on the assumption that the RGB sensor is positioned strictly to the left of the depth sensor.
     // namely D415/D435 and SR300. The implementation WILL NOT work properly for different setups
@@ -170,7 +127,7 @@ namespace librealsense
            byte* depth_planes[1];
            depth_planes[0] = alloc.data();
 
-           rotate_image_optimized<2>(depth_planes, (const byte*)(depth.get_data()), points_width, points_height);
+           rotate_image(depth_planes[0], (const byte*)(depth.get_data()), points_width, points_height, 2, image_rotation::transverse);
 
            // scan depth frame after rotation: check if there is a noticed jump between adjacen pixels in Z-axis (depth), it means there could be occlusion.
            // save suspected points and run occlusion-invalidation vertical scan only on them
@@ -5,6 +5,7 @@
 #include "environment.h"
 #include "proc/occlusion-filter.h"
 #include "proc/pointcloud.h"
+#include "proc/deprojection-table.h"
 #include "option.h"
 #include "environment.h"
 #include "context.h"
@@ -22,25 +23,14 @@
 
 namespace librealsense
 {
-    template<class MAP_DEPTH> void deproject_depth(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, MAP_DEPTH map_depth)
-    {
-        for (int y = 0; y < intrin.height; ++y)
-        {
-            for (int x = 0; x < intrin.width; ++x)
-            {
-                const float pixel[] = { (float)x, (float)y };
-                rs2_deproject_pixel_to_point(points, &intrin, pixel, map_depth(*depth++));
-                points += 3;
-            }
-        }
-    }
-
     const float3 * pointcloud::depth_to_points(rs2::points output, 
         const rs2_intrinsics &depth_intrinsics, const rs2::depth_frame& depth_frame)
     {
+        if (!_deprojection || !_deprojection->matches(depth_intrinsics, 0.f))
+            _deprojection = get_deprojection_table(depth_intrinsics);
+
         auto image = output.get_vertices();
-        auto depth_scale = depth_frame.get_units();
-        deproject_depth((float*)image, depth_intrinsics, (const uint16_t*)depth_frame.get_data(), [depth_scale](uint16_t z) { return depth_scale * z; });
+        deproject_depth((float3*)image, *_deprojection, (const uint16_t*)depth_frame.get_data(), depth_frame.get_units());
         return (float3*)image;
     }
 
@@ -7,6 +7,7 @@
 namespace librealsense
 {
     class occlusion_filter;
+    class deprojection_table;
 
     class LRS_EXTENSION_API pointcloud : public stream_filter_processing_block
     {
@@ -45,6 +46,8 @@ namespace librealsense
 
         // Intermediate translation table of (depth_x*depth_y) with actual texel coordinates per depth pixel
         std::vector<float2>                    _pixels_map;
+        // Per-pixel rays of the depth intrinsics, shared with other blocks using the same intrinsics
+        std::shared_ptr<const deprojection_table> _deprojection;
 
         rs2::stream_profile _output_stream;
         rs2::frame _other_stream;
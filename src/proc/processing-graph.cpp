@@ -0,0 +1,494 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "proc/processing-graph.h"
+
+#include "archive.h"
+#include "core/video.h"
+
+#include <condition_variable>
+#include <functional>
+#include <thread>
+
+namespace librealsense
+{
+    // Every worker runs the tasks it pushed itself newest first, so a frame tends to go down the
+    // graph on the thread that started it while its data is still in the cache, and takes the
+    // oldest task of another worker when it has nothing left.
+    class processing_graph::worker_pool
+    {
+    public:
+        explicit worker_pool(size_t threads)
+        {
+            for (size_t i = 0; i < threads; ++i)
+                _workers.emplace_back(new worker());
+            for (size_t i = 0; i < threads; ++i)
+                _threads.emplace_back([this, i]() { work(i); });
+        }
+
+        // Tasks that did not start yet are discarded
+        ~worker_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _cv.notify_all();
+            for (auto&& t : _threads)
+                t.join();
+        }
+
+        void push(std::function<void()> task)
+        {
+            auto index = (_current == this) ? _current_index : _next++ % _workers.size();
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                ++_pending;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_workers[index]->mutex);
+                _workers[index]->tasks.push_back(std::move(task));
+            }
+            _cv.notify_one();
+        }
+
+    private:
+        struct worker
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        bool pop(size_t self, std::function<void()>& task)
+        {
+            for (size_t i = 0; i < _workers.size(); ++i)
+            {
+                auto& w = *_workers[(self + i) % _workers.size()];
+                std::lock_guard<std::mutex> lock(w.mutex);
+                if (w.tasks.empty())
+                    continue;
+                if (i == 0)
+                {
+                    task = std::move(w.tasks.back());
+                    w.tasks.pop_back();
+                }
+                else
+                {
+                    task = std::move(w.tasks.front());
+                    w.tasks.pop_front();
+                }
+                return true;
+            }
+            return false;
+        }
+
+        void work(size_t self)
+        {
+            _current = this;
+            _current_index = self;
+
+            while (true)
+            {
+                std::function<void()> task;
+                if (pop(self, task))
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        --_pending;
+                    }
+                    try
+                    {
+                        task();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        LOG_ERROR("Exception was thrown by a processing graph task: " << e.what());
+                    }
+                    continue;
+                }
+
+                // A task is counted before it is pushed, so this may briefly spin until it shows up
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(lock, [&]() { return _stopping || _pending > 0; });
+                if (_stopping)
+                    return;
+            }
+        }
+
+        std::vector<std::unique_ptr<worker>> _workers;
+        std::vector<std::thread> _threads;
+        std::atomic<size_t> _next{ 0 };
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        size_t _pending = 0;
+        bool _stopping = false;
+
+        static thread_local worker_pool* _current;
+        static thread_local size_t _current_index;
+    };
+
+    thread_local processing_graph::worker_pool* processing_graph::worker_pool::_current = nullptr;
+    thread_local size_t processing_graph::worker_pool::_current_index = 0;
+
+    processing_graph::processing_graph(int threads)
+        : processing_block("Processing Graph"),
+        _leaves_count(0), _next_seq(0), _in_flight(0), _dropped_inputs(0), _next_emit(0), _emitting(false)
+    {
+        size_t count = threads > 0 ? size_t(threads) : std::max(1u, std::thread::hardware_concurrency());
+        // Frames in the graph keep their sensor and block frame pools busy, so only a few are let in
+        _capacity = std::min<size_t>(std::max<size_t>(2 * count, 4), 16);
+        _pool.reset(new worker_pool(count));
+    }
+
+    processing_graph::~processing_graph()
+    {
+        // Running tasks finish before the nodes go away
+        _pool.reset();
+    }
+
+    processing_graph::node& processing_graph::get_node(int index)
+    {
+        std::lock_guard<std::mutex> lock(_input_mutex);
+        return find_node(index);
+    }
+
+    // Called with _input_mutex locked. Nodes are held by pointer, so the reference stays valid as nodes are added.
+    processing_graph::node& processing_graph::find_node(int index)
+    {
+        if (index < 0 || index >= int(_nodes.size()))
+            throw invalid_value_exception(to_string() << "Node index " << index << " is out of range");
+        return *_nodes[index];
+    }
+
+    void processing_graph::attach(node& n, std::shared_ptr<processing_block_interface> block)
+    {
+        std::unique_ptr<replica> r(new replica());
+        r->block = block;
+        auto ptr = r.get();
+
+        // Blocks report their result synchronously from invoke(), on the thread that runs the replica.
+        // By the time a later result comes, the frame has moved on without it.
+        auto name = n.name;
+        auto on_output = [ptr, name](frame_holder fh) {
+            if (ptr->invoking)
+                ptr->output = std::move(fh);
+            else
+                LOG_WARNING("Processing graph node " << name << " output a frame outside of invoke(), dropping it");
+        };
+        block->set_output_callback(std::make_shared<internal_frame_callback<decltype(on_output)>>(on_output));
+        n.replicas.push_back(std::move(r));
+    }
+
+    int processing_graph::add_node(std::shared_ptr<processing_block_interface> block, int parent)
+    {
+        std::lock_guard<std::mutex> lock(_input_mutex);
+
+        if (_next_seq)
+            throw wrong_api_call_sequence_exception("Nodes cannot be added once the graph processed frames");
+        if (parent >= int(_nodes.size()))
+            throw invalid_value_exception(to_string() << "Parent node " << parent << " is out of range");
+
+        std::unique_ptr<node> n(new node());
+        n->name = block->get_info(RS2_CAMERA_INFO_NAME);
+        n->leaf = -1;
+        n->queue_size = _capacity;
+        n->next_forward = 0;
+        n->processed = 0;
+        n->dropped = 0;
+        n->total_latency_ms = 0.;
+        attach(*n, block);
+
+        auto index = int(_nodes.size());
+        _nodes.push_back(std::move(n));
+        if (parent < 0)
+            _roots.push_back(index);
+        else
+            _nodes[parent]->children.push_back(index);
+        return index;
+    }
+
+    void processing_graph::add_replica(int index, std::shared_ptr<processing_block_interface> block)
+    {
+        std::lock_guard<std::mutex> lock(_input_mutex);
+
+        if (_next_seq)
+            throw wrong_api_call_sequence_exception("Replicas cannot be added once the graph processed frames");
+        attach(find_node(index), block);
+    }
+
+    void processing_graph::set_queue_size(int index, size_t size)
+    {
+        auto& n = get_node(index);
+        std::lock_guard<std::mutex> lock(n.mutex);
+        n.queue_size = std::max<size_t>(size, 1);
+    }
+
+    size_t processing_graph::get_nodes_count()
+    {
+        std::lock_guard<std::mutex> lock(_input_mutex);
+        return _nodes.size();
+    }
+
+    const char* processing_graph::get_node_name(int index)
+    {
+        return get_node(index).name.c_str();
+    }
+
+    processing_graph::node_stats processing_graph::get_node_stats(int index)
+    {
+        auto& n = get_node(index);
+        std::lock_guard<std::mutex> lock(n.mutex);
+        return { n.queue.size(), n.queue_size, n.processed, n.dropped,
+                 n.processed ? n.total_latency_ms / n.processed : 0. };
+    }
+
+    void processing_graph::invoke(frame_holder frame)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_input_mutex);
+            if (!_nodes.empty())
+            {
+                enqueue(std::move(frame));
+                frame = frame_holder();
+            }
+        }
+
+        // The callback may call back into the graph, so it is only ever called with no lock held
+        if (frame)
+            _source_wrapper.frame_ready(std::move(frame));
+        else
+            emit_completed();
+    }
+
+    // Called with _input_mutex locked
+    void processing_graph::enqueue(frame_holder frame)
+    {
+
+        if (!_next_seq)
+        {
+            _leaves_count = 0;
+            for (auto&& n : _nodes)
+            {
+                if (n->children.empty())
+                    n->leaf = int(_leaves_count++);
+                n->results.resize(_capacity);
+                n->done.assign(_capacity, false);
+            }
+            std::lock_guard<std::mutex> output_lock(_output_mutex);
+            _jobs.resize(_capacity);
+            for (auto&& j : _jobs)
+            {
+                j.outputs.resize(_leaves_count);
+                j.active = false;
+            }
+        }
+
+        if (_in_flight >= _capacity)
+        {
+            _dropped_inputs++;
+            return;
+        }
+
+        auto seq = _next_seq++;
+        _in_flight++;
+        {
+            std::lock_guard<std::mutex> output_lock(_output_mutex);
+            auto& j = _jobs[seq % _capacity];
+            j.leaves_remaining = _leaves_count;
+            j.active = true;
+        }
+
+        for (auto root : _roots)
+            submit(root, seq, frame.clone());
+    }
+
+    void processing_graph::submit(int index, unsigned long long seq, frame_holder frame)
+    {
+        auto& n = *_nodes[index];
+        std::lock_guard<std::mutex> lock(n.mutex);
+
+        // Frames dropped or filtered out upstream still go through, to keep every node in step
+        if (!frame)
+        {
+            complete(index, seq, frame_holder());
+            return;
+        }
+
+        n.queue.push_back({ seq, std::move(frame), std::chrono::steady_clock::now() });
+        if (n.queue.size() > n.queue_size)
+        {
+            auto oldest = n.queue.front().seq;
+            n.queue.pop_front();
+            n.dropped++;
+            complete(index, oldest, frame_holder());
+        }
+        dispatch(index);
+    }
+
+    void processing_graph::dispatch(int index)
+    {
+        auto& n = *_nodes[index];
+        for (auto&& r : n.replicas)
+        {
+            if (n.queue.empty())
+                break;
+            if (r->busy)
+                continue;
+
+            r->busy = true;
+            auto it = std::make_shared<item>(std::move(n.queue.front()));
+            n.queue.pop_front();
+            auto ptr = r.get();
+            _pool->push([this, index, ptr, it]() { run(index, ptr, std::move(*it)); });
+        }
+    }
+
+    void processing_graph::run(int index, replica* r, item it)
+    {
+        auto& n = *_nodes[index];
+        r->invoking = true;
+        r->block->invoke(std::move(it.frame));
+        r->invoking = false;
+        auto result = std::move(r->output);
+        auto end = std::chrono::steady_clock::now();
+
+        {
+            std::lock_guard<std::mutex> lock(n.mutex);
+            if (result && n.replicas.size() > 1)
+                unify_profile(n, result.frame);
+            r->busy = false;
+            n.processed++;
+            n.total_latency_ms += std::chrono::duration<double, std::milli>(end - it.arrival).count();
+            complete(index, it.seq, std::move(result));
+            dispatch(index);
+        }
+        emit_completed();
+    }
+
+    // Every replica creates its own output profiles, and blocks downstream reset their state
+    // (temporal filter history, cached tables) when the profile of their input changes
+    void processing_graph::unify_profile(node& n, frame_interface* f)
+    {
+        if (auto composite = dynamic_cast<composite_frame*>(f))
+        {
+            for (size_t i = 0; i < composite->get_embedded_frames_count(); ++i)
+                unify_profile(n, composite->get_frame(int(i)));
+            return;
+        }
+
+        auto sp = f->get_stream();
+        if (!sp)
+            return;
+        auto vsp = dynamic_cast<video_stream_profile_interface*>(sp.get());
+        for (auto&& p : n.profiles)
+        {
+            if (p == sp)
+                return;
+            if (p->get_stream_type() != sp->get_stream_type() || p->get_stream_index() != sp->get_stream_index()
+                || p->get_format() != sp->get_format())
+                continue;
+            auto vp = dynamic_cast<video_stream_profile_interface*>(p.get());
+            if (vsp && (!vp || vp->get_width() != vsp->get_width() || vp->get_height() != vsp->get_height()))
+                continue;
+
+            f->set_stream(p);
+            return;
+        }
+        n.profiles.push_back(sp);
+    }
+
+    // Called with the node locked. Children are locked after their parent, which cannot deadlock
+    // since nodes are only ever added below existing ones.
+    void processing_graph::complete(int index, unsigned long long seq, frame_holder result)
+    {
+        auto& n = *_nodes[index];
+        n.results[seq % _capacity] = std::move(result);
+        n.done[seq % _capacity] = true;
+
+        while (n.done[n.next_forward % _capacity])
+        {
+            auto slot = n.next_forward % _capacity;
+            auto s = n.next_forward++;
+            n.done[slot] = false;
+            auto res = std::move(n.results[slot]);
+
+            for (auto child : n.children)
+                submit(child, s, res ? res.clone() : frame_holder());
+            if (n.leaf >= 0)
+                leaf_done(n.leaf, s, std::move(res));
+        }
+    }
+
+    // Called with the leaf node locked, so the frame is only recorded here and output by emit_completed()
+    void processing_graph::leaf_done(int leaf, unsigned long long seq, frame_holder result)
+    {
+        std::lock_guard<std::mutex> lock(_output_mutex);
+        auto& j = _jobs[seq % _capacity];
+        j.outputs[leaf] = std::move(result);
+        j.leaves_remaining--;
+    }
+
+    // Called with no lock held. Whoever finds the oldest frame completed outputs it and every completed
+    // frame after it; the others leave their frames to it. This also keeps a callback that invokes
+    // the graph again from outputting a frame ahead of the one it is handling.
+    void processing_graph::emit_completed()
+    {
+        std::unique_lock<std::mutex> lock(_output_mutex);
+        if (_emitting || _jobs.empty())
+            return;
+        _emitting = true;
+        while (true)
+        {
+            auto& next = _jobs[_next_emit % _capacity];
+            if (!next.active || next.leaves_remaining)
+                break;
+
+            std::vector<frame_holder> outputs(_leaves_count);
+            outputs.swap(next.outputs);
+            next.active = false;
+            _next_emit++;
+            lock.unlock();
+
+            _in_flight--;
+            emit(std::move(outputs));
+            lock.lock();
+        }
+        _emitting = false;
+    }
+
+    void processing_graph::emit(std::vector<frame_holder> outputs)
+    {
+        if (_leaves_count == 1)
+        {
+            if (outputs[0])
+                _source_wrapper.frame_ready(std::move(outputs[0]));
+            return;
+        }
+
+        std::vector<frame_holder> frames;
+        for (auto&& f : outputs)
+        {
+            if (!f)
+                continue;
+            if (auto composite = dynamic_cast<composite_frame*>(f.frame))
+            {
+                for (size_t i = 0; i < composite->get_embedded_frames_count(); ++i)
+                {
+                    auto embedded = composite->get_frame(int(i));
+                    embedded->acquire();
+                    frames.emplace_back(embedded);
+                }
+            }
+            else
+            {
+                frames.push_back(std::move(f));
+            }
+        }
+        if (frames.empty())
+            return;
+
+        if (auto res = _source_wrapper.allocate_composite_frame(std::move(frames)))
+            _source_wrapper.frame_ready(res);
+    }
+}
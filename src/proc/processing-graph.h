@@ -0,0 +1,134 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+
+namespace librealsense
+{
+    // Runs a graph of processing blocks asynchronously on a pool of worker threads.
+    // The graph is a tree: every node processes the output of a single parent node, or the frames given
+    // to the graph, and several frames can be in the graph at once, each in a different node. There is
+    // no fan-in; results of separate branches only come together in the output of the graph.
+    // A node with a single block processes its frames one at a time and in order, as stateful blocks
+    // (temporal filter, HDR merge) need. Stateless blocks can be given replicas: interchangeable
+    // instances that process that many frames in parallel. Nodes forward their results in frame
+    // order, and the graph outputs the result of its leaf node (or a frameset of the results of its
+    // leaves) once per input frame, in the order the frames came in.
+    class processing_graph : public processing_block
+    {
+    public:
+        struct node_stats
+        {
+            size_t queue_depth;         // Frames waiting for a block of the node
+            size_t queue_size;          // Waiting frames above which the oldest one is dropped
+            unsigned long long processed;
+            unsigned long long dropped;
+            double average_latency_ms;  // From the arrival of a frame at the node to its result
+        };
+
+        // threads: number of worker threads, or 0 for one per core
+        explicit processing_graph(int threads = 0);
+        ~processing_graph();
+
+        // Adds a node fed by the node at index parent, or by the graph input when parent is negative,
+        // and returns its index. A node has exactly one parent.
+        // The graph takes over the output of the block, which must output its result from within
+        // invoke(), as every block of the library does. A result output later, from another thread,
+        // is dropped with a warning and the frame counts as filtered out by the node.
+        // Nodes and replicas can only be added before the first frame.
+        int add_node(std::shared_ptr<processing_block_interface> block, int parent);
+        void add_replica(int node, std::shared_ptr<processing_block_interface> block);
+        void set_queue_size(int node, size_t size);
+
+        size_t get_nodes_count();
+        const char* get_node_name(int node);
+        node_stats get_node_stats(int node);
+        // Input frames dropped because the graph already held as many frames as it can
+        unsigned long long get_dropped_frames() const { return _dropped_inputs; }
+
+        void invoke(frame_holder frame) override;
+
+    private:
+        class worker_pool;
+
+        struct item
+        {
+            unsigned long long seq;
+            frame_holder frame;
+            std::chrono::steady_clock::time_point arrival;
+        };
+
+        struct replica
+        {
+            std::shared_ptr<processing_block_interface> block;
+            frame_holder output;    // Set by the block from within invoke()
+            std::atomic<bool> invoking{ false };
+            bool busy = false;
+        };
+
+        struct node
+        {
+            std::string name;
+            int leaf;               // Index among the leaves, or -1
+            std::vector<int> children;
+            std::vector<std::unique_ptr<replica>> replicas;
+            // Output profiles of the first replica to create them, shared by the others
+            std::vector<std::shared_ptr<stream_profile_interface>> profiles;
+
+            std::mutex mutex;
+            std::deque<item> queue;
+            size_t queue_size;
+            // Results waiting for the ones of earlier frames, indexed by frame sequence
+            std::vector<frame_holder> results;
+            std::vector<bool> done;
+            unsigned long long next_forward;
+
+            unsigned long long processed;
+            unsigned long long dropped;
+            double total_latency_ms;
+        };
+
+        struct job
+        {
+            std::vector<frame_holder> outputs;  // One per leaf
+            size_t leaves_remaining;
+            bool active;
+        };
+
+        void enqueue(frame_holder frame);
+        node& get_node(int index);
+        node& find_node(int index);
+        void attach(node& n, std::shared_ptr<processing_block_interface> block);
+        void submit(int index, unsigned long long seq, frame_holder frame);
+        void dispatch(int index);
+        void run(int index, replica* r, item it);
+        void unify_profile(node& n, frame_interface* f);
+        void complete(int index, unsigned long long seq, frame_holder result);
+        void leaf_done(int leaf, unsigned long long seq, frame_holder result);
+        void emit_completed();
+        void emit(std::vector<frame_holder> outputs);
+
+        std::vector<std::unique_ptr<node>> _nodes;
+        std::vector<int> _roots;
+        size_t _leaves_count;
+        size_t _capacity;           // Frames that can be in the graph at once
+
+        std::mutex _input_mutex;
+        unsigned long long _next_seq;
+        std::atomic<size_t> _in_flight;
+        std::atomic<unsigned long long> _dropped_inputs;
+
+        std::mutex _output_mutex;
+        std::vector<job> _jobs;     // Indexed by frame sequence
+        unsigned long long _next_emit;
+        bool _emitting;
+
+        std::unique_ptr<worker_pool> _pool;
+    };
+}
@@ -9,78 +9,329 @@
 #include "image.h"
 #include "stream.h"
 
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#endif
+
 namespace librealsense
 {
     //// Unpacking routines ////
-    template<size_t SIZE>
-    void rotate_image_optimized(byte * const dest[], const byte * source, int width, int height, int actual_size)
+    // 8x8 blocks: out[i] gets column i of the rows in[0..7]
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    static inline void transpose_8x8(const uint8_t* const in[8], uint8_t* const out[8])
     {
-        auto width_out = height;
-        auto height_out = width;
+        uint8x8x2_t t01 = vtrn_u8(vld1_u8(in[0]), vld1_u8(in[1]));
+        uint8x8x2_t t23 = vtrn_u8(vld1_u8(in[2]), vld1_u8(in[3]));
+        uint8x8x2_t t45 = vtrn_u8(vld1_u8(in[4]), vld1_u8(in[5]));
+        uint8x8x2_t t67 = vtrn_u8(vld1_u8(in[6]), vld1_u8(in[7]));
+        uint16x4x2_t u02 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]), vreinterpret_u16_u8(t23.val[0]));
+        uint16x4x2_t u13 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]), vreinterpret_u16_u8(t23.val[1]));
+        uint16x4x2_t u46 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]), vreinterpret_u16_u8(t67.val[0]));
+        uint16x4x2_t u57 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]), vreinterpret_u16_u8(t67.val[1]));
+        uint32x2x2_t v04 = vtrn_u32(vreinterpret_u32_u16(u02.val[0]), vreinterpret_u32_u16(u46.val[0]));
+        uint32x2x2_t v15 = vtrn_u32(vreinterpret_u32_u16(u13.val[0]), vreinterpret_u32_u16(u57.val[0]));
+        uint32x2x2_t v26 = vtrn_u32(vreinterpret_u32_u16(u02.val[1]), vreinterpret_u32_u16(u46.val[1]));
+        uint32x2x2_t v37 = vtrn_u32(vreinterpret_u32_u16(u13.val[1]), vreinterpret_u32_u16(u57.val[1]));
+        vst1_u8(out[0], vreinterpret_u8_u32(v04.val[0]));
+        vst1_u8(out[1], vreinterpret_u8_u32(v15.val[0]));
+        vst1_u8(out[2], vreinterpret_u8_u32(v26.val[0]));
+        vst1_u8(out[3], vreinterpret_u8_u32(v37.val[0]));
+        vst1_u8(out[4], vreinterpret_u8_u32(v04.val[1]));
+        vst1_u8(out[5], vreinterpret_u8_u32(v15.val[1]));
+        vst1_u8(out[6], vreinterpret_u8_u32(v26.val[1]));
+        vst1_u8(out[7], vreinterpret_u8_u32(v37.val[1]));
+    }
 
-        auto out = dest[0];
-        byte buffer[8][8 * SIZE]; // = { 0 };
-        for (int i = 0; i <= height - 8; i = i + 8)
+    static inline void transpose_8x8(const uint16_t* const in[8], uint16_t* const out[8])
+    {
+        uint16x8x2_t t01 = vtrnq_u16(vld1q_u16(in[0]), vld1q_u16(in[1]));
+        uint16x8x2_t t23 = vtrnq_u16(vld1q_u16(in[2]), vld1q_u16(in[3]));
+        uint16x8x2_t t45 = vtrnq_u16(vld1q_u16(in[4]), vld1q_u16(in[5]));
+        uint16x8x2_t t67 = vtrnq_u16(vld1q_u16(in[6]), vld1q_u16(in[7]));
+        uint32x4x2_t u02 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0]));
+        uint32x4x2_t u13 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1]));
+        uint32x4x2_t u46 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0]));
+        uint32x4x2_t u57 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]));
+        auto store = [](uint16_t* dst, uint32x2_t lo, uint32x2_t hi) { vst1q_u16(dst, vreinterpretq_u16_u32(vcombine_u32(lo, hi))); };
+        store(out[0], vget_low_u32(u02.val[0]), vget_low_u32(u46.val[0]));
+        store(out[1], vget_low_u32(u13.val[0]), vget_low_u32(u57.val[0]));
+        store(out[2], vget_low_u32(u02.val[1]), vget_low_u32(u46.val[1]));
+        store(out[3], vget_low_u32(u13.val[1]), vget_low_u32(u57.val[1]));
+        store(out[4], vget_high_u32(u02.val[0]), vget_high_u32(u46.val[0]));
+        store(out[5], vget_high_u32(u13.val[0]), vget_high_u32(u57.val[0]));
+        store(out[6], vget_high_u32(u02.val[1]), vget_high_u32(u46.val[1]));
+        store(out[7], vget_high_u32(u13.val[1]), vget_high_u32(u57.val[1]));
+    }
+
+    static inline void transpose_4x4(const uint32_t* const in[4], int x, uint32_t* const out[4], int y)
+    {
+        uint32x4x2_t t01 = vtrnq_u32(vld1q_u32(in[0] + x), vld1q_u32(in[1] + x));
+        uint32x4x2_t t23 = vtrnq_u32(vld1q_u32(in[2] + x), vld1q_u32(in[3] + x));
+        vst1q_u32(out[0] + y, vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])));
+        vst1q_u32(out[1] + y, vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])));
+        vst1q_u32(out[2] + y, vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+        vst1q_u32(out[3] + y, vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+    }
+
+    static inline void transpose_8x8(const uint32_t* const in[8], uint32_t* const out[8])
+    {
+        transpose_4x4(in, 0, out, 0);
+        transpose_4x4(in, 4, out + 4, 0);
+        transpose_4x4(in + 4, 0, out, 4);
+        transpose_4x4(in + 4, 4, out + 4, 4);
+    }
+
+    // Reverses the order of 16 bytes of pixels
+    static inline void reverse_16(const uint8_t* in, uint8_t* out, uint8_t)
+    {
+        uint8x16_t v = vrev64q_u8(vld1q_u8(in));
+        vst1q_u8(out, vcombine_u8(vget_high_u8(v), vget_low_u8(v)));
+    }
+    static inline void reverse_16(const uint8_t* in, uint8_t* out, uint16_t)
+    {
+        uint16x8_t v = vrev64q_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(in)));
+        vst1q_u16(reinterpret_cast<uint16_t*>(out), vcombine_u16(vget_high_u16(v), vget_low_u16(v)));
+    }
+    static inline void reverse_16(const uint8_t* in, uint8_t* out, uint32_t)
+    {
+        uint32x4_t v = vrev64q_u32(vld1q_u32(reinterpret_cast<const uint32_t*>(in)));
+        vst1q_u32(reinterpret_cast<uint32_t*>(out), vcombine_u32(vget_high_u32(v), vget_low_u32(v)));
+    }
+#elif defined(__SSSE3__)
+    static inline void transpose_8x8(const uint8_t* const in[8], uint8_t* const out[8])
+    {
+        auto row = [&](int i) { return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in[i])); };
+        __m128i a0 = _mm_unpacklo_epi8(row(0), row(1));
+        __m128i a1 = _mm_unpacklo_epi8(row(2), row(3));
+        __m128i a2 = _mm_unpacklo_epi8(row(4), row(5));
+        __m128i a3 = _mm_unpacklo_epi8(row(6), row(7));
+        __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+        __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+        __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+        __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+        // Two columns in each
+        __m128i c[4] = { _mm_unpacklo_epi32(b0, b2), _mm_unpackhi_epi32(b0, b2), _mm_unpacklo_epi32(b1, b3), _mm_unpackhi_epi32(b1, b3) };
+        for (int i = 0; i < 4; ++i)
         {
-            for (int j = 0; j <= width - 8; j = j + 8)
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out[2 * i]), c[i]);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out[2 * i + 1]), _mm_srli_si128(c[i], 8));
+        }
+    }
+
+    static inline void transpose_8x8(const uint16_t* const in[8], uint16_t* const out[8])
+    {
+        auto row = [&](int i) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in[i])); };
+        __m128i r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3), r4 = row(4), r5 = row(5), r6 = row(6), r7 = row(7);
+        __m128i a0 = _mm_unpacklo_epi16(r0, r1), a1 = _mm_unpackhi_epi16(r0, r1);
+        __m128i a2 = _mm_unpacklo_epi16(r2, r3), a3 = _mm_unpackhi_epi16(r2, r3);
+        __m128i a4 = _mm_unpacklo_epi16(r4, r5), a5 = _mm_unpackhi_epi16(r4, r5);
+        __m128i a6 = _mm_unpacklo_epi16(r6, r7), a7 = _mm_unpackhi_epi16(r6, r7);
+        __m128i b0 = _mm_unpacklo_epi32(a0, a2), b1 = _mm_unpackhi_epi32(a0, a2);
+        __m128i b2 = _mm_unpacklo_epi32(a1, a3), b3 = _mm_unpackhi_epi32(a1, a3);
+        __m128i b4 = _mm_unpacklo_epi32(a4, a6), b5 = _mm_unpackhi_epi32(a4, a6);
+        __m128i b6 = _mm_unpacklo_epi32(a5, a7), b7 = _mm_unpackhi_epi32(a5, a7);
+        auto store = [&](int i, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out[i]), v); };
+        store(0, _mm_unpacklo_epi64(b0, b4));
+        store(1, _mm_unpackhi_epi64(b0, b4));
+        store(2, _mm_unpacklo_epi64(b1, b5));
+        store(3, _mm_unpackhi_epi64(b1, b5));
+        store(4, _mm_unpacklo_epi64(b2, b6));
+        store(5, _mm_unpackhi_epi64(b2, b6));
+        store(6, _mm_unpacklo_epi64(b3, b7));
+        store(7, _mm_unpackhi_epi64(b3, b7));
+    }
+
+#ifdef __AVX2__
+    static inline void transpose_8x8(const uint32_t* const in[8], uint32_t* const out[8])
+    {
+        auto row = [&](int i) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in[i])); };
+        __m256i r[8];
+        for (int i = 0; i < 8; ++i)
+            r[i] = row(i);
+        __m256i a[8], b[8];
+        for (int i = 0; i < 4; ++i)
+        {
+            a[2 * i] = _mm256_unpacklo_epi32(r[2 * i], r[2 * i + 1]);
+            a[2 * i + 1] = _mm256_unpackhi_epi32(r[2 * i], r[2 * i + 1]);
+        }
+        for (int i = 0; i < 2; ++i)
+        {
+            b[4 * i] = _mm256_unpacklo_epi64(a[4 * i], a[4 * i + 2]);
+            b[4 * i + 1] = _mm256_unpackhi_epi64(a[4 * i], a[4 * i + 2]);
+            b[4 * i + 2] = _mm256_unpacklo_epi64(a[4 * i + 1], a[4 * i + 3]);
+            b[4 * i + 3] = _mm256_unpackhi_epi64(a[4 * i + 1], a[4 * i + 3]);
+        }
+        // Columns 0-3 in the low lanes, 4-7 in the high ones
+        for (int i = 0; i < 4; ++i)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out[i]), _mm256_permute2x128_si256(b[i], b[i + 4], 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out[i + 4]), _mm256_permute2x128_si256(b[i], b[i + 4], 0x31));
+        }
+    }
+#else
+    static inline void transpose_4x4(const uint32_t* const in[4], int x, uint32_t* const out[4], int y)
+    {
+        auto row = [&](int i) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in[i] + x)); };
+        __m128i r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+        __m128i a0 = _mm_unpacklo_epi32(r0, r1), a1 = _mm_unpacklo_epi32(r2, r3);
+        __m128i a2 = _mm_unpackhi_epi32(r0, r1), a3 = _mm_unpackhi_epi32(r2, r3);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out[0] + y), _mm_unpacklo_epi64(a0, a1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out[1] + y), _mm_unpackhi_epi64(a0, a1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out[2] + y), _mm_unpacklo_epi64(a2, a3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out[3] + y), _mm_unpackhi_epi64(a2, a3));
+    }
+
+    static inline void transpose_8x8(const uint32_t* const in[8], uint32_t* const out[8])
+    {
+        transpose_4x4(in, 0, out, 0);
+        transpose_4x4(in, 4, out + 4, 0);
+        transpose_4x4(in + 4, 0, out, 4);
+        transpose_4x4(in + 4, 4, out + 4, 4);
+    }
+#endif
+
+    // Where byte b of 16 comes from when pixels of n bytes are reversed
+    static constexpr char reversed_byte(int b, int n) { return char(16 - n - b + 2 * (b % n)); }
+
+    template<class T> static inline void reverse_16(const uint8_t* in, uint8_t* out, T)
+    {
+        const int n = sizeof(T);
+        const __m128i mask = _mm_setr_epi8(reversed_byte(0, n), reversed_byte(1, n), reversed_byte(2, n), reversed_byte(3, n),
+            reversed_byte(4, n), reversed_byte(5, n), reversed_byte(6, n), reversed_byte(7, n),
+            reversed_byte(8, n), reversed_byte(9, n), reversed_byte(10, n), reversed_byte(11, n),
+            reversed_byte(12, n), reversed_byte(13, n), reversed_byte(14, n), reversed_byte(15, n));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), mask));
+    }
+#else
+    template<class T> static inline void transpose_8x8(const T* const in[8], T* const out[8])
+    {
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 8; ++j)
+                out[i][j] = in[j][i];
+    }
+
+    template<class T> static inline void reverse_16(const uint8_t* in, uint8_t* out, T)
+    {
+        for (int i = 0; i < 16; i += sizeof(T))
+            memcpy(out + 16 - sizeof(T) - i, in + i, sizeof(T));
+    }
+#endif
+
+    // The quarter turns and the transposes: the pixel at (x, y) goes to row x, or width - 1 - x when
+    // flip_x, and to column y, or height - 1 - y when flip_y, of a height-wide image. Tiles of 64x64
+    // pixels keep both sides in L1 while 8x8 blocks are transposed in registers.
+    template<class T>
+    void transpose_image(byte* dest, const byte* source, int width, int height, bool flip_x, bool flip_y)
+    {
+        const int tile = 64;
+        auto src = reinterpret_cast<const T*>(source);
+        auto dst = reinterpret_cast<T*>(dest);
+        auto out_row = [=](int x) { return dst + size_t(flip_x ? width - 1 - x : x) * height; };
+        auto out_col = [=](int y) { return flip_y ? height - 1 - y : y; };
+
+#pragma omp parallel for
+        for (int ty = 0; ty < height; ty += tile)
+        {
+            int y1 = std::min(ty + tile, height);
+            for (int tx = 0; tx < width; tx += tile)
             {
-                for (int ii = 0; ii < 8; ++ii)
+                int x1 = std::min(tx + tile, width);
+                int y = ty;
+                for (; y + 8 <= y1; y += 8)
                 {
-                    for (int jj = 0; jj < 8; ++jj)
+                    // With flip_y, the rows go in from the bottom so that the columns come out reversed
+                    const T* in[8];
+                    for (int k = 0; k < 8; ++k)
+                        in[k] = src + size_t(flip_y ? y + 7 - k : y + k) * width;
+                    int col = flip_y ? height - 8 - y : y;
+
+                    int x = tx;
+                    for (; x + 8 <= x1; x += 8)
                     {
-                        auto source_index = ((j + jj) + (width * (i + ii))) * SIZE;
-                        memcpy((void*)(&buffer[7 - jj][(7 - ii) * SIZE]), &source[source_index], SIZE);
+                        const T* block_in[8];
+                        T* block_out[8];
+                        for (int k = 0; k < 8; ++k)
+                        {
+                            block_in[k] = in[k] + x;
+                            block_out[k] = out_row(x + k) + col;
+                        }
+                        transpose_8x8(block_in, block_out);
                     }
+                    for (; x < x1; ++x)
+                        for (int k = 0; k < 8; ++k)
+                            out_row(x)[col + k] = in[k][x];
                 }
-
-                for (int ii = 0; ii < 8; ++ii)
-                {
-                    auto out_index = (((height_out - 8 - j + 1) * width_out) - i - 8 + (ii)* width_out);
-                    memcpy(&out[(out_index)* SIZE], &(buffer[ii]), 8 * SIZE);
-                }
+                for (; y < y1; ++y)
+                    for (int x = tx; x < x1; ++x)
+                        out_row(x)[out_col(y)] = src[size_t(y) * width + x];
             }
         }
     }
 
-    template<size_t SIZE>
-    void rotate_image(byte * const dest[], const byte * source, int width, int height, int actual_size)
+    template<class T>
+    void rotate_image_180(byte* dest, const byte* source, int width, int height)
     {
-        auto width_out = height;
-        auto height_out = width;
+        const size_t row_bytes = size_t(width) * sizeof(T);
+#pragma omp parallel for
+        for (int y = 0; y < height; ++y)
+        {
+            auto in = source + y * row_bytes;
+            auto out = dest + (height - 1 - y) * row_bytes;
+            size_t i = 0;
+            for (; i + 16 <= row_bytes; i += 16)
+                reverse_16(in + i, out + row_bytes - 16 - i, T());
+            for (; i < row_bytes; i += sizeof(T))
+                memcpy(out + row_bytes - sizeof(T) - i, in + i, sizeof(T));
+        }
+    }
 
-        auto out = dest[0];
-        for (int i = 0; i < height; ++i)
+    template<class T>
+    void rotate_image(byte* dest, const byte* source, int width, int height, image_rotation rotation)
+    {
+        switch (rotation)
         {
-            auto row_offset = i * width;
-            for (int j = 0; j < width; ++j)
-            {
-                auto out_index = (((height_out - j) * width_out) - i - 1) * SIZE;
-                librealsense::copy((void*)(&out[out_index]), &(source[(row_offset + j) * SIZE]), SIZE);
-            }
+        case image_rotation::rotate_90_cw: transpose_image<T>(dest, source, width, height, false, true); break;
+        case image_rotation::rotate_180: rotate_image_180<T>(dest, source, width, height); break;
+        case image_rotation::rotate_90_ccw: transpose_image<T>(dest, source, width, height, true, false); break;
+        case image_rotation::transpose: transpose_image<T>(dest, source, width, height, false, false); break;
+        case image_rotation::transverse: transpose_image<T>(dest, source, width, height, true, true); break;
         }
     }
 
-    void rotate_confidence(byte * const dest[], const byte * source, int width, int height, int actual_size)
+    void rotate_image(byte* dest, const byte* source, int width, int height, int bpp, image_rotation rotation)
     {
-#pragma pack (push, 1)
-        struct lsb_msb
+        switch (bpp)
         {
-            unsigned lsb : 4;
-            unsigned msb : 4;
-        };
-#pragma pack(pop)
+        case 1: rotate_image<uint8_t>(dest, source, width, height, rotation); break;
+        case 2: rotate_image<uint16_t>(dest, source, width, height, rotation); break;
+        case 4: rotate_image<uint32_t>(dest, source, width, height, rotation); break;
+        default: throw invalid_value_exception(to_string() << "Cannot rotate images of " << bpp << " bytes per pixel");
+        }
+    }
 
-        rotate_image<1>(dest, source, width, height, actual_size);
+    void rotate_confidence(byte * const dest[], const byte * source, int width, int height, int actual_size)
+    {
+        // Two 4-bit pixels in each byte: the bytes are turned, then each line of bytes becomes two
+        // lines of pixels. Going from the last line down, the expansion can be done in place.
         auto out = dest[0];
-        for (int i = (width - 1), out_i = ((width - 1) * 2); i >= 0; --i, out_i -= 2)
+        rotate_image(out, source, width, height, 1, image_rotation::transverse);
+        for (int i = width - 1; i >= 0; --i)
         {
-            auto row_offset = i * height;
+            auto line = out + i * height;
+            auto lsb = out + 2 * i * height;
+            auto msb = lsb + height;
             for (int j = 0; j < height; ++j)
             {
-                auto val = *(reinterpret_cast<const lsb_msb*>(&out[(row_offset + j)]));
-                auto out_index = out_i * height + j;
-                out[out_index] = val.lsb << 4;
-                out[out_index + height] = val.msb << 4;
+                auto val = line[j];
+                lsb[j] = byte(val << 4);
+                msb[j] = byte(val & 0xf0);
             }
         }
     }
@@ -120,10 +371,9 @@ namespace librealsense
         switch (_target_bpp)
         {
         case 1:
-            rotate_image_optimized<1>(dest, source, rotated_width, rotated_height, actual_size);
-            break;
         case 2:
-            rotate_image_optimized<2>(dest, source, rotated_width, rotated_height, actual_size);
+        case 4:
+            rotate_image(dest[0], source, rotated_width, rotated_height, _target_bpp, image_rotation::transverse);
             break;
         default:
             LOG_ERROR("Rotation transform does not support format: " + std::string(rs2_format_to_string(_target_format)));
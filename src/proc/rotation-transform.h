@@ -7,6 +7,20 @@
 
 namespace librealsense
 {
+    // Where the pixels of an image go. All but the half turn swap the width and the height; the
+    // transverse (a quarter turn and a mirror) is what the rotated sensors need.
+    enum class image_rotation
+    {
+        rotate_90_cw,
+        rotate_180,
+        rotate_90_ccw,
+        transpose,
+        transverse
+    };
+
+    // Turns a width x height image of 1, 2 or 4-byte pixels into dest, which must not overlap source
+    void rotate_image(byte* dest, const byte* source, int width, int height, int bpp, image_rotation rotation);
+
     // Processes rotated frames.
     class rotation_transform : public functional_processing_block
     {
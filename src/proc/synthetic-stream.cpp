@@ -28,10 +28,12 @@ namespace librealsense
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
         register_info(RS2_CAMERA_INFO_NAME, name);
         _source.init(std::shared_ptr<metadata_parser_map>());
+        _source.set_trace_stage(name);
     }
 
     void processing_block::invoke(frame_holder f)
     {
+        trace_frame_begin(f.frame);
         auto callback = _source.begin_callback();
         try
         {
@@ -331,6 +333,8 @@ namespace librealsense
             data.metadata_size = 0;
             data.system_time = _actual_source.get_time();
             data.is_blocking = original->is_blocking();
+            if (auto of = dynamic_cast<frame*>(original))
+                data.trace = of->additional_data.trace.forward();
 
             auto res = _actual_source.alloc_frame(frame_type, vid_stream->get_width() * vid_stream->get_height() * sizeof(float) * 5, data, true);
             if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
@@ -393,6 +397,7 @@ namespace librealsense
 
         auto of = dynamic_cast<frame*>(original);
         frame_additional_data data = of->additional_data;
+        data.trace = of->additional_data.trace.forward();
         auto res = _actual_source.alloc_frame(frame_type, stride * height, data, true);
         if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
         vf = dynamic_cast<video_frame*>(res);
@@ -412,11 +417,13 @@ namespace librealsense
 
     frame_interface* synthetic_source::allocate_motion_frame(std::shared_ptr<stream_profile_interface> stream,
         frame_interface* original,
-        rs2_extension frame_type)
+        rs2_extension frame_type,
+        size_t new_size)
     {
         auto of = dynamic_cast<frame*>(original);
         frame_additional_data data = of->additional_data;
-        auto res = _actual_source.alloc_frame(frame_type, of->get_frame_data_size(), data, true);
+        data.trace = of->additional_data.trace.forward();
+        auto res = _actual_source.alloc_frame(frame_type, new_size ? new_size : of->get_frame_data_size(), data, true);
         if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
         auto mf = dynamic_cast<motion_frame*>(res);
         mf->metadata_parsers = of->metadata_parsers;
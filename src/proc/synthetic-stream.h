@@ -29,7 +29,8 @@ namespace librealsense
 
         frame_interface* allocate_motion_frame(std::shared_ptr<stream_profile_interface> stream,
             frame_interface* original,
-            rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME) override;
+            rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME,
+            size_t new_size = 0) override;
 
         frame_interface* allocate_composite_frame(std::vector<frame_holder> frames) override;
 
@@ -54,6 +55,8 @@ namespace librealsense
         void set_output_callback(frame_callback_ptr callback) override;
         void invoke(frame_holder frames) override;
         synthetic_source_interface& get_source() override { return _source_wrapper; }
+        // Called by the sensor once it stopped feeding the block, for blocks that hold frames back to output them
+        virtual void on_input_stopped() {}
 
         virtual ~processing_block() { _source.flush(); }
     protected:
@@ -227,6 +230,21 @@ namespace librealsense
         bool should_process(const rs2::frame& frame) override;
     };
 
+    // Implemented by blocks whose output pixel depends only on the input pixel at the same position
+    // and on pixels to its left, so that a frame can be pushed through several of them one band of
+    // rows at a time (see fused_filter_chain)
+    class band_processing_interface
+    {
+    public:
+        // Prepares the block for a frame derived from f whose pixels are of input_format.
+        // Returns the output format, or RS2_FORMAT_ANY if the frame must be processed as a whole
+        virtual rs2_format prepare_bands(const rs2::frame& f, rs2_format input_format) = 0;
+        // Processes 'rows' complete, contiguous rows of 'width' pixels
+        virtual void process_band(const void* in, void* out, size_t width, size_t rows) = 0;
+
+        virtual ~band_processing_interface() = default;
+    };
+
     // Sequential chained processing blocks
     // The order of the processing blocks defines the execution flow.
     class LRS_EXTENSION_API composite_processing_block : public processing_block
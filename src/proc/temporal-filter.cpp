@@ -42,6 +42,8 @@ namespace librealsense
         _width(0), _height(0), _stride(0), _bpp(0),
         _extension_type(RS2_EXTENSION_DEPTH_FRAME),
         _current_frm_size_pixels(0),
+        _focal_lenght_mm(0.f),
+        _stereo_baseline_mm(0.f), // Stays 0 for depth that does not come from a stereo sensor
          _temppral_delta_LUT_buffer_init_flag(0),
         _temppral_delta_LUT_value_init_flag(0)
     {
@@ -324,6 +326,7 @@ namespace librealsense
         float delta_hf = _delta_param / 2;
         int _max_dist = static_cast<int>(tfb / (_ALTEK_TF_DELTA_MAX_ * 1.0f) + 0.5);
         if (_max_dist < 65535)_max_dist = 65534;
+        if (_max_dist > 65535) _max_dist = 65535;
         for (int i = _ALTEK_TF_MIN_DIST_; i <= _max_dist; i++)
         {
             float tdisp = tfb / (i * 1.0f);
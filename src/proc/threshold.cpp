@@ -13,7 +13,18 @@
 
 namespace librealsense
 {
-    threshold::threshold() : stream_filter_processing_block("Threshold Filter"),_min(0.1f), _max(4.f)
+    // Shared by the whole-frame and the band paths, so that both give the same result
+    static void threshold_depth(const uint16_t* depth_data, uint16_t* new_data, size_t count, float units, float min, float max)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            auto dist = units * depth_data[i];
+            new_data[i] = (dist >= min && dist <= max) ? depth_data[i] : 0;
+        }
+    }
+
+    threshold::threshold() : stream_filter_processing_block("Threshold Filter"),_min(0.1f), _max(4.f),
+        _band_units(0.001f), _band_min(0.1f), _band_max(4.f)
     {
         _stream_filter.format = RS2_FORMAT_Z16;
         _stream_filter.stream = RS2_STREAM_DEPTH;
@@ -60,16 +71,30 @@ namespace librealsense
             ptr->set_sensor(orig->get_sensor());
             auto du = orig->get_units();
 
-            memset(new_data, 0, width * height * sizeof(uint16_t));
-            for (int i = 0; i < width * height; i++)
-            {
-                auto dist = du * depth_data[i];
-                if (dist >= _min && dist <= _max) new_data[i] = depth_data[i];
-            }
+            threshold_depth(depth_data, new_data, size_t(width) * height, du, _min, _max);
 
             return new_f;
         }
 
         return f;
     }
+
+    rs2_format threshold::prepare_bands(const rs2::frame& f, rs2_format input_format)
+    {
+        auto df = f.as<rs2::depth_frame>();
+        if (!df || input_format != RS2_FORMAT_Z16)
+            return RS2_FORMAT_ANY;
+
+        // Latch the range so that all the bands of a frame see the same values
+        _band_units = df.get_units();
+        _band_min = _min;
+        _band_max = _max;
+        return RS2_FORMAT_Z16;
+    }
+
+    void threshold::process_band(const void* in, void* out, size_t width, size_t rows)
+    {
+        threshold_depth(reinterpret_cast<const uint16_t*>(in), reinterpret_cast<uint16_t*>(out),
+            width * rows, _band_units, _band_min, _band_max);
+    }
 }
@@ -12,11 +12,14 @@ namespace rs2
 
 namespace librealsense 
 {
-    class threshold : public stream_filter_processing_block
+    class threshold : public stream_filter_processing_block, public band_processing_interface
     {
     public:
         threshold();
 
+        rs2_format prepare_bands(const rs2::frame& f, rs2_format input_format) override;
+        void process_band(const void* in, void* out, size_t width, size_t rows) override;
+
     protected:
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
@@ -25,6 +28,7 @@ namespace librealsense
         rs2::stream_profile _source_stream_profile;
 
         float _min, _max;
+        float _band_units, _band_min, _band_max;
     };
     MAP_EXTENSION(RS2_EXTENSION_THRESHOLD_FILTER, librealsense::threshold);
 }
@@ -3,6 +3,7 @@
 
 #include "y12i-to-y16y16.h"
 #include "stream.h"
+#include "image-neon.h"
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
@@ -16,7 +17,12 @@ namespace librealsense
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y16_y16_from_y12i_cuda(dest, count, reinterpret_cast<const y12i_pixel *>(source));
 #else
-        split_frame(dest, count, reinterpret_cast<const y12i_pixel*>(source),
+        int done = 0;
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        done = split_y12i_10_neon(dest, source, count);
+#endif
+        byte * const rest[] = { dest[0] + done * sizeof(uint16_t), dest[1] + done * sizeof(uint16_t) };
+        split_frame(rest, count - done, reinterpret_cast<const y12i_pixel*>(source) + done,
             [](const y12i_pixel & p) -> uint16_t { return p.l() << 6 | p.l() >> 4; },  // We want to convert 10-bit data to 16-bit data
             [](const y12i_pixel & p) -> uint16_t { return p.r() << 6 | p.r() >> 4; }); // Multiply by 64 1/16 to efficiently approximate 65535/1023
 #endif
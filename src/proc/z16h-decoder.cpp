@@ -0,0 +1,279 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "z16h-decoder.h"
+#include "../common/decompress-huffman.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Every emission stores 8 bytes and keeps the ones it advances over
+    static const uint32_t store_bytes = 8;
+    static const uint32_t nibbles_per_word = 8;
+    // Stripes shorter than this resynchronize for too large a part of their length
+    static const uint32_t min_stripe_words = 1024;
+    // Stripes decoded together by each thread
+    static const int lanes = 4;
+
+    static inline uint32_t nibble(uint32_t word, uint32_t k)
+    {
+        return (word >> (28 - 4 * k)) & 0xf;
+    }
+
+    z16h_decoder::z16h_decoder()
+        : _table(sizeof(DecompressionStateTable) / sizeof(DecompressionStateTable[0]))
+    {
+        // Source entries: the difference in bits 24-31, the next state's byte offset in bits 6-14,
+        // whether a symbol completes in bit 3 and the run of zero differences that follows in bits 0-2
+        for (size_t i = 0; i < _table.size(); ++i)
+        {
+            auto word = uint32_t(DecompressionStateTable[i]);
+            bool emit = (word & 0x8) != 0;
+            _table[i].delta = emit ? uint8_t(word >> 24) : 0;
+            _table[i].advance = emit ? uint8_t(1 + (word & 0x7)) : 0;
+            _table[i].next = uint16_t((word & 0x7fc0) >> 2);
+            _max_advance = std::max<uint32_t>(_max_advance, _table[i].advance);
+        }
+    }
+
+    bool z16h_decoder::decode(const uint32_t* compressed, uint32_t compressed_u32s, uint32_t stride_bytes, uint32_t height,
+        uint8_t* image, int threads)
+    {
+        if (!compressed || !image || !stride_bytes || !height || compressed_u32s < (stride_bytes + 3) / 4)
+            return false;
+
+        // The first line is not compressed
+        memcpy(image, compressed, stride_bytes);
+        auto first = (stride_bytes + 3) / 4;
+        if (height == 1)
+            return compressed_u32s == first + 1;
+        if (compressed_u32s == first)
+            return false;
+
+        auto words = compressed + first;
+        auto count = compressed_u32s - first;
+        auto end = image + size_t(stride_bytes) * height;
+        threads = std::min<int>(threads, count / (lanes * min_stripe_words));
+        if (threads > 0 && stride_bytes >= store_bytes)
+            return decode_stripes(words, count, stride_bytes, image, end, threads);
+        return decode_single(words, count, stride_bytes, image, end);
+    }
+
+    bool z16h_decoder::decode_single(const uint32_t* words, uint32_t count, uint32_t stride, uint8_t* image, uint8_t* end) const
+    {
+        auto table = _table.data();
+        auto current = image + stride;
+        uint32_t state = 0;
+        uint32_t w = 0;
+
+        // Whole words, without bounds checks, while the longest emissions cannot reach the end
+        if (stride >= store_bytes)
+        {
+            while (w < count && end - current >= std::ptrdiff_t(nibbles_per_word * store_bytes + store_bytes))
+            {
+                auto word = words[w++];
+                for (uint32_t k = 0; k < nibbles_per_word; ++k)
+                {
+                    auto& e = table[state + nibble(word, k)];
+                    uint64_t above;
+                    memcpy(&above, current - stride, sizeof(above));
+                    memcpy(current, &above, sizeof(above));
+                    *current += e.delta;
+                    current += e.advance;
+                    state = e.next;
+                }
+            }
+        }
+
+        for (; w < count; ++w)
+        {
+            auto word = words[w];
+            for (uint32_t k = 0; k < nibbles_per_word; ++k)
+            {
+                auto& e = table[state + nibble(word, k)];
+                state = e.next;
+                if (!e.advance)
+                    continue;
+
+                // The last run may be cut by the end of the image
+                auto n = std::min<std::ptrdiff_t>(e.advance, end - current);
+                for (std::ptrdiff_t i = 0; i < n; ++i)
+                    current[i] = current[i - stride];
+                *current += e.delta;
+                current += n;
+
+                // The image must end in the last word, or on the last nibble of the word before it
+                if (current == end)
+                    return w + 1 == count || (w + 2 == count && k == nibbles_per_word - 1);
+            }
+        }
+        return false;
+    }
+
+    template<int LANES>
+    void z16h_decoder::decode_speculative(const uint32_t* words, stripe* s) const
+    {
+        auto table = _table.data();
+        uint8_t* begin[LANES];
+        uint8_t* out[LANES];
+        uint32_t state[LANES];
+        uint32_t n = ~0u;
+        for (int l = 0; l < LANES; ++l)
+        {
+            auto count = s[l].end_word - s[l].first_word;
+            s[l].deltas.resize(size_t(count) * nibbles_per_word * _max_advance + store_bytes);
+            s[l].states.resize(count + 1);
+            s[l].offsets.resize(count + 1);
+            begin[l] = out[l] = s[l].deltas.data();
+            state[l] = 0;
+            n = std::min(n, count);
+        }
+
+        // Only the differences: the line above is not known yet
+        auto decode_word = [&](int l, uint32_t j)
+        {
+            s[l].states[j] = state[l];
+            s[l].offsets[j] = uint32_t(out[l] - begin[l]);
+            auto word = words[s[l].first_word + j];
+            for (uint32_t k = 0; k < nibbles_per_word; ++k)
+            {
+                auto& e = table[state[l] + nibble(word, k)];
+                uint64_t delta = e.delta;
+                memcpy(out[l], &delta, sizeof(delta));
+                out[l] += e.advance;
+                state[l] = e.next;
+            }
+        };
+
+        // Each nibble depends on the state left by the previous one: going through several stripes
+        // at once keeps more than one lookup in flight
+        for (uint32_t j = 0; j < n; ++j)
+        {
+            uint32_t word[LANES];
+            for (int l = 0; l < LANES; ++l)
+            {
+                s[l].states[j] = state[l];
+                s[l].offsets[j] = uint32_t(out[l] - begin[l]);
+                word[l] = words[s[l].first_word + j];
+            }
+            for (uint32_t k = 0; k < nibbles_per_word; ++k)
+                for (int l = 0; l < LANES; ++l)
+                {
+                    auto& e = table[state[l] + nibble(word[l], k)];
+                    uint64_t delta = e.delta;
+                    memcpy(out[l], &delta, sizeof(delta));
+                    out[l] += e.advance;
+                    state[l] = e.next;
+                }
+        }
+
+        for (int l = 0; l < LANES; ++l)
+        {
+            auto count = s[l].end_word - s[l].first_word;
+            for (uint32_t j = n; j < count; ++j)
+                decode_word(l, j);
+            s[l].states[count] = state[l];
+            s[l].offsets[count] = uint32_t(out[l] - begin[l]);
+        }
+    }
+
+    bool z16h_decoder::decode_stripes(const uint32_t* words, uint32_t count, uint32_t stride, uint8_t* image, uint8_t* end, int threads)
+    {
+        const int stripes = threads * lanes;
+        _stripes.resize(stripes);
+        for (int i = 0; i < stripes; ++i)
+        {
+            _stripes[i].first_word = uint32_t(uint64_t(count) * i / stripes);
+            _stripes[i].end_word = uint32_t(uint64_t(count) * (i + 1) / stripes);
+        }
+
+#pragma omp parallel for num_threads(threads)
+        for (int i = 0; i < threads; ++i)
+            decode_speculative<lanes>(words, &_stripes[i * lanes]);
+
+        // Re-decode the start of each stripe from the state the previous one ended in, until the states
+        // agree. From there on, the speculative output is right and only its offset changes. The states
+        // and offsets before that point are replaced with the true ones.
+        auto table = _table.data();
+        uint32_t state = 0, base = 0;
+        for (auto& s : _stripes)
+        {
+            auto n = s.end_word - s.first_word;
+            s.base = base;
+            s.fixed.clear();
+            uint32_t j = 0;
+            for (; j < n && state != s.states[j]; ++j)
+            {
+                s.states[j] = state;
+                s.offsets[j] = uint32_t(s.fixed.size());
+                auto word = words[s.first_word + j];
+                for (uint32_t k = 0; k < nibbles_per_word; ++k)
+                {
+                    auto& e = table[state + nibble(word, k)];
+                    if (e.advance)
+                    {
+                        s.fixed.push_back(e.delta);
+                        s.fixed.insert(s.fixed.end(), e.advance - 1, 0);
+                    }
+                    state = e.next;
+                }
+            }
+            s.resync = j;
+            if (j < n)
+                state = s.states[n];
+            base += uint32_t(s.fixed.size()) + s.offsets[n] - s.offsets[j];
+        }
+
+        auto deltas = image + stride;
+        auto total = uint32_t(end - deltas);
+        bool good = base >= total;
+        if (good)
+        {
+            // As in decode_single(), the image must end in the last word or on the last nibble of the one before
+            auto& s = _stripes.back();
+            auto j = s.end_word - s.first_word - 2;
+            auto offset = s.base + (j < s.resync ? s.offsets[j] : uint32_t(s.fixed.size()) + s.offsets[j] - s.offsets[s.resync]);
+            auto at = s.states[j];
+            auto word = words[s.first_word + j];
+            for (uint32_t k = 0; k < nibbles_per_word - 1; ++k)
+            {
+                auto& e = table[at + nibble(word, k)];
+                offset += e.advance;
+                at = e.next;
+            }
+            good = offset < total;
+        }
+        else
+            memset(deltas + base, 0, total - base);
+
+#pragma omp parallel for num_threads(threads)
+        for (int i = 0; i < stripes; ++i)
+        {
+            auto& s = _stripes[i];
+            if (s.base >= total)
+                continue;
+            auto n = s.end_word - s.first_word;
+            auto fixed = std::min<uint32_t>(uint32_t(s.fixed.size()), total - s.base);
+            if (fixed)
+                memcpy(deltas + s.base, s.fixed.data(), fixed);
+            auto rest = s.base + uint32_t(s.fixed.size());
+            if (rest < total)
+                memcpy(deltas + rest, s.deltas.data() + s.offsets[s.resync], std::min(s.offsets[n] - s.offsets[s.resync], total - rest));
+        }
+
+        // Each line is the line above plus its differences: independent columns, sequential lines
+        const uint32_t band = 256;
+        const int bands = int((stride + band - 1) / band);
+#pragma omp parallel for num_threads(threads)
+        for (int b = 0; b < bands; ++b)
+        {
+            auto x0 = b * band, x1 = std::min(stride, x0 + band);
+            for (auto above = image, line = image + stride; line < end; above = line, line += stride)
+                for (auto x = x0; x < x1; ++x)
+                    line[x] += above[x];
+        }
+        return good;
+    }
+}
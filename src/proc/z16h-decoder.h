@@ -0,0 +1,57 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace librealsense
+{
+    // Decodes Z16H frames: the first line is sent as is, and every other byte is coded as its
+    // difference from the byte above, with runs of zero differences folded into the preceding
+    // symbol. The firmware's nibble-driven state table (common/decompress-huffman.h) is compacted
+    // into 4-byte entries that emit a symbol and its run without branching.
+    //
+    // The stream has no restart markers, but the code resynchronizes within a few words of a wrong
+    // starting state. Large frames are cut into stripes of whole words that are decoded from state 0,
+    // several per thread at once to overlap their table lookups, and each stripe is then re-decoded
+    // from its true state until it rejoins the speculative result. The lines are rebuilt from the
+    // differences last.
+    class z16h_decoder
+    {
+    public:
+        z16h_decoder();
+
+        // Same contract as unhuffimage4(): returns false unless the compressed words exactly cover
+        // the image. The threads are OpenMP's. Not re-entrant: the scratch buffers are kept between frames.
+        bool decode(const uint32_t* compressed, uint32_t compressed_u32s, uint32_t stride_bytes, uint32_t height,
+            uint8_t* image, int threads = 1);
+
+    private:
+        struct entry
+        {
+            uint8_t delta;      // added to the byte above; 0 when nothing is emitted
+            uint8_t advance;    // bytes emitted: 0, or 1 + the run of zero differences
+            uint16_t next;      // index of the next state's first entry
+        };
+
+        struct stripe
+        {
+            uint32_t first_word, end_word;
+            std::vector<uint8_t> deltas;            // speculative output
+            std::vector<uint32_t> states, offsets;  // at the start of each word, and at the end
+            std::vector<uint8_t> fixed;             // re-decoded from the true state
+            uint32_t resync = 0;                    // first word where the speculation was right
+            uint32_t base = 0;                      // true offset of the stripe's output
+        };
+
+        bool decode_single(const uint32_t* words, uint32_t count, uint32_t stride, uint8_t* image, uint8_t* end) const;
+        bool decode_stripes(const uint32_t* words, uint32_t count, uint32_t stride, uint8_t* image, uint8_t* end, int threads);
+        template<int LANES> void decode_speculative(const uint32_t* words, stripe* s) const;
+
+        std::vector<entry> _table;
+        uint32_t _max_advance = 0;
+        std::vector<stripe> _stripes;
+    };
+}
@@ -2,6 +2,7 @@
 // Copyright(c) 2015 Intel Corporation. All Rights Reserved.
 
 #include <functional>   // For function
+#include <future>
 
 #include "api.h"
 #include "log.h"
@@ -34,6 +35,9 @@
 #include "proc/rates-printer.h"
 #include "proc/hdr-merge.h"
 #include "proc/sequence-id-filter.h"
+#include "proc/fused-filter-chain.h"
+#include "proc/processing-graph.h"
+#include "proc/motion-transform.h"
 #include "media/playback/playback_device.h"
 #include "stream.h"
 #include "../include/librealsense2/h/rs_types.h"
@@ -110,11 +114,12 @@ struct rs2_pipeline_profile
 struct rs2_frame_queue
 {
     explicit rs2_frame_queue(int cap)
-        : queue(cap)
+        : queue(cap), trace_stage(frame_tracer::get_instance().register_stage("Frame queue"))
     {
     }
 
     single_consumer_frame_queue<librealsense::frame_holder> queue;
+    uint16_t trace_stage;
 };
 
 struct rs2_sensor_list
@@ -300,6 +305,44 @@ rs2_device* rs2_create_device(const rs2_device_list* info_list, int index, rs2_e
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, info_list, index)
 
+void rs2_create_devices(const rs2_device_list* info_list, rs2_device** devices, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(info_list);
+    VALIDATE_NOT_NULL(devices);
+    VALIDATE_RANGE(count, (int)info_list->list.size(), (int)info_list->list.size());
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Each construction is dominated by waiting on its own camera, so every device gets a thread
+    std::vector<std::future<std::shared_ptr<librealsense::device_interface>>> created;
+    for (auto&& info : info_list->list)
+        created.push_back(std::async(std::launch::async, [&info]() { return info.info->create_device(); }));
+
+    std::vector<std::shared_ptr<librealsense::device_interface>> results;
+    std::exception_ptr failure;
+    for (auto&& f : created)
+    {
+        try
+        {
+            results.push_back(f.get());
+        }
+        catch (...)
+        {
+            if (!failure)
+                failure = std::current_exception();
+        }
+    }
+    if (failure)
+        std::rethrow_exception(failure);
+
+    LOG_INFO("Created " << results.size() << " devices in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms");
+
+    for (int i = 0; i < count; ++i)
+        devices[i] = new rs2_device{ info_list->ctx, info_list->list[i].info, results[i] };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, info_list, devices, count)
+
 void rs2_delete_device(rs2_device* device) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -853,6 +896,15 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame, frame_metadata)
 
+unsigned long long rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(values);
+    VALIDATE_RANGE(count, 0, int(::RS2_FRAME_METADATA_COUNT));
+    return ((frame_interface*)frame)->get_frame_metadata_all(values, size_t(count));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, values, count)
+
 const char* rs2_get_notification_description(rs2_notification* notification, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(notification);
@@ -1060,6 +1112,7 @@ rs2_frame* rs2_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, r
     {
         throw std::runtime_error("Frame did not arrive in time!");
     }
+    trace_frame_end(fh.frame, queue->trace_stage);
 
     frame_interface* result = nullptr;
     std::swap(result, fh.frame);
@@ -1074,6 +1127,7 @@ int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_err
     librealsense::frame_holder fh;
     if (queue->queue.try_dequeue(&fh))
     {
+        trace_frame_end(fh.frame, queue->trace_stage);
         frame_interface* result = nullptr;
         std::swap(result, fh.frame);
         *output_frame = (rs2_frame*)result;
@@ -1093,6 +1147,7 @@ int rs2_try_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_
     {
         return false;
     }
+    trace_frame_end(fh.frame, queue->trace_stage);
 
     frame_interface* result = nullptr;
     std::swap(result, fh.frame);
@@ -1108,6 +1163,7 @@ void rs2_enqueue_frame(rs2_frame* frame, void* queue) BEGIN_API_CALL
     auto q = reinterpret_cast<rs2_frame_queue*>(queue);
     librealsense::frame_holder fh;
     fh.frame = (frame_interface*)frame;
+    trace_frame_begin(fh.frame);
     q->queue.enqueue(std::move(fh));
 }
 NOEXCEPT_RETURN(, frame, queue)
@@ -1356,6 +1412,32 @@ void rs2_enable_rolling_log_file( unsigned max_size, rs2_error ** error ) BEGIN_
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, max_size)
 
+void rs2_enable_frame_trace(int enable, rs2_error** error) BEGIN_API_CALL
+{
+    frame_tracer::get_instance().enable(enable != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, enable)
+
+void rs2_reset_frame_trace(rs2_error** error) BEGIN_API_CALL
+{
+    frame_tracer::get_instance().reset();
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN_VOID()
+
+void rs2_export_frame_trace(const char* file_path, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(file_path);
+    frame_tracer::get_instance().export_chrome_trace(file_path);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, file_path)
+
+void rs2_export_frame_trace_histograms(const char* file_path, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(file_path);
+    frame_tracer::get_instance().export_histograms(file_path);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, file_path)
+
 // librealsense wrapper around a C function
 class on_log_callback : public rs2_log_callback
 {
@@ -2354,6 +2436,137 @@ rs2_processing_block* rs2_create_sequence_id_filter(rs2_error** error) BEGIN_API
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+static std::shared_ptr<librealsense::fused_filter_chain> get_fused_filter_chain(rs2_processing_block* chain)
+{
+    VALIDATE_NOT_NULL(chain);
+    auto fused = std::dynamic_pointer_cast<librealsense::fused_filter_chain>(chain->block);
+    if (!fused)
+        throw std::runtime_error("Processing block is not a fused filter chain!");
+    return fused;
+}
+
+rs2_processing_block* rs2_create_fused_filter_chain(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::fused_filter_chain>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+void rs2_fused_filter_chain_add(rs2_processing_block* chain, rs2_processing_block* block, rs2_error** error) BEGIN_API_CALL
+{
+    auto fused = get_fused_filter_chain(chain);
+    VALIDATE_NOT_NULL(block);
+    fused->add(block->block);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, chain, block)
+
+int rs2_fused_filter_chain_get_stages_count(rs2_processing_block* chain, rs2_error** error) BEGIN_API_CALL
+{
+    auto fused = get_fused_filter_chain(chain);
+    return int(fused->get_stage_timings().size());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, chain)
+
+const char* rs2_fused_filter_chain_get_stage_name(rs2_processing_block* chain, int index, rs2_error** error) BEGIN_API_CALL
+{
+    auto fused = get_fused_filter_chain(chain);
+    VALIDATE_RANGE(index, 0, int(fused->get_stage_timings().size()) - 1);
+    return fused->get_stage_name(index);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, chain, index)
+
+float rs2_fused_filter_chain_get_stage_time(rs2_processing_block* chain, int index, rs2_error** error) BEGIN_API_CALL
+{
+    auto fused = get_fused_filter_chain(chain);
+    auto timings = fused->get_stage_timings();
+    VALIDATE_RANGE(index, 0, int(timings.size()) - 1);
+    return float(timings[index].average_ms);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0.f, chain, index)
+
+static std::shared_ptr<librealsense::processing_graph> get_processing_graph(rs2_processing_block* graph)
+{
+    VALIDATE_NOT_NULL(graph);
+    auto res = std::dynamic_pointer_cast<librealsense::processing_graph>(graph->block);
+    if (!res)
+        throw std::runtime_error("Processing block is not a processing graph!");
+    return res;
+}
+
+rs2_processing_block* rs2_create_processing_graph(int threads, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(threads, 0, 1024);
+    auto block = std::make_shared<librealsense::processing_graph>(threads);
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, threads)
+
+int rs2_processing_graph_add_node(rs2_processing_block* graph, rs2_processing_block* block, int parent, rs2_error** error) BEGIN_API_CALL
+{
+    auto g = get_processing_graph(graph);
+    VALIDATE_NOT_NULL(block);
+    return g->add_node(block->block, parent);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, graph, block, parent)
+
+void rs2_processing_graph_add_replica(rs2_processing_block* graph, int node, rs2_processing_block* block, rs2_error** error) BEGIN_API_CALL
+{
+    auto g = get_processing_graph(graph);
+    VALIDATE_NOT_NULL(block);
+    g->add_replica(node, block->block);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, node, block)
+
+void rs2_processing_graph_set_queue_size(rs2_processing_block* graph, int node, int size, rs2_error** error) BEGIN_API_CALL
+{
+    auto g = get_processing_graph(graph);
+    VALIDATE_RANGE(size, 1, 1024);
+    g->set_queue_size(node, size_t(size));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, node, size)
+
+int rs2_processing_graph_get_nodes_count(rs2_processing_block* graph, rs2_error** error) BEGIN_API_CALL
+{
+    auto g = get_processing_graph(graph);
+    return int(g->get_nodes_count());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, graph)
+
+const char* rs2_processing_graph_get_node_name(rs2_processing_block* graph, int node, rs2_error** error) BEGIN_API_CALL
+{
+    auto g = get_processing_graph(graph);
+    return g->get_node_name(node);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, graph, node)
+
+void rs2_processing_graph_get_node_stats(rs2_processing_block* graph, int node, rs2_processing_node_stats* stats, rs2_error** error) BEGIN_API_CALL
+{
+    auto g = get_processing_graph(graph);
+    VALIDATE_NOT_NULL(stats);
+    auto s = g->get_node_stats(node);
+    stats->queue_depth = int(s.queue_depth);
+    stats->queue_size = int(s.queue_size);
+    stats->processed = s.processed;
+    stats->dropped = s.dropped;
+    stats->average_latency_ms = float(s.average_latency_ms);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, node, stats)
+
+unsigned long long rs2_processing_graph_get_dropped_frames(rs2_processing_block* graph, rs2_error** error) BEGIN_API_CALL
+{
+    auto g = get_processing_graph(graph);
+    return g->get_dropped_frames();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, graph)
+
+rs2_processing_block* rs2_create_motion_batcher(rs2_error** error) BEGIN_API_CALL
+{
+    return new rs2_processing_block{ std::make_shared<motion_batcher>() };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
 float rs2_get_depth_scale(rs2_sensor* sensor, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -3376,6 +3589,29 @@ int rs2_parse_firmware_log(rs2_device* dev, rs2_firmware_log_message* fw_log_msg
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, dev, fw_log_msg)
 
+int rs2_parse_firmware_logs(rs2_device* dev, rs2_firmware_log_message** fw_log_msgs, rs2_firmware_log_parsed_message** parsed_msgs, int count, rs2_error** error)BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(dev);
+    VALIDATE_NOT_NULL(fw_log_msgs);
+    VALIDATE_NOT_NULL(parsed_msgs);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+
+    auto fw_logger = VALIDATE_INTERFACE(dev->device, librealsense::firmware_logger_extensions);
+
+    std::vector<const librealsense::fw_logs::fw_logs_binary_data*> binary_data(count);
+    std::vector<librealsense::fw_logs::fw_log_data*> parsed_data(count);
+    for (int i = 0; i < count; ++i)
+    {
+        VALIDATE_NOT_NULL(fw_log_msgs[i]);
+        VALIDATE_NOT_NULL(parsed_msgs[i]);
+        binary_data[i] = fw_log_msgs[i]->firmware_log_binary_data.get();
+        parsed_data[i] = parsed_msgs[i]->firmware_log_parsed.get();
+    }
+
+    return static_cast<int>(fw_logger->parse_logs(binary_data.data(), parsed_data.data(), count));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, dev, fw_log_msgs, count)
+
 unsigned int rs2_get_number_of_fw_logs(rs2_device* dev, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(dev);
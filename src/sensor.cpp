@@ -1581,6 +1581,11 @@ namespace librealsense
     {
         std::lock_guard<std::mutex> lock(_synthetic_configure_lock);
         _raw_sensor->stop();
+
+        // No frame arrives anymore, so whatever the blocks hold back is output before stop() returns
+        for (auto&& entry : _profiles_to_processing_block)
+            for (auto&& pb : entry.second)
+                pb->on_input_stopped();
     }
 
     float librealsense::synthetic_sensor::get_preset_max_value() const
@@ -44,7 +44,8 @@ namespace librealsense
     frame_source::frame_source(uint32_t max_publish_list_size)
             : _callback(nullptr, [](rs2_frame_callback*) {}),
               _max_publish_list_size(max_publish_list_size),
-              _ts(environment::get_instance().get_time_service())
+              _ts(environment::get_instance().get_time_service()),
+              _trace_stage(frame_tracer::get_instance().register_stage("Sensor"))
     {}
 
     void frame_source::init(std::shared_ptr<metadata_parser_map> metadata_parsers)
@@ -105,6 +106,11 @@ namespace librealsense
         _callback = callback;
     }
 
+    void frame_source::set_trace_stage(const std::string& name)
+    {
+        _trace_stage = frame_tracer::get_instance().register_stage(name);
+    }
+
     frame_callback_ptr frame_source::get_callback() const
     {
         std::lock_guard<std::mutex> lock(_callback_mutex);
@@ -118,6 +124,7 @@ namespace librealsense
             try
             {
                 frame->log_callback_start(_ts ? _ts->get_time() : 0);
+                trace_frame_end(frame.frame, _trace_stage);
                 if (_callback)
                 {
                     frame_interface* ref = nullptr;
@@ -50,6 +50,9 @@ namespace librealsense
 
         void set_max_publish_list_size(int qsize) {_max_publish_list_size = qsize; }
 
+        // Name of the stage the frames leave when they are passed to the callback
+        void set_trace_stage(const std::string& name);
+
     private:
         friend class syncer_process_unit;
 
@@ -61,5 +64,6 @@ namespace librealsense
         frame_callback_ptr _callback;
         std::shared_ptr<platform::time_service> _ts;
         std::shared_ptr<metadata_parser_map> _metadata_parsers;
+        uint16_t _trace_stage;
     };
 }
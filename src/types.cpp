@@ -461,6 +461,9 @@ namespace librealsense
 			CASE(SET_SP_FILTER_HEIGHT)
 			CASE(SET_SP_FILTER_DEPTH_ANGLE)
 			CASE(SET_SP_FILTER_CONTURE_MODE)
+			CASE(HISTOGRAM_UPDATE_INTERVAL)
+			CASE(MOTION_BATCH_SIZE)
+			CASE(MOTION_BATCH_MAX_AGE)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -504,6 +507,7 @@ namespace librealsense
             CASE(Z16H)
             CASE(FG)
             CASE(Y411)
+            CASE(MOTION_XYZ32F_BATCH)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -0,0 +1,573 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "tclap/CmdLine.h"
+
+using namespace std;
+using namespace chrono;
+using namespace TCLAP;
+using namespace rs2;
+
+// Every heap allocation of the process is counted here. On ELF platforms this also covers
+// allocations made inside a dynamically linked librealsense; elsewhere only static builds are covered.
+static atomic<unsigned long long> allocations(0);
+
+void* operator new(size_t size)
+{
+    allocations++;
+    if (auto ptr = malloc(size ? size : 1))
+        return ptr;
+    throw bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+string get_cpu()
+{
+#if defined __linux__ || defined(__linux__)
+    string line;
+    ifstream finfo("/proc/cpuinfo");
+    while (getline(finfo, line))
+    {
+        stringstream str(line);
+        string itype;
+        string info;
+        if (getline(str, itype, ':') && getline(str, info) && itype.substr(0, 10) == "model name")
+            return info.substr(info.find_first_not_of(' '));
+    }
+#endif
+    return "unknown";
+}
+
+// The frames a benchmark can be fed with. A recording may lack some of them.
+struct inputs
+{
+    string source;
+    int width = 0;
+    int height = 0;
+
+    vector<frame> depth;
+    vector<frame> infrared;
+    vector<frame> color;
+    vector<frame> yuyv;
+    vector<frameset> depth_color;
+    vector<frameset> hdr;   // Depth + infrared pairs carrying HDR sequence metadata
+};
+
+enum class input_type { depth, infrared, color, yuyv, depth_color, hdr };
+
+static const vector<frame>& select(const inputs& in, input_type type, vector<frame>& storage)
+{
+    switch (type)
+    {
+    case input_type::depth: return in.depth;
+    case input_type::infrared: return in.infrared;
+    case input_type::color: return in.color;
+    case input_type::yuyv: return in.yuyv;
+    case input_type::depth_color: storage.assign(in.depth_color.begin(), in.depth_color.end()); return storage;
+    default: storage.assign(in.hdr.begin(), in.hdr.end()); return storage;
+    }
+}
+
+static frameset make_frameset(vector<frame> frames)
+{
+    filter bundle([&frames](frame, const frame_source& src)
+    {
+        src.frame_ready(src.allocate_composite_frame(frames));
+    });
+    return bundle.process(frames.front()).as<frameset>();
+}
+
+// Software device producing deterministic depth, infrared and color frames of a given resolution.
+// The pixel buffers are owned by the camera, so it must outlive the frames it produced.
+class synthetic_camera
+{
+public:
+    synthetic_camera(int width, int height, int frames_count)
+        : _depth_queue(frames_count * 4, true), _color_queue(frames_count * 4, true)
+    {
+        rs2_intrinsics intrinsics{ width, height, width / 2.f, height / 2.f, width * 0.75f, width * 0.75f,
+                                   RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+
+        auto stereo = _dev.add_sensor("Stereo Module");
+        stereo.add_read_only_option(RS2_OPTION_DEPTH_UNITS, 0.001f);
+        stereo.add_read_only_option(RS2_OPTION_STEREO_BASELINE, 50.f);
+        auto depth = stereo.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics });
+        auto ir = stereo.add_video_stream({ RS2_STREAM_INFRARED, 1, 1, width, height, 30, 1, RS2_FORMAT_Y8, intrinsics });
+
+        auto rgb = _dev.add_sensor("RGB Camera");
+        auto color = rgb.add_video_stream({ RS2_STREAM_COLOR, 0, 2, width, height, 30, 3, RS2_FORMAT_RGB8, intrinsics });
+        auto yuyv = rgb.add_video_stream({ RS2_STREAM_COLOR, 1, 3, width, height, 30, 2, RS2_FORMAT_YUYV, intrinsics });
+        depth.register_extrinsics_to(color, { { 1,0,0,0,1,0,0,0,1 },{ 0.015f,0,0 } });
+        depth.register_extrinsics_to(ir, { { 1,0,0,0,1,0,0,0,1 },{ 0,0,0 } });
+
+        stereo.open({ depth, ir });
+        rgb.open({ color, yuyv });
+        stereo.start(_depth_queue);
+        rgb.start(_color_queue);
+
+        _in.source = "synthetic";
+        _in.width = width;
+        _in.height = height;
+
+        size_t pixels = size_t(width) * height;
+        _depth_pixels.resize(frames_count, vector<uint16_t>(pixels));
+        _ir_pixels.resize(frames_count, vector<uint8_t>(pixels));
+        _color_pixels.resize(frames_count, vector<uint8_t>(pixels * 3));
+        _yuyv_pixels.resize(frames_count, vector<uint8_t>(pixels * 2));
+
+        uint32_t seed = 1;
+        auto noise = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 16; };
+
+        for (int i = 0; i < frames_count; i++)
+        {
+            // A slanted, wavy surface with sensor noise and about 10% holes
+            for (int y = 0; y < height; y++)
+                for (int x = 0; x < width; x++)
+                {
+                    auto idx = size_t(y) * width + x;
+                    auto z = 1500.f + 2.f * y + 300.f * sin(x * 0.02f + i * 0.1f) * cos(y * 0.015f);
+                    _depth_pixels[i][idx] = (noise() % 10 == 0) ? 0 : uint16_t(z + noise() % 16);
+                    _ir_pixels[i][idx] = uint8_t((x + y + i) ^ (noise() & 0x1f));
+                    _color_pixels[i][idx * 3 + 0] = uint8_t(x + i);
+                    _color_pixels[i][idx * 3 + 1] = uint8_t(y);
+                    _color_pixels[i][idx * 3 + 2] = uint8_t(x ^ y);
+                    _yuyv_pixels[i][idx * 2 + 0] = uint8_t(16 + (x + y + i) % 220);
+                    _yuyv_pixels[i][idx * 2 + 1] = uint8_t(noise());
+                }
+
+            // Frame counters go up in pairs of HDR sub-presets 0 and 1
+            stereo.set_metadata(RS2_FRAME_METADATA_FRAME_COUNTER, i);
+            stereo.set_metadata(RS2_FRAME_METADATA_SEQUENCE_SIZE, 2);
+            stereo.set_metadata(RS2_FRAME_METADATA_SEQUENCE_ID, i % 2);
+
+            auto ts = i * 1000. / 30;
+            stereo.on_video_frame({ _depth_pixels[i].data(), [](void*) {}, width * 2, 2, ts,
+                                    RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth, 0.001f });
+            stereo.on_video_frame({ _ir_pixels[i].data(), [](void*) {}, width, 1, ts,
+                                    RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, ir });
+            rgb.on_video_frame({ _color_pixels[i].data(), [](void*) {}, width * 3, 3, ts,
+                                 RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, color });
+            rgb.on_video_frame({ _yuyv_pixels[i].data(), [](void*) {}, width * 2, 2, ts,
+                                 RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, yuyv });
+
+            frame d, f, c, u;
+            if (!_depth_queue.try_wait_for_frame(&d, 5000) || !_depth_queue.try_wait_for_frame(&f, 5000) ||
+                !_color_queue.try_wait_for_frame(&c, 5000) || !_color_queue.try_wait_for_frame(&u, 5000))
+                throw runtime_error("Software device did not deliver the synthetic frames");
+            d.keep();
+            f.keep();
+            c.keep();
+            u.keep();
+
+            _in.depth.push_back(d);
+            _in.infrared.push_back(f);
+            _in.color.push_back(c);
+            _in.yuyv.push_back(u);
+            _in.depth_color.push_back(make_frameset({ d, c }));
+            _in.hdr.push_back(make_frameset({ d, f }));
+        }
+    }
+
+    const inputs& get() const { return _in; }
+
+private:
+    vector<vector<uint16_t>> _depth_pixels;
+    vector<vector<uint8_t>> _ir_pixels;
+    vector<vector<uint8_t>> _color_pixels;
+    vector<vector<uint8_t>> _yuyv_pixels;
+    software_device _dev;
+    frame_queue _depth_queue;
+    frame_queue _color_queue;
+    inputs _in;
+};
+
+static inputs load_recording(const string& file, int frames_count)
+{
+    config cfg;
+    cfg.enable_device_from_file(file, false);
+    pipeline pipe;
+    auto profile = pipe.start(cfg);
+    profile.get_device().as<playback>().set_real_time(false);
+
+    inputs in;
+    in.source = file;
+    for (int i = 0; i < frames_count; i++)
+    {
+        frameset fs;
+        if (!pipe.try_wait_for_frames(&fs, 5000))
+            break;
+        fs.keep();
+
+        auto depth = fs.get_depth_frame();
+        auto ir = fs.get_infrared_frame();
+        auto color = fs.get_color_frame();
+        if (depth)
+        {
+            in.depth.push_back(depth);
+            in.width = depth.get_width();
+            in.height = depth.get_height();
+        }
+        if (ir)
+            in.infrared.push_back(ir);
+        if (color)
+        {
+            if (color.get_profile().format() == RS2_FORMAT_YUYV)
+                in.yuyv.push_back(color);
+            else
+                in.color.push_back(color);
+        }
+        if (depth && color)
+            in.depth_color.push_back(fs);
+        if (depth && ir && depth.supports_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID))
+            in.hdr.push_back(fs);
+    }
+    pipe.stop();
+    return in;
+}
+
+struct benchmark
+{
+    string name;
+    input_type input;
+    // Creates a fresh block (or chain of blocks) for every run
+    function<function<frame(const frame&)>()> create;
+};
+
+template<class T, class... Args>
+static benchmark block_benchmark(string name, input_type input, Args... args)
+{
+    return { name, input, [args...]()
+    {
+        shared_ptr<filter> block = make_shared<T>(args...);
+        return function<frame(const frame&)>([block](const frame& f) { return block->process(f); });
+    } };
+}
+
+template<class T>
+static benchmark option_benchmark(string name, input_type input, rs2_option option, float value)
+{
+    return { name, input, [option, value]()
+    {
+        auto block = make_shared<T>();
+        block->set_option(option, value);
+        return function<frame(const frame&)>([block](const frame& f) { return block->process(f); });
+    } };
+}
+
+// threshold -> disparity -> spatial -> temporal -> depth -> hole filling
+static vector<shared_ptr<filter>> depth_chain()
+{
+    return { make_shared<threshold_filter>(0.15f, 4.f), make_shared<disparity_transform>(true),
+             make_shared<spatial_filter>(), make_shared<temporal_filter>(),
+             make_shared<disparity_transform>(false), make_shared<hole_filling_filter>(0) };
+}
+
+static vector<benchmark> make_benchmarks()
+{
+    vector<benchmark> res;
+    res.push_back(block_benchmark<colorizer>("colorizer", input_type::depth));
+    res.push_back(option_benchmark<colorizer>("colorizer (histogram every 30 frames)", input_type::depth,
+        RS2_OPTION_HISTOGRAM_UPDATE_INTERVAL, 30.f));
+    res.push_back(block_benchmark<pointcloud>("pointcloud", input_type::depth));
+    res.push_back(block_benchmark<rs2::align>("align to color", input_type::depth_color, RS2_STREAM_COLOR));
+    res.push_back(block_benchmark<rs2::align>("align to depth", input_type::depth_color, RS2_STREAM_DEPTH));
+    for (int scale : { 2, 3, 4, 8 })
+        res.push_back(option_benchmark<decimation_filter>("decimation x" + to_string(scale), input_type::depth,
+            RS2_OPTION_FILTER_MAGNITUDE, float(scale)));
+    res.push_back(block_benchmark<spatial_filter>("spatial (Altek SF)", input_type::depth));
+    res.push_back(block_benchmark<temporal_filter>("temporal", input_type::depth));
+    res.push_back(block_benchmark<hole_filling_filter>("hole filling (fill from left)", input_type::depth, 0));
+    res.push_back(block_benchmark<hole_filling_filter>("hole filling (farest from around)", input_type::depth, 1));
+    res.push_back(block_benchmark<hole_filling_filter>("hole filling (nearest from around)", input_type::depth, 2));
+    res.push_back(block_benchmark<disparity_transform>("depth to disparity", input_type::depth, true));
+    res.push_back(block_benchmark<threshold_filter>("threshold", input_type::depth));
+    res.push_back(block_benchmark<units_transform>("units transform", input_type::depth));
+    res.push_back(block_benchmark<hdr_merge>("hdr merge", input_type::hdr));
+    res.push_back(block_benchmark<yuy_decoder>("yuy decoder", input_type::yuyv));
+
+    res.push_back({ "depth chain (block by block)", input_type::depth, []()
+    {
+        auto chain = depth_chain();
+        return function<frame(const frame&)>([chain](const frame& f)
+        {
+            frame res = f;
+            for (auto&& block : chain)
+                res = block->process(res);
+            return res;
+        });
+    } });
+    res.push_back({ "depth chain (fused)", input_type::depth, []()
+    {
+        auto fused = make_shared<fused_filter_chain>();
+        for (auto&& block : depth_chain())
+            fused->add(*block);
+        return function<frame(const frame&)>([fused](const frame& f) { return fused->process(f); });
+    } });
+    return res;
+}
+
+struct result
+{
+    string name;
+    string source;
+    int width;
+    int height;
+    int threads;
+    size_t frames;
+    double mean_ms;
+    double p50_ms;
+    double p99_ms;
+    double max_ms;
+    double allocations_per_frame;
+};
+
+static double percentile(const vector<double>& sorted, double p)
+{
+    auto rank = size_t(ceil(p * sorted.size()));
+    return sorted[min(sorted.size() - 1, rank ? rank - 1 : 0)];
+}
+
+static result run(const benchmark& b, const inputs& in, int threads, int warmup, int iterations)
+{
+    vector<frame> storage;
+    auto& frames = select(in, b.input, storage);
+
+    auto process = b.create();
+    for (int i = 0; i < warmup; i++)
+        process(frames[i % frames.size()]);
+
+    vector<double> times;
+    unsigned long long allocs = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+        auto& f = frames[i % frames.size()];
+        auto before = allocations.load();
+        auto start = high_resolution_clock::now();
+        auto res = process(f);
+        auto end = high_resolution_clock::now();
+        allocs += allocations.load() - before;
+        times.push_back(duration<double, milli>(end - start).count());
+    }
+
+    result r{ b.name, in.source, in.width, in.height, threads, times.size() };
+    r.mean_ms = accumulate(times.begin(), times.end(), 0.0) / times.size();
+    sort(times.begin(), times.end());
+    r.p50_ms = percentile(times, 0.5);
+    r.p99_ms = percentile(times, 0.99);
+    r.max_ms = times.back();
+    r.allocations_per_frame = double(allocs) / times.size();
+    return r;
+}
+
+static string escape(const string& s)
+{
+    string res;
+    for (auto c : s)
+    {
+        if (c == '"' || c == '\\')
+            res += '\\';
+        res += c;
+    }
+    return res;
+}
+
+static void write_json(ostream& out, const vector<result>& results)
+{
+    out << "{\n";
+    out << "  \"librealsense\": \"" << RS2_API_VERSION_STR << "\",\n";
+    out << "  \"cpu\": \"" << escape(get_cpu()) << "\",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto& r = results[i];
+        out << "    { \"block\": \"" << escape(r.name) << "\", \"source\": \"" << escape(r.source)
+            << "\", \"width\": " << r.width << ", \"height\": " << r.height << ", \"threads\": " << r.threads
+            << ", \"frames\": " << r.frames << ", \"mean_ms\": " << r.mean_ms << ", \"p50_ms\": " << r.p50_ms
+            << ", \"p99_ms\": " << r.p99_ms << ", \"max_ms\": " << r.max_ms
+            << ", \"allocations_per_frame\": " << r.allocations_per_frame << " }"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+static void write_csv(ostream& out, const vector<result>& results)
+{
+    out << "block,source,width,height,threads,frames,mean_ms,p50_ms,p99_ms,max_ms,allocations_per_frame\n";
+    for (auto&& r : results)
+    {
+        out << "\"" << escape(r.name) << "\",\"" << escape(r.source) << "\"," << r.width << "," << r.height << ","
+            << r.threads << "," << r.frames << "," << r.mean_ms << "," << r.p50_ms << "," << r.p99_ms << ","
+            << r.max_ms << "," << r.allocations_per_frame << "\n";
+    }
+}
+
+int main(int argc, char** argv) try
+{
+    CmdLine cmd("librealsense rs-benchmark-headless tool", ' ', RS2_API_VERSION_STR);
+
+    MultiArg<string> resolutions("r", "resolution", "Resolution of the synthetic frames as WxH (default: 640x480, 848x480, 1280x720)", false, "WxH");
+    MultiArg<int> threads("t", "threads", "Number of OpenMP threads to run the blocks with (default: 1 and all cores)", false, "count");
+    ValueArg<string> input("i", "input", "Benchmark on the frames of a recording instead of synthetic frames", false, "", "bag file");
+    ValueArg<int> frames("n", "frames", "Number of timed frames per block", false, 100, "count");
+    ValueArg<int> warmup("w", "warmup", "Number of untimed frames per block before measuring", false, 10, "count");
+    ValueArg<string> filter_arg("b", "block", "Only run blocks whose name contains this string", false, "", "name");
+    ValueArg<string> format("f", "format", "Output format: json or csv", false, "json", "json|csv");
+    ValueArg<string> output("o", "output", "Output file (default: standard output)", false, "", "file");
+
+    cmd.add(resolutions);
+    cmd.add(threads);
+    cmd.add(input);
+    cmd.add(frames);
+    cmd.add(warmup);
+    cmd.add(filter_arg);
+    cmd.add(format);
+    cmd.add(output);
+    cmd.parse(argc, argv);
+
+    // The percentiles are taken from the timed frames, so there must be at least one
+    if (frames.getValue() <= 0 || warmup.getValue() < 0)
+    {
+        cerr << "The number of timed frames must be positive and the number of warmup frames not negative" << endl;
+        cmd.getOutput()->usage(cmd);
+        return EXIT_FAILURE;
+    }
+    for (auto t : threads.getValue())
+    {
+        if (t <= 0)
+        {
+            cerr << "Invalid thread count " << t << endl;
+            cmd.getOutput()->usage(cmd);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (format.getValue() != "json" && format.getValue() != "csv")
+    {
+        cerr << "Unsupported output format " << format.getValue() << endl;
+        return EXIT_FAILURE;
+    }
+
+    vector<pair<int, int>> sizes;
+    for (auto&& res : resolutions.getValue())
+    {
+        int w = 0, h = 0;
+        char x = 0;
+        stringstream ss(res);
+        if (!(ss >> w >> x >> h) || x != 'x' || w <= 0 || h <= 0)
+        {
+            cerr << "Invalid resolution " << res << ", expected WxH" << endl;
+            return EXIT_FAILURE;
+        }
+        sizes.emplace_back(w, h);
+    }
+    if (sizes.empty())
+        sizes = { { 640, 480 }, { 848, 480 }, { 1280, 720 } };
+
+    vector<int> thread_counts = threads.getValue();
+#ifdef _OPENMP
+    if (thread_counts.empty())
+    {
+        thread_counts.push_back(1);
+        if (omp_get_num_procs() > 1)
+            thread_counts.push_back(omp_get_num_procs());
+    }
+#else
+    if (!thread_counts.empty())
+        cerr << "Built without OpenMP, --threads is ignored" << endl;
+    thread_counts = { 1 };
+#endif
+
+    // A handful of distinct frames is enough to defeat caching between iterations
+    const int distinct_frames = 8;
+    vector<result> results;
+    auto benchmarks = make_benchmarks();
+
+    auto run_all = [&](const inputs& in)
+    {
+        for (auto t : thread_counts)
+        {
+#ifdef _OPENMP
+            omp_set_num_threads(t);
+#endif
+            for (auto&& b : benchmarks)
+            {
+                if (b.name.find(filter_arg.getValue()) == string::npos)
+                    continue;
+
+                vector<frame> storage;
+                if (select(in, b.input, storage).empty())
+                {
+                    cerr << "Skipping " << b.name << ": " << in.source << " has no suitable frames" << endl;
+                    continue;
+                }
+
+                cerr << in.source << " " << in.width << "x" << in.height << ", " << t << " threads: " << b.name << endl;
+                results.push_back(run(b, in, t, warmup.getValue(), frames.getValue()));
+            }
+        }
+    };
+
+    if (!input.getValue().empty())
+    {
+        run_all(load_recording(input.getValue(), distinct_frames * 4));
+    }
+    else
+    {
+        for (auto&& size : sizes)
+        {
+            synthetic_camera camera(size.first, size.second, distinct_frames);
+            run_all(camera.get());
+        }
+    }
+
+    ofstream file;
+    if (!output.getValue().empty())
+        file.open(output.getValue());
+    ostream& out = output.getValue().empty() ? cout : file;
+
+    out.precision(4);
+    out << fixed;
+    if (format.getValue() == "json")
+        write_json(out, results);
+    else
+        write_csv(out, results);
+
+    return EXIT_SUCCESS;
+}
+catch (const error & e)
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << endl;
+    return EXIT_FAILURE;
+}
+catch (const exception& e)
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
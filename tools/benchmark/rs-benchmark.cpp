@@ -112,11 +112,24 @@ public:
     {
         return _name;
     }
+protected:
+    T& block() { return _block; }
 private:
     T _block;
     std::string _name;
 };
 
+template<class T>
+class pb_option_test : public pb_test<T>
+{
+public:
+    pb_option_test(std::string name, rs2_option option, float value)
+        : pb_test<T>(std::move(name))
+    {
+        this->block().set_option(option, value);
+    }
+};
+
 template<class T>
 class gl_test : public pb_test<T>
 {
@@ -171,12 +184,17 @@ public:
         if (stream.stream_type() == RS2_STREAM_DEPTH)
         {
             REGISTER_TEST(colorizer);
+            tests.push_back(make_shared<pb_option_test<colorizer>>(
+                "colorizer (histogram every 30 frames)", RS2_OPTION_HISTOGRAM_UPDATE_INTERVAL, 30.f));
             REGISTER_TEST(pointcloud);
             REGISTER_TEST(spatial_filter);
             REGISTER_TEST(temporal_filter);
             REGISTER_TEST(disparity_transform);
             REGISTER_TEST(threshold_filter);
-            REGISTER_TEST(decimation_filter);
+            // Median kernels for 2x2/3x3, mean-of-valid above that
+            for (int scale = 2; scale <= 8; scale++)
+                tests.push_back(make_shared<pb_option_test<decimation_filter>>(
+                    "decimation_filter x" + to_string(scale), RS2_OPTION_FILTER_MAGNITUDE, float(scale)));
         }
         if (stream.format() == RS2_FORMAT_YUYV)
         {
@@ -0,0 +1,322 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+
+#include <compression/Lz4Compression.h>
+#include <compression/RvlCompression.h>
+#include <compression/TemporalCompression.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+
+using namespace std;
+using namespace chrono;
+using namespace TCLAP;
+using namespace rs2;
+
+// Z16 depth frames to compress, copied out of the frames they came in
+struct inputs
+{
+    string source;
+    int width = 0;
+    int height = 0;
+    vector<vector<uint16_t>> depth;
+};
+
+struct result
+{
+    string codec;
+    string source;
+    int width = 0;
+    int height = 0;
+    int frames = 0;
+    int failed = 0;          // Frames the encoder or the decoder gave up on
+    double ratio = 0;        // Size of the frames over the size of their compression
+    double encode_mbps = 0;  // Megabytes of frames per second
+    double decode_mbps = 0;
+    int max_error = 0;       // Largest depth difference between a frame and its decompression
+};
+
+// The codecs of rs-server differ in the data their decoder takes: the compressed payload without its size, or the
+// whole compressed buffer for RVL
+struct codec
+{
+    string name;
+    function<shared_ptr<ICompression>(int, int)> create;
+    bool payload_only;
+};
+
+// A static scene, such as a shelf, seen through stereo noise: depth noise grows with the distance, holes flicker at
+// the edges of the boxes, and something passes in front of the shelf from time to time
+static inputs synthetic_scene(int width, int height, int frames_count)
+{
+    inputs in;
+    in.source = "synthetic";
+    in.width = width;
+    in.height = height;
+
+    vector<uint16_t> scene(width * height);
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+        {
+            int z = 2000 - y * 400 / height;
+            for (int box = 0; box < 4; box++)
+            {
+                int bx = width / 10 + box * width / 5, by = height / 4 + (box % 2) * height / 6;
+                if (x >= bx && x < bx + width / 7 && y >= by && y < by + height / 3)
+                    z = 1400 + box * 80 + (x - bx) / 8;
+            }
+            scene[y * width + x] = z;
+        }
+
+    uint32_t seed = 12345;
+    auto random = [&seed]() { seed = seed * 1664525 + 1013904223; return seed >> 8; };
+    for (int f = 0; f < frames_count; f++)
+    {
+        vector<uint16_t> depth(scene);
+        for (size_t i = 0; i < depth.size(); i++)
+        {
+            int amplitude = depth[i] / 1000 + 1;
+            int noise = int(random() % (2 * amplitude + 1)) - amplitude;
+            depth[i] = uint16_t(depth[i] + noise);
+            bool edge = i + 1 < depth.size() && abs(int(scene[i]) - int(scene[i + 1])) > 50;
+            if (edge && random() % 4 == 0)
+                depth[i] = 0;
+        }
+        // An arm reaching in for a quarter of the frames
+        if (f % 120 < 30)
+        {
+            int ax = (f % 120) * width / 40;
+            for (int y = height / 3; y < height / 2; y++)
+                for (int x = ax; x < min(width, ax + width / 8); x++)
+                    depth[y * width + x] = uint16_t(900 + random() % 5);
+        }
+        in.depth.push_back(move(depth));
+    }
+    return in;
+}
+
+static inputs read_recording(const string& file, int frames_count)
+{
+    config cfg;
+    cfg.enable_device_from_file(file, false);
+    pipeline pipe;
+    auto profile = pipe.start(cfg);
+    profile.get_device().as<playback>().set_real_time(false);
+
+    inputs in;
+    in.source = file;
+    while (int(in.depth.size()) < frames_count)
+    {
+        frameset fs;
+        if (!pipe.try_wait_for_frames(&fs, 5000))
+            break;
+        auto depth = fs.get_depth_frame();
+        if (!depth || depth.get_profile().format() != RS2_FORMAT_Z16)
+            continue;
+        in.width = depth.get_width();
+        in.height = depth.get_height();
+        auto data = (const uint16_t*)depth.get_data();
+        in.depth.emplace_back(data, data + in.width * in.height);
+    }
+    pipe.stop();
+    return in;
+}
+
+static result run(const codec& c, const inputs& in)
+{
+    result r;
+    r.codec = c.name;
+    r.source = in.source;
+    r.width = in.width;
+    r.height = in.height;
+
+    // As in rs-server, the encoder and the decoder are apart, and only meet through the compressed frames
+    auto encoder = c.create(in.width, in.height);
+    auto decoder = c.create(in.width, in.height);
+    int frame_size = in.width * in.height * 2;
+    vector<unsigned char> frame(frame_size), compressed(frame_size * 2), decompressed(frame_size);
+    double raw = 0, packed = 0;
+    duration<double> encoding(0), decoding(0);
+    for (auto&& depth : in.depth)
+    {
+        memcpy(frame.data(), depth.data(), frame_size);
+        auto start = high_resolution_clock::now();
+        int size = encoder->compressBuffer(frame.data(), frame_size, compressed.data());
+        encoding += high_resolution_clock::now() - start;
+        r.frames++;
+        raw += frame_size;
+        if (size < 0)
+        {
+            r.failed++;
+            packed += frame_size;
+            continue;
+        }
+        packed += size;
+
+        start = high_resolution_clock::now();
+        int decoded = c.payload_only ? decoder->decompressBuffer(compressed.data() + sizeof(int), size - sizeof(int), decompressed.data())
+                                     : decoder->decompressBuffer(compressed.data(), frame_size, decompressed.data());
+        decoding += high_resolution_clock::now() - start;
+        if (decoded != frame_size)
+        {
+            r.failed++;
+            continue;
+        }
+        auto result = (const uint16_t*)decompressed.data();
+        for (size_t i = 0; i < depth.size(); i++)
+            r.max_error = max(r.max_error, abs(int(result[i]) - int(depth[i])));
+    }
+
+    r.ratio = packed > 0 ? raw / packed : 0;
+    r.encode_mbps = encoding.count() > 0 ? raw / 1e6 / encoding.count() : 0;
+    r.decode_mbps = decoding.count() > 0 ? raw / 1e6 / decoding.count() : 0;
+    return r;
+}
+
+static string escape(const string& s)
+{
+    string res;
+    for (auto c : s)
+    {
+        if (c == '"' || c == '\\')
+            res += '\\';
+        res += c;
+    }
+    return res;
+}
+
+static void write_json(ostream& out, const vector<result>& results)
+{
+    out << "{\n";
+    out << "  \"librealsense\": \"" << RS2_API_VERSION_STR << "\",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto& r = results[i];
+        out << "    { \"codec\": \"" << escape(r.codec) << "\", \"source\": \"" << escape(r.source)
+            << "\", \"width\": " << r.width << ", \"height\": " << r.height << ", \"frames\": " << r.frames
+            << ", \"failed\": " << r.failed << ", \"ratio\": " << r.ratio << ", \"encode_mbps\": " << r.encode_mbps
+            << ", \"decode_mbps\": " << r.decode_mbps << ", \"max_error\": " << r.max_error << " }"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+static void write_csv(ostream& out, const vector<result>& results)
+{
+    out << "codec,source,width,height,frames,failed,ratio,encode_mbps,decode_mbps,max_error\n";
+    for (auto&& r : results)
+    {
+        out << "\"" << escape(r.codec) << "\",\"" << escape(r.source) << "\"," << r.width << "," << r.height << ","
+            << r.frames << "," << r.failed << "," << r.ratio << "," << r.encode_mbps << "," << r.decode_mbps << ","
+            << r.max_error << "\n";
+    }
+}
+
+int main(int argc, char** argv) try
+{
+    CmdLine cmd("librealsense rs-compression-benchmark tool", ' ', RS2_API_VERSION_STR);
+
+    ValueArg<string> input("i", "input", "Compress the depth frames of a recording instead of a synthetic scene", false, "", "bag file");
+    ValueArg<string> resolution("r", "resolution", "Resolution of the synthetic frames as WxH", false, "848x480", "WxH");
+    ValueArg<int> frames("n", "frames", "Number of frames to compress", false, 300, "count");
+    ValueArg<int> keyframes("k", "keyframe-interval", "Frames between the keyframes of temporal compression", false, 30, "count");
+    MultiArg<int> tolerances("t", "tolerance", "Depth tolerance of temporal compression, in depth units (default: 0, 2 and 8)", false, "units");
+    ValueArg<string> format("f", "format", "Output format: json or csv", false, "json", "json|csv");
+    ValueArg<string> output("o", "output", "Output file (default: standard output)", false, "", "file");
+
+    cmd.add(input);
+    cmd.add(resolution);
+    cmd.add(frames);
+    cmd.add(keyframes);
+    cmd.add(tolerances);
+    cmd.add(format);
+    cmd.add(output);
+    cmd.parse(argc, argv);
+
+    if (format.getValue() != "json" && format.getValue() != "csv")
+    {
+        cerr << "Unsupported output format " << format.getValue() << endl;
+        return EXIT_FAILURE;
+    }
+
+    inputs in;
+    if (input.isSet())
+    {
+        in = read_recording(input.getValue(), frames.getValue());
+        if (in.depth.empty())
+        {
+            cerr << input.getValue() << " has no Z16 depth frames" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        int w = 0, h = 0;
+        char x = 0;
+        stringstream ss(resolution.getValue());
+        if (!(ss >> w >> x >> h) || x != 'x' || w <= 0 || h <= 0)
+        {
+            cerr << "Invalid resolution " << resolution.getValue() << ", expected WxH" << endl;
+            return EXIT_FAILURE;
+        }
+        in = synthetic_scene(w, h, frames.getValue());
+    }
+
+    vector<codec> codecs;
+    codecs.push_back({ "lz4", [](int w, int h) { return make_shared<Lz4Compression>(w, h, RS2_FORMAT_Z16, 2); }, true });
+    codecs.push_back({ "rvl", [](int w, int h) { return make_shared<RvlCompression>(w, h, RS2_FORMAT_Z16, 2); }, false });
+    auto tolerance_values = tolerances.getValue();
+    if (tolerance_values.empty())
+        tolerance_values = { 0, 2, 8 };
+    int interval = keyframes.getValue();
+    for (auto tolerance : tolerance_values)
+    {
+        codecs.push_back({ "temporal tolerance=" + to_string(tolerance) + " keyframes=" + to_string(interval),
+                           [interval, tolerance](int w, int h) { return make_shared<TemporalCompression>(w, h, RS2_FORMAT_Z16, 2, interval, tolerance); },
+                           true });
+    }
+
+    vector<result> results;
+    for (auto&& c : codecs)
+        results.push_back(run(c, in));
+
+    ofstream file;
+    if (!output.getValue().empty())
+        file.open(output.getValue());
+    ostream& out = output.getValue().empty() ? cout : file;
+
+    out.precision(4);
+    out << fixed;
+    if (format.getValue() == "json")
+        write_json(out, results);
+    else
+        write_csv(out, results);
+
+    return EXIT_SUCCESS;
+}
+catch (const error & e)
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << endl;
+    return EXIT_FAILURE;
+}
+catch (const exception& e)
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
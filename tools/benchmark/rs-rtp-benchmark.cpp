@@ -0,0 +1,215 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+
+#include "../rs-server/RsRtpFragmenter.h"
+#include "../../src/ethernet/RsFragmentReassembler.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <poll.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+
+using namespace std;
+using namespace chrono;
+using namespace TCLAP;
+
+// A pair of non-blocking UDP sockets on the loopback, the first sending to the second
+class loopback
+{
+public:
+    loopback()
+    {
+        sender = socket(AF_INET, SOCK_DGRAM, 0);
+        receiver = socket(AF_INET, SOCK_DGRAM, 0);
+        if (sender < 0 || receiver < 0)
+            throw runtime_error("Cannot create UDP sockets");
+        int size = 8 * 1024 * 1024;
+        setsockopt(sender, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+        if (setsockopt(receiver, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)))
+            setsockopt(receiver, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (bind(receiver, (sockaddr*)&address, length) || getsockname(receiver, (sockaddr*)&address, &length))
+            throw runtime_error("Cannot bind a UDP socket on the loopback");
+        fcntl(sender, F_SETFL, fcntl(sender, F_GETFL) | O_NONBLOCK);
+        fcntl(receiver, F_SETFL, fcntl(receiver, F_GETFL) | O_NONBLOCK);
+    }
+
+    ~loopback()
+    {
+        close(sender);
+        close(receiver);
+    }
+
+    // Reads until a message is complete or nothing comes for a while
+    int receive(RsFragmentReassembler& reassembler, int timeout_ms)
+    {
+        while (true)
+        {
+            int size = reassembler.receive(receiver);
+            if (size > 0)
+                return size;
+            if (size < 0)
+            {
+                pollfd fd = { receiver, POLLIN, 0 };
+                if (poll(&fd, 1, timeout_ms) <= 0)
+                    return 0;
+            }
+        }
+    }
+
+    int sender, receiver;
+    sockaddr_in address;
+};
+
+static double cpu_seconds()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+int main(int argc, char** argv) try
+{
+    CmdLine cmd("librealsense rs-rtp-benchmark tool", ' ', RS2_API_VERSION_STR);
+
+    ValueArg<int> streams_arg("s", "streams", "Number of streams, each on its own sockets and receiver thread", false, 4, "count");
+    ValueArg<string> resolution("r", "resolution", "Resolution of the 16 bit frames as WxH", false, "1280x720", "WxH");
+    ValueArg<int> fps_arg("f", "fps", "Frames per second of every stream", false, 30, "fps");
+    ValueArg<int> seconds_arg("d", "duration", "Seconds to send frames for", false, 2, "seconds");
+
+    cmd.add(streams_arg);
+    cmd.add(resolution);
+    cmd.add(fps_arg);
+    cmd.add(seconds_arg);
+    cmd.parse(argc, argv);
+
+    int w = 0, h = 0;
+    char x = 0;
+    stringstream ss(resolution.getValue());
+    if (!(ss >> w >> x >> h) || x != 'x' || w <= 0 || h <= 0)
+    {
+        cerr << "Invalid resolution " << resolution.getValue() << ", expected WxH" << endl;
+        return EXIT_FAILURE;
+    }
+    const int streams = streams_arg.getValue(), fps = fps_arg.getValue(), seconds = seconds_arg.getValue();
+    const size_t frame_size = size_t(w) * h * 2;
+    if (streams <= 0 || fps <= 0 || seconds <= 0 || sizeof(RsFrameHeader) + frame_size > size_t(MAX_MESSAGE_SIZE))
+    {
+        cmd.getOutput()->usage(cmd);
+        return EXIT_FAILURE;
+    }
+
+    // One frame per stream, its header carrying the number of the frame for the receiver to time it
+    vector<unique_ptr<loopback>> sockets;
+    vector<RsFrameHeader> headers(streams);
+    vector<vector<unsigned char>> data(streams, vector<unsigned char>(frame_size));
+    mt19937 rng(47);
+    for (int s = 0; s < streams; s++)
+    {
+        sockets.emplace_back(new loopback);
+        memset(&headers[s], 0, sizeof(RsFrameHeader));
+        headers[s].networkHeader.data.frameSize = uint32_t(frame_size);
+        for (auto& b : data[s])
+            b = (unsigned char)rng();
+    }
+
+    typedef steady_clock clock;
+    vector<clock::time_point> sent(size_t(streams) * fps * seconds);
+    vector<vector<double>> latencies(streams);
+    atomic<bool> done(false);
+    vector<unsigned long long> dropped(streams);
+
+    vector<thread> receivers;
+    for (int s = 0; s < streams; s++)
+    {
+        receivers.emplace_back([&, s]() {
+            RsFragmentReassembler reassembler;
+            vector<unsigned char> buffer(MAX_MESSAGE_SIZE);
+            while (!done)
+            {
+                reassembler.begin(buffer.data(), (unsigned)buffer.size());
+                if (!sockets[s]->receive(reassembler, 50))
+                    continue;
+                auto now = clock::now();
+                RsFrameHeader header;
+                memcpy(&header, buffer.data(), sizeof(header));
+                auto frame = header.metadataHeader.data.frameCounter;
+                latencies[s].push_back(duration<double, milli>(now - sent[frame]).count());
+            }
+            dropped[s] = reassembler.droppedMessages();
+        });
+    }
+
+    RsRtpFragmenter fragmenter;
+    vector<uint16_t> seqs(streams);
+    auto cpu_start = cpu_seconds();
+    auto start = clock::now();
+    for (int f = 0; f < fps * seconds; f++)
+    {
+        this_thread::sleep_until(start + microseconds(1000000ll * f / fps));
+        for (int s = 0; s < streams; s++)
+        {
+            int frame = f * streams + s;
+            headers[s].metadataHeader.data.frameCounter = frame;
+            sent[frame] = clock::now();
+            RsRtpMessage message{ (const unsigned char*)&headers[s], sizeof(RsFrameHeader), data[s].data(), (unsigned)frame_size,
+                                  uint32_t(frame + 1), uint32_t(frame + 1) * 3000 };
+            fragmenter.send(sockets[s]->sender, (sockaddr*)&sockets[s]->address, sizeof(sockets[s]->address), message, 96, s, seqs[s]);
+        }
+    }
+    auto elapsed = duration<double>(clock::now() - start).count();
+    this_thread::sleep_for(milliseconds(100));
+    done = true;
+    for (auto& receiver : receivers)
+        receiver.join();
+    auto cpu = cpu_seconds() - cpu_start;
+
+    vector<double> all;
+    unsigned long long lost = 0;
+    for (int s = 0; s < streams; s++)
+    {
+        all.insert(all.end(), latencies[s].begin(), latencies[s].end());
+        lost += dropped[s];
+    }
+    sort(all.begin(), all.end());
+    if (all.empty())
+    {
+        cerr << "No frame was received" << endl;
+        return EXIT_FAILURE;
+    }
+
+    auto bits = 8. * (frame_size + sizeof(RsFrameHeader)) * all.size();
+    cout << "fragments over loopback, " << streams << " x " << w << "x" << h << "x2 @ " << fps << " fps: "
+         << all.size() << " frames received, " << lost << " dropped, "
+         << bits / elapsed / 1e9 << " Gb/s, "
+         << cpu * 1000 / (fps * seconds * streams) << " ms CPU per frame, latency median "
+         << all[all.size() / 2] << " ms, 99% " << all[all.size() * 99 / 100] << " ms" << endl;
+
+    return EXIT_SUCCESS;
+}
+catch (const exception& e)
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
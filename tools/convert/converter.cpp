@@ -44,19 +44,86 @@ bool converter_base::frames_map_get_and_set(rs2_stream streamType, frame_number_
     return result;
 }
 
-void converter_base::wait_sub_workers()
+void converter_base::wait()
 {
-    for_each(_subWorkers.begin(), _subWorkers.end(),
-        [](std::thread& t) {
-            t.join();
-        });
+    if (_workers)
+        _workers->wait();
+}
 
-    _subWorkers.clear();
+worker_pool::worker_pool(size_t threads, size_t max_queued)
+    : _max_queued(max_queued ? max_queued : 2 * std::max<size_t>(threads, 1))
+    , _busy(0)
+    , _stopping(false)
+{
+    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i)
+        _threads.emplace_back([this] { run(); });
 }
 
-void converter_base::wait()
+worker_pool::~worker_pool()
 {
-    _worker.join();
+    {
+        std::lock_guard<std::mutex> lock(_m);
+        _stopping = true;
+    }
+    _task_added.notify_all();
+
+    for (auto& t : _threads)
+        t.join();
+}
+
+void worker_pool::enqueue(std::function<void()> task)
+{
+    std::unique_lock<std::mutex> lock(_m);
+    _task_taken.wait(lock, [this] { return _tasks.size() < _max_queued; });
+    _tasks.push_back(std::move(task));
+    lock.unlock();
+
+    _task_added.notify_one();
+}
+
+void worker_pool::wait()
+{
+    std::unique_lock<std::mutex> lock(_m);
+    _idle.wait(lock, [this] { return _tasks.empty() && !_busy; });
+
+    if (_error)
+    {
+        auto error = _error;
+        _error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void worker_pool::run()
+{
+    std::unique_lock<std::mutex> lock(_m);
+    while (true)
+    {
+        _task_added.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+        if (_tasks.empty())
+            return;
+
+        auto task = std::move(_tasks.front());
+        _tasks.pop_front();
+        ++_busy;
+        lock.unlock();
+        _task_taken.notify_one();
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> error_lock(_m);
+            if (!_error)
+                _error = std::current_exception();
+        }
+
+        lock.lock();
+        if (!--_busy && _tasks.empty())
+            _idle.notify_all();
+    }
 }
 
 std::string converter_base::get_statistics()
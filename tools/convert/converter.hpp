@@ -7,8 +7,15 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <exception>
+#include <memory>
 #include <string>
 #include <sstream>
+#include <iomanip>
 #include <algorithm>
 
 #include "librealsense2/rs.hpp"
@@ -22,30 +29,64 @@ namespace rs2 {
 
             typedef unsigned long long frame_number_t;
 
+            // Threads shared by all the converters. The queue is bounded, so that reading the file
+            // blocks instead of buffering the whole recording when encoding is the bottleneck.
+            class worker_pool {
+                std::vector<std::thread> _threads;
+                std::deque<std::function<void()>> _tasks;
+                size_t _max_queued;
+                size_t _busy;
+                bool _stopping;
+                std::exception_ptr _error;
+                std::mutex _m;
+                std::condition_variable _task_added;
+                std::condition_variable _task_taken;
+                std::condition_variable _idle;
+
+                void run();
+
+            public:
+                explicit worker_pool(size_t threads, size_t max_queued = 0);
+                ~worker_pool();
+
+                size_t size() const { return _threads.size(); }
+
+                void enqueue(std::function<void()> task);
+
+                // Blocks until every queued task is done; rethrows the first error a task threw
+                void wait();
+            };
+
             class converter_base {
             protected:
-                std::thread _worker;
-                std::vector<std::thread> _subWorkers;
+                std::shared_ptr<worker_pool> _workers;
                 std::unordered_map<int, std::unordered_set<frame_number_t>> _framesMap;
 
             protected:
                 bool frames_map_get_and_set(rs2_stream streamType, frame_number_t frameNumber);
-                void wait_sub_workers();
-
-                template <typename F> void start_worker(const F& f)
-                {
-                    _worker = std::thread(f);
-                }
 
-                template <typename F> void add_sub_worker(const F& f)
+                // Runs on the worker pool, or right away when there is none. Everything that decides
+                // what is written and under which name stays on the calling thread, so the output
+                // does not depend on the order in which the workers finish.
+                template <typename F> void start_worker(F f)
                 {
-                    _subWorkers.emplace_back(f);
+                    if (_workers)
+                        _workers->enqueue(f);
+                    else
+                        f();
                 }
 
             public:
+                virtual ~converter_base() = default;
+
+                void set_workers(std::shared_ptr<worker_pool> workers) { _workers = workers; }
+
                 virtual void convert(rs2::frame& frame) = 0;
                 virtual std::string name() const = 0;
 
+                // Called once all the frames were converted
+                virtual void flush() {}
+
                 virtual std::string get_statistics();
 
                 void wait();
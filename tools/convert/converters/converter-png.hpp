@@ -19,7 +19,6 @@ namespace rs2 {
             class converter_png : public converter_base {
                 rs2_stream _streamType;
                 std::string _filePath;
-                rs2::colorizer _colorizer;
 
             public:
                 converter_png(const std::string& filePath, rs2_stream streamType = rs2_stream::RS2_STREAM_ANY)
@@ -45,44 +44,42 @@ namespace rs2 {
                         return;
                     }
 
-                    start_worker(
-                        [this, &frame] {
-                            rs2::video_frame videoframe = frame.as<rs2::video_frame>();
+                    std::stringstream filename;
+                    filename << _filePath
+                        << "_" << videoframe.get_profile().stream_name()
+                        << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
+                        << ".png";
+
+                    std::stringstream metadata_file;
+                    metadata_file << _filePath
+                        << "_" << videoframe.get_profile().stream_name()
+                        << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
+                        << ".txt";
+
+                    std::string filenameS = filename.str();
+                    std::string metadataS = metadata_file.str();
 
+                    // Release the frame from the playback pool, as it may wait in the queue for a while
+                    videoframe.keep();
+
+                    start_worker(
+                        [filenameS, metadataS, videoframe]() mutable {
                             if (videoframe.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
-                                videoframe = _colorizer.process(videoframe);
+                                // A processing block is not reentrant: every worker colorizes with its own
+                                static thread_local rs2::colorizer colorizer;
+                                videoframe = colorizer.process(videoframe);
                             }
 
-                            std::stringstream filename;
-                            filename << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".png";
-
-                            std::stringstream metadata_file;
-                            metadata_file << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".txt";
-
-                            std::string filenameS = filename.str();
-                            std::string metadataS = metadata_file.str();
-
-                            add_sub_worker(
-                                [filenameS, metadataS, videoframe] {
-                                    stbi_write_png(
-                                        filenameS.c_str()
-                                        , videoframe.get_width()
-                                        , videoframe.get_height()
-                                        , videoframe.get_bytes_per_pixel()
-                                        , videoframe.get_data()
-                                        , videoframe.get_stride_in_bytes()
-                                    );
-
-                                    metadata_to_txtfile(videoframe, metadataS);
-                            });
-
-                            wait_sub_workers();
+                            stbi_write_png(
+                                filenameS.c_str()
+                                , videoframe.get_width()
+                                , videoframe.get_height()
+                                , videoframe.get_bytes_per_pixel()
+                                , videoframe.get_data()
+                                , videoframe.get_stride_in_bytes()
+                            );
+
+                            metadata_to_txtfile(videoframe, metadataS);
                     });
                 }
             };
@@ -14,6 +14,8 @@
 #include "converters/converter-bin.hpp"
 
 #include <mutex>
+#include <atomic>
+#include <chrono>
 
 #define SECONDS_TO_NANOSECONDS 1000000000
  
@@ -41,6 +43,7 @@ int main(int argc, char** argv) try
     ValueArg <string> frameNumberEnd("t", "last-framenumber", "ignore frames whose frame number is greater than this value", false, "", "last-framenumber");
     ValueArg <string> startTime("s", "start-time", "ignore frames whose timestamp is less than this value (the first frame is at time 0)", false, "", "start-time");
     ValueArg <string> endTime("e", "end-time", "ignore frames whose timestamp is greater than this value (the first frame is at time 0)", false, "", "end-time");
+    ValueArg <int> threads("j", "threads", "number of threads converting frames (default - one per core)", false, 0, "threads");
 
 
     cmd.add(inputFilename);
@@ -55,6 +58,7 @@ int main(int argc, char** argv) try
     cmd.add(outputFilenameBin);
     cmd.add(switchDepth);
     cmd.add(switchColor);
+    cmd.add(threads);
     cmd.parse(argc, argv);
 
     vector<shared_ptr<rs2::tools::converter::converter_base>> converters;
@@ -100,6 +104,24 @@ int main(int argc, char** argv) try
         throw runtime_error("output not defined");
     }
 
+    // Frames are read on this thread (or the playback sensors'), and encoded on the workers
+    auto num_threads = threads.getValue() > 0 ? size_t(threads.getValue()) : size_t(std::thread::hardware_concurrency());
+    auto workers = make_shared<rs2::tools::converter::worker_pool>(num_threads);
+    for_each(converters.begin(), converters.end(),
+        [&workers](shared_ptr<rs2::tools::converter::converter_base>& converter) {
+        converter->set_workers(workers);
+    });
+
+    std::atomic<unsigned long long> frames_converted(0);
+    auto conversion_start = std::chrono::steady_clock::now();
+    auto print_progress = [&](int percent) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - conversion_start;
+        cout << percent << "%";
+        if (elapsed.count() > 0)
+            cout << " (" << static_cast<int>(frames_converted / elapsed.count()) << " frames/s)";
+        cout << "    \r" << flush;
+    };
+
     unsigned long long first_frame = 0;
     unsigned long long last_frame = 0;
     uint64_t start_time = 0;
@@ -134,6 +156,7 @@ int main(int argc, char** argv) try
 
         plyconverter = make_shared<rs2::tools::converter::converter_ply>(
             outputFilenamePly.getValue());
+        plyconverter->set_workers(workers);
 
         rs2::config cfg;
         cfg.enable_device_from_file(inputFilename.getValue());
@@ -158,7 +181,7 @@ int main(int argc, char** argv) try
             if (posP > progress)
             {
                 progress = posP;
-                cout << posP << "%" << "\r" << flush;
+                print_progress(posP);
             }
 
             frameNumber = frameset[0].get_frame_number();
@@ -176,7 +199,7 @@ int main(int argc, char** argv) try
             if( process_frame )
             {
                 plyconverter->convert(frameset);
-                plyconverter->wait();
+                ++frames_converted;
             }
 
             auto posNext = playback.get_position();
@@ -187,6 +210,8 @@ int main(int argc, char** argv) try
 
             posCurr = posNext;
         }
+
+        plyconverter->wait();
     }
 
     // for every converter other than ply,
@@ -231,18 +256,16 @@ int main(int argc, char** argv) try
                     [&frame](shared_ptr<rs2::tools::converter::converter_base>& converter) {
                     converter->convert(frame);
                 });
-
-                for_each(converters.begin(), converters.end(),
-                    [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
-                    converter->wait();
-                });
+                ++frames_converted;
             });
 
         }
 
         //we need to clear the output of ply progress ("100%") before writing
         //the progress of the other converters in the same line
-        cout << "\r    \r";
+        cout << "\r                         \r";
+        frames_converted = 0;
+        conversion_start = std::chrono::steady_clock::now();
 
         while (true)
         {
@@ -251,7 +274,7 @@ int main(int argc, char** argv) try
             if (posP > progress)
             {
                 progress = posP;
-                cout << posP << "%" << "\r" << flush;
+                print_progress(posP);
             }
 
             const uint64_t posNext = playback.get_position();
@@ -270,6 +293,12 @@ int main(int argc, char** argv) try
             sensor.stop();
             sensor.close();
         }
+
+        workers->wait();
+        for_each(converters.begin(), converters.end(),
+            [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
+            converter->flush();
+        });
     }
 
     cout << endl;
@@ -0,0 +1,142 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "RsFragmentingRTPSink.h"
+#include "RsSource.hh"
+
+#include <GroupsockHelper.hh>
+#include <compression/CompressionFactory.h>
+
+// Microseconds between looks at an empty frame queue
+#define POLL_INTERVAL_US 1000
+
+namespace
+{
+    // The UDP destinations of a groupsock, which live555 keeps to itself
+    struct RsGroupsockDestinations : public Groupsock
+    {
+        static destRecord* first(Groupsock& t_groupsock)
+        {
+            return t_groupsock.*(&RsGroupsockDestinations::fDests);
+        }
+    };
+} // namespace
+
+RsFragmentingRTPSink* RsFragmentingRTPSink::createNew(UsageEnvironment& t_env,
+                                                      Groupsock* t_RTPgs,
+                                                      unsigned char t_rtpPayloadFormat,
+                                                      unsigned t_rtpTimestampFrequency,
+                                                      char const* t_sdpMediaTypeString,
+                                                      char const* t_rtpPayloadFormatName,
+                                                      rs2::video_stream_profile& t_videoStream,
+                                                      std::shared_ptr<RsDevice> device,
+                                                      unsigned t_mtu)
+{
+    CompressionFactory::getIsEnabled() = IS_COMPRESSION_ENABLED;
+    return new RsFragmentingRTPSink(t_env, t_RTPgs, t_rtpPayloadFormat, t_rtpTimestampFrequency, t_sdpMediaTypeString, t_rtpPayloadFormatName, t_videoStream, device, t_mtu);
+}
+
+RsFragmentingRTPSink::RsFragmentingRTPSink(UsageEnvironment& t_env,
+                                           Groupsock* t_RTPgs,
+                                           unsigned char t_rtpPayloadFormat,
+                                           unsigned t_rtpTimestampFrequency,
+                                           char const* t_sdpMediaTypeString,
+                                           char const* t_rtpPayloadFormatName,
+                                           rs2::video_stream_profile& t_videoStream,
+                                           std::shared_ptr<RsDevice> device,
+                                           unsigned t_mtu)
+    : RsSimpleRTPSink(t_env, t_RTPgs, t_rtpPayloadFormat, t_rtpTimestampFrequency, t_sdpMediaTypeString, t_rtpPayloadFormatName, t_videoStream, device, 1, True, True, RS_PAYLOAD_FRAGMENTS)
+    , m_fragmenter(t_mtu)
+    , m_frameId(0)
+    , m_packet(m_fragmenter.fragmentSize() + sizeof(RsFragmentPacketHeader))
+{
+    // A frame leaves as a burst of packets, which the send buffer should hold
+    increaseSendBufferTo(envir(), t_RTPgs->socketNum(), 1024 * 1024 * 8);
+}
+
+Boolean RsFragmentingRTPSink::continuePlaying()
+{
+    handleSendNextFrame();
+    return True;
+}
+
+void RsFragmentingRTPSink::sendNextFrame(RsFragmentingRTPSink* t_sink)
+{
+    t_sink->handleSendNextFrame();
+}
+
+void RsFragmentingRTPSink::handleSendNextFrame()
+{
+    nextTask() = NULL;
+    RsDeviceSource* source = dynamic_cast<RsDeviceSource*>(fSource);
+    if(source == NULL)
+    {
+        return;
+    }
+
+    rs2::frame frame;
+    bool sent = false;
+    try
+    {
+        if(source->pollFrame(frame))
+        {
+            sendFrame(*source, frame);
+            sent = true;
+        }
+    }
+    catch(const std::exception& e)
+    {
+        envir() << "RsFragmentingRTPSink: " << e.what() << '\n';
+    }
+
+    // Frames queued meanwhile go right away, otherwise look again shortly rather than spin
+    nextTask() = envir().taskScheduler().scheduleDelayedTask(sent ? 0 : POLL_INTERVAL_US, (TaskFunc*)sendNextFrame, this);
+}
+
+void RsFragmentingRTPSink::sendFrame(RsDeviceSource& t_source, rs2::frame& t_frame)
+{
+    RsFrameHeader header;
+    RsRtpMessage message;
+    message.dataSize = t_source.getMessage(t_frame, header, message.data);
+    message.header = (const unsigned char*)&header;
+    message.headerSize = sizeof(header);
+    message.frameId = m_frameId++;
+
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    if(fInitialPresentationTime.tv_sec == 0 && fInitialPresentationTime.tv_usec == 0)
+    {
+        fInitialPresentationTime = now;
+    }
+    fMostRecentPresentationTime = now;
+    message.rtpTimestamp = fCurrentTimestamp = convertToRTPTimestamp(now);
+
+    unsigned packets = m_fragmenter.packetCount(message);
+    destRecord* destinations = RsGroupsockDestinations::first(groupsockBeingUsed());
+    if(destinations != NULL)
+    {
+        for(destRecord* dest = destinations; dest != NULL; dest = dest->fNext)
+        {
+            sockaddr_storage const& address = dest->fGroupEId.groupAddress();
+            uint16_t seqNo = fSeqNo;
+            if(m_fragmenter.send(groupsockBeingUsed().socketNum(), (const sockaddr*)&address, addressSize(address), message, rtpPayloadType(), SSRC(), seqNo) < 0)
+            {
+                envir() << "RsFragmentingRTPSink: failed to send frame " << message.frameId << '\n';
+            }
+        }
+    }
+    else
+    {
+        // RTP over the RTSP connection: live555 frames each packet
+        for(unsigned i = 0; i < packets; i++)
+        {
+            unsigned size = m_fragmenter.buildPacket(m_packet.data(), message, i, rtpPayloadType(), SSRC(), (uint16_t)(fSeqNo + i));
+            fRTPInterface.sendPacket(m_packet.data(), size);
+        }
+    }
+
+    fSeqNo += packets;
+    fPacketCount += packets;
+    fOctetCount += message.headerSize + message.dataSize;
+    fTotalOctetCount += message.headerSize + message.dataSize + packets * sizeof(RsFragmentPacketHeader);
+}
@@ -0,0 +1,50 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "RsRtpFragmenter.h"
+#include "RsSimpleRTPSink.h"
+
+class RsDeviceSource;
+
+/*
+    Sends the frames of an RsDeviceSource in fragments of an MTU, gathered from the frame itself, instead of
+    copying them into live555's packet buffer first. Announced by "payload=fragments" in the SDP, so clients
+    read the stream with an RsFragmentSource. Falls back to one copied packet at a time over RTP over TCP.
+*/
+class RsFragmentingRTPSink : public RsSimpleRTPSink
+{
+public:
+    static RsFragmentingRTPSink* createNew(UsageEnvironment& env,
+                                           Groupsock* RTPgs,
+                                           unsigned char rtpPayloadFormat,
+                                           unsigned rtpTimestampFrequency,
+                                           char const* sdpMediaTypeString,
+                                           char const* rtpPayloadFormatName,
+                                           rs2::video_stream_profile& video_stream,
+                                           std::shared_ptr<RsDevice> device,
+                                           unsigned mtu);
+
+protected:
+    RsFragmentingRTPSink(UsageEnvironment& env,
+                         Groupsock* RTPgs,
+                         unsigned char rtpPayloadFormat,
+                         unsigned rtpTimestampFrequency,
+                         char const* sdpMediaTypeString,
+                         char const* rtpPayloadFormatName,
+                         rs2::video_stream_profile& video_stream,
+                         std::shared_ptr<RsDevice> device,
+                         unsigned mtu);
+
+    virtual Boolean continuePlaying();
+
+private:
+    static void sendNextFrame(RsFragmentingRTPSink* t_sink);
+    void handleSendNextFrame();
+    void sendFrame(RsDeviceSource& t_source, rs2::frame& t_frame);
+
+    RsRtpFragmenter m_fragmenter;
+    uint32_t m_frameId;
+    std::vector<unsigned char> m_packet; // For RTP over TCP
+};
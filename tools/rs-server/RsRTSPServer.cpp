@@ -158,6 +158,7 @@ RsRTSPServer::RsRTSPClientSession ::RsRTSPClientSession(RTSPServer& t_ourServer,
 {}
 
 RsRTSPServer::RsRTSPClientSession::~RsRTSPClientSession() {
+    RsServerMediaSubsession::getSharedMemorySessions().erase(fOurSessionId);
     try
     {
         closeRsCamera();
@@ -254,6 +255,14 @@ void RsRTSPServer::RsRTSPClientSession::handleCmd_SET_PARAMETER(RTSPClientConnec
     std::string afterSplit; //, opt, val;
 
     envir() << "SET_PARAMETER \n";
+    size_t keyframe = str.find("\r\n\r\n" + RS_KEYFRAME_PARAMETER + ":");
+    if(keyframe != std::string::npos)
+    {
+        std::string trackId;
+        std::istringstream(str.substr(keyframe + 4 + RS_KEYFRAME_PARAMETER.size() + 1)) >> trackId;
+        requestKeyframe(t_ourClientConnection, trackId);
+        return;
+    }
     afterSplit = str.substr(str.find(ContentLength) + ContentLength.size());
     char* contLength = strtok((char*)afterSplit.c_str(), "\r\n: ");
     char* sensorName = strtok(NULL, "_\r\n:");
@@ -272,8 +281,30 @@ void RsRTSPServer::RsRTSPClientSession::handleCmd_SET_PARAMETER(RTSPClientConnec
         return;
     }
 }
+void RsRTSPServer::RsRTSPClientSession::requestKeyframe(RTSPClientConnection* t_ourClientConnection, const std::string& t_trackId)
+{
+    ServerMediaSubsessionIterator iter(*fOurServerMediaSession);
+    ServerMediaSubsession* subsession;
+    while((subsession = iter.next()) != NULL)
+    {
+        if(t_trackId == subsession->trackId())
+        {
+            RsSensor& sensor = static_cast<RsServerMediaSession*>(fOurServerMediaSession)->getRsSensor();
+            sensor.requestKeyframe(sensor.getStreamProfileKey(((RsServerMediaSubsession*)(subsession))->getStreamProfile()));
+            setRTSPResponse(t_ourClientConnection, "200 OK");
+            return;
+        }
+    }
+    setRTSPResponse(t_ourClientConnection, "404 Stream Not Found");
+}
+
 void RsRTSPServer::RsRTSPClientSession::handleCmd_SETUP(RTSPServer::RTSPClientConnection* t_ourClientConnection, char const* t_urlPreSuffix, char const* t_urlSuffix, char const* t_fullRequestStr)
 {
+    // Clients on the same host ask for the frames in shared memory; the stream source is created by the SETUP
+    if(strstr(t_fullRequestStr, RS_SHARED_MEMORY_HEADER.c_str()) != NULL)
+    {
+        RsServerMediaSubsession::getSharedMemorySessions().insert(fOurSessionId);
+    }
     RTSPServer::RTSPClientSession::handleCmd_SETUP(t_ourClientConnection, t_urlPreSuffix, t_urlSuffix, t_fullRequestStr);
     ServerMediaSubsession* subsession;
     if(t_urlSuffix[0] != '\0' && strcmp(fOurServerMediaSession->streamName(), t_urlPreSuffix) == 0)
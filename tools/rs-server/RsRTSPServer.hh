@@ -60,6 +60,8 @@ public:
 
         void openRsCamera();
         void closeRsCamera();
+        // Answers the keyframe request of a client for the stream of track t_trackId
+        void requestKeyframe(RTSPClientConnection* t_ourClientConnection, const std::string& t_trackId);
         void emptyStreamProfileQueue(long long int t_profile_key);
 
     private:
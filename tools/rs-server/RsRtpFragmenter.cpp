@@ -0,0 +1,126 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "RsRtpFragmenter.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+
+// Packets given to the kernel in one call
+#define SEND_BATCH 64
+// Milliseconds to wait for room in the send buffer before the rest of a message is dropped
+#define SEND_TIMEOUT_MS 20
+// IPv4 and UDP headers
+#define UDP_OVERHEAD 28
+
+RsRtpFragmenter::RsRtpFragmenter(unsigned t_mtu)
+    : m_headers(SEND_BATCH)
+    , m_pieces(SEND_BATCH * 3)
+    , m_messages(SEND_BATCH)
+{
+    // Fragments are described by 16 bits, and UDP datagrams are limited to 64KB
+    t_mtu = std::min(std::max(t_mtu, 576u), 65535u);
+    m_fragmentSize = t_mtu - UDP_OVERHEAD - sizeof(RsFragmentPacketHeader);
+}
+
+unsigned RsRtpFragmenter::packetCount(const RsRtpMessage& t_message) const
+{
+    unsigned size = t_message.headerSize + t_message.dataSize;
+    return std::max(1u, (size + m_fragmentSize - 1) / m_fragmentSize);
+}
+
+int RsRtpFragmenter::preparePacket(const RsRtpMessage& t_message, unsigned t_index, unsigned char t_payloadType, uint32_t t_ssrc, uint16_t t_seqNo, RsFragmentPacketHeader& t_header, iovec* t_pieces) const
+{
+    unsigned messageSize = t_message.headerSize + t_message.dataSize;
+    unsigned begin = t_index * m_fragmentSize;
+    unsigned end = std::min(begin + m_fragmentSize, messageSize);
+    bool last = end == messageSize;
+
+    t_header.rtpFlags = 0x80;
+    t_header.rtpPayloadType = (t_payloadType & 0x7f) | (last ? 0x80 : 0);
+    t_header.rtpSeqNo = htons(t_seqNo);
+    t_header.rtpTimestamp = htonl(t_message.rtpTimestamp);
+    t_header.rtpSsrc = htonl(t_ssrc);
+    t_header.frameId = htonl(t_message.frameId);
+    t_header.offset = htonl(begin);
+    t_header.messageSize = htonl(messageSize);
+    t_header.fragmentSize = htons((uint16_t)m_fragmentSize);
+    t_header.reserved = 0;
+
+    int count = 0;
+    t_pieces[count].iov_base = &t_header;
+    t_pieces[count++].iov_len = sizeof(t_header);
+    // The fragment may end the message header and start the data
+    if(begin < t_message.headerSize)
+    {
+        unsigned headerEnd = std::min(end, t_message.headerSize);
+        t_pieces[count].iov_base = const_cast<unsigned char*>(t_message.header + begin);
+        t_pieces[count++].iov_len = headerEnd - begin;
+    }
+    if(end > t_message.headerSize)
+    {
+        unsigned dataBegin = std::max(begin, t_message.headerSize) - t_message.headerSize;
+        t_pieces[count].iov_base = const_cast<unsigned char*>(t_message.data + dataBegin);
+        t_pieces[count++].iov_len = end - t_message.headerSize - dataBegin;
+    }
+    return count;
+}
+
+int RsRtpFragmenter::send(int t_socket, const sockaddr* t_destination, socklen_t t_destinationSize, const RsRtpMessage& t_message, unsigned char t_payloadType, uint32_t t_ssrc, uint16_t& t_seqNo)
+{
+    unsigned total = packetCount(t_message);
+    unsigned sent = 0;
+    while(sent < total)
+    {
+        unsigned batch = std::min(total - sent, (unsigned)SEND_BATCH);
+        for(unsigned i = 0; i < batch; i++)
+        {
+            iovec* pieces = &m_pieces[i * 3];
+            memset(&m_messages[i], 0, sizeof(mmsghdr));
+            m_messages[i].msg_hdr.msg_name = const_cast<sockaddr*>(t_destination);
+            m_messages[i].msg_hdr.msg_namelen = t_destinationSize;
+            m_messages[i].msg_hdr.msg_iov = pieces;
+            m_messages[i].msg_hdr.msg_iovlen = preparePacket(t_message, sent + i, t_payloadType, t_ssrc, (uint16_t)(t_seqNo + i), m_headers[i], pieces);
+        }
+
+        int res = sendmmsg(t_socket, m_messages.data(), batch, 0);
+        if(res < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            if(errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                return -1;
+            }
+            // The send buffer is full: wait for the kernel to drain it
+            pollfd fd = {t_socket, POLLOUT, 0};
+            if(poll(&fd, 1, SEND_TIMEOUT_MS) <= 0)
+            {
+                return -1;
+            }
+            continue;
+        }
+        sent += res;
+        t_seqNo += res;
+    }
+    return sent;
+}
+
+unsigned RsRtpFragmenter::buildPacket(unsigned char* t_packet, const RsRtpMessage& t_message, unsigned t_index, unsigned char t_payloadType, uint32_t t_ssrc, uint16_t t_seqNo) const
+{
+    RsFragmentPacketHeader header;
+    iovec pieces[3];
+    int count = preparePacket(t_message, t_index, t_payloadType, t_ssrc, t_seqNo, header, pieces);
+    unsigned size = 0;
+    for(int i = 0; i < count; i++)
+    {
+        memcpy(t_packet + size, pieces[i].iov_base, pieces[i].iov_len);
+        size += pieces[i].iov_len;
+    }
+    return size;
+}
@@ -0,0 +1,57 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../../src/ipDeviceCommon/RsCommon.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <vector>
+
+// A frame as sent over the network: its header, then its data, each where it already lies in memory
+struct RsRtpMessage
+{
+    const unsigned char* header;
+    unsigned headerSize;
+    const unsigned char* data;
+    unsigned dataSize;
+    uint32_t frameId;
+    uint32_t rtpTimestamp;
+};
+
+/*
+    Splits messages into RTP packets of at most an MTU, each made of an RsFragmentPacketHeader and a fragment
+    of the message. Packets are gathered from the header and data of the message as they lie in memory, and sent
+    in batches of one system call, so the frame data is copied only by the kernel.
+    There is no forward error correction: a message missing a packet is dropped by the receiver.
+*/
+class RsRtpFragmenter
+{
+public:
+    explicit RsRtpFragmenter(unsigned t_mtu = RS_DEFAULT_MTU);
+
+    unsigned fragmentSize() const
+    {
+        return m_fragmentSize;
+    }
+    unsigned packetCount(const RsRtpMessage& t_message) const;
+
+    // Sends the message to t_destination over the UDP socket, numbering its packets from t_seqNo, which is advanced.
+    // Waits for the socket while its send buffer is full. Returns the number of packets sent, or -1 on error.
+    int send(int t_socket, const sockaddr* t_destination, socklen_t t_destinationSize, const RsRtpMessage& t_message, unsigned char t_payloadType, uint32_t t_ssrc, uint16_t& t_seqNo);
+
+    // Copies packet t_index of the message into t_packet, of at least an MTU, and returns its size.
+    // For transports that cannot gather, such as RTP over the RTSP connection.
+    unsigned buildPacket(unsigned char* t_packet, const RsRtpMessage& t_message, unsigned t_index, unsigned char t_payloadType, uint32_t t_ssrc, uint16_t t_seqNo) const;
+
+private:
+    // Fills the header and the pieces of packet t_index, returns the number of pieces
+    int preparePacket(const RsRtpMessage& t_message, unsigned t_index, unsigned char t_payloadType, uint32_t t_ssrc, uint16_t t_seqNo, RsFragmentPacketHeader& t_header, iovec* t_pieces) const;
+
+    unsigned m_fragmentSize;
+    std::vector<RsFragmentPacketHeader> m_headers;
+    std::vector<iovec> m_pieces;
+    std::vector<mmsghdr> m_messages;
+};
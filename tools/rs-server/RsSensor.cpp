@@ -42,7 +42,12 @@ int RsSensor::open(std::unordered_map<long long int, rs2::frame_queue>& t_stream
             std::shared_ptr<ICompression> compressPtr = CompressionFactory::getObject(vsp.width(), vsp.height(), vsp.format(), vsp.stream_type(), getStreamProfileBpp(vsp.format()));
             if(compressPtr != nullptr)
             {
-                m_iCompress.insert(std::pair<long long int, std::shared_ptr<ICompression>>(streamProfileKey, compressPtr));
+                // A new one for each opening: compressors that predict frames start over with the client
+                m_iCompress[streamProfileKey] = compressPtr;
+                // Compressors check the size of their output once it is written, so leave room for frames that do not compress
+                int frameSize = vsp.width() * vsp.height() * getStreamProfileBpp(vsp.format());
+                m_compressBufferSize[streamProfileKey] = frameSize + frameSize / 2;
+                m_memPool->reserve(m_compressBufferSize[streamProfileKey], 1);
             }
         }
         else
@@ -77,7 +82,7 @@ int RsSensor::start(std::unordered_map<long long int, rs2::frame_queue>& t_strea
             std::chrono::duration<double> timeSpan = std::chrono::duration_cast<std::chrono::duration<double>>(curSample - m_prevSample[profileKey]);
             if(CompressionFactory::isCompressionSupported(frame.get_profile().format(), frame.get_profile().stream_type()))
             {
-                unsigned char* buff = m_memPool->getNextMem();
+                unsigned char* buff = m_memPool->getNextMem(m_compressBufferSize.at(profileKey));
                 int frameSize = m_iCompress.at(profileKey)->compressBuffer((unsigned char*)frame.get_data(), frame.get_data_size(), buff);
                 if(frameSize == -1)
                 {
@@ -96,6 +101,15 @@ int RsSensor::start(std::unordered_map<long long int, rs2::frame_queue>& t_strea
     return EXIT_SUCCESS;
 }
 
+void RsSensor::requestKeyframe(long long int t_profileKey)
+{
+    auto compressor = m_iCompress.find(t_profileKey);
+    if(compressor != m_iCompress.end())
+    {
+        compressor->second->requestKeyframe();
+    }
+}
+
 long long int RsSensor::getStreamProfileKey(rs2::stream_profile t_profile)
 {
     long long int key;
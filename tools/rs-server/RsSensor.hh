@@ -39,12 +39,16 @@ public:
         return m_device;
     }
     std::vector<RsOption> getSupportedOptions();
+    // Makes the compressor of the stream code its next frame on its own
+    void requestKeyframe(long long int t_profileKey);
 
 private:
     UsageEnvironment* env;
     rs2::sensor m_sensor;
     std::unordered_map<long long int, rs2::video_stream_profile> m_streamProfiles;
     std::unordered_map<long long int, std::shared_ptr<ICompression>> m_iCompress;
+    // Size of the buffer each compressed stream is compressed into
+    std::unordered_map<long long int, int> m_compressBufferSize;
     rs2::device m_device;
     MemoryPool* m_memPool;
     std::unordered_map<long long int, std::chrono::high_resolution_clock::time_point> m_prevSample;
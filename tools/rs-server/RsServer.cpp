@@ -42,10 +42,26 @@ struct server
         SwitchArg arg_enable_compression("c", "enable-compression", "Enable video compression");
         ValueArg<std::string> arg_address("i", "interface-address", "Address of the interface to bind on", false, "", "string");
         ValueArg<unsigned int> arg_port("p", "port", "RTSP port to listen on", false, 8554, "integer");
+        ValueArg<std::string> arg_payload("", "payload", "RTP payload path: 'live555' to packetize frames through live555, or 'fragments' to send them in MTU-sized fragments straight from the frame buffer", false, "live555", "string");
+        ValueArg<unsigned int> arg_mtu("", "mtu", "Size of the packets of the 'fragments' payload path, including the IP and UDP headers", false, RS_DEFAULT_MTU, "integer");
+        SwitchArg arg_temporal_depth("", "temporal-depth", "Compress depth frames against the previous one, with -c");
+        ValueArg<int> arg_keyframe_interval("", "keyframe-interval", "Frames between the keyframes of --temporal-depth, 0 for keyframes on request of the clients only", false, 30, "integer");
+        ValueArg<int> arg_depth_tolerance("", "depth-tolerance", "Depth changes that --temporal-depth leaves out, in depth units", false, 0, "integer");
+        ValueArg<int> arg_jpeg_quality("", "jpeg-quality", "Quality of the JPEG compression of color and infrared frames, from 1 to 100, with -c", false, 75, "integer");
+        ValueArg<int> arg_jpeg_threads("", "jpeg-threads", "Threads that compress slices of each JPEG frame, 0 for one per core", false, 0, "integer");
+        SwitchArg arg_disable_shared_memory("", "disable-shared-memory", "Send the frames to clients on the same host too, rather than publishing them in shared memory");
 
         cmd.add(arg_enable_compression);
         cmd.add(arg_address);
         cmd.add(arg_port);
+        cmd.add(arg_payload);
+        cmd.add(arg_mtu);
+        cmd.add(arg_temporal_depth);
+        cmd.add(arg_keyframe_interval);
+        cmd.add(arg_depth_tolerance);
+        cmd.add(arg_jpeg_quality);
+        cmd.add(arg_jpeg_threads);
+        cmd.add(arg_disable_shared_memory);
 
         cmd.parse(argc, argv);
 
@@ -54,6 +70,19 @@ struct server
         {
             CompressionFactory::getIsEnabled() = 1;
         }
+        if (arg_temporal_depth.isSet())
+        {
+            CompressionFactory::getDepthMethod() = ZipMethod::temporal;
+            CompressionFactory::getKeyframeInterval() = arg_keyframe_interval.getValue();
+            CompressionFactory::getDepthTolerance() = arg_depth_tolerance.getValue();
+        }
+        if (arg_jpeg_quality.getValue() < 1 || arg_jpeg_quality.getValue() > 100)
+        {
+            std::cerr << "JPEG quality must be between 1 and 100\n";
+            exit(1);
+        }
+        CompressionFactory::getJpegQuality() = arg_jpeg_quality.getValue();
+        CompressionFactory::getJpegThreads() = arg_jpeg_threads.getValue();
 
         if (arg_address.isSet()) 
         {
@@ -64,7 +93,19 @@ struct server
         {
             port = arg_port.getValue();
         }
+
+        if (arg_payload.getValue() == RS_PAYLOAD_FRAGMENTS)
+        {
+            RsServerMediaSubsession::getFragmentMtu() = arg_mtu.getValue();
+        }
+        else if (arg_payload.getValue() != "live555")
+        {
+            std::cerr << "Unknown payload path: " << arg_payload.getValue() << "\n";
+            exit(1);
+        }
         
+        RsServerMediaSubsession::getSharedMemoryEnabled() = !arg_disable_shared_memory.isSet();
+
         OutPacketBuffer::increaseMaxSizeTo(MAX_MESSAGE_SIZE);
         
         // Begin by setting up our usage environment:
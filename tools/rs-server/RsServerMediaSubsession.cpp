@@ -4,8 +4,11 @@
 #include "RsServerMediaSubsession.h"
 #include "RsCommon.h"
 #include "RsServerMediaSession.h"
+#include "RsFragmentingRTPSink.h"
 #include "RsSimpleRTPSink.h"
 
+#include <unistd.h>
+
 #define CAPACITY 100
 
 RsServerMediaSubsession* RsServerMediaSubsession::createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsDevice> rsDevice)
@@ -33,13 +36,47 @@ rs2::video_stream_profile RsServerMediaSubsession::getStreamProfile()
     return m_videoStreamProfile;
 }
 
-FramedSource* RsServerMediaSubsession::createNewStreamSource(unsigned /*t_clientSessionId*/, unsigned& t_estBitrate)
+FramedSource* RsServerMediaSubsession::createNewStreamSource(unsigned t_clientSessionId, unsigned& t_estBitrate)
 {
     t_estBitrate = 20000;
-    return RsDeviceSource::createNew(envir(), m_videoStreamProfile, m_frameQueue);
+    std::shared_ptr<RsSharedMemoryRing> ring;
+    if(getSharedMemoryEnabled() && getSharedMemorySessions().count(t_clientSessionId))
+    {
+        // A ring per session, so the slots a client leaves held go away with it
+        std::string name = "/rs-server-" + std::to_string(getpid()) + "-" + std::to_string(t_clientSessionId) + "-" + std::to_string(m_videoStreamProfile.unique_id());
+        unsigned slotSize = sizeof(RsFrameHeader) + m_videoStreamProfile.width() * m_videoStreamProfile.height() * getStreamProfileBpp(m_videoStreamProfile.format());
+        ring = RsSharedMemoryRing::create(name, RS_SHARED_MEMORY_SLOTS, slotSize);
+        if(ring == nullptr)
+        {
+            envir() << "Cannot create shared memory for the stream, sending its frames\n";
+        }
+    }
+    return RsDeviceSource::createNew(envir(), m_videoStreamProfile, m_frameQueue, ring);
+}
+
+bool& RsServerMediaSubsession::getSharedMemoryEnabled()
+{
+    static bool enabled = true;
+    return enabled;
+}
+
+std::set<unsigned>& RsServerMediaSubsession::getSharedMemorySessions()
+{
+    static std::set<unsigned> sessions;
+    return sessions;
+}
+
+unsigned& RsServerMediaSubsession::getFragmentMtu()
+{
+    static unsigned mtu = 0;
+    return mtu;
 }
 
 RTPSink* RsServerMediaSubsession ::createNewRTPSink(Groupsock* t_rtpGroupsock, unsigned char t_rtpPayloadTypeIfDynamic, FramedSource* /*t_inputSource*/)
 {
+    if(getFragmentMtu() != 0)
+    {
+        return RsFragmentingRTPSink::createNew(envir(), t_rtpGroupsock, 96 + m_videoStreamProfile.stream_type(), RTP_TIMESTAMP_FREQ, RS_MEDIA_TYPE.c_str(), RS_PAYLOAD_FORMAT.c_str(), m_videoStreamProfile, m_rsDevice, getFragmentMtu());
+    }
     return RsSimpleRTPSink::createNew(envir(), t_rtpGroupsock, 96 + m_videoStreamProfile.stream_type(), RTP_TIMESTAMP_FREQ, RS_MEDIA_TYPE.c_str(), RS_PAYLOAD_FORMAT.c_str(), m_videoStreamProfile, m_rsDevice);
 }
\ No newline at end of file
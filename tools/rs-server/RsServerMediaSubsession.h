@@ -12,12 +12,20 @@
 
 #include "RsSource.hh"
 
+#include <set>
+
 class RsServerMediaSubsession : public OnDemandServerMediaSubsession
 {
 public:
     static RsServerMediaSubsession* createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsDevice> rsDevice);
     rs2::frame_queue& getFrameQueue();
     rs2::video_stream_profile getStreamProfile();
+    // MTU of the packets of the fragments payload path, or 0 to send the frames through live555's packetizer
+    static unsigned& getFragmentMtu();
+    // Whether clients on the same host are offered to take the frames from shared memory
+    static bool& getSharedMemoryEnabled();
+    // The client sessions that asked for shared memory in their SETUP requests
+    static std::set<unsigned>& getSharedMemorySessions();
 
 protected:
     RsServerMediaSubsession(UsageEnvironment& t_env, rs2::video_stream_profile& t_video_stream_profile, std::shared_ptr<RsDevice> device);
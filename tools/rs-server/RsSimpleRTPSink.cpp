@@ -3,6 +3,7 @@
 
 #include "RsSimpleRTPSink.h"
 #include "RsDevice.hh"
+#include "RsServerMediaSubsession.h"
 #include <algorithm>
 #include <compression/CompressionFactory.h>
 #include <iostream>
@@ -85,7 +86,7 @@ std::string get_extrinsics_string_per_stream(std::shared_ptr<RsDevice> device, r
     return str;
 }
 
-std::string getSdpLineForVideoStream(rs2::video_stream_profile& t_videoStream, std::shared_ptr<RsDevice> device)
+std::string getSdpLineForVideoStream(rs2::video_stream_profile& t_videoStream, std::shared_ptr<RsDevice> device, const std::string& t_payload)
 {
     std::string str;
     str.append(getSdpLineForField("width", t_videoStream.width()));
@@ -100,6 +101,18 @@ std::string getSdpLineForVideoStream(rs2::video_stream_profile& t_videoStream, s
     str.append(getSdpLineForField("usb_type", device.get()->getDevice().get_info(RS2_CAMERA_INFO_USB_TYPE_DESCRIPTOR)));
 	str.append(getSdpLineForField("product_id", device.get()->getDevice().get_info(RS2_CAMERA_INFO_PRODUCT_ID)));
     str.append(getSdpLineForField("compression", CompressionFactory::getIsEnabled()));
+    if(CompressionFactory::getDepthMethod() == ZipMethod::temporal)
+    {
+        str.append(getSdpLineForField("temporal", 1));
+    }
+    if(!t_payload.empty())
+    {
+        str.append(getSdpLineForField("payload", t_payload.c_str()));
+    }
+    if(RsServerMediaSubsession::getSharedMemoryEnabled())
+    {
+        str.append(getSdpLineForField("shm", 1));
+    }
 
     str.append(getSdpLineForField("ppx", t_videoStream.get_intrinsics().ppx));
     str.append(getSdpLineForField("ppy", t_videoStream.get_intrinsics().ppy));
@@ -132,13 +145,14 @@ RsSimpleRTPSink ::RsSimpleRTPSink(UsageEnvironment& t_env,
                                   std::shared_ptr<RsDevice> device,
                                   unsigned t_numChannels,
                                   Boolean t_allowMultipleFramesPerPacket,
-                                  Boolean t_doNormalMBitRule)
+                                  Boolean t_doNormalMBitRule,
+                                  std::string t_payload)
     : SimpleRTPSink(t_env, t_RTPgs, t_rtpPayloadFormat, t_rtpTimestampFrequency, t_sdpMediaTypeString, t_rtpPayloadFormatName, t_numChannels, t_allowMultipleFramesPerPacket, t_doNormalMBitRule)
 {
     // Then use this 'config' string to construct our "a=fmtp:" SDP line:
     unsigned fmtpSDPLineMaxSize = SDP_MAX_LINE_LENGHT;
     m_fFmtpSDPLine = new char[fmtpSDPLineMaxSize];
-    std::string sdpStr = getSdpLineForVideoStream(t_videoStream, device);
+    std::string sdpStr = getSdpLineForVideoStream(t_videoStream, device, t_payload);
     sprintf(m_fFmtpSDPLine, "a=fmtp:%d;%s\r\n", rtpPayloadType(), sdpStr.c_str());
 }
 
@@ -33,7 +33,8 @@ protected:
                     std::shared_ptr<RsDevice> device,
                     unsigned numChannels = 1,
                     Boolean allowMultipleFramesPerPacket = True,
-                    Boolean doNormalMBitRule = True);
+                    Boolean doNormalMBitRule = True,
+                    std::string payload = ""); // "payload" SDP field, for payload paths other than live555's
 
 private:
     char* m_fFmtpSDPLine;
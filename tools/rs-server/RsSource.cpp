@@ -11,13 +11,14 @@
 #include <ipDeviceCommon/Statistic.h>
 #include <librealsense2/h/rs_sensor.h>
 
-RsDeviceSource* RsDeviceSource::createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue)
+RsDeviceSource* RsDeviceSource::createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue, std::shared_ptr<RsSharedMemoryRing> t_ring)
 {
-    return new RsDeviceSource(t_env, t_videoStreamProfile, t_queue);
+    return new RsDeviceSource(t_env, t_videoStreamProfile, t_queue, t_ring);
 }
 
-RsDeviceSource::RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue)
+RsDeviceSource::RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue, std::shared_ptr<RsSharedMemoryRing> t_ring)
     : FramedSource(t_env)
+    , m_ring(t_ring)
 {
     m_framesQueue = &t_queue;
     m_streamProfile = &t_videoStreamProfile;
@@ -76,59 +77,77 @@ void RsDeviceSource::waitForFrame(RsDeviceSource* t_deviceSource)
     t_deviceSource->handleWaitForFrame();
 }
 
-void RsDeviceSource::deliverRSFrame(rs2::frame* t_frame)
+unsigned RsDeviceSource::getFrameMessage(rs2::frame& t_frame, RsFrameHeader& t_header, const unsigned char*& t_data)
 {
-    if(!isCurrentlyAwaitingData())
+    unsigned dataSize;
+    if(CompressionFactory::isCompressionSupported(t_frame.get_profile().format(), t_frame.get_profile().stream_type()))
     {
-        envir() << "isCurrentlyAwaitingData returned false\n";
-        return; // we're not ready for the data yet
+        dataSize = ((int*)t_frame.get_data())[0];
+        t_data = (const unsigned char*)t_frame.get_data() + sizeof(int);
+    }
+    else
+    {
+        dataSize = t_frame.get_data_size();
+        t_data = (const unsigned char*)t_frame.get_data();
     }
 
-    unsigned newFrameSize = t_frame->get_data_size();
-
-    gettimeofday(&fPresentationTime, NULL); // If you have a more accurate time - e.g., from an encoder - then use that instead.
-    RsFrameHeader header;
-    unsigned char* data;
-    if(CompressionFactory::isCompressionSupported(t_frame->get_profile().format(), t_frame->get_profile().stream_type()))
+    memset(&t_header, 0, sizeof(t_header));
+    t_header.networkHeader.data.frameSize = dataSize + sizeof(RsMetadataHeader);
+    if(t_frame.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP))
     {
-        fFrameSize = ((int*)t_frame->get_data())[0];
-        data = (unsigned char*)t_frame->get_data() + sizeof(int);
+        t_header.metadataHeader.data.timestamp = t_frame.get_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP) / 1000;
     }
     else
     {
-        fFrameSize = t_frame->get_data_size();
-        data = (unsigned char*)t_frame->get_data();
+        t_header.metadataHeader.data.timestamp = t_frame.get_timestamp();
     }
-    memmove(fTo + sizeof(RsFrameHeader), data, fFrameSize);
-    fFrameSize += sizeof(RsMetadataHeader);
-    header.networkHeader.data.frameSize = fFrameSize;
-    fFrameSize += sizeof(RsNetworkHeader);
-    if(t_frame->supports_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP))
+
+    if(t_frame.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER))
     {
-        header.metadataHeader.data.timestamp = t_frame->get_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP) / 1000;
+        t_header.metadataHeader.data.frameCounter = t_frame.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
     }
     else
     {
-        header.metadataHeader.data.timestamp = t_frame->get_timestamp();
+        t_header.metadataHeader.data.frameCounter = t_frame.get_frame_number();
     }
 
-    if(t_frame->supports_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER))
+    if(t_frame.supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
     {
-        header.metadataHeader.data.frameCounter = t_frame->get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
+        t_header.metadataHeader.data.actualFps = t_frame.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
     }
-    else
+
+    t_header.metadataHeader.data.timestampDomain = t_frame.get_frame_timestamp_domain();
+    return dataSize;
+}
+
+unsigned RsDeviceSource::getMessage(rs2::frame& t_frame, RsFrameHeader& t_header, const unsigned char*& t_data)
+{
+    unsigned dataSize = getFrameMessage(t_frame, t_header, t_data);
+    RsNetworkHeader& networkHeader = t_header.networkHeader;
+    // When all the slots are held, the frame is sent as usual
+    if(m_ring != nullptr && m_ring->publish(&t_header, sizeof(t_header), t_data, dataSize, networkHeader.data.sharedMemorySlot, networkHeader.data.sharedMemorySequence))
     {
-        header.metadataHeader.data.frameCounter = t_frame->get_frame_number();
+        strncpy(networkHeader.data.sharedMemoryName, m_ring->name().c_str(), SHARED_MEMORY_NAME_SIZE - 1);
+        return 0;
     }
+    return dataSize;
+}
 
-    if(t_frame->supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
+void RsDeviceSource::deliverRSFrame(rs2::frame* t_frame)
+{
+    if(!isCurrentlyAwaitingData())
     {
-        header.metadataHeader.data.actualFps = t_frame->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
+        envir() << "isCurrentlyAwaitingData returned false\n";
+        return; // we're not ready for the data yet
     }
 
-    header.metadataHeader.data.timestampDomain = t_frame->get_frame_timestamp_domain();
-
+    gettimeofday(&fPresentationTime, NULL); // If you have a more accurate time - e.g., from an encoder - then use that instead.
+    RsFrameHeader header;
+    const unsigned char* data;
+    unsigned dataSize = getMessage(*t_frame, header, data);
+    memmove(fTo + sizeof(RsFrameHeader), data, dataSize);
     memmove(fTo, &header, sizeof(header));
+    fFrameSize = dataSize + sizeof(RsFrameHeader);
 
     // After delivering the data, inform the reader that it is now available:
     FramedSource::afterGetting(this);
@@ -9,15 +9,33 @@
 #include <mutex>
 #include <rs.hpp> // Include RealSense Cross Platform API
 
+#include "RsCommon.h"
+#include "RsSharedMemoryRing.h"
+
 class RsDeviceSource : public FramedSource
 {
 public:
-    static RsDeviceSource* createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue);
+    static RsDeviceSource* createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue, std::shared_ptr<RsSharedMemoryRing> t_ring = nullptr);
     void handleWaitForFrame();
     static void waitForFrame(RsDeviceSource* t_deviceSource);
 
+    // Takes the next frame of the stream, for sinks that send frames from where they lie
+    bool pollFrame(rs2::frame& t_frame)
+    {
+        return m_framesQueue->poll_for_frame(&t_frame);
+    }
+    // Fills the header sent ahead of the frame, and returns where the data to send lies and its size
+    static unsigned getFrameMessage(rs2::frame& t_frame, RsFrameHeader& t_header, const unsigned char*& t_data);
+    // Same as getFrameMessage(), but when the client takes frames from shared memory the frame is published there,
+    // the header tells where, and no data is left to send
+    unsigned getMessage(rs2::frame& t_frame, RsFrameHeader& t_header, const unsigned char*& t_data);
+    bool usesSharedMemory() const
+    {
+        return m_ring != nullptr;
+    }
+
 protected:
-    RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue);
+    RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue, std::shared_ptr<RsSharedMemoryRing> t_ring);
     virtual ~RsDeviceSource();
 
 private:
@@ -31,4 +49,5 @@ private:
 private:
     rs2::frame_queue* m_framesQueue;
     rs2::video_stream_profile* m_streamProfile;
+    std::shared_ptr<RsSharedMemoryRing> m_ring;
 };
@@ -0,0 +1,159 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <src/device-cache.h>
+
+#include "../catch.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace librealsense;
+
+static std::string temp_directory()
+{
+#ifdef _WIN32
+    auto dir = getenv( "TEMP" );
+    return dir ? dir : ".";
+#else
+    return "/tmp";
+#endif
+}
+
+TEST_CASE( "device cache persists entries per firmware version", "[device-cache]" )
+{
+    auto dir = temp_directory();
+    std::string serial = "test-device-cache-0001";
+    std::remove( ( dir + "/" + serial + ".cache" ).c_str() );
+
+    std::vector< uint8_t > table( 512 );
+    for( size_t i = 0; i < table.size(); ++i )
+        table[i] = uint8_t( i * 7 );
+
+    {
+        device_cache cache( dir, serial, "5.13.0.50/0.0.2.130" );
+        std::vector< uint8_t > value;
+        REQUIRE_FALSE( cache.get( "calibration-table/25", value ) );
+        cache.put( "calibration-table/25", table );
+        cache.put( "al3d-param/503", { '1', '.', '2', '3' } );
+    }
+
+    // Same firmware: a new session reads the entries back
+    {
+        device_cache cache( dir, serial, "5.13.0.50/0.0.2.130" );
+        std::vector< uint8_t > value;
+        REQUIRE( cache.get( "calibration-table/25", value ) );
+        REQUIRE( value == table );
+        REQUIRE( cache.get( "al3d-param/503", value ) );
+        REQUIRE( value == std::vector< uint8_t >{ '1', '.', '2', '3' } );
+    }
+
+    // Firmware update: nothing is trusted anymore
+    {
+        device_cache cache( dir, serial, "5.13.0.55/0.0.2.131" );
+        std::vector< uint8_t > value;
+        REQUIRE_FALSE( cache.get( "calibration-table/25", value ) );
+        cache.put( "calibration-table/25", { 1, 2, 3 } );
+        cache.clear();
+        REQUIRE_FALSE( cache.get( "calibration-table/25", value ) );
+    }
+    REQUIRE_FALSE( std::ifstream( dir + "/" + serial + ".cache" ) );
+}
+
+static std::string read_file( const std::string & path )
+{
+    std::ifstream in( path, std::ios::binary );
+    return std::string( std::istreambuf_iterator< char >( in ), std::istreambuf_iterator< char >() );
+}
+
+static void write_file( const std::string & path, const std::string & content )
+{
+    std::ofstream out( path, std::ios::binary | std::ios::trunc );
+    out.write( content.data(), content.size() );
+}
+
+TEST_CASE( "device cache writes only on flush and only when an entry changed", "[device-cache]" )
+{
+    auto dir = temp_directory();
+    std::string serial = "test-device-cache-0002";
+    auto path = dir + "/" + serial + ".cache";
+    std::remove( path.c_str() );
+
+    {
+        device_cache cache( dir, serial, "5.13.0.50" );
+        cache.put( "calibration-table/25", { 1, 2, 3 } );
+        cache.put( "calibration-table/26", { 4, 5, 6 } );
+        REQUIRE_FALSE( std::ifstream( path ) );
+        cache.flush();
+        REQUIRE( std::ifstream( path ) );
+    }
+
+    // Putting back what was read does not rewrite the file
+    {
+        device_cache cache( dir, serial, "5.13.0.50" );
+        std::remove( path.c_str() );
+        cache.put( "calibration-table/25", { 1, 2, 3 } );
+        cache.flush();
+        REQUIRE_FALSE( std::ifstream( path ) );
+    }
+
+    // Entries put and not flushed are saved on destruction
+    {
+        device_cache cache( dir, serial, "5.13.0.50" );
+        cache.put( "calibration-table/25", { 7 } );
+    }
+    {
+        device_cache cache( dir, serial, "5.13.0.50" );
+        std::vector< uint8_t > value;
+        REQUIRE( cache.get( "calibration-table/25", value ) );
+        REQUIRE( value == std::vector< uint8_t >{ 7 } );
+        cache.clear();
+    }
+}
+
+TEST_CASE( "device cache drops a corrupt file", "[device-cache]" )
+{
+    auto dir = temp_directory();
+    std::string serial = "test-device-cache-0003";
+    auto path = dir + "/" + serial + ".cache";
+    std::remove( path.c_str() );
+
+    std::vector< uint8_t > table( 64, 0x5a );
+    {
+        device_cache cache( dir, serial, "5.13.0.50" );
+        cache.put( "calibration-table/25", table );
+    }
+    auto good = read_file( path );
+    REQUIRE( good.size() > table.size() );
+
+    // The file ends with the value of the only entry and its checksum
+    auto value_pos = good.size() - sizeof( uint32_t ) - table.size();
+
+    SECTION( "flipped bit" )
+    {
+        auto bad = good;
+        bad[value_pos + 10] ^= 0x10;
+        write_file( path, bad );
+    }
+    SECTION( "length past the end of the file" )
+    {
+        auto bad = good;
+        uint32_t len = 0x7fffffff;
+        bad.replace( value_pos - sizeof( len ), sizeof( len ), reinterpret_cast< const char * >( &len ), sizeof( len ) );
+        write_file( path, bad );
+    }
+    SECTION( "truncated" )
+    {
+        write_file( path, good.substr( 0, good.size() - 2 ) );
+    }
+
+    {
+        device_cache cache( dir, serial, "5.13.0.50" );
+        std::vector< uint8_t > value;
+        REQUIRE_FALSE( cache.get( "calibration-table/25", value ) );
+    }
+    REQUIRE_FALSE( std::ifstream( path ) );
+}
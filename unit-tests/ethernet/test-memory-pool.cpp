@@ -0,0 +1,104 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../test.h"
+#include <src/ipDeviceCommon/MemoryPool.h>
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+// Counts the heap allocations of the whole test program
+static std::atomic< size_t > heap_allocations( 0 );
+
+void * operator new( size_t size )
+{
+    heap_allocations++;
+    if( void * p = std::malloc( size ? size : 1 ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free( p );
+}
+
+TEST_CASE( "memory pool reuses buffers of the same size class", "[ethernet]" )
+{
+    MemoryPool pool;
+    const size_t depth_size = sizeof( RsFrameHeader ) + 848 * 480 * 2;
+    const size_t color_size = sizeof( RsFrameHeader ) + 1280 * 720 * 3;
+
+    auto depth = pool.getNextMem( depth_size );
+    auto color = pool.getNextMem( color_size );
+    REQUIRE( depth );
+    REQUIRE( color );
+    REQUIRE( reinterpret_cast< uintptr_t >( depth + sizeof( RsFrameHeader ) ) % 16 == 0 );
+    memset( depth, 1, depth_size );
+    memset( color, 2, color_size );
+    pool.returnMem( depth );
+    pool.returnMem( color );
+
+    // The same size class gives back the same buffer; other sizes never get it
+    REQUIRE( pool.getNextMem( depth_size - 100 ) == depth );
+    auto small = pool.getNextMem( 1024 );
+    REQUIRE( small != depth );
+    REQUIRE( small != color );
+
+    auto metrics = pool.getMetrics();
+    REQUIRE( metrics.allocations == 3 );
+    REQUIRE( metrics.reuses == 1 );
+    REQUIRE( metrics.outstanding == 2 );
+
+    pool.returnMem( depth );
+    pool.returnMem( small );
+}
+
+TEST_CASE( "memory pool keeps at most its capacity", "[ethernet]" )
+{
+    const size_t size = 64 * 1024;
+    MemoryPool pool( 2 * size );
+    unsigned char * buffers[4];
+    for( auto & b : buffers )
+        b = pool.getNextMem( size );
+    for( auto & b : buffers )
+        pool.returnMem( b );
+
+    auto metrics = pool.getMetrics();
+    REQUIRE( metrics.pooledBytes == 2 * size );
+    REQUIRE( metrics.releases == 2 );
+    REQUIRE( metrics.outstanding == 0 );
+}
+
+TEST_CASE( "memory pool does not allocate while streaming", "[ethernet]" )
+{
+    MemoryPool pool;
+    const size_t sizes[] = { sizeof( RsFrameHeader ) + 1280 * 720 * 2,
+                             sizeof( RsFrameHeader ) + 1280 * 720 * 3,
+                             sizeof( RsFrameHeader ) + 640 * 480 };
+    // A receive buffer and a decompression buffer per stream, as in RsSink
+    for( auto size : sizes )
+        pool.reserve( size, 2 );
+    auto reserved = pool.getMetrics().allocations;
+
+    auto before = heap_allocations.load();
+    for( int frame = 0; frame < 300; ++frame )
+    {
+        for( auto size : sizes )
+        {
+            auto received = pool.getNextMem( size );
+            auto decompressed = pool.getNextMem( size );
+            received[size - 1] = decompressed[0] = uint8_t( frame );
+            pool.returnMem( received );
+            pool.returnMem( decompressed );
+        }
+    }
+    auto after = heap_allocations.load();
+
+    REQUIRE( after == before );
+    auto metrics = pool.getMetrics();
+    REQUIRE( metrics.allocations == reserved );
+    REQUIRE( metrics.reuses == 300 * 3 * 2 );
+    REQUIRE( metrics.outstanding == 0 );
+}
@@ -0,0 +1,85 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+// Before the test header: the logging of the codecs takes the INFO macro of Catch away
+#include <src/compression/ParallelJpegCompression.h>
+#include "../test.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+struct jpeg_format
+{
+    rs2_format format;
+    int bpp;
+};
+
+static const jpeg_format formats[] = { { RS2_FORMAT_YUYV, 2 },
+                                       { RS2_FORMAT_UYVY, 2 },
+                                       { RS2_FORMAT_RGB8, 3 },
+                                       { RS2_FORMAT_BGR8, 3 },
+                                       { RS2_FORMAT_Y8, 1 } };
+
+// Smooth gradients, which JPEG reproduces closely, in every byte of the pixel
+static std::vector< uint8_t > color_frame( int width, int height, int bpp )
+{
+    std::vector< uint8_t > frame( width * height * bpp );
+    for( int y = 0; y < height; ++y )
+        for( int x = 0; x < width; ++x )
+            for( int c = 0; c < bpp; ++c )
+                frame[( y * width + x ) * bpp + c] = uint8_t( 40 + x + 2 * y + 30 * c );
+    return frame;
+}
+
+// The JPEG of the frame, without the size in front of it
+static std::vector< uint8_t > compress( int width, int height, const jpeg_format & f, int slices, std::vector< uint8_t > frame )
+{
+    ParallelJpegCompression codec( width, height, f.format, f.bpp, 90, slices );
+    std::vector< uint8_t > buffer( frame.size() );
+    auto res = codec.compressBuffer( frame.data(), int( frame.size() ), buffer.data() );
+    REQUIRE( res > int( sizeof( int ) ) );
+    return std::vector< uint8_t >( buffer.begin() + sizeof( int ), buffer.begin() + res );
+}
+
+TEST_CASE( "parallel JPEG gives the same bytes for any number of slices", "[compression]" )
+{
+    // Neither dimension is a whole number of MCUs, and the slice counts include odd ones and
+    // more slices than MCU rows
+    int sizes[][2] = { { 100, 61 }, { 64, 37 }, { 48, 8 } };
+    for( auto & size : sizes )
+    {
+        for( auto & f : formats )
+        {
+            INFO( size[0] << "x" << size[1] << " format " << f.format );
+            auto frame = color_frame( size[0], size[1], f.bpp );
+            auto single = compress( size[0], size[1], f, 1, frame );
+            for( int slices : { 2, 3, 4, 5, 7 } )
+            {
+                INFO( slices << " slices" );
+                REQUIRE( compress( size[0], size[1], f, slices, frame ) == single );
+            }
+        }
+    }
+}
+
+TEST_CASE( "parallel JPEG frames decode with JpegCompression", "[compression]" )
+{
+    const int width = 100;
+    const int height = 61;
+    for( auto & f : formats )
+    {
+        INFO( "format " << f.format );
+        auto frame = color_frame( width, height, f.bpp );
+        auto jpeg = compress( width, height, f, 3, frame );
+
+        JpegCompression decoder( width, height, f.format, f.bpp );
+        std::vector< uint8_t > decoded( frame.size() );
+        REQUIRE( decoder.decompressBuffer( jpeg.data(), int( jpeg.size() ), decoded.data() ) == int( frame.size() ) );
+
+        double error = 0;
+        for( size_t i = 0; i < frame.size(); ++i )
+            error += std::abs( int( decoded[i] ) - int( frame[i] ) );
+        REQUIRE( error / frame.size() < 3. );
+    }
+}
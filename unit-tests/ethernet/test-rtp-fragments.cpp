@@ -0,0 +1,238 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../tools/rs-server/RsRtpFragmenter.cpp
+//#cmake:add-file ../../src/ethernet/RsFragmentReassembler.cpp
+
+#include "../test.h"
+#include <tools/rs-server/RsRtpFragmenter.h>
+#include <src/ethernet/RsFragmentReassembler.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <poll.h>
+#include <random>
+#include <unistd.h>
+#include <vector>
+
+static std::vector< unsigned char > random_bytes( size_t size, unsigned seed )
+{
+    std::mt19937 rng( seed );
+    std::vector< unsigned char > res( size );
+    for( auto & b : res )
+        b = (unsigned char)rng();
+    return res;
+}
+
+// A frame message as rs-server sends it: its header, then the frame data
+struct test_message
+{
+    RsFrameHeader header;
+    std::vector< unsigned char > data;
+
+    test_message( size_t size, unsigned seed )
+        : data( random_bytes( size, seed ) )
+    {
+        memset( &header, 0, sizeof( header ) );
+        header.networkHeader.data.frameSize = (uint32_t)size;
+        header.metadataHeader.data.frameCounter = seed;
+    }
+
+    RsRtpMessage get( uint32_t frame_id ) const
+    {
+        return { (const unsigned char *)&header, sizeof( header ), data.data(), (unsigned)data.size(), frame_id, frame_id * 3000 };
+    }
+
+    bool matches( const std::vector< unsigned char > & buffer ) const
+    {
+        return ! memcmp( buffer.data(), &header, sizeof( header ) )
+            && ! memcmp( buffer.data() + sizeof( header ), data.data(), data.size() );
+    }
+};
+
+static std::vector< std::vector< unsigned char > > build_packets( const RsRtpFragmenter & fragmenter, const RsRtpMessage & message )
+{
+    std::vector< std::vector< unsigned char > > packets;
+    for( unsigned i = 0; i < fragmenter.packetCount( message ); i++ )
+    {
+        std::vector< unsigned char > packet( fragmenter.fragmentSize() + sizeof( RsFragmentPacketHeader ) );
+        packet.resize( fragmenter.buildPacket( packet.data(), message, i, 96, 1234, (uint16_t)i ) );
+        packets.push_back( packet );
+    }
+    return packets;
+}
+
+TEST_CASE( "fragments fit the MTU and carry the RTP header", "[ethernet]" )
+{
+    RsRtpFragmenter fragmenter( 1500 );
+    REQUIRE( fragmenter.fragmentSize() + sizeof( RsFragmentPacketHeader ) + 28 == 1500 );
+
+    test_message message( 100000, 1 );
+    auto packets = build_packets( fragmenter, message.get( 7 ) );
+    REQUIRE( packets.size() == ( sizeof( RsFrameHeader ) + 100000 + fragmenter.fragmentSize() - 1 ) / fragmenter.fragmentSize() );
+    for( size_t i = 0; i < packets.size(); i++ )
+    {
+        RsFragmentPacketHeader header;
+        memcpy( &header, packets[i].data(), sizeof( header ) );
+        REQUIRE( header.rtpFlags == 0x80 );
+        // Only the last packet is marked
+        REQUIRE( ( header.rtpPayloadType & 0x80 ) == ( i + 1 == packets.size() ? 0x80 : 0 ) );
+        REQUIRE( ( header.rtpPayloadType & 0x7f ) == 96 );
+        REQUIRE( ntohs( header.rtpSeqNo ) == i );
+        REQUIRE( ntohl( header.rtpSsrc ) == 1234 );
+        REQUIRE( ntohl( header.frameId ) == 7 );
+        REQUIRE( ntohl( header.offset ) == i * fragmenter.fragmentSize() );
+        REQUIRE( packets[i].size() <= 1500 - 28 );
+    }
+}
+
+TEST_CASE( "fragments are reassembled in any order", "[ethernet]" )
+{
+    RsRtpFragmenter fragmenter( 1500 );
+    test_message message( 300000, 2 );
+    auto packets = build_packets( fragmenter, message.get( 1 ) );
+
+    std::vector< unsigned char > buffer( MAX_MESSAGE_SIZE );
+    RsFragmentReassembler reassembler;
+    reassembler.begin( buffer.data(), (unsigned)buffer.size() );
+
+    SECTION( "in order" ) {}
+    SECTION( "reordered" )
+    {
+        std::shuffle( packets.begin(), packets.end(), std::mt19937( 3 ) );
+    }
+    SECTION( "duplicated" )
+    {
+        packets.insert( packets.begin() + 10, packets[3] );
+        packets.push_back( packets[0] );
+    }
+
+    int size = 0;
+    for( auto & packet : packets )
+    {
+        REQUIRE( size == 0 );
+        size = reassembler.push( packet.data(), (unsigned)packet.size() );
+        if( size )
+            break;
+    }
+    REQUIRE( size == sizeof( RsFrameHeader ) + 300000 );
+    REQUIRE( message.matches( buffer ) );
+    REQUIRE( reassembler.droppedMessages() == 0 );
+}
+
+TEST_CASE( "a message missing a fragment is dropped", "[ethernet]" )
+{
+    RsRtpFragmenter fragmenter( 9000 );
+    test_message first( 200000, 4 ), second( 150000, 5 );
+    auto lossy = build_packets( fragmenter, first.get( 1 ) );
+    lossy.erase( lossy.begin() + 5 );
+    auto complete = build_packets( fragmenter, second.get( 2 ) );
+
+    std::vector< unsigned char > buffer( MAX_MESSAGE_SIZE );
+    RsFragmentReassembler reassembler;
+    reassembler.begin( buffer.data(), (unsigned)buffer.size() );
+    for( auto & packet : lossy )
+        REQUIRE( reassembler.push( packet.data(), (unsigned)packet.size() ) == 0 );
+
+    int size = 0;
+    for( auto & packet : complete )
+        size = reassembler.push( packet.data(), (unsigned)packet.size() );
+    REQUIRE( size == sizeof( RsFrameHeader ) + 150000 );
+    REQUIRE( second.matches( buffer ) );
+    REQUIRE( reassembler.droppedMessages() == 1 );
+
+    // Late fragments of the dropped message are ignored
+    reassembler.begin( buffer.data(), (unsigned)buffer.size() );
+    REQUIRE( reassembler.push( lossy[0].data(), (unsigned)lossy[0].size() ) == 0 );
+    REQUIRE( reassembler.droppedMessages() == 1 );
+}
+
+TEST_CASE( "a message larger than the buffer is dropped", "[ethernet]" )
+{
+    RsRtpFragmenter fragmenter;
+    test_message message( 50000, 6 );
+    auto packets = build_packets( fragmenter, message.get( 1 ) );
+
+    std::vector< unsigned char > buffer( 40000 );
+    RsFragmentReassembler reassembler;
+    reassembler.begin( buffer.data(), (unsigned)buffer.size() );
+    for( auto & packet : packets )
+        REQUIRE( reassembler.push( packet.data(), (unsigned)packet.size() ) == 0 );
+    REQUIRE( reassembler.droppedMessages() == 1 );
+}
+
+// A pair of non-blocking UDP sockets on the loopback, the first sending to the second
+struct loopback
+{
+    int sender, receiver;
+    sockaddr_in address;
+
+    loopback()
+    {
+        sender = socket( AF_INET, SOCK_DGRAM, 0 );
+        receiver = socket( AF_INET, SOCK_DGRAM, 0 );
+        REQUIRE( sender >= 0 );
+        REQUIRE( receiver >= 0 );
+        int size = 8 * 1024 * 1024;
+        setsockopt( sender, SOL_SOCKET, SO_SNDBUF, &size, sizeof( size ) );
+        if( setsockopt( receiver, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof( size ) ) )
+            setsockopt( receiver, SOL_SOCKET, SO_RCVBUF, &size, sizeof( size ) );
+
+        memset( &address, 0, sizeof( address ) );
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+        socklen_t length = sizeof( address );
+        REQUIRE( bind( receiver, (sockaddr *)&address, length ) == 0 );
+        REQUIRE( getsockname( receiver, (sockaddr *)&address, &length ) == 0 );
+        fcntl( sender, F_SETFL, fcntl( sender, F_GETFL ) | O_NONBLOCK );
+        fcntl( receiver, F_SETFL, fcntl( receiver, F_GETFL ) | O_NONBLOCK );
+    }
+
+    ~loopback()
+    {
+        close( sender );
+        close( receiver );
+    }
+
+    // Reads until a message is complete or nothing comes for a while
+    int receive( RsFragmentReassembler & reassembler, int timeout_ms = 200 )
+    {
+        while( true )
+        {
+            int size = reassembler.receive( receiver );
+            if( size > 0 )
+                return size;
+            if( size < 0 )
+            {
+                pollfd fd = { receiver, POLLIN, 0 };
+                if( poll( &fd, 1, timeout_ms ) <= 0 )
+                    return 0;
+            }
+        }
+    }
+};
+
+TEST_CASE( "frames are received over UDP into the frame buffer", "[ethernet]" )
+{
+    loopback sockets;
+    RsRtpFragmenter fragmenter;
+    RsFragmentReassembler reassembler;
+    std::vector< unsigned char > buffer( MAX_MESSAGE_SIZE );
+
+    uint16_t seq = 0;
+    for( uint32_t id = 1; id <= 5; id++ )
+    {
+        // Sizes that are not multiples of the fragment, and one that fits a single packet
+        test_message message( id == 3 ? 100 : 100000 + id, id );
+        auto packets = fragmenter.send( sockets.sender, (sockaddr *)&sockets.address, sizeof( sockets.address ), message.get( id ), 96, 1234, seq );
+        REQUIRE( packets == (int)fragmenter.packetCount( message.get( id ) ) );
+
+        reassembler.begin( buffer.data(), (unsigned)buffer.size() );
+        REQUIRE( sockets.receive( reassembler ) == (int)( sizeof( RsFrameHeader ) + message.data.size() ) );
+        REQUIRE( message.matches( buffer ) );
+    }
+    REQUIRE( reassembler.droppedMessages() == 0 );
+}
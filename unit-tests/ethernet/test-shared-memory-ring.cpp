@@ -0,0 +1,171 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/ipDeviceCommon/RsSharedMemoryRing.cpp
+
+// The ring and the processes sharing it here are POSIX (shm_open, fork), as on the Linux network device
+#ifdef __linux__
+
+#include "../test.h"
+#include <src/ipDeviceCommon/RsSharedMemoryRing.h>
+
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+static std::string ring_name( const char * test )
+{
+    return std::string( "/rs-test-" ) + test + "-" + std::to_string( getpid() );
+}
+
+// Publishes a message whose header and data are filled with value
+static bool publish( RsSharedMemoryRing & ring, unsigned char value, unsigned size, uint32_t & slot, uint64_t & sequence )
+{
+    std::vector< unsigned char > header( 256, value ), data( size - 256, value );
+    return ring.publish( header.data(), (unsigned)header.size(), data.data(), (unsigned)data.size(), slot, sequence );
+}
+
+static bool filled_with( const unsigned char * message, unsigned size, unsigned char value )
+{
+    for( unsigned i = 0; i < size; i++ )
+        if( message[i] != value )
+            return false;
+    return true;
+}
+
+TEST_CASE( "shared memory ring hands messages to readers", "[ethernet]" )
+{
+    auto writer = RsSharedMemoryRing::create( ring_name( "read" ), 4, 64 * 1024 );
+    REQUIRE( writer );
+    auto reader = RsSharedMemoryRing::open( writer->name() );
+    REQUIRE( reader );
+
+    uint32_t slot;
+    uint64_t sequence;
+    REQUIRE( publish( *writer, 7, 10000, slot, sequence ) );
+    unsigned size = 0;
+    auto message = reader->acquire( slot, sequence, size );
+    REQUIRE( message );
+    REQUIRE( size == 10000 );
+    REQUIRE( filled_with( message, size, 7 ) );
+    // Messages are aligned for the frames that follow their header
+    REQUIRE( reinterpret_cast< uintptr_t >( message ) % 64 == 0 );
+
+    // A message larger than a slot is left to be sent
+    REQUIRE_FALSE( publish( *writer, 8, 64 * 1024 + 1, slot, sequence ) );
+
+    REQUIRE( RsSharedMemoryRing::releaseMessage( message ) );
+    std::vector< unsigned char > elsewhere( 16 );
+    REQUIRE_FALSE( RsSharedMemoryRing::releaseMessage( elsewhere.data() ) );
+}
+
+TEST_CASE( "shared memory ring never overwrites held messages", "[ethernet]" )
+{
+    auto writer = RsSharedMemoryRing::create( ring_name( "held" ), 3, 4096 );
+    REQUIRE( writer );
+    auto reader = RsSharedMemoryRing::open( writer->name() );
+    REQUIRE( reader );
+
+    uint32_t held_slot;
+    uint64_t held_sequence;
+    REQUIRE( publish( *writer, 1, 1000, held_slot, held_sequence ) );
+    unsigned size;
+    auto held = reader->acquire( held_slot, held_sequence, size );
+    REQUIRE( held );
+
+    // The writer goes around the held slot
+    for( unsigned char value = 2; value < 10; value++ )
+    {
+        uint32_t slot;
+        uint64_t sequence;
+        REQUIRE( publish( *writer, value, 1000, slot, sequence ) );
+        REQUIRE( slot != held_slot );
+    }
+    REQUIRE( filled_with( held, 1000, 1 ) );
+
+    // Once every slot is held, messages are not published
+    std::vector< const unsigned char * > messages;
+    uint32_t slot;
+    uint64_t sequence;
+    while( publish( *writer, 10, 1000, slot, sequence ) )
+    {
+        auto message = reader->acquire( slot, sequence, size );
+        REQUIRE( message );
+        messages.push_back( message );
+        REQUIRE( messages.size() < 3 );
+    }
+    REQUIRE( messages.size() == 2 );
+
+    reader->release( held );
+    REQUIRE( publish( *writer, 11, 1000, slot, sequence ) );
+    REQUIRE( slot == held_slot );
+
+    // The message that was there is gone
+    REQUIRE( reader->acquire( held_slot, held_sequence, size ) == nullptr );
+    for( auto message : messages )
+        reader->release( message );
+}
+
+TEST_CASE( "shared memory ring is shared between processes", "[ethernet]" )
+{
+    auto writer = RsSharedMemoryRing::create( ring_name( "fork" ), 2, 4096 );
+    REQUIRE( writer );
+    uint32_t slot;
+    uint64_t sequence;
+    REQUIRE( publish( *writer, 42, 2000, slot, sequence ) );
+
+    int to_parent[2], to_child[2];
+    REQUIRE( pipe( to_parent ) == 0 );
+    REQUIRE( pipe( to_child ) == 0 );
+    pid_t child = fork();
+    REQUIRE( child >= 0 );
+    if( child == 0 )
+    {
+        // Hold the message until the parent has published around it
+        auto reader = RsSharedMemoryRing::open( writer->name() );
+        unsigned size = 0;
+        auto message = reader ? reader->acquire( slot, sequence, size ) : nullptr;
+        char result = message && size == 2000 && filled_with( message, size, 42 ) ? 1 : 0;
+        char go;
+        if( write( to_parent[1], &result, 1 ) != 1 || read( to_child[0], &go, 1 ) != 1 )
+            _exit( 2 );
+        if( message )
+            reader->release( message );
+        _exit( 0 );
+    }
+
+    char result = 0;
+    REQUIRE( read( to_parent[0], &result, 1 ) == 1 );
+    REQUIRE( result == 1 );
+
+    // The slot the other process holds is not written over
+    uint32_t other;
+    uint64_t other_sequence;
+    for( unsigned char value = 43; value < 46; value++ )
+    {
+        REQUIRE( publish( *writer, value, 2000, other, other_sequence ) );
+        REQUIRE( other != slot );
+    }
+
+    char go = 1;
+    REQUIRE( write( to_child[1], &go, 1 ) == 1 );
+    int status;
+    REQUIRE( waitpid( child, &status, 0 ) == child );
+    REQUIRE( WIFEXITED( status ) );
+    REQUIRE( WEXITSTATUS( status ) == 0 );
+
+    // Released by the other process
+    REQUIRE( publish( *writer, 46, 2000, other, other_sequence ) );
+    REQUIRE( other == slot );
+
+    for( int fd : { to_parent[0], to_parent[1], to_child[0], to_child[1] } )
+        close( fd );
+}
+
+#else
+
+#include "../test.h"
+
+#endif
@@ -0,0 +1,116 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+// Before the test header: the logging of the codecs takes the INFO macro of Catch away
+#include <src/compression/TemporalCompression.h>
+#include "../test.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const int W = 96;
+static const int H = 64;
+
+// A slanted wall with sensor noise and holes
+static std::vector< uint16_t > depth_frame( std::mt19937 & rng, int noise )
+{
+    std::vector< uint16_t > frame( W * H );
+    for( int y = 0; y < H; ++y )
+        for( int x = 0; x < W; ++x )
+            frame[y * W + x] = ( rng() % 10 == 0 ) ? 0 : uint16_t( 1000 + 3 * x + y + int( rng() % ( 2 * noise + 1 ) ) - noise );
+    return frame;
+}
+
+// The packet sent over the network: the frame header and the compressed planes
+static std::vector< uint8_t > compress( TemporalCompression & codec, std::vector< uint16_t > frame )
+{
+    auto size = int( frame.size() * sizeof( uint16_t ) );
+    std::vector< uint8_t > buffer( size );
+    auto res = codec.compressBuffer( reinterpret_cast< unsigned char * >( frame.data() ), size, buffer.data() );
+    REQUIRE( res > int( sizeof( int ) ) );
+    int packet_size = 0;
+    memcpy( &packet_size, buffer.data(), sizeof( packet_size ) );
+    REQUIRE( packet_size + int( sizeof( int ) ) == res );
+    return std::vector< uint8_t >( buffer.begin() + sizeof( int ), buffer.begin() + res );
+}
+
+static int decompress( TemporalCompression & codec, std::vector< uint8_t > packet, std::vector< uint16_t > & frame )
+{
+    frame.assign( W * H, 0xffff );
+    return codec.decompressBuffer( packet.data(), int( packet.size() ), reinterpret_cast< unsigned char * >( frame.data() ) );
+}
+
+TEST_CASE( "temporal compression is lossless with no tolerance", "[compression]" )
+{
+    std::mt19937 rng( 49 );
+    TemporalCompression encoder( W, H, RS2_FORMAT_Z16, 2, 4, 0 );
+    TemporalCompression decoder( W, H, RS2_FORMAT_Z16, 2, 4, 0 );
+
+    // Keyframes and predicted frames alike
+    for( int i = 0; i < 10; ++i )
+    {
+        INFO( i );
+        auto frame = depth_frame( rng, 3 );
+        std::vector< uint16_t > decoded;
+        REQUIRE( decompress( decoder, compress( encoder, frame ), decoded ) == W * H * 2 );
+        REQUIRE( decoded == frame );
+        REQUIRE_FALSE( decoder.needsKeyframe() );
+    }
+}
+
+TEST_CASE( "temporal compression stays within its tolerance", "[compression]" )
+{
+    const int tolerance = 5;
+    std::mt19937 rng( 5 );
+    TemporalCompression encoder( W, H, RS2_FORMAT_Z16, 2, 0, tolerance );
+    TemporalCompression decoder( W, H, RS2_FORMAT_Z16, 2, 0, tolerance );
+
+    // The noise is larger than the tolerance, so some changes are sent and others left out
+    for( int i = 0; i < 20; ++i )
+    {
+        INFO( i );
+        auto frame = depth_frame( rng, 8 );
+        std::vector< uint16_t > decoded;
+        REQUIRE( decompress( decoder, compress( encoder, frame ), decoded ) == W * H * 2 );
+        for( int p = 0; p < W * H; ++p )
+        {
+            INFO( p );
+            if( ! frame[p] )
+                REQUIRE( decoded[p] == 0 );
+            else
+                REQUIRE( std::abs( int( decoded[p] ) - int( frame[p] ) ) <= tolerance );
+        }
+    }
+}
+
+TEST_CASE( "temporal compression recovers from a dropped frame with a keyframe", "[compression]" )
+{
+    std::mt19937 rng( 7 );
+    TemporalCompression encoder( W, H, RS2_FORMAT_Z16, 2, 0, 0 );
+    TemporalCompression decoder( W, H, RS2_FORMAT_Z16, 2, 0, 0 );
+    std::vector< uint16_t > decoded;
+
+    REQUIRE( decompress( decoder, compress( encoder, depth_frame( rng, 3 ) ), decoded ) > 0 );
+    compress( encoder, depth_frame( rng, 3 ) );  // Lost on the way
+
+    // The next frames are predicted from the lost one
+    REQUIRE( decompress( decoder, compress( encoder, depth_frame( rng, 3 ) ), decoded ) == -1 );
+    REQUIRE( decoder.needsKeyframe() );
+    REQUIRE_FALSE( decoder.needsKeyframe() );
+    REQUIRE( decompress( decoder, compress( encoder, depth_frame( rng, 3 ) ), decoded ) == -1 );
+    REQUIRE_FALSE( decoder.needsKeyframe() );
+
+    // The keyframe asked for restores decoding, and the frames predicted from it decode as well
+    encoder.requestKeyframe();
+    for( int i = 0; i < 3; ++i )
+    {
+        INFO( i );
+        auto frame = depth_frame( rng, 3 );
+        REQUIRE( decompress( decoder, compress( encoder, frame ), decoded ) == W * H * 2 );
+        REQUIRE( decoded == frame );
+    }
+    REQUIRE_FALSE( decoder.needsKeyframe() );
+}
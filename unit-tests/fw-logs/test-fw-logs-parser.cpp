@@ -0,0 +1,110 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <src/fw-logs/fw-logs-parser.h>
+
+#include "../catch.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+using namespace librealsense::fw_logs;
+
+static const char* xml =
+    "<Format>"
+    "<Event id=\"1\" numberOfArguments=\"0\" format=\"Device started\"/>"
+    "<Event id=\"2\" numberOfArguments=\"3\" format=\"Frame {0} of stream {1}, status {2:x}\"/>"
+    "<Event id=\"3\" numberOfArguments=\"1\" format=\"Power state {0,PowerState}\"/>"
+    "<Event id=\"4\" numberOfArguments=\"1\" format=\"Set {0} {1} {x} {00} {0,Unknown} {0:f}\"/>"
+    "<File id=\"7\" Name=\"sensor.c\"/>"
+    "<Thread id=\"2\" Name=\"Main\"/>"
+    "<Enums>"
+    "<Enum Name=\"PowerState\">"
+    "<EnumValue Key=\"0\" Value=\"Off\"/>"
+    "<EnumValue Key=\"1\" Value=\"On\"/>"
+    "</Enum>"
+    "</Enums>"
+    "</Format>";
+
+static fw_logs_binary_data make_log( uint16_t event_id, uint16_t p1, uint16_t p2, uint32_t p3, uint32_t timestamp )
+{
+    fw_log_binary log;
+    std::memset( &log, 0, sizeof( log ) );
+    log.dword1.bits.magic_number = 0xA0;
+    log.dword1.bits.thread_id = 2;
+    log.dword1.bits.file_id = 7;
+    log.dword2.bits.event_id = event_id;
+    log.dword3.p1 = p1;
+    log.dword3.p2 = p2;
+    log.dword4.p3 = p3;
+    log.dword5.timestamp = timestamp;
+
+    fw_logs_binary_data data;
+    auto bytes = reinterpret_cast< const uint8_t * >( &log );
+    data.logs_buffer.assign( bytes, bytes + sizeof( log ) );
+    return data;
+}
+
+TEST_CASE( "compiled formats match the XML", "[fw-logs]" )
+{
+    fw_logs_parser parser( xml );
+    auto message = [&parser]( fw_logs_binary_data data ) { return parser.parse_fw_log( &data )._message; };
+
+    auto log = make_log( 1, 0, 0, 0, 100 );
+    auto parsed = parser.parse_fw_log( &log );
+    CHECK( parsed._message == "Device started" );
+    CHECK( parsed._file_name == "sensor.c" );
+    CHECK( parsed._thread_name == "Main" );
+
+    CHECK( message( make_log( 2, 12, 3, 0xbeef, 200 ) ) == "Frame 12 of stream 3, status beef" );
+    CHECK( message( make_log( 2, 12, 3, 5, 200 ) ) == "Frame 12 of stream 3, status 05" );
+    CHECK( message( make_log( 3, 1, 0, 0, 300 ) ) == "Power state On" );
+
+    // Slots that are not valid for the event stay as written
+    CHECK( message( make_log( 4, 9, 0, 0, 400 ) ) == "Set 9 {1} {x} {00} {0,Unknown} 9" );
+
+    // A value outside of the enum leaves the message empty
+    CHECK( message( make_log( 3, 5, 0, 0, 500 ) ).empty() );
+
+    // Too short to hold a log
+    fw_logs_binary_data truncated;
+    truncated.logs_buffer.resize( 4 );
+    fw_log_data data;
+    CHECK_FALSE( parser.parse_fw_log( &truncated, &data ) );
+}
+
+TEST_CASE( "batch parsing throughput", "[fw-logs]" )
+{
+    fw_logs_parser parser( xml );
+
+    const size_t count = 100000;
+    std::vector< fw_logs_binary_data > logs;
+    for( size_t i = 0; i < count; ++i )
+    {
+        auto event_id = uint16_t( 1 + i % 3 );
+        auto p1 = uint16_t( event_id == 3 ? i % 2 : i );
+        logs.push_back( make_log( event_id, p1, uint16_t( i % 2 ), uint32_t( i ), uint32_t( i ) ) );
+    }
+
+    std::vector< fw_log_data > parsed( count );
+    std::vector< const fw_logs_binary_data * > in;
+    std::vector< fw_log_data * > out;
+    for( size_t i = 0; i < count; ++i )
+    {
+        in.push_back( &logs[i] );
+        out.push_back( &parsed[i] );
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE( parser.parse_fw_logs( in.data(), out.data(), count ) == count );
+    std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Parsed " << count << " firmware log lines at " << size_t( count / elapsed.count() )
+              << " lines/s" << std::endl;
+
+    CHECK( parsed[4]._message == "Frame 4 of stream 0, status 04" );
+    CHECK( parsed[5]._message == "Power state On" );
+    CHECK( parsed[6]._message == "Device started" );
+}
@@ -0,0 +1,193 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#ifdef __linux__
+
+#include <src/linux/udev-device-watcher.h>
+
+#include "../catch.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace librealsense::platform;
+using namespace std::chrono;
+
+// Hands out the events pushed by the test, as the netlink socket would
+class mock_event_source : public hotplug_event_source
+{
+public:
+    void push( hotplug_event const & event )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _events.push_back( event );
+        _cv.notify_one();
+    }
+
+    bool read( hotplug_event & event, milliseconds timeout ) override
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+        if( ! _cv.wait_for( lock, timeout, [&]() { return ! _events.empty(); } ) )
+            return false;
+        event = _events.front();
+        _events.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque< hotplug_event > _events;
+};
+
+static const std::string usb_root = "/sys/devices/pci0000:00/0000:00:14.0/usb2";
+
+static uvc_device_info make_node( std::string const & port, int video )
+{
+    uvc_device_info info;
+    info.vid = 0x8086;
+    info.pid = 0x0b3a;
+    info.id = "/dev/video" + std::to_string( video );
+    info.device_path = usb_root + "/" + port + "/" + port + ":1.0/video4linux/video" + std::to_string( video );
+    info.unique_id = port;
+    return info;
+}
+
+// Probing a video node opens it and issues ioctls; 'probe_latency' stands for that per node
+struct mock_system
+{
+    std::mutex mutex;
+    std::vector< uvc_device_info > nodes;
+    std::vector< std::string > scopes_queried;
+    milliseconds probe_latency{ 20 };
+
+    hotplug_enumerator enumerator()
+    {
+        hotplug_enumerator e;
+        e.query_uvc_devices = [this]( std::string const & scope ) {
+            std::vector< uvc_device_info > result;
+            std::lock_guard< std::mutex > lock( mutex );
+            scopes_queried.push_back( scope );
+            for( auto & n : nodes )
+            {
+                if( ! scope.empty() && n.device_path.compare( 0, scope.size() + 1, scope + "/" ) != 0 )
+                    continue;
+                std::this_thread::sleep_for( probe_latency );
+                result.push_back( n );
+            }
+            return result;
+        };
+        e.query_usb_devices = []() { return std::vector< usb_device_info >(); };
+        e.query_hid_devices = []() { return std::vector< hid_device_info >(); };
+        return e;
+    }
+};
+
+TEST_CASE( "udev watcher reports hot-plug without polling", "[linux][device-watcher]" )
+{
+    mock_system sys;
+    for( int i = 0; i < 8; ++i )
+        sys.nodes.push_back( make_node( "2-" + std::to_string( i + 1 ), 2 * i ) );
+
+    auto source = std::make_shared< mock_event_source >();
+    udev_device_watcher watcher( sys.enumerator(), source, milliseconds( 20 ) );
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    backend_device_group reported;
+    int n_callbacks = 0;
+    watcher.start( [&]( backend_device_group, backend_device_group curr ) {
+        std::lock_guard< std::mutex > lock( mutex );
+        reported = curr;
+        ++n_callbacks;
+        cv.notify_one();
+    } );
+
+    auto wait_for_callback = [&]( int n ) {
+        std::unique_lock< std::mutex > lock( mutex );
+        return cv.wait_for( lock, seconds( 5 ), [&]() { return n_callbacks >= n; } );
+    };
+
+    // Plug: the USB device, its interface and its video node announce themselves in one burst
+    {
+        std::lock_guard< std::mutex > lock( sys.mutex );
+        sys.nodes.push_back( make_node( "2-9", 16 ) );
+        sys.scopes_queried.clear();
+    }
+    auto plugged = steady_clock::now();
+    source->push( { "add", "/devices/pci0000:00/0000:00:14.0/usb2/2-9", "usb", "usb_device" } );
+    source->push( { "add", "/devices/pci0000:00/0000:00:14.0/usb2/2-9/2-9:1.0", "usb", "usb_interface" } );
+    source->push( { "add", "/devices/pci0000:00/0000:00:14.0/usb2/2-9/2-9:1.0/video4linux/video16", "video4linux", "" } );
+    REQUIRE( wait_for_callback( 1 ) );
+    auto latency = duration_cast< milliseconds >( steady_clock::now() - plugged ).count();
+    INFO( "hot-plug to callback: " << latency << " ms" );
+
+    // Only the new device was probed, so the latency is the settle time plus a single node
+    CHECK( latency < 1000 );
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        REQUIRE( reported.uvc_devices.size() == 9 );
+    }
+    {
+        std::lock_guard< std::mutex > lock( sys.mutex );
+        REQUIRE( sys.scopes_queried == std::vector< std::string >{ usb_root + "/2-9" } );
+    }
+
+    // Unplug
+    {
+        std::lock_guard< std::mutex > lock( sys.mutex );
+        sys.nodes.erase( sys.nodes.begin() );
+    }
+    source->push( { "remove", "/devices/pci0000:00/0000:00:14.0/usb2/2-1/2-1:1.0/video4linux/video0", "video4linux", "" } );
+    source->push( { "remove", "/devices/pci0000:00/0000:00:14.0/usb2/2-1", "usb", "usb_device" } );
+    REQUIRE( wait_for_callback( 2 ) );
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        REQUIRE( reported.uvc_devices.size() == 8 );
+        for( auto & n : reported.uvc_devices )
+            REQUIRE( n.unique_id != "2-1" );
+    }
+
+    // Events of unrelated subsystems do not trigger enumeration
+    source->push( { "add", "/devices/virtual/net/veth0", "net", "" } );
+    std::this_thread::sleep_for( milliseconds( 100 ) );
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        REQUIRE( n_callbacks == 2 );
+    }
+
+    watcher.stop();
+}
+
+TEST_CASE( "udev watcher enumerates subsystems concurrently", "[linux][device-watcher]" )
+{
+    hotplug_enumerator e;
+    e.query_uvc_devices = []( std::string const & ) {
+        std::this_thread::sleep_for( milliseconds( 200 ) );
+        return std::vector< uvc_device_info >();
+    };
+    e.query_usb_devices = []() {
+        std::this_thread::sleep_for( milliseconds( 200 ) );
+        return std::vector< usb_device_info >();
+    };
+    e.query_hid_devices = []() {
+        std::this_thread::sleep_for( milliseconds( 200 ) );
+        return std::vector< hid_device_info >();
+    };
+
+    auto start = steady_clock::now();
+    udev_device_watcher watcher( e, std::make_shared< mock_event_source >() );
+    auto elapsed = duration_cast< milliseconds >( steady_clock::now() - start ).count();
+    INFO( "initial enumeration: " << elapsed << " ms" );
+    CHECK( elapsed < 500 );
+}
+
+#else
+
+#include "../catch.h"
+
+#endif
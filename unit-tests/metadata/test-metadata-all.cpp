@@ -0,0 +1,56 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../test.h"
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <vector>
+
+using namespace rs2;
+
+TEST_CASE( "metadata bulk query matches the per-attribute queries", "[software-device]" )
+{
+    const int W = 16;
+    const int H = 8;
+
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 10.f, 10.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    frame_queue q( 1, true );
+    s.open( profile );
+    s.start( q );
+
+    s.set_metadata( RS2_FRAME_METADATA_FRAME_COUNTER, 123 );
+    s.set_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, 8500 );
+    s.set_metadata( RS2_FRAME_METADATA_GAIN_LEVEL, 16 );
+
+    std::vector< uint16_t > pixels( W * H, 1000 );
+    s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, 0,
+                        RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, profile } );
+    frame f;
+    REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+
+    rs2_metadata_type values[RS2_FRAME_METADATA_COUNT] = {};
+    auto supported = f.get_frame_metadata_all( values );
+
+    CHECK( ( supported >> RS2_FRAME_METADATA_FRAME_COUNTER & 1 ) );
+    CHECK( values[RS2_FRAME_METADATA_FRAME_COUNTER] == 123 );
+    CHECK( values[RS2_FRAME_METADATA_ACTUAL_EXPOSURE] == 8500 );
+    CHECK( values[RS2_FRAME_METADATA_GAIN_LEVEL] == 16 );
+
+    for( int i = 0; i < RS2_FRAME_METADATA_COUNT; i++ )
+    {
+        auto md = rs2_frame_metadata_value( i );
+        bool in_mask = ( supported >> i & 1 ) != 0;
+        CHECK( in_mask == f.supports_frame_metadata( md ) );
+        if( in_mask )
+            CHECK( f.get_frame_metadata( md ) == values[i] );
+        else
+            CHECK_THROWS( f.get_frame_metadata( md ) );
+    }
+
+    s.stop();
+    s.close();
+}
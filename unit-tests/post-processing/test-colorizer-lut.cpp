@@ -0,0 +1,146 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <librealsense2/hpp/rs_internal.hpp>
+#include <src/proc/synthetic-stream.h>
+#include <src/proc/colorizer.h>
+
+#include "../catch.h"
+
+#include <random>
+#include <vector>
+
+using namespace rs2;
+
+// Not a multiple of the 16 pixels of the vectorized mapping, so the scalar tail is covered too
+static const int W = 100;
+static const int H = 20;
+
+// Colorizes Z16 through the lookup table, and also per pixel the way it was done before the table,
+// from the same state
+class reference_colorizer : public librealsense::colorizer
+{
+public:
+    std::vector< uint8_t > colorize_per_pixel( const uint16_t * depth )
+    {
+        std::vector< uint8_t > rgb( W * H * 3 );
+        if( _equalize )
+        {
+            update_histogram( _hist_data, depth, W, H );
+            auto coloring_function = [this]( float data ) {
+                auto hist_data = _hist_data[(int)data];
+                auto pixels = (float)_hist_data[MAX_DEPTH - 1];
+                return ( hist_data / pixels );
+            };
+            make_rgb_data< uint16_t >( depth, rgb.data(), W, H, coloring_function );
+        }
+        else
+        {
+            auto min = _min;
+            auto max = _max;
+            auto coloring_function = [&, this]( float data ) {
+                if( min >= max )
+                    return 0.f;
+                return ( data * _depth_units - min ) / ( max - min );
+            };
+            make_rgb_data< uint16_t >( depth, rgb.data(), W, H, coloring_function );
+        }
+        return rgb;
+    }
+};
+
+class depth_source
+{
+public:
+    depth_source()
+        : _sensor( _dev.add_sensor( "depth" ) )
+        , _queue( 1, true )
+    {
+        rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 100.f, 100.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        _profile = _sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+        _sensor.open( _profile );
+        _sensor.start( _queue );
+    }
+
+    ~depth_source()
+    {
+        _sensor.stop();
+        _sensor.close();
+    }
+
+    frame make( std::vector< uint16_t > & depth, float units )
+    {
+        _sensor.on_video_frame( { depth.data(), []( void * ) {}, W * 2, 2, double( ++_number ),
+                                  RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, _number, _profile, units } );
+        frame f;
+        REQUIRE( _queue.try_wait_for_frame( &f, 5000 ) );
+        return f;
+    }
+
+private:
+    software_device _dev;
+    software_sensor _sensor;
+    stream_profile _profile;
+    frame_queue _queue;
+    int _number = 0;
+};
+
+TEST_CASE( "colorizer lookup table matches the per-pixel colorization", "[software-device]" )
+{
+    depth_source source;
+    auto internal = std::make_shared< reference_colorizer >();
+    filter colorize( std::shared_ptr< rs2_processing_block >( new rs2_processing_block( internal ),
+                                                              rs2_delete_processing_block ) );
+
+    // Two scenes with different histograms, and the edges of the 16-bit range
+    std::mt19937 rng( 27 );
+    std::vector< std::vector< uint16_t > > scenes( 2, std::vector< uint16_t >( W * H ) );
+    for( size_t s = 0; s < scenes.size(); ++s )
+        for( auto & d : scenes[s] )
+            d = ( rng() % 6 == 0 ) ? 0 : uint16_t( 200 + rng() % ( s ? 60000 : 5000 ) );
+    scenes[0][1] = 1;
+    scenes[0][2] = 0xffff;
+
+    // Every setting that the table is computed from changes between two frames at some point
+    int step = 0;
+    auto check = [&]() {
+        for( auto units : { 0.001f, 0.0001f } )
+            for( auto & scene : scenes )
+            {
+                INFO( "step " << step << " units " << units );
+                auto res = colorize.process( source.make( scene, units ) ).as< video_frame >();
+                REQUIRE( res );
+                REQUIRE( res.get_profile().format() == RS2_FORMAT_RGB8 );
+                auto expected = internal->colorize_per_pixel( scene.data() );
+                auto data = reinterpret_cast< const uint8_t * >( res.get_data() );
+                REQUIRE( std::equal( expected.begin(), expected.end(), data ) );
+            }
+        ++step;
+    };
+
+    for( int preset = 0; preset < 4; ++preset )
+    {
+        colorize.set_option( RS2_OPTION_VISUAL_PRESET, float( preset ) );
+        check();
+
+        for( auto equalize : { 0.f, 1.f, 0.f } )
+        {
+            colorize.set_option( RS2_OPTION_HISTOGRAM_EQUALIZATION_ENABLED, equalize );
+            check();
+            colorize.set_option( RS2_OPTION_MIN_DISTANCE, 0.5f );
+            colorize.set_option( RS2_OPTION_MAX_DISTANCE, 3.f );
+            check();
+            colorize.set_option( RS2_OPTION_MAX_DISTANCE, 9.f );
+            colorize.set_option( RS2_OPTION_MIN_DISTANCE, 0.f );
+            check();
+        }
+
+        for( int scheme = 0; scheme < 10; ++scheme )
+        {
+            colorize.set_option( RS2_OPTION_COLOR_SCHEME, float( scheme ) );
+            check();
+        }
+    }
+}
@@ -0,0 +1,90 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../test.h"
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace rs2;
+
+// Straightforward re-statement of the decimation rules: lower median of the non-zero
+// pixels for 2x2/3x3 blocks, integer mean of the non-zero pixels for larger blocks
+static std::vector< uint16_t > reference_decimation( std::vector< uint16_t > const & in,
+                                                     int w, int h, int scale,
+                                                     int padded_w, int padded_h )
+{
+    std::vector< uint16_t > out( padded_w * padded_h, 0 );
+    for( int j = 0; j < h / scale; j++ )
+    {
+        for( int i = 0; i < w / scale; i++ )
+        {
+            std::vector< uint16_t > valid;
+            for( int n = 0; n < scale; n++ )
+                for( int m = 0; m < scale; m++ )
+                    if( auto v = in[( j * scale + n ) * w + i * scale + m] )
+                        valid.push_back( v );
+
+            if( valid.empty() )
+                continue;
+
+            auto & pix = out[j * padded_w + i];
+            if( scale == 2 || scale == 3 )
+            {
+                std::sort( valid.begin(), valid.end() );
+                pix = valid[( valid.size() - 1 ) / 2];
+            }
+            else
+            {
+                int sum = 0;
+                for( auto v : valid )
+                    sum += v;
+                pix = uint16_t( sum / int( valid.size() ) );
+            }
+        }
+    }
+    return out;
+}
+
+TEST_CASE( "decimation output matches the reference for every scale", "[software-device]" )
+{
+    const int W = 848;
+    const int H = 480;
+
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 420.f, 420.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    frame_queue q( 1, true );
+    s.open( profile );
+    s.start( q );
+
+    // Roughly a third of the pixels are holes, so every valid-count case is exercised
+    std::mt19937 rng( 26 );
+    std::vector< uint16_t > pixels( W * H );
+    for( auto & p : pixels )
+        p = ( rng() % 3 == 0 ) ? 0 : uint16_t( rng() );
+
+    for( int scale = 1; scale <= 8; scale++ )
+    {
+        CAPTURE( scale );
+        s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, 0,
+                            RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, scale, profile, 0.001f } );
+        frame f;
+        REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+
+        decimation_filter dec;
+        dec.set_option( RS2_OPTION_FILTER_MAGNITUDE, float( scale ) );
+        auto res = dec.process( f ).as< video_frame >();
+        REQUIRE( res );
+
+        auto expected = reference_decimation( pixels, W, H, scale, res.get_width(), res.get_height() );
+        auto data = reinterpret_cast< const uint16_t * >( res.get_data() );
+        REQUIRE( std::equal( expected.begin(), expected.end(), data ) );
+    }
+    s.stop();
+    s.close();
+}
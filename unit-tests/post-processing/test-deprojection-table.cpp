@@ -0,0 +1,129 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <librealsense2/rsutil.h>
+#include <src/proc/deprojection-table.h>
+
+#include "../catch.h"
+
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+// Odd sizes, so the vectorized rows end in a scalar tail
+static const int W = 37;
+static const int H = 23;
+
+static rs2_intrinsics make_intrinsics( rs2_distortion model )
+{
+    rs2_intrinsics intrin{ W, H, W / 2.f - 0.3f, H / 2.f + 0.2f, 30.f, 31.f, model, { 0, 0, 0, 0, 0 } };
+    switch( model )
+    {
+    case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
+    case RS2_DISTORTION_BROWN_CONRADY:
+        intrin.coeffs[0] = 0.05f;
+        intrin.coeffs[1] = -0.02f;
+        intrin.coeffs[2] = 0.001f;
+        intrin.coeffs[3] = -0.002f;
+        intrin.coeffs[4] = 0.003f;
+        break;
+    case RS2_DISTORTION_FTHETA:
+        intrin.coeffs[0] = 0.9f;
+        break;
+    case RS2_DISTORTION_KANNALA_BRANDT4:
+        intrin.coeffs[0] = -0.01f;
+        intrin.coeffs[1] = 0.04f;
+        intrin.coeffs[2] = -0.005f;
+        intrin.coeffs[3] = 0.001f;
+        break;
+    default:
+        break;
+    }
+    return intrin;
+}
+
+// Every point must be exactly what rs2_deproject_pixel_to_point() returns for the same pixel and depth
+static void require_reference( const deprojection_table & table, const rs2_intrinsics & intrin, float offset )
+{
+    std::mt19937 rng( intrin.model );
+    std::vector< uint16_t > depth( W * H );
+    for( auto & d : depth )
+        d = ( rng() % 5 == 0 ) ? 0 : uint16_t( rng() );
+    depth[0] = 0xffff;
+
+    const float depth_scale = 0.001f;
+    std::vector< float3 > points( W * H );
+    deproject_depth( points.data(), table, depth.data(), depth_scale );
+
+    for( int y = 0; y < H; ++y )
+        for( int x = 0; x < W; ++x )
+        {
+            INFO( "model " << intrin.model << " offset " << offset << " pixel " << x << "," << y );
+            const float pixel[] = { x + offset, y + offset };
+            float expected[3];
+            rs2_deproject_pixel_to_point( expected, &intrin, pixel, depth_scale * depth[y * W + x] );
+
+            auto & p = points[y * W + x];
+            REQUIRE( p.x == expected[0] );
+            REQUIRE( p.y == expected[1] );
+            REQUIRE( p.z == expected[2] );
+        }
+}
+
+// RS2_DISTORTION_MODIFIED_BROWN_CONRADY is left out: rs2_deproject_pixel_to_point() asserts against it
+static const rs2_distortion models[] = { RS2_DISTORTION_NONE,
+                                         RS2_DISTORTION_BROWN_CONRADY,
+                                         RS2_DISTORTION_INVERSE_BROWN_CONRADY,
+                                         RS2_DISTORTION_FTHETA,
+                                         RS2_DISTORTION_KANNALA_BRANDT4 };
+
+TEST_CASE( "deprojection table matches rs2_deproject_pixel_to_point", "[deprojection]" )
+{
+    for( auto model : models )
+    {
+        auto intrin = make_intrinsics( model );
+        for( auto offset : { 0.f, -0.5f } )
+        {
+            auto table = get_deprojection_table( intrin, offset );
+            REQUIRE( table->width() == W );
+            REQUIRE( table->height() == H );
+            require_reference( *table, intrin, offset );
+        }
+    }
+}
+
+TEST_CASE( "deprojection table is shared until the intrinsics change", "[deprojection]" )
+{
+    for( auto model : models )
+    {
+        auto intrin = make_intrinsics( model );
+        auto table = get_deprojection_table( intrin );
+        REQUIRE( get_deprojection_table( intrin ) == table );
+        REQUIRE( get_deprojection_table( intrin, -0.5f ) != table );
+
+        auto moved = intrin;
+        moved.ppx += 1.f;
+        auto moved_table = get_deprojection_table( moved );
+        REQUIRE( moved_table != table );
+        require_reference( *moved_table, moved, 0.f );
+
+        auto distorted = intrin;
+        distorted.coeffs[0] += 0.01f;
+        auto distorted_table = get_deprojection_table( distorted );
+        REQUIRE( distorted_table != table );
+        require_reference( *distorted_table, distorted, 0.f );
+
+        auto other_model = intrin;
+        other_model.model = ( model == RS2_DISTORTION_NONE ) ? RS2_DISTORTION_INVERSE_BROWN_CONRADY : RS2_DISTORTION_NONE;
+        auto other_table = get_deprojection_table( other_model );
+        REQUIRE( other_table != table );
+        require_reference( *other_table, other_model, 0.f );
+
+        // The original table is still the one served for the original intrinsics
+        REQUIRE( get_deprojection_table( intrin ) == table );
+        require_reference( *table, intrin, 0.f );
+    }
+}
@@ -0,0 +1,151 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include <src/proc/synthetic-stream.h>
+
+#include "../catch.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace rs2;
+
+static std::string read_file( const std::string & path )
+{
+    std::ifstream in( path );
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+TEST_CASE( "frame trace records the sensor, processing blocks and queues", "[software-device]" )
+{
+    const int W = 640;
+    const int H = 480;
+    const int N = 5;
+
+    enable_frame_trace();
+    reset_frame_trace();
+    {
+        software_device dev;
+        auto s = dev.add_sensor( "depth" );
+        rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 380.f, 380.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+        frame_queue q( N, true );
+        s.open( profile );
+        s.start( q );
+
+        std::vector< uint16_t > pixels( W * H, 1000 );
+        decimation_filter dec;
+        for( int i = 0; i < N; ++i )
+        {
+            s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, double( i ),
+                                RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i + 1, profile, 0.001f } );
+            frame f;
+            REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+            auto res = dec.process( f );
+            REQUIRE( res.get_profile().as< video_stream_profile >().width() == W / 2 );
+        }
+
+        s.stop();
+        s.close();
+    }
+
+    const std::string trace_file = "frame-trace.json";
+    const std::string histograms_file = "frame-trace-histograms.json";
+    export_frame_trace( trace_file );
+    export_frame_trace_histograms( histograms_file );
+    enable_frame_trace( false );
+
+    // The decimated frames carry the stages of their input, which is left out
+    auto trace = read_file( trace_file );
+    REQUIRE( trace.find( "\"traceEvents\"" ) != std::string::npos );
+    REQUIRE( trace.find( "\"name\":\"Sensor\"" ) != std::string::npos );
+    REQUIRE( trace.find( "\"name\":\"Frame queue\"" ) != std::string::npos );
+    REQUIRE( trace.find( "\"name\":\"Decimation Filter\"" ) != std::string::npos );
+
+    // filter::process() waits for the result on a queue of its own
+    auto histograms = read_file( histograms_file );
+    std::vector< std::pair< std::string, int > > stages = { { "Sensor", N }, { "Frame queue", 2 * N }, { "Decimation Filter", N } };
+    for( auto & stage : stages )
+    {
+        INFO( stage.first );
+        auto pos = histograms.find( "{\"name\":\"" + stage.first + "\",\"count\":" );
+        REQUIRE( pos != std::string::npos );
+        auto count = std::stoi( histograms.substr( histograms.find( "\"count\":", pos ) + 8 ) );
+        REQUIRE( count == stage.second );
+    }
+    REQUIRE( histograms.find( "\"end_to_end\":{\"name\":\"End to end\",\"count\":5" ) != std::string::npos );
+
+    std::remove( trace_file.c_str() );
+    std::remove( histograms_file.c_str() );
+}
+
+// Passes frames through under a name that is not valid as is in a JSON string
+class oddly_named_block : public librealsense::generic_processing_block
+{
+public:
+    oddly_named_block()
+        : generic_processing_block( "Say \"cheese\" \\ now\t\x01" )
+    {
+    }
+
+protected:
+    bool should_process( const rs2::frame & f ) override { return true; }
+    rs2::frame process_frame( const rs2::frame_source & source, const rs2::frame & f ) override { return f; }
+};
+
+TEST_CASE( "frame trace escapes stage names", "[software-device]" )
+{
+    const int W = 64;
+    const int H = 48;
+    const std::string escaped = "\"Say \\\"cheese\\\" \\\\ now\\u0009\\u0001\"";
+
+    enable_frame_trace();
+    reset_frame_trace();
+    {
+        software_device dev;
+        auto s = dev.add_sensor( "depth" );
+        rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 380.f, 380.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+        frame_queue q( 1, true );
+        s.open( profile );
+        s.start( q );
+
+        std::vector< uint16_t > pixels( W * H, 1000 );
+        s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, 0.,
+                            RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, profile, 0.001f } );
+        frame f;
+        REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+
+        filter block( std::shared_ptr< rs2_processing_block >(
+                          new rs2_processing_block( std::make_shared< oddly_named_block >() ),
+                          rs2_delete_processing_block ) );
+        REQUIRE( block.process( f ) );
+
+        s.stop();
+        s.close();
+    }
+
+    const std::string trace_file = "frame-trace-names.json";
+    const std::string histograms_file = "frame-trace-names-histograms.json";
+    export_frame_trace( trace_file );
+    export_frame_trace_histograms( histograms_file );
+    enable_frame_trace( false );
+
+    auto trace = read_file( trace_file );
+    REQUIRE( trace.find( "\"name\":" + escaped + "," ) != std::string::npos );
+    auto histograms = read_file( histograms_file );
+    REQUIRE( histograms.find( "{\"name\":" + escaped + ",\"count\":1," ) != std::string::npos );
+
+    std::remove( trace_file.c_str() );
+    std::remove( histograms_file.c_str() );
+}
@@ -0,0 +1,173 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../test.h"
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace rs2;
+
+TEST_CASE( "fused filter chain matches the filters applied one by one", "[software-device]" )
+{
+    const int W = 640;
+    const int H = 480;
+
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 380.f, 380.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    frame_queue q( 1, true );
+    s.open( profile );
+    s.start( q );
+
+    std::mt19937 rng( 29 );
+    std::vector< uint16_t > pixels( W * H );
+    for( auto & p : pixels )
+        p = ( rng() % 4 == 0 ) ? 0 : uint16_t( rng() % 6000 );
+
+    s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, 0,
+                        RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, profile, 0.001f } );
+    frame f;
+    REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+
+    // Threshold and "fill from left" run fused, spatial falls back to the whole frame
+    threshold_filter thr( 0.5f, 4.f ), ref_thr( 0.5f, 4.f );
+    hole_filling_filter fill( 0 ), ref_fill( 0 );
+    spatial_filter spat, ref_spat;
+
+    fused_filter_chain chain;
+    chain.add( thr );
+    chain.add( fill );
+    chain.add( spat );
+    chain.add( threshold_filter( 1.f, 3.f ) );
+
+    auto expected = threshold_filter( 1.f, 3.f ).process( ref_spat.process( ref_fill.process( ref_thr.process( f ) ) ) );
+    auto res = chain.process( f ).as< depth_frame >();
+    REQUIRE( res );
+    REQUIRE( res.get_data_size() == expected.get_data_size() );
+
+    auto data = reinterpret_cast< const uint16_t * >( res.get_data() );
+    auto ref = reinterpret_cast< const uint16_t * >( expected.get_data() );
+    REQUIRE( std::equal( ref, ref + W * H, data ) );
+
+    auto timings = chain.get_stage_timings();
+    REQUIRE( timings.size() == 4 );
+    REQUIRE( timings[0].first == "Threshold Filter" );
+
+    s.stop();
+    s.close();
+}
+
+TEST_CASE( "fused filter chain runs disparity transforms in bands", "[software-device]" )
+{
+    const int W = 424;
+    const int H = 240;
+
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    // With a baseline the disparity transforms can work on bands of rows
+    s.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+    s.add_read_only_option( RS2_OPTION_STEREO_BASELINE, 50.f );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 210.f, 210.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    frame_queue q( 1, true );
+    s.open( profile );
+    s.start( q );
+
+    std::mt19937 rng( 31 );
+    std::vector< uint16_t > pixels( W * H );
+    for( auto & p : pixels )
+        p = ( rng() % 5 == 0 ) ? 0 : uint16_t( 300 + rng() % 5000 );
+
+    s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, 0,
+                        RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, profile, 0.001f } );
+    frame f;
+    REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+
+    // Holes are filled in the disparity domain, as in the viewer
+    disparity_transform to_disparity( true ), ref_to_disparity( true );
+    hole_filling_filter fill( 0 ), ref_fill( 0 );
+    disparity_transform to_depth( false ), ref_to_depth( false );
+
+    fused_filter_chain chain;
+    chain.add( to_disparity );
+    chain.add( fill );
+    chain.add( to_depth );
+
+    auto expected = ref_to_depth.process( ref_fill.process( ref_to_disparity.process( f ) ) );
+    auto res = chain.process( f ).as< depth_frame >();
+    REQUIRE( res );
+    REQUIRE( res.get_profile().format() == RS2_FORMAT_Z16 );
+    REQUIRE( res.get_data_size() == expected.get_data_size() );
+
+    auto data = reinterpret_cast< const uint16_t * >( res.get_data() );
+    auto ref = reinterpret_cast< const uint16_t * >( expected.get_data() );
+    REQUIRE( std::equal( ref, ref + W * H, data ) );
+
+    // Ending the chain in the disparity domain gives a disparity frame
+    fused_filter_chain half;
+    half.add( disparity_transform( true ) );
+    auto disparity = half.process( f ).as< disparity_frame >();
+    REQUIRE( disparity );
+    auto expected_disparity = disparity_transform( true ).process( f );
+    REQUIRE( disparity.get_data_size() == expected_disparity.get_data_size() );
+    REQUIRE( std::memcmp( disparity.get_data(), expected_disparity.get_data(), disparity.get_data_size() ) == 0 );
+
+    s.stop();
+    s.close();
+}
+
+TEST_CASE( "fused filter chain can be extended while it processes frames", "[software-device]" )
+{
+    const int W = 320;
+    const int H = 240;
+
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 190.f, 190.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    frame_queue q( 1, true );
+    s.open( profile );
+    s.start( q );
+
+    std::vector< uint16_t > pixels( W * H, 1000 );
+    s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, 0,
+                        RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, profile, 0.001f } );
+    frame f;
+    REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+
+    fused_filter_chain chain;
+    chain.add( threshold_filter( 0.f, 16.f ) );
+
+    const int added = 20;
+    std::thread writer( [&]() {
+        for( int i = 0; i < added; ++i )
+        {
+            if( i % 2 )
+                chain.add( threshold_filter( 0.f, 16.f ) );
+            else
+                chain.add( hole_filling_filter( 0 ) );
+            chain.get_stage_timings();
+        }
+    } );
+    for( int i = 0; i < 200; ++i )
+    {
+        auto res = chain.process( f ).as< depth_frame >();
+        REQUIRE( res );
+        // Every stage leaves this frame as it is
+        REQUIRE( reinterpret_cast< const uint16_t * >( res.get_data() )[W * H - 1] == 1000 );
+    }
+    writer.join();
+    REQUIRE( chain.get_stage_timings().size() == added + 1 );
+
+    s.stop();
+    s.close();
+}
@@ -0,0 +1,162 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../test.h"
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace rs2;
+
+// Not a multiple of the 8 pixels of the vectorized kernels, so the scalar tails are covered too
+static const int W = 70;
+static const int H = 6;
+
+// Depth and infrared frames of an HDR sequence, paired into framesets as the syncer would
+class hdr_source
+{
+public:
+    explicit hdr_source( rs2_format ir_format )
+        : _sensor( _dev.add_sensor( "stereo" ) )
+        , _queue( 10, true )
+    {
+        rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 380.f, 380.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        _depth = _sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+        int ir_bpp = ir_format == RS2_FORMAT_Y8 ? 1 : 2;
+        _ir = _sensor.add_video_stream( { RS2_STREAM_INFRARED, 1, 1, W, H, 30, ir_bpp, ir_format, intrinsics } );
+        _sensor.open( { _depth, _ir } );
+        _sensor.start( _queue );
+    }
+
+    ~hdr_source()
+    {
+        _sensor.stop();
+        _sensor.close();
+    }
+
+    frameset make( std::vector< uint16_t > & depth, void * ir, int counter, int seq_id )
+    {
+        _sensor.set_metadata( RS2_FRAME_METADATA_FRAME_COUNTER, counter );
+        _sensor.set_metadata( RS2_FRAME_METADATA_SEQUENCE_SIZE, 2 );
+        _sensor.set_metadata( RS2_FRAME_METADATA_SEQUENCE_ID, seq_id );
+
+        int ir_bpp = _ir.format() == RS2_FORMAT_Y8 ? 1 : 2;
+        _sensor.on_video_frame( { depth.data(), []( void * ) {}, W * 2, 2, double( counter ),
+                                  RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, counter, _depth, 0.001f } );
+        _sensor.on_video_frame( { ir, []( void * ) {}, W * ir_bpp, ir_bpp, double( counter ),
+                                  RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, counter, _ir } );
+        frame d, i;
+        REQUIRE( _queue.try_wait_for_frame( &d, 5000 ) );
+        REQUIRE( _queue.try_wait_for_frame( &i, 5000 ) );
+
+        filter compose( [&]( frame, frame_source & src ) { src.frame_ready( src.allocate_composite_frame( { d, i } ) ); } );
+        auto fs = compose.process( d ).as< frameset >();
+        REQUIRE( fs );
+        return fs;
+    }
+
+private:
+    software_device _dev;
+    software_sensor _sensor;
+    stream_profile _depth, _ir;
+    frame_queue _queue;
+};
+
+template< class T >
+static std::vector< uint16_t > merge_using_ir( const std::vector< uint16_t > & d0, const std::vector< uint16_t > & d1,
+                                               const std::vector< T > & i0, const std::vector< T > & i1, int under, int over )
+{
+    std::vector< uint16_t > res( d0.size() );
+    for( size_t i = 0; i < res.size(); ++i )
+    {
+        if( i0[i] > under && i0[i] < over && d0[i] )
+            res[i] = d0[i];
+        else if( i1[i] > under && i1[i] < over && d1[i] )
+            res[i] = d1[i];
+        else
+            res[i] = 0;
+    }
+    return res;
+}
+
+// The merged depth replaces the depth of the output frameset; with nothing merged, the input passes through
+static void require_depth( frame f, const std::vector< uint16_t > & expected )
+{
+    auto fs = f.as< frameset >();
+    REQUIRE( fs );
+    auto depth = fs.get_depth_frame();
+    REQUIRE( depth );
+    auto data = reinterpret_cast< const uint16_t * >( depth.get_data() );
+    REQUIRE( std::equal( expected.begin(), expected.end(), data ) );
+}
+
+template< class T >
+static void random_frames( std::mt19937 & rng, std::vector< uint16_t > & depth, std::vector< T > & ir, int ir_max )
+{
+    depth.resize( W * H );
+    ir.resize( W * H );
+    for( auto & d : depth )
+        d = ( rng() % 4 == 0 ) ? 0 : uint16_t( rng() % 6000 );
+    for( auto & i : ir )
+        i = T( rng() % ( ir_max + 1 ) );
+}
+
+TEST_CASE( "HDR merge pairs framesets in sequence order and merges through Y8 infrared", "[software-device]" )
+{
+    hdr_source source( RS2_FORMAT_Y8 );
+    std::mt19937 rng( 28 );
+    std::vector< uint16_t > d0, d1, stray;
+    std::vector< uint8_t > i0, i1, stray_ir;
+    random_frames( rng, d0, i0, 255 );
+    random_frames( rng, d1, i1, 255 );
+    random_frames( rng, stray, stray_ir, 255 );
+
+    hdr_merge merge;
+
+    // A second frame of the sequence with no first one is not paired
+    require_depth( merge.process( source.make( stray, stray_ir.data(), 1, 1 ) ), stray );
+
+    require_depth( merge.process( source.make( d0, i0.data(), 2, 0 ) ), d0 );
+    auto res = merge.process( source.make( d1, i1.data(), 3, 1 ) );
+    require_depth( res, merge_using_ir( d0, d1, i0, i1, 5, 250 ) );
+}
+
+TEST_CASE( "HDR merge through Y16 infrared covers the whole 16-bit range", "[software-device]" )
+{
+    hdr_source source( RS2_FORMAT_Y16 );
+    std::mt19937 rng( 16 );
+    std::vector< uint16_t > d0, d1;
+    std::vector< uint16_t > i0, i1;
+    random_frames( rng, d0, i0, 0xffff );
+    random_frames( rng, d1, i1, 0xffff );
+    // And the thresholds themselves
+    i0[0] = 20;
+    i0[1] = 21;
+    i0[2] = 1002;
+    i0[3] = 1003;
+
+    hdr_merge merge;
+    merge.process( source.make( d0, i0.data(), 7, 0 ) );
+    auto res = merge.process( source.make( d1, i1.data(), 8, 1 ) );
+    require_depth( res, merge_using_ir( d0, d1, i0, i1, 20, 1003 ) );
+}
+
+TEST_CASE( "HDR merge skips framesets that are not consecutive", "[software-device]" )
+{
+    hdr_source source( RS2_FORMAT_Y8 );
+    std::mt19937 rng( 5 );
+    std::vector< uint16_t > d0, d1;
+    std::vector< uint8_t > i0, i1;
+    random_frames( rng, d0, i0, 255 );
+    random_frames( rng, d1, i1, 255 );
+
+    hdr_merge merge;
+    merge.process( source.make( d0, i0.data(), 10, 0 ) );
+    require_depth( merge.process( source.make( d1, i1.data(), 12, 1 ) ), d1 );
+
+    // The next pair is merged
+    merge.process( source.make( d0, i0.data(), 13, 0 ) );
+    auto res = merge.process( source.make( d1, i1.data(), 14, 1 ) );
+    require_depth( res, merge_using_ir( d0, d1, i0, i1, 5, 250 ) );
+}
@@ -0,0 +1,133 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <src/proc/synthetic-stream.h>
+#include <src/proc/motion-transform.h>
+#include <src/option.h>
+#include <src/stream.h>
+
+#include "../catch.h"
+
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+// Frames as the HID backend delivers them: one raw sample each, under a MOTION_XYZ32F profile
+class hid_source
+{
+public:
+    explicit hid_source( rs2_stream stream )
+        : _profile( std::make_shared< motion_stream_profile >( platform::stream_profile{ 0, 0, 200, 0 } ) )
+    {
+        _source.init( std::make_shared< metadata_parser_map >() );
+        _profile->set_stream_type( stream );
+        _profile->set_format( RS2_FORMAT_MOTION_XYZ32F );
+        _profile->set_framerate( 200 );
+        _profile->set_unique_id( environment::get_instance().generate_stream_id() );
+    }
+
+    frame_holder make( const hid_data & hid )
+    {
+        frame_additional_data data;
+        data.timestamp = 5. * _number;
+        data.frame_number = ++_number;
+        frame_holder f( _source.alloc_frame( RS2_EXTENSION_MOTION_FRAME, sizeof( hid ), data, true ) );
+        REQUIRE( f );
+        memcpy( const_cast< byte * >( f->get_frame_data() ), &hid, sizeof( hid ) );
+        f->set_stream( _profile );
+        return f;
+    }
+
+private:
+    frame_source _source;
+    std::shared_ptr< motion_stream_profile > _profile;
+    unsigned long long _number = 0;
+};
+
+// Collects what a block outputs
+static std::shared_ptr< std::vector< frame_holder > > collect( processing_block & block )
+{
+    auto results = std::make_shared< std::vector< frame_holder > >();
+    auto on_output = [results]( frame_holder f ) { results->push_back( std::move( f ) ); };
+    block.set_output_callback( std::make_shared< internal_frame_callback< decltype( on_output ) > >( on_output ) );
+    return results;
+}
+
+TEST_CASE( "motion batcher converts raw HID samples as the motion transforms do", "[motion]" )
+{
+    std::mt19937 rng( 46 );
+    std::vector< hid_data > samples( 37 );
+    for( auto & s : samples )
+    {
+        s = {};
+        s.x = short( rng() );
+        s.y = short( rng() );
+        s.z = short( rng() );
+    }
+    samples[0].x = 32767;
+    samples[0].y = -32768;
+    samples[0].z = 0;
+
+    for( auto stream : { RS2_STREAM_ACCEL, RS2_STREAM_GYRO } )
+    {
+        INFO( rs2_stream_to_string( stream ) );
+        // A source for each block, so both get the same frame numbers and timestamps
+        hid_source transform_source( stream ), batcher_source( stream );
+
+        // Without calibration the transforms only scale, which the batcher reproduces exactly
+        std::shared_ptr< processing_block > transform;
+        if( stream == RS2_STREAM_ACCEL )
+            transform = std::make_shared< acceleration_transform >( nullptr, nullptr );
+        else
+            transform = std::make_shared< gyroscope_transform >( nullptr, nullptr );
+        // The transform allocates from a pool of its own, so its results are copied rather than held
+        std::vector< std::pair< float3, double > > expected;
+        auto on_expected = [&]( frame_holder f ) {
+            REQUIRE( f->get_stream()->get_format() == RS2_FORMAT_MOTION_XYZ32F );
+            expected.emplace_back( *reinterpret_cast< const float3 * >( f->get_frame_data() ), f->get_frame_timestamp() );
+        };
+        transform->set_output_callback(
+            std::make_shared< internal_frame_callback< decltype( on_expected ) > >( on_expected ) );
+
+        auto batch_size = std::make_shared< float_option >( option_range{ 1, 1000, 1, 16 } );
+        auto max_age = std::make_shared< float_option >( option_range{ 1, 1000, 1, 20 } );
+        batch_size->set( float( samples.size() ) );
+        max_age->set( 1000 );
+        motion_batcher batcher( stream, nullptr, nullptr, batch_size, max_age );
+        auto batches = collect( batcher );
+
+        for( auto & s : samples )
+        {
+            transform->invoke( transform_source.make( s ) );
+            batcher.invoke( batcher_source.make( s ) );
+        }
+
+        REQUIRE( expected.size() == samples.size() );
+        REQUIRE( batches->size() == 1 );
+
+        auto & batch = ( *batches )[0];
+        REQUIRE( batch->get_stream()->get_format() == RS2_FORMAT_MOTION_XYZ32F_BATCH );
+        auto data = batch->get_frame_data();
+        rs2_motion_batch_header header;
+        memcpy( &header, data, sizeof( header ) );
+        REQUIRE( header.count == samples.size() );
+
+        auto count = samples.size();
+        auto timestamps = reinterpret_cast< const double * >( data + sizeof( header ) );
+        auto x = reinterpret_cast< const float * >( timestamps + count );
+        auto y = x + count;
+        auto z = y + count;
+        for( size_t i = 0; i < count; ++i )
+        {
+            INFO( i );
+            auto & xyz = expected[i].first;
+            REQUIRE( x[i] == xyz.x );
+            REQUIRE( y[i] == xyz.y );
+            REQUIRE( z[i] == xyz.z );
+            REQUIRE( timestamps[i] == expected[i].second );
+        }
+    }
+}
@@ -0,0 +1,129 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include "../test.h"
+#include <librealsense2/hpp/rs_internal.hpp>
+#include <src/proc/synthetic-stream.h>
+#include <src/proc/motion-transform.h>
+#include <src/context.h>
+#include <src/option.h>
+#include <src/sensor.h>
+#include <src/software-device.h>
+
+#include <mutex>
+#include <vector>
+
+using namespace rs2;
+
+// What the sensor does on stop(), which software sensors cannot reach
+static void stop_input( processing_block & block )
+{
+    auto internal = std::dynamic_pointer_cast< librealsense::processing_block >( block.get()->block );
+    REQUIRE( internal );
+    internal->on_input_stopped();
+}
+
+TEST_CASE( "motion batcher sends what it holds when the stream stops", "[software-device]" )
+{
+    software_device dev;
+    auto s = dev.add_sensor( "motion" );
+    rs2_motion_device_intrinsic intrinsics{ { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 } }, { 0, 0, 0 }, { 0, 0, 0 } };
+    auto profile = s.add_motion_stream( { RS2_STREAM_GYRO, 0, 0, 200, RS2_FORMAT_MOTION_XYZ32F, intrinsics } );
+    frame_queue q( 5, true );
+    s.open( profile );
+    s.start( q );
+
+    motion_batcher batcher;
+    batcher.set_option( RS2_OPTION_MOTION_BATCH_SIZE, 100 );
+    batcher.set_option( RS2_OPTION_MOTION_BATCH_MAX_AGE, 1000 );
+    frame_queue results( 3, true );
+    batcher.start( results );
+
+    float xyz[3] = { 1.f, 2.f, 3.f };
+    for( int i = 0; i < 5; ++i )
+    {
+        s.on_motion_frame( { xyz, []( void * ) {}, 5. * i, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i + 1, profile } );
+        frame f;
+        REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+        batcher.invoke( f );
+    }
+    frame f;
+    REQUIRE_FALSE( results.poll_for_frame( &f ) );
+
+    // The batch is out by the time the sensor stop returns, rather than when its age runs out
+    stop_input( batcher );
+    REQUIRE( results.poll_for_frame( &f ) );
+    REQUIRE( f.get_profile().stream_type() == RS2_STREAM_GYRO );
+    REQUIRE( motion_batcher::get_batch( f ).count == 5 );
+    REQUIRE( f.get_frame_number() == 5 );
+
+    // Nothing is left to send
+    stop_input( batcher );
+    REQUIRE_FALSE( results.poll_for_frame( &f ) );
+
+    s.stop();
+    s.close();
+}
+
+TEST_CASE( "motion batcher of a sensor sends what it holds when the sensor stops", "[software-device]" )
+{
+    // A sensor set up the way the motion module of a device is, over a raw sensor of HID samples
+    librealsense::software_device dev;
+    auto & raw = dev.add_software_sensor( "raw motion" );
+    rs2_motion_device_intrinsic intrinsics{ { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 } }, { 0, 0, 0 }, { 0, 0, 0 } };
+    auto raw_profile = raw.add_motion_stream( { RS2_STREAM_GYRO, 0, 0, 200, RS2_FORMAT_MOTION_XYZ32F, intrinsics } );
+
+    auto batch_size = std::make_shared< librealsense::float_option >( librealsense::option_range{ 1, 1000, 1, 16 } );
+    auto max_age = std::make_shared< librealsense::float_option >( librealsense::option_range{ 1, 1000, 1, 20 } );
+    batch_size->set( 100 );
+    max_age->set( 1000 );
+
+    auto sensor = std::make_shared< librealsense::synthetic_sensor >( "Motion Module", raw.shared_from_this(), &dev );
+    sensor->register_processing_block( { { RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_GYRO } },
+                                       { { RS2_FORMAT_MOTION_XYZ32F_BATCH, RS2_STREAM_GYRO } },
+                                       [=]() {
+                                           return std::make_shared< librealsense::motion_batcher >( RS2_STREAM_GYRO, nullptr, nullptr,
+                                                                                                    batch_size, max_age );
+                                       } );
+
+    std::shared_ptr< librealsense::stream_profile_interface > batch_profile;
+    for( auto & p : sensor->get_stream_profiles() )
+        if( p->get_format() == RS2_FORMAT_MOTION_XYZ32F_BATCH )
+            batch_profile = p;
+    REQUIRE( batch_profile );
+
+    std::mutex m;
+    std::vector< unsigned int > counts;
+    auto on_frame = [&]( librealsense::frame_holder f ) {
+        rs2_motion_batch_header header;
+        memcpy( &header, f->get_frame_data(), sizeof( header ) );
+        std::lock_guard< std::mutex > lock( m );
+        counts.push_back( header.count );
+    };
+    sensor->open( { batch_profile } );
+    sensor->start( librealsense::frame_callback_ptr( new librealsense::internal_frame_callback< decltype( on_frame ) >( on_frame ),
+                                                     []( rs2_frame_callback * p ) { p->release(); } ) );
+
+    librealsense::hid_data hid = {};
+    hid.x = 10;
+    hid.y = -20;
+    hid.z = 30;
+    rs2_stream_profile c_profile{ raw_profile.get(), raw_profile };
+    for( int i = 0; i < 5; ++i )
+        raw.on_motion_frame( { &hid, []( void * ) {}, 5. * i, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i + 1, &c_profile } );
+    {
+        std::lock_guard< std::mutex > lock( m );
+        REQUIRE( counts.empty() );
+    }
+
+    // The batch is out by the time stop() returns, rather than when its age runs out
+    sensor->stop();
+    {
+        std::lock_guard< std::mutex > lock( m );
+        REQUIRE( counts.size() == 1 );
+        REQUIRE( counts[0] == 5 );
+    }
+    sensor->close();
+}
@@ -0,0 +1,127 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../test.h"
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace rs2;
+
+static std::vector< frame > record_samples( int n )
+{
+    software_device dev;
+    auto s = dev.add_sensor( "motion" );
+    rs2_motion_device_intrinsic intrinsics{ { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 } }, { 0, 0, 0 }, { 0, 0, 0 } };
+    auto profile = s.add_motion_stream( { RS2_STREAM_ACCEL, 0, 0, 200, RS2_FORMAT_MOTION_XYZ32F, intrinsics } );
+
+    frame_queue q( n, true );
+    s.open( profile );
+    s.start( q );
+
+    // The frames outlive the device, so they own their samples
+    std::vector< frame > frames;
+    for( int i = 0; i < n; ++i )
+    {
+        auto xyz = new float[3]{ float( i ), float( -i ), 9.8f };
+        s.on_motion_frame( { xyz, []( void * p ) { delete[] static_cast< float * >( p ); }, 5. * i,
+                             RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i + 1, profile } );
+        frame f;
+        REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+        frames.push_back( f );
+    }
+    s.stop();
+    s.close();
+    return frames;
+}
+
+TEST_CASE( "motion batcher gathers the samples of a stream", "[software-device]" )
+{
+    const int N = 12;
+    auto samples = record_samples( N );
+
+    motion_batcher batcher;
+    batcher.set_option( RS2_OPTION_MOTION_BATCH_SIZE, 4 );
+    batcher.set_option( RS2_OPTION_MOTION_BATCH_MAX_AGE, 1000 );
+    frame_queue results( N, true );
+    batcher.start( results );
+
+    for( auto & f : samples )
+        batcher.invoke( f );
+
+    for( int b = 0; b < N / 4; ++b )
+    {
+        INFO( b );
+        frame f;
+        REQUIRE( results.poll_for_frame( &f ) );
+        REQUIRE( f.get_profile().stream_type() == RS2_STREAM_ACCEL );
+        REQUIRE( f.get_profile().format() == RS2_FORMAT_MOTION_XYZ32F_BATCH );
+        // The batch frame is stamped as its last sample
+        REQUIRE( f.get_frame_number() == ( b + 1 ) * 4 );
+
+        auto batch = motion_batcher::get_batch( f );
+        REQUIRE( batch.count == 4 );
+        for( int i = 0; i < 4; ++i )
+        {
+            auto sample = b * 4 + i;
+            REQUIRE( batch.timestamps[i] == 5. * sample );
+            REQUIRE( batch.x[i] == float( sample ) );
+            REQUIRE( batch.y[i] == float( -sample ) );
+            REQUIRE( batch.z[i] == 9.8f );
+        }
+    }
+    frame extra;
+    REQUIRE_FALSE( results.poll_for_frame( &extra ) );
+}
+
+TEST_CASE( "motion batcher sends batches that waited their maximal age", "[software-device]" )
+{
+    auto samples = record_samples( 2 );
+
+    motion_batcher batcher;
+    batcher.set_option( RS2_OPTION_MOTION_BATCH_SIZE, 100 );
+    batcher.set_option( RS2_OPTION_MOTION_BATCH_MAX_AGE, 50 );
+    frame_queue results( 3, true );
+    batcher.start( results );
+
+    batcher.invoke( samples[0] );
+    batcher.invoke( samples[1] );
+    frame f;
+    REQUIRE_FALSE( results.poll_for_frame( &f ) );
+
+    // The stream stalls: no sample comes to push the batch out, the timer does
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE( results.try_wait_for_frame( &f, 5000 ) );
+    REQUIRE( std::chrono::steady_clock::now() - start < std::chrono::seconds( 1 ) );
+    REQUIRE( motion_batcher::get_batch( f ).count == 2 );
+    REQUIRE( motion_batcher::get_batch( f ).timestamps[1] == 5. );
+    REQUIRE_FALSE( results.poll_for_frame( &f ) );
+}
+
+TEST_CASE( "motion batcher passes other frames through", "[software-device]" )
+{
+    const int W = 16;
+    const int H = 16;
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 380.f, 380.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+    frame_queue q( 1, true );
+    s.open( profile );
+    s.start( q );
+    std::vector< uint16_t > pixels( W * H, 1000 );
+    s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, 0., RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, profile, 0.001f } );
+    frame depth;
+    REQUIRE( q.try_wait_for_frame( &depth, 5000 ) );
+
+    motion_batcher batcher;
+    frame_queue results( 1, true );
+    batcher.start( results );
+    batcher.invoke( depth );
+    frame f;
+    REQUIRE( results.poll_for_frame( &f ) );
+    REQUIRE( f.get_profile().format() == RS2_FORMAT_Z16 );
+    s.stop();
+    s.close();
+}
@@ -0,0 +1,235 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../test.h"
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace rs2;
+
+TEST_CASE( "processing graph matches the blocks applied one by one, in order", "[software-device]" )
+{
+    const int W = 640;
+    const int H = 480;
+    const int N = 10;
+
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 380.f, 380.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    frame_queue q( N, true );
+    s.open( profile );
+    s.start( q );
+
+    std::mt19937 rng( 41 );
+    std::vector< std::vector< uint16_t > > pixels( N, std::vector< uint16_t >( W * H ) );
+    std::vector< frame > inputs;
+    for( int i = 0; i < N; ++i )
+    {
+        for( auto & p : pixels[i] )
+            p = ( rng() % 4 == 0 ) ? 0 : uint16_t( 1000 + rng() % 3000 );
+        s.on_video_frame( { pixels[i].data(), []( void * ) {}, W * 2, 2, double( i ),
+                            RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i + 1, profile, 0.001f } );
+        frame f;
+        REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+        inputs.push_back( f );
+    }
+
+    // The temporal filter depends on the previous frames, so it must see them in order
+    decimation_filter ref_dec;
+    temporal_filter ref_temp;
+    std::vector< frame > expected;
+    for( auto & f : inputs )
+        expected.push_back( ref_temp.process( ref_dec.process( f ) ) );
+
+    processing_graph graph( 8 );
+    decimation_filter dec[3];
+    temporal_filter temp;
+    auto dec_node = graph.add_node( dec[0] );
+    graph.add_replica( dec_node, dec[1] );
+    graph.add_replica( dec_node, dec[2] );
+    graph.add_node( temp, dec_node );
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector< frame > results;
+    graph.start( [&]( frame f ) {
+        std::lock_guard< std::mutex > lock( m );
+        results.push_back( f );
+        cv.notify_one();
+    } );
+
+    for( auto & f : inputs )
+        graph.invoke( f );
+
+    {
+        std::unique_lock< std::mutex > lock( m );
+        REQUIRE( cv.wait_for( lock, std::chrono::seconds( 10 ), [&]() { return results.size() == N; } ) );
+    }
+    REQUIRE( graph.get_dropped_frames() == 0 );
+
+    for( int i = 0; i < N; ++i )
+    {
+        INFO( i );
+        auto res = results[i].as< depth_frame >();
+        auto ref = expected[i].as< depth_frame >();
+        REQUIRE( res );
+        REQUIRE( res.get_frame_number() == inputs[i].get_frame_number() );
+        REQUIRE( res.get_data_size() == ref.get_data_size() );
+        auto data = reinterpret_cast< const uint16_t * >( res.get_data() );
+        auto ref_data = reinterpret_cast< const uint16_t * >( ref.get_data() );
+        REQUIRE( std::equal( ref_data, ref_data + ref.get_width() * ref.get_height(), data ) );
+    }
+
+    auto stats = graph.get_node_stats();
+    REQUIRE( stats.size() == 2 );
+    REQUIRE( stats[0].first == "Decimation Filter" );
+    for( auto & st : stats )
+    {
+        REQUIRE( st.second.processed == N );
+        REQUIRE( st.second.dropped == 0 );
+        REQUIRE( st.second.queue_depth == 0 );
+    }
+
+    s.stop();
+    s.close();
+}
+
+TEST_CASE( "processing graph callback can call back into the graph", "[software-device]" )
+{
+    const int W = 64;
+    const int H = 48;
+    const int N = 20;
+
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 380.f, 380.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    frame_queue q( N, true );
+    s.open( profile );
+    s.start( q );
+
+    std::vector< uint16_t > pixels( W * H, 1000 );
+    std::vector< frame > inputs;
+    for( int i = 0; i < N; ++i )
+    {
+        s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, double( i ),
+                            RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i + 1, profile, 0.001f } );
+        frame f;
+        REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+        inputs.push_back( f );
+    }
+
+    processing_graph graph( 2 );
+    decimation_filter dec[2];
+    auto dec_node = graph.add_node( dec[0] );
+    graph.add_replica( dec_node, dec[1] );
+
+    // Every result feeds the next input from the callback, which used to run with the graph locked
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector< unsigned long long > results;
+    std::vector< unsigned long long > processed;
+    graph.start( [&]( frame f ) {
+        auto stats = graph.get_node_stats();
+        size_t next;
+        {
+            std::lock_guard< std::mutex > lock( m );
+            results.push_back( f.get_frame_number() );
+            processed.push_back( stats[0].second.processed );
+            next = results.size();
+        }
+        if( next < inputs.size() )
+            graph.invoke( inputs[next] );
+        cv.notify_one();
+    } );
+
+    graph.invoke( inputs[0] );
+    {
+        std::unique_lock< std::mutex > lock( m );
+        REQUIRE( cv.wait_for( lock, std::chrono::seconds( 10 ), [&]() { return results.size() == N; } ) );
+    }
+
+    for( int i = 0; i < N; ++i )
+    {
+        INFO( i );
+        REQUIRE( results[i] == inputs[i].get_frame_number() );
+        REQUIRE( processed[i] == unsigned( i + 1 ) );
+    }
+
+    s.stop();
+    s.close();
+}
+
+TEST_CASE( "processing graph drops results output after invoke returns", "[software-device]" )
+{
+    const int W = 64;
+    const int H = 48;
+    const int N = 3;
+
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 380.f, 380.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    frame_queue q( N, true );
+    s.open( profile );
+    s.start( q );
+
+    std::vector< uint16_t > pixels( W * H, 1000 );
+    std::vector< frame > inputs;
+    for( int i = 0; i < N; ++i )
+    {
+        s.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, double( i ),
+                            RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i + 1, profile, 0.001f } );
+        frame f;
+        REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+        inputs.push_back( f );
+    }
+
+    // Outputs every frame from another thread, once invoke() has returned
+    std::mutex m;
+    std::vector< std::thread > threads;
+    processing_block async_block( [&]( frame f, frame_source & src ) {
+        std::lock_guard< std::mutex > lock( m );
+        // frame_source only lives for the call, but the rs2_source it wraps belongs to the block
+        rs2_source * source = src._source;
+        threads.emplace_back( [f, source]() {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+            rs2_frame_add_ref( f.get(), nullptr );
+            rs2_synthetic_frame_ready( source, f.get(), nullptr );
+        } );
+    } );
+
+    {
+        processing_graph graph( 2 );
+        graph.add_node( async_block );
+
+        std::atomic< int > results( 0 );
+        graph.start( [&]( frame ) { results++; } );
+        for( auto & f : inputs )
+            graph.invoke( f );
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 500 ) );
+        std::lock_guard< std::mutex > lock( m );
+        for( auto & t : threads )
+            t.join();
+
+        auto stats = graph.get_node_stats();
+        REQUIRE( stats[0].second.processed == N );
+        REQUIRE( results == 0 );
+        REQUIRE( graph.get_dropped_frames() == 0 );
+    }
+
+    s.stop();
+    s.close();
+}
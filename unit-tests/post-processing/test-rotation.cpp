@@ -0,0 +1,110 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <src/proc/rotation-transform.h>
+
+#include "../catch.h"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+static std::vector< byte > random_bytes( size_t size )
+{
+    std::mt19937 rng( 5 );
+    std::vector< byte > res( size );
+    for( auto & b : res )
+        b = byte( rng() );
+    return res;
+}
+
+// The per-pixel rotation the rotation transform used before, for the transverse
+static void rotate_image_reference( byte * out, const byte * source, int width, int height, int bpp )
+{
+    auto width_out = height;
+    auto height_out = width;
+    for( int i = 0; i < height; ++i )
+    {
+        auto row_offset = i * width;
+        for( int j = 0; j < width; ++j )
+        {
+            auto out_index = ( ( ( height_out - j ) * width_out ) - i - 1 ) * bpp;
+            memcpy( &out[out_index], &source[( row_offset + j ) * bpp], bpp );
+        }
+    }
+}
+
+// Where the pixel at (x, y) goes, by definition
+static std::vector< byte > rotate_by_definition( const std::vector< byte > & src, int width, int height, int bpp, image_rotation rotation )
+{
+    std::vector< byte > res( src.size() );
+    for( int y = 0; y < height; ++y )
+        for( int x = 0; x < width; ++x )
+        {
+            int row, col, out_width = height;
+            switch( rotation )
+            {
+            case image_rotation::rotate_90_cw: row = x, col = height - 1 - y; break;
+            case image_rotation::rotate_180: row = height - 1 - y, col = width - 1 - x, out_width = width; break;
+            case image_rotation::rotate_90_ccw: row = width - 1 - x, col = y; break;
+            case image_rotation::transpose: row = x, col = y; break;
+            default: row = width - 1 - x, col = height - 1 - y; break;
+            }
+            memcpy( &res[( row * out_width + col ) * bpp], &src[( y * width + x ) * bpp], bpp );
+        }
+    return res;
+}
+
+static const image_rotation rotations[] = { image_rotation::rotate_90_cw, image_rotation::rotate_180, image_rotation::rotate_90_ccw,
+                                            image_rotation::transpose, image_rotation::transverse };
+
+TEST_CASE( "rotations match their definition", "[rotation]" )
+{
+    struct size { int width, height; };
+    for( auto s : { size{ 8, 8 }, size{ 1, 1 }, size{ 7, 3 }, size{ 37, 21 }, size{ 64, 64 }, size{ 130, 67 }, size{ 640, 480 } } )
+        for( int bpp : { 1, 2, 4 } )
+        {
+            auto src = random_bytes( s.width * s.height * bpp );
+            std::vector< byte > out( src.size() );
+
+            rotate_image( out.data(), src.data(), s.width, s.height, bpp, image_rotation::transverse );
+            std::vector< byte > reference( src.size() );
+            rotate_image_reference( reference.data(), src.data(), s.width, s.height, bpp );
+            REQUIRE( out == reference );
+
+            for( auto rotation : rotations )
+            {
+                rotate_image( out.data(), src.data(), s.width, s.height, bpp, rotation );
+                REQUIRE( out == rotate_by_definition( src, s.width, s.height, bpp, rotation ) );
+            }
+        }
+}
+
+TEST_CASE( "rotation throughput", "[rotation]" )
+{
+    const int width = 1024, height = 768, iterations = 20;
+    auto measure = [&]( const char * name, int bpp, std::function< void( byte *, const byte * ) > rotate ) {
+        auto src = random_bytes( width * height * bpp );
+        std::vector< byte > out( src.size() );
+        auto start = std::chrono::steady_clock::now();
+        for( int i = 0; i < iterations; ++i )
+            rotate( out.data(), src.data() );
+        std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << name << ", " << bpp << " bytes: " << iterations * width * height / elapsed.count() / 1e6 << " MPixel/s" << std::endl;
+    };
+
+    for( int bpp : { 1, 2, 4 } )
+    {
+        measure( "per pixel", bpp, [&]( byte * out, const byte * src ) { rotate_image_reference( out, src, width, height, bpp ); } );
+        measure( "transverse", bpp, [&]( byte * out, const byte * src ) { rotate_image( out, src, width, height, bpp, image_rotation::transverse ); } );
+        measure( "90 cw", bpp, [&]( byte * out, const byte * src ) { rotate_image( out, src, width, height, bpp, image_rotation::rotate_90_cw ); } );
+        measure( "180", bpp, [&]( byte * out, const byte * src ) { rotate_image( out, src, width, height, bpp, image_rotation::rotate_180 ); } );
+    }
+}
@@ -0,0 +1,175 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+#include "../test.h"
+#include <librealsense2/hpp/rs_internal.hpp>
+#include <librealsense2/hpp/rs_export.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace rs2;
+
+static const int W = 320;
+static const int H = 240;
+
+static std::vector< frame > record_depth( int n )
+{
+    software_device dev;
+    auto s = dev.add_sensor( "depth" );
+    rs2_intrinsics intrinsics{ W, H, W / 2.f, H / 2.f, 300.f, 300.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = s.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    frame_queue q( n, true );
+    s.open( profile );
+    s.start( q );
+
+    // A slanted surface with holes and steps, so that some faces are dropped by the threshold
+    std::vector< frame > frames;
+    for( int i = 0; i < n; ++i )
+    {
+        auto depth = new uint16_t[W * H];
+        for( int y = 0; y < H; ++y )
+            for( int x = 0; x < W; ++x )
+                depth[y * W + x] = ( ( x * 7 + y * 3 + i ) % 37 == 0 ) ? 0 : uint16_t( 800 + x + 2 * y + ( x / 50 ) * 100 );
+        s.on_video_frame( { depth, []( void * p ) { delete[] static_cast< uint16_t * >( p ); }, W * 2, 2, double( i ),
+                            RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i + 1, profile, 0.001f } );
+        frame f;
+        REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+        frames.push_back( f );
+    }
+    s.stop();
+    s.close();
+    return frames;
+}
+
+static std::string read_file( const std::string & name )
+{
+    std::ifstream in( name, std::ios_base::binary );
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// The background export writes the file some time after the frame went through the filter
+static std::string wait_for_file( const std::string & name, size_t size )
+{
+    std::string content;
+    for( int i = 0; i < 500; ++i )
+    {
+        content = read_file( name );
+        if( content.size() == size )
+            break;
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+    }
+    return content;
+}
+
+static void set_ply_options( save_to_ply & ply, bool binary )
+{
+    ply.set_option( save_to_ply::OPTION_PLY_MESH, 1 );
+    ply.set_option( save_to_ply::OPTION_PLY_NORMALS, 1 );
+    ply.set_option( save_to_ply::OPTION_PLY_BINARY, binary );
+}
+
+TEST_CASE( "save_to_ply writes the same file in the background as in the foreground", "[software-device]" )
+{
+    auto frames = record_depth( 3 );
+
+    for( bool binary : { true, false } )
+    {
+        INFO( "binary " << binary );
+        std::vector< std::string > expected;
+        for( size_t i = 0; i < frames.size(); ++i )
+        {
+            std::stringstream name;
+            name << "save-to-ply-sync-" << i << ".ply";
+            save_to_ply ply( name.str() );
+            set_ply_options( ply, binary );
+            ply.process( frames[i] );
+            expected.push_back( read_file( name.str() ) );
+            std::remove( name.str().c_str() );
+            REQUIRE( expected.back().size() > 0 );
+        }
+
+        save_to_ply ply( "save-to-ply-async-" );
+        set_ply_options( ply, binary );
+        ply.set_option( save_to_ply::OPTION_PLY_EVERY_NTH_FRAME, 1 );
+        for( size_t i = 0; i < frames.size(); ++i )
+        {
+            INFO( i );
+            REQUIRE( ply.process( frames[i] ) == frames[i] );
+
+            std::stringstream name;
+            name << "save-to-ply-async-" << frames[i].get_frame_number() << ".ply";
+            auto content = wait_for_file( name.str(), expected[i].size() );
+            std::remove( name.str().c_str() );
+            REQUIRE( content == expected[i] );
+        }
+    }
+}
+
+TEST_CASE( "save_to_ply can be copied", "[software-device]" )
+{
+    auto frames = record_depth( 1 );
+
+    save_to_ply original( "save-to-ply-copy-" );
+    original.set_option( save_to_ply::OPTION_PLY_EVERY_NTH_FRAME, 1 );
+    save_to_ply copy( original );
+    REQUIRE( copy.get_option( save_to_ply::OPTION_PLY_EVERY_NTH_FRAME ) == 1 );
+
+    // The copies share the export, including the background thread
+    copy.process( frames[0] );
+    std::stringstream name;
+    name << "save-to-ply-copy-" << frames[0].get_frame_number() << ".ply";
+    std::string content;
+    for( int i = 0; i < 500 && content.empty(); ++i )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        content = read_file( name.str() );
+    }
+    std::remove( name.str().c_str() );
+    REQUIRE( content.compare( 0, 4, "ply\n" ) == 0 );
+}
+
+TEST_CASE( "save_to_ply exports inline while the background export is running", "[software-device]" )
+{
+    auto frames = record_depth( 4 );
+
+    std::vector< std::string > expected;
+    for( size_t i = 0; i < frames.size(); ++i )
+    {
+        save_to_ply ply( "save-to-ply-expected.ply" );
+        set_ply_options( ply, true );
+        ply.process( frames[i] );
+        expected.push_back( read_file( "save-to-ply-expected.ply" ) );
+        std::remove( "save-to-ply-expected.ply" );
+    }
+
+    // Every other frame goes to the worker, and the next one is exported inline right away,
+    // sharing the pointcloud with the export that is still running
+    save_to_ply ply( "save-to-ply-mixed-" );
+    set_ply_options( ply, true );
+    for( size_t i = 0; i < frames.size(); i += 2 )
+    {
+        INFO( i );
+        ply.set_option( save_to_ply::OPTION_PLY_EVERY_NTH_FRAME, 1 );
+        ply.process( frames[i] );
+        ply.set_option( save_to_ply::OPTION_PLY_EVERY_NTH_FRAME, 0 );
+        ply.process( frames[i + 1] );
+
+        auto inline_content = read_file( "save-to-ply-mixed-" );
+        std::remove( "save-to-ply-mixed-" );
+        REQUIRE( inline_content == expected[i + 1] );
+
+        std::stringstream name;
+        name << "save-to-ply-mixed-" << frames[i].get_frame_number() << ".ply";
+        auto content = wait_for_file( name.str(), expected[i].size() );
+        std::remove( name.str().c_str() );
+        REQUIRE( content == expected[i] );
+    }
+}
@@ -0,0 +1,195 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <src/proc/color-formats-converter.h>
+#include <src/proc/y8i-to-y8y8.h>
+#include <src/proc/y12i-to-y16y16.h>
+
+#include "../catch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+// Expose the per-frame conversion of the converter blocks
+template< class CONVERTER > struct unpacker : CONVERTER
+{
+    template< class... ARGS > unpacker( ARGS... args ) : CONVERTER( args... ) {}
+    using CONVERTER::process_function;
+};
+
+static const int W = 1920, H = 1080;
+
+static std::vector< byte > random_bytes( size_t size )
+{
+    std::mt19937 rng( 7 );
+    std::vector< byte > res( size );
+    for( auto & b : res )
+        b = byte( rng() );
+    return res;
+}
+
+template< class F > static void benchmark( const char * name, F f )
+{
+    const int iterations = 20;
+    auto start = std::chrono::steady_clock::now();
+    for( int i = 0; i < iterations; ++i )
+        f();
+    std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << iterations * W * H / elapsed.count() / 1e6 << " MPixel/s" << std::endl;
+}
+
+// The generic YUV -> RGB conversion, which the NEON kernels reproduce exactly
+static void yuv_to_rgb( int y, int u, int v, byte * rgb )
+{
+    auto clamp = []( int x ) { return byte( x > 255 ? 255 : x < 0 ? 0 : x ); };
+    int c = y - 16, d = u - 128, e = v - 128;
+    rgb[0] = clamp( ( 298 * c + 409 * e + 128 ) >> 8 );
+    rgb[1] = clamp( ( 298 * c - 100 * d - 208 * e + 128 ) >> 8 );
+    rgb[2] = clamp( ( 298 * c + 516 * d + 128 ) >> 8 );
+}
+
+// The 16-bit fixed point conversion of the SSSE3 kernels: every product keeps the high half of (a << 4) * (k << 4),
+// and the rounding term is left out
+static int mulhi( int a, int k )
+{
+    return ( a * 16 * k * 16 ) >> 16;
+}
+
+static void yuv_to_rgb_ssse3( int y, int u, int v, byte * rgb )
+{
+    auto clamp = []( int x ) { return byte( x > 255 ? 255 : x < 0 ? 0 : x ); };
+    int c = y - 16, d = u - 128, e = v - 128;
+    rgb[0] = clamp( mulhi( c, 298 ) + mulhi( e, 409 ) );
+    rgb[1] = clamp( mulhi( c, 298 ) - mulhi( d, 100 ) - mulhi( e, 208 ) );
+    rgb[2] = clamp( mulhi( c, 298 ) + mulhi( d, 516 ) );
+}
+
+// What the unpackers of this build must output, byte for byte
+static std::vector< byte > reference_yuv422( const std::vector< byte > & src, bool uyvy, rs2_format format )
+{
+#ifdef __SSSE3__
+    auto convert = yuv_to_rgb_ssse3;
+#else
+    auto convert = yuv_to_rgb;
+#endif
+
+    std::vector< byte > res;
+    for( size_t i = 0; i < src.size(); i += 4 )
+    {
+        int y[2] = { src[i + ( uyvy ? 1 : 0 )], src[i + ( uyvy ? 3 : 2 )] };
+        int u = src[i + ( uyvy ? 0 : 1 )], v = src[i + ( uyvy ? 2 : 3 )];
+        for( int k = 0; k < 2; ++k )
+        {
+            byte rgb[3];
+            convert( y[k], u, v, rgb );
+            switch( format )
+            {
+            case RS2_FORMAT_Y8: res.push_back( byte( y[k] ) ); break;
+            case RS2_FORMAT_Y16: res.push_back( 0 ); res.push_back( byte( y[k] ) ); break;
+            case RS2_FORMAT_RGB8: res.insert( res.end(), { rgb[0], rgb[1], rgb[2] } ); break;
+            case RS2_FORMAT_BGR8: res.insert( res.end(), { rgb[2], rgb[1], rgb[0] } ); break;
+            case RS2_FORMAT_RGBA8: res.insert( res.end(), { rgb[0], rgb[1], rgb[2], 255 } ); break;
+            case RS2_FORMAT_BGRA8: res.insert( res.end(), { rgb[2], rgb[1], rgb[0], 255 } ); break;
+            default: break;
+            }
+        }
+    }
+    return res;
+}
+
+// The index of the first byte that differs, or the size when none does; comparing the frames themselves would print
+// megabytes on failure
+static size_t first_difference( const std::vector< byte > & out, const std::vector< byte > & expected )
+{
+    REQUIRE( out.size() == expected.size() );
+    return std::mismatch( out.begin(), out.end(), expected.begin() ).first - out.begin();
+}
+
+static size_t bytes_per_pixel( rs2_format format )
+{
+    switch( format )
+    {
+    case RS2_FORMAT_Y8: return 1;
+    case RS2_FORMAT_Y16: return 2;
+    case RS2_FORMAT_RGB8: case RS2_FORMAT_BGR8: return 3;
+    default: return 4;
+    }
+}
+
+TEST_CASE( "YUY2 and UYVY unpackers", "[unpackers]" )
+{
+    auto src = random_bytes( W * H * 2 );
+
+    for( auto format : { RS2_FORMAT_Y8, RS2_FORMAT_Y16, RS2_FORMAT_RGB8, RS2_FORMAT_BGR8, RS2_FORMAT_RGBA8, RS2_FORMAT_BGRA8 } )
+    {
+        std::vector< byte > out( W * H * bytes_per_pixel( format ) );
+        byte * dest[] = { out.data() };
+
+        unpacker< yuy2_converter > yuy2( format );
+        yuy2.process_function( dest, src.data(), W, H, int( out.size() ), int( src.size() ) );
+        INFO( "YUY2 to " << rs2_format_to_string( format ) );
+        CHECK( first_difference( out, reference_yuv422( src, false, format ) ) == out.size() );
+        benchmark( ( std::string( "YUY2 to " ) + rs2_format_to_string( format ) ).c_str(),
+                   [&] { yuy2.process_function( dest, src.data(), W, H, int( out.size() ), int( src.size() ) ); } );
+
+        if( format == RS2_FORMAT_Y8 || format == RS2_FORMAT_Y16 )
+            continue;
+
+        unpacker< uyvy_converter > uyvy( format );
+        std::fill( out.begin(), out.end(), byte( 0 ) );
+        uyvy.process_function( dest, src.data(), W, H, int( out.size() ), int( src.size() ) );
+        INFO( "UYVY to " << rs2_format_to_string( format ) );
+        CHECK( first_difference( out, reference_yuv422( src, true, format ) ) == out.size() );
+        benchmark( ( std::string( "UYVY to " ) + rs2_format_to_string( format ) ).c_str(),
+                   [&] { uyvy.process_function( dest, src.data(), W, H, int( out.size() ), int( src.size() ) ); } );
+    }
+}
+
+TEST_CASE( "Y8I and Y12I splitters", "[unpackers]" )
+{
+    // Not a multiple of 16 pixels, to go through the tail as well
+    const int w = 1283, h = 3;
+
+    auto y8i = random_bytes( w * h * 2 );
+    std::vector< byte > left( w * h ), right( w * h );
+    byte * dest8[] = { left.data(), right.data() };
+    unpacker< y8i_to_y8y8 > y8i_splitter;
+    y8i_splitter.process_function( dest8, y8i.data(), w, h, w * h, int( y8i.size() ) );
+    for( int i = 0; i < w * h; ++i )
+    {
+        REQUIRE( left[i] == y8i[2 * i] );
+        REQUIRE( right[i] == y8i[2 * i + 1] );
+    }
+
+    auto y12i = random_bytes( w * h * 3 );
+    std::vector< uint16_t > left16( w * h ), right16( w * h );
+    byte * dest16[] = { reinterpret_cast< byte * >( left16.data() ), reinterpret_cast< byte * >( right16.data() ) };
+    unpacker< y12i_to_y16y16 > y12i_splitter;
+    y12i_splitter.process_function( dest16, y12i.data(), w, h, w * h * 2, int( y12i.size() ) );
+    for( int i = 0; i < w * h; ++i )
+    {
+        int l = y12i[3 * i + 2] << 4 | y12i[3 * i + 1] >> 4;
+        int r = ( y12i[3 * i + 1] & 0x0f ) << 8 | y12i[3 * i];
+        REQUIRE( left16[i] == uint16_t( l << 6 | l >> 4 ) );
+        REQUIRE( right16[i] == uint16_t( r << 6 | r >> 4 ) );
+    }
+
+    y8i = random_bytes( W * H * 2 );
+    left.resize( W * H );
+    right.resize( W * H );
+    byte * full8[] = { left.data(), right.data() };
+    benchmark( "Y8I to Y8 Y8", [&] { y8i_splitter.process_function( full8, y8i.data(), W, H, W * H, W * H * 2 ); } );
+
+    y12i = random_bytes( W * H * 3 );
+    left16.resize( W * H );
+    right16.resize( W * H );
+    byte * full16[] = { reinterpret_cast< byte * >( left16.data() ), reinterpret_cast< byte * >( right16.data() ) };
+    benchmark( "Y12I to Y16 Y16", [&] { y12i_splitter.process_function( full16, y12i.data(), W, H, W * H * 2, W * H * 3 ); } );
+}
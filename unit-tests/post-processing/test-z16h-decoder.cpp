@@ -0,0 +1,216 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2022 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <src/proc/z16h-decoder.h>
+#include <common/decompress-huffman.h>
+
+#include "../catch.h"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace librealsense;
+
+// Produces Z16H streams with the Huffman code recovered from the decoder's state table. A zero
+// difference is '1'; a bit string is the code of a difference when, followed by ones, it decodes
+// to that difference and exactly as many zeros as there were ones.
+class z16h_encoder
+{
+    std::vector< std::string > _codes;  // the shortest code of each difference
+
+    static std::vector< uint8_t > decode_bits( const std::string & bits )
+    {
+        std::vector< uint8_t > res;
+        uint32_t state = 0;
+        for( size_t i = 0; i + 4 <= bits.size(); i += 4 )
+        {
+            auto e = uint32_t( DecompressionStateTable[state * 16 + std::stoi( bits.substr( i, 4 ), nullptr, 2 )] );
+            if( e & 0x8 )
+            {
+                res.push_back( uint8_t( e >> 24 ) );
+                res.insert( res.end(), e & 0x7, 0 );
+            }
+            state = ( e & 0x7fc0 ) >> 6;
+        }
+        return res;
+    }
+
+    void find_codes( const std::string & prefix )
+    {
+        auto ones = 24 + ( 4 - prefix.size() % 4 ) % 4;
+        auto decoded = decode_bits( prefix + std::string( ones, '1' ) );
+        REQUIRE( ! decoded.empty() );
+        if( decoded.size() == ones + 1 )
+        {
+            auto & code = _codes[decoded[0]];
+            if( code.empty() || code.size() > prefix.size() )
+                code = prefix;
+            return;
+        }
+        REQUIRE( prefix.size() < 24 );
+        find_codes( prefix + '0' );
+        find_codes( prefix + '1' );
+    }
+
+public:
+    z16h_encoder()
+        : _codes( 256 )
+    {
+        _codes[0] = "1";
+        find_codes( "0" );
+        for( auto & code : _codes )
+            REQUIRE( ! code.empty() );
+    }
+
+    // Zeros pad the last word: they start a code that never ends. When the image ends on the last
+    // nibble of a word, the stream may also have one more word.
+    std::vector< uint32_t > encode( const std::vector< uint8_t > & image, uint32_t stride, bool * ends_word = nullptr ) const
+    {
+        std::vector< uint32_t > res( ( stride + 3 ) / 4 );
+        memcpy( res.data(), image.data(), stride );
+
+        size_t bits = 0;
+        for( size_t i = stride; i < image.size(); ++i )
+            for( auto c : _codes[uint8_t( image[i] - image[i - stride] )] )
+            {
+                if( bits % 32 == 0 )
+                    res.push_back( 0 );
+                if( c == '1' )
+                    res.back() |= 1u << ( 31 - bits % 32 );
+                ++bits;
+            }
+        if( ends_word )
+            *ends_word = ( bits - 1 ) % 32 >= 28;
+        return res;
+    }
+};
+
+// Smooth surfaces with noise, steps and holes, like real depth
+static std::vector< uint8_t > make_depth( uint32_t width, uint32_t height, std::mt19937 & rng )
+{
+    std::vector< uint8_t > res( width * height * 2 );
+    std::normal_distribution< float > noise( 0.f, 2.f );
+    std::uniform_real_distribution< float > uniform( 0.f, 1.f );
+    float slope_x = uniform( rng ) * 4, slope_y = uniform( rng ) * 4, base = 500 + uniform( rng ) * 2000;
+    for( uint32_t y = 0; y < height; ++y )
+        for( uint32_t x = 0; x < width; ++x )
+        {
+            float z = base + slope_x * x + slope_y * y + ( x > width / 2 ? 300.f : 0.f );
+            bool hole = ( ( x / 37 + y / 29 ) % 11 ) == 0;
+            auto d = hole ? 0 : uint16_t( z + noise( rng ) );
+            memcpy( &res[( y * width + x ) * 2], &d, 2 );
+        }
+    return res;
+}
+
+TEST_CASE( "Z16H round trip", "[z16h]" )
+{
+    z16h_encoder encoder;
+    z16h_decoder decoder;
+    std::mt19937 rng( 7 );
+
+    struct resolution { uint32_t width, height; };
+    for( auto res : { resolution{ 4, 2 }, resolution{ 7, 3 }, resolution{ 64, 48 }, resolution{ 424, 240 }, resolution{ 848, 480 } } )
+    {
+        for( int i = 0; i < 8; ++i )
+        {
+            auto stride = res.width * 2;
+            auto image = make_depth( res.width, res.height, rng );
+            if( i % 4 == 1 )
+                for( auto & b : image )
+                    b = uint8_t( rng() );  // incompressible
+            bool ends_word;
+            auto compressed = encoder.encode( image, stride, &ends_word );
+            auto size = uint32_t( compressed.size() );
+
+            for( int threads : { 1, 4 } )
+            {
+                std::vector< uint8_t > decoded( image.size() );
+                REQUIRE( decoder.decode( compressed.data(), size, stride, res.height, decoded.data(), threads ) );
+                REQUIRE( decoded == image );
+
+                // A word less is refused, and so is a word more unless the image ended with a word
+                compressed.push_back( 0 );
+                CHECK( decoder.decode( compressed.data(), size + 1, stride, res.height, decoded.data(), threads ) == ends_word );
+                compressed.pop_back();
+                CHECK_FALSE( decoder.decode( compressed.data(), size - 1, stride, res.height, decoded.data(), threads ) );
+            }
+
+            std::vector< uint8_t > old( image.size() + 64 );
+            CHECK( unhuffimage4( compressed.data(), size, stride, res.height, old.data() ) );
+            old.resize( image.size() );
+            CHECK( old == image );
+        }
+    }
+}
+
+TEST_CASE( "Z16H corrupted streams", "[z16h]" )
+{
+    // Flipped bits and cut streams: the decoder stays inside the image and agrees with unhuffimage4()
+    // on what it accepts, and on what it decodes then
+    z16h_encoder encoder;
+    z16h_decoder decoder;
+    std::mt19937 rng( 11 );
+    const uint32_t width = 848, height = 480, stride = width * 2;
+    auto image = make_depth( width, height, rng );
+    auto valid = encoder.encode( image, stride );
+    int accepted = 0;
+    for( int i = 0; i < 200; ++i )
+    {
+        auto compressed = valid;
+        for( int flips = 1 + rng() % 3; flips; --flips )
+            compressed[stride / 4 + rng() % ( compressed.size() - stride / 4 )] ^= 1u << ( rng() % 32 );
+        if( i % 4 == 0 )
+            compressed.resize( compressed.size() - rng() % 100 );
+        auto size = uint32_t( compressed.size() );
+
+        std::vector< uint8_t > single( image.size() + 1, 0xcd ), striped( image.size() + 1, 0xcd ), old( image.size() + 64 );
+        auto good = decoder.decode( compressed.data(), size, stride, height, single.data(), 1 );
+        CHECK( decoder.decode( compressed.data(), size, stride, height, striped.data(), 8 ) == good );
+        CHECK( single.back() == 0xcd );
+        CHECK( striped.back() == 0xcd );
+        CHECK( unhuffimage4( compressed.data(), size, stride, height, old.data() ) == good );
+        if( good )
+        {
+            ++accepted;
+            CHECK( single == striped );
+            CHECK( std::equal( image.begin(), image.end(), old.begin() ) == std::equal( image.begin(), image.end(), single.begin() ) );
+            CHECK( std::equal( single.begin(), single.end() - 1, old.begin() ) );
+        }
+    }
+    std::cout << accepted << " of 200 corrupted streams still fit the image" << std::endl;
+}
+
+TEST_CASE( "Z16H throughput", "[z16h]" )
+{
+    z16h_encoder encoder;
+    z16h_decoder decoder;
+    std::mt19937 rng( 3 );
+    const uint32_t width = 1280, height = 720, stride = width * 2;
+    auto image = make_depth( width, height, rng );
+    auto compressed = encoder.encode( image, stride );
+    auto size = uint32_t( compressed.size() );
+    std::vector< uint8_t > decoded( image.size() + 64 );
+
+    auto benchmark = [&]( const char * name, std::function< bool() > decode ) {
+        const int iterations = 50;
+        auto start = std::chrono::steady_clock::now();
+        for( int i = 0; i < iterations; ++i )
+            REQUIRE( decode() );
+        std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << name << ": " << iterations * image.size() / elapsed.count() / 1e6 << " MB/s (compressed "
+                  << image.size() / ( size * 4. ) << ":1)" << std::endl;
+        CHECK( std::equal( image.begin(), image.end(), decoded.begin() ) );
+    };
+
+    benchmark( "unhuffimage4", [&] { return unhuffimage4( compressed.data(), size, stride, height, decoded.data() ); } );
+    benchmark( "z16h_decoder, 1 thread", [&] { return decoder.decode( compressed.data(), size, stride, height, decoded.data() ); } );
+    benchmark( "z16h_decoder, 4 threads", [&] { return decoder.decode( compressed.data(), size, stride, height, decoded.data(), 4 ); } );
+}
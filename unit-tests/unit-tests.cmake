@@ -11,6 +11,24 @@ if(Python3_FOUND)
         message(FATAL_ERROR "unit-test-config has failed with status = ${rv}")
     endif()
     add_subdirectory( ${CMAKE_CURRENT_BINARY_DIR} ${CMAKE_CURRENT_BINARY_DIR}/build )
+
+    # The compression tests link to the compression library of the network device, so they are only built along with it
+    foreach(test test-ethernet-temporal-compression test-ethernet-parallel-jpeg-compression)
+        if(NOT TARGET ${test})
+        elseif(BUILD_NETWORK_DEVICE)
+            set_property(TARGET ${test} APPEND PROPERTY LINK_LIBRARIES realsense2-compression)
+            set_property(TARGET ${test} APPEND PROPERTY INCLUDE_DIRECTORIES
+                ${CMAKE_SOURCE_DIR}/src/ipDeviceCommon
+                ${CMAKE_BINARY_DIR}/libjpeg-turbo/include)
+        else()
+            set_target_properties(${test} PROPERTIES EXCLUDE_FROM_ALL TRUE)
+        endif()
+    endforeach()
+
+    # The RTP fragment test builds the fragmenter of rs-server, which sends with POSIX sockets and sendmmsg()
+    if(TARGET test-ethernet-rtp-fragments AND NOT CMAKE_SYSTEM_NAME STREQUAL "Linux")
+        set_target_properties(test-ethernet-rtp-fragments PROPERTIES EXCLUDE_FROM_ALL TRUE)
+    endif()
 else()
     message(WARNING "Python 3 was not found; Unit tests will be limited!")
 endif()
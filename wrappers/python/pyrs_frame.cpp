@@ -4,6 +4,9 @@ Copyright(c) 2017 Intel Corporation. All Rights Reserved. */
 #include "python.hpp"
 #include "../include/librealsense2/rs.hpp"
 
+#include <pybind11/numpy.h>
+#include <cstring>
+
 void init_frame(py::module &m) {
     py::class_<BufData> BufData_py(m, "BufData", py::buffer_protocol());
     BufData_py.def_buffer([](BufData& self)
@@ -41,6 +44,72 @@ void init_frame(py::module &m) {
         else
             return BufData(const_cast<void*>(self.get_data()), 1, std::string("@B"), 0); };
     
+    // The AI results of a frame are a 16 bytes header (total bytes, number of boxes, PTS) followed by
+    // the boxes, laid out as altek_ai_box_info
+    const size_t ai_results_size = 1016;
+    const size_t ai_header_size = 16;
+    const size_t ai_max_boxes = (ai_results_size - ai_header_size) / sizeof(altek_ai_box_info);
+
+    // The dtypes are created on first use, so that numpy is only needed by the code using them.
+    // They are never released, as the interpreter may be gone when static objects are destroyed.
+    auto ai_box_dtype = []() -> const py::dtype&
+    {
+        static auto dtype = new py::dtype(
+            py::list(py::make_tuple("id", "left", "top", "right", "bottom", "distance", "degree")),
+            py::list(py::make_tuple("<u2", "<u2", "<u2", "<u2", "<u2", "<u2", "<f4")),
+            py::list(py::make_tuple(offsetof(altek_ai_box_info, m_u16Box_ID), offsetof(altek_ai_box_info, m_u16Box_Left),
+                offsetof(altek_ai_box_info, m_u16Box_Top), offsetof(altek_ai_box_info, m_u16Box_Right),
+                offsetof(altek_ai_box_info, m_u16Box_Bottom), offsetof(altek_ai_box_info, m_u16Box_Distance),
+                offsetof(altek_ai_box_info, m_f32Box_Degree))),
+            sizeof(altek_ai_box_info));
+        return *dtype;
+    };
+
+    auto metadata_dtype = []() -> const py::dtype&
+    {
+        static auto dtype = []()
+        {
+            py::list names, formats, offsets;
+            for (int i = 0; i < RS2_FRAME_METADATA_COUNT; ++i)
+            {
+                names.append(make_pythonic_str(rs2_frame_metadata_value_to_string(rs2_frame_metadata_value(i))));
+                formats.append("<i8");
+                offsets.append(i * sizeof(rs2_metadata_type));
+            }
+            names.append("supported");
+            formats.append("<u8");
+            offsets.append(RS2_FRAME_METADATA_COUNT * sizeof(rs2_metadata_type));
+            return new py::dtype(names, formats, offsets, (RS2_FRAME_METADATA_COUNT + 1) * sizeof(rs2_metadata_type));
+        }();
+        return *dtype;
+    };
+
+    // Views the boxes in place; the array keeps the frame alive
+    auto get_ai_results = [ai_box_dtype, ai_header_size, ai_max_boxes](const rs2::frame& self) -> py::array
+    {
+        auto data = static_cast<const uint8_t*>(self.get_al3d_ai_results());
+        uint32_t count;
+        memcpy(&count, data + sizeof(uint32_t), sizeof(count));
+        count = std::min<uint32_t>(count, uint32_t(ai_max_boxes));
+
+        py::array boxes(ai_box_dtype(), { size_t(count) }, { sizeof(altek_ai_box_info) }, data + ai_header_size, py::cast(self));
+        boxes.attr("setflags")("write"_a = false);
+        return boxes;
+    };
+
+    // Every attribute in one call, as a record with a field per attribute and a bitmask of the supported ones
+    auto get_metadata_all = [metadata_dtype](const rs2::frame& self) -> py::object
+    {
+        rs2_metadata_type values[RS2_FRAME_METADATA_COUNT] = {};
+        auto supported = self.get_frame_metadata_all(values);
+
+        py::array record(metadata_dtype(), std::vector<py::ssize_t>{});
+        auto dst = static_cast<uint8_t*>(record.mutable_data());
+        memcpy(dst, values, sizeof(values));
+        memcpy(dst + sizeof(values), &supported, sizeof(supported));
+        return record[py::tuple()];
+    };
+
     /* rs_frame.hpp */
     py::class_<rs2::stream_profile> stream_profile(m, "stream_profile", "Stores details about the profile of a stream.");
     stream_profile.def(py::init<>())
@@ -104,7 +173,7 @@ void init_frame(py::module &m) {
     pose_stream_profile.def(py::init<const rs2::stream_profile&>(), "sp"_a);
 
     py::class_<rs2::filter_interface> filter_interface(m, "filter_interface", "Interface for frame filtering functionality");
-    filter_interface.def("process", &rs2::filter_interface::process, "frame"_a); // No docstring in C++
+    filter_interface.def("process", &rs2::filter_interface::process, "frame"_a, py::call_guard<py::gil_scoped_release>()); // No docstring in C++
 
     py::class_<rs2::frame> frame(m, "frame", "Base class for multiple frame extensions");
     frame.def(py::init<>())
@@ -121,9 +190,14 @@ void init_frame(py::module &m) {
         .def("supports_frame_metadata", &rs2::frame::supports_frame_metadata, "Determine if the device allows a specific metadata to be queried.", "frame_metadata"_a)
         .def("get_frame_number", &rs2::frame::get_frame_number, "Retrieve the frame number.")
         .def_property_readonly("frame_number", &rs2::frame::get_frame_number, "The frame number. Identical to calling get_frame_number.")
+        .def("get_frame_metadata_all", get_metadata_all, "Retrieve every metadata attribute the frame supports in a single call, as a numpy record "
+             "with a field per frame_metadata_value and a 'supported' bitmask, bit i set when attribute i is supported.")
         .def("get_data_size", &rs2::frame::get_data_size, "Retrieve data size from frame handle.")
         .def("get_data", get_frame_data, "Retrieve data from the frame handle.", py::keep_alive<0, 1>())
         .def_property_readonly("data", get_frame_data, "Data from the frame handle. Identical to calling get_data.", py::keep_alive<0, 1>())
+        .def("get_al3d_ai_results", get_ai_results, "Retrieve the AL3D AI boxes of the frame as a read-only numpy structured array "
+             "(id, left, top, right, bottom, distance, degree) over the frame memory, without copying.")
+        .def_property_readonly("al3d_ai_results", get_ai_results, "AL3D AI boxes of the frame. Identical to calling get_al3d_ai_results.")
         .def("get_profile", &rs2::frame::get_profile, "Retrieve stream profile from frame handle.")
         .def_property_readonly("profile", &rs2::frame::get_profile, "Stream profile from frame handle. Identical to calling get_profile.")
         .def("keep", &rs2::frame::keep, "Keep the frame, otherwise if no refernce to the frame, the frame will be released.")
@@ -181,7 +181,8 @@ void init_internal(py::module &m) {
         .def("get_flash_log", &rs2::firmware_logger::get_flash_log, "Get Flash Log", "msg"_a)
         .def("init_parser", &rs2::firmware_logger::init_parser, "Initialize Parser with content of xml file",
             "xml_content"_a)
-        .def("parse_log", &rs2::firmware_logger::parse_log, "Parse Fw Log ", "msg"_a, "parsed_msg"_a);
+        .def("parse_log", &rs2::firmware_logger::parse_log, "Parse Fw Log ", "msg"_a, "parsed_msg"_a)
+        .def("parse_logs", &rs2::firmware_logger::parse_logs, "Parse a batch of Fw Logs, msgs[i] into parsed_msgs[i]", "msgs"_a, "parsed_msgs"_a);
 
     // rs2::terminal_parser
     py::class_<rs2::terminal_parser> terminal_parser(m, "terminal_parser");
@@ -154,7 +154,7 @@ void init_pipeline(py::module &m) {
              "To avoid frame drops, this method should be called as fast as the device frame rate.\n"
              "The application can maintain the frames handles to defer processing. However, if the application maintains too long "
              "history, the device may lack memory resources to produce new frames, and the following calls to this method shall "
-             "return no new frames, until resources become available.")
+             "return no new frames, until resources become available.", py::call_guard<py::gil_scoped_release>())
         .def("try_wait_for_frames", [](const rs2::pipeline &self, unsigned int timeout_ms) {
             rs2::frameset fs;
             auto success = self.try_wait_for_frames(&fs, timeout_ms);
@@ -35,7 +35,7 @@ void init_processing(py::module &m) {
             rs2::frame frame;
             self.poll_for_frame(&frame);
             return frame;
-        }, "Poll if a new frame is available and dequeue it if it is")
+        }, "Poll if a new frame is available and dequeue it if it is", py::call_guard<py::gil_scoped_release>())
         .def("try_wait_for_frame", [](const rs2::frame_queue &self, unsigned int timeout_ms) {
             rs2::frame frame;
             auto success = self.try_wait_for_frame(&frame, timeout_ms);
@@ -53,7 +53,7 @@ void init_processing(py::module &m) {
         .def("start", [](rs2::processing_block& self, std::function<void(rs2::frame)> f) {
             self.start(f);
         }, "Start the processing block with callback function to inform the application the frame is processed.", "callback"_a)
-        .def("invoke", &rs2::processing_block::invoke, "Ask processing block to process the frame", "f"_a)
+        .def("invoke", &rs2::processing_block::invoke, "Ask processing block to process the frame", "f"_a, py::call_guard<py::gil_scoped_release>())
         .def("supports", (bool (rs2::processing_block::*)(rs2_camera_info) const) &rs2::processing_block::supports, "Check if a specific camera info field is supported.")
         .def("get_info", &rs2::processing_block::get_info, "Retrieve camera specific information, like versions of various internal components.");
         /*.def("__call__", &rs2::processing_block::operator(), "f"_a)*/
@@ -81,7 +81,7 @@ void init_processing(py::module &m) {
     py::class_<rs2::pointcloud, rs2::filter> pointcloud(m, "pointcloud", "Generates 3D point clouds based on a depth frame. Can also map textures from a color frame.");
     pointcloud.def(py::init<>())
         .def(py::init<rs2_stream, int>(), "stream"_a, "index"_a = 0)
-        .def("calculate", &rs2::pointcloud::calculate, "Generate the pointcloud and texture mappings of depth map.", "depth"_a)
+        .def("calculate", &rs2::pointcloud::calculate, "Generate the pointcloud and texture mappings of depth map.", "depth"_a, py::call_guard<py::gil_scoped_release>())
         .def("map_to", &rs2::pointcloud::map_to, "Map the point cloud to the given color frame.", "mapped"_a);
 
     py::class_<rs2::yuy_decoder, rs2::filter> yuy_decoder(m, "yuy_decoder", "Converts frames in raw YUY format to RGB. This conversion is somewhat costly, "
@@ -107,7 +107,7 @@ void init_processing(py::module &m) {
             rs2::frameset frames;
             self.poll_for_frames(&frames);
             return frames;
-        }, "Check if a coherent set of frames is available")
+        }, "Check if a coherent set of frames is available", py::call_guard<py::gil_scoped_release>())
         .def("try_wait_for_frames", [](const rs2::syncer &self, unsigned int timeout_ms) {
             rs2::frameset fs;
             auto success = self.try_wait_for_frames(&fs, timeout_ms);
@@ -119,7 +119,7 @@ void init_processing(py::module &m) {
     align.def(py::init<rs2_stream>(), "To perform alignment of a depth image to the other, set the align_to parameter with the other stream type.\n"
               "To perform alignment of a non depth image to a depth image, set the align_to parameter to RS2_STREAM_DEPTH.\n"
               "Camera calibration and frame's stream type are determined on the fly, according to the first valid frameset passed to process().", "align_to"_a)
-        .def("process", (rs2::frameset(rs2::align::*)(rs2::frameset)) &rs2::align::process, "Run thealignment process on the given frames to get an aligned set of frames", "frames"_a);
+        .def("process", (rs2::frameset(rs2::align::*)(rs2::frameset)) &rs2::align::process, "Run thealignment process on the given frames to get an aligned set of frames", "frames"_a, py::call_guard<py::gil_scoped_release>());
 
     py::class_<rs2::colorizer, rs2::filter> colorizer(m, "colorizer", "Colorizer filter generates color images based on input depth frame");
     colorizer.def(py::init<>())
@@ -133,7 +133,7 @@ void init_processing(py::module &m) {
              "6 - Warm\n"
              "7 - Quantized\n"
              "8 - Pattern", "color_scheme"_a)
-        .def("colorize", &rs2::colorizer::colorize, "Start to generate color image base on depth frame", "depth"_a)
+        .def("colorize", &rs2::colorizer::colorize, "Start to generate color image base on depth frame", "depth"_a, py::call_guard<py::gil_scoped_release>())
         /*.def("__call__", &rs2::colorizer::operator())*/;
 
     py::class_<rs2::decimation_filter, rs2::filter> decimation_filter(m, "decimation_filter", "Performs downsampling by using the median with specific kernel size.");